@@ -0,0 +1,249 @@
+/******************************************************************************
+ * Copyright 2024 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include <getopt.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "cyber/benchmark/benchmark_msg.pb.h"
+#include "cyber/cyber.h"
+
+using apollo::cyber::benchmark::BenchmarkMsg;
+
+std::string BINARY_NAME = "cyber_topology_benchmark";  // NOLINT
+
+int nums_of_node = 10;
+int nums_of_channel = 10;
+int timeout_s = 60;
+
+void DisplayUsage() {
+  AINFO << "Usage: \n    " << BINARY_NAME << " [OPTION]...\n"
+        << "Description: \n"
+        << "    Node i writes its own m channels and reads the m channels of "
+           "node i+1, the time until every writer sees its reader and every "
+           "reader sees its writer is reported.\n"
+        << "Options: \n"
+        << "    -h, --help: help information \n"
+        << "    -n, --nums_of_node=nums_of_node: numbers of node, every node "
+           "runs in its own process, default value is 10\n"
+        << "    -m, --nums_of_channel=nums_of_channel: numbers of channel "
+           "written by every node, default value is 10\n"
+        << "    -t, --timeout=timeout: seconds to wait for the topology to "
+           "be fully connected, default value is 60\n"
+        << "Example:\n"
+        << "    " << BINARY_NAME << " -h\n"
+        << "    " << BINARY_NAME << " -n 10 -m 10\n"
+        << "    " << BINARY_NAME << " -n 50 -m 20 -t 120";
+}
+
+void GetOptions(const int argc, char* const argv[]) {
+  opterr = 0;  // extern int opterr
+  int long_index = 0;
+  const std::string short_opts = "hn:m:t:";
+  static const struct option long_opts[] = {
+      {"help", no_argument, nullptr, 'h'},
+      {"nums_of_node", required_argument, nullptr, 'n'},
+      {"nums_of_channel", required_argument, nullptr, 'm'},
+      {"timeout", required_argument, nullptr, 't'},
+      {NULL, no_argument, nullptr, 0}};
+
+  do {
+    int opt =
+        getopt_long(argc, argv, short_opts.c_str(), long_opts, &long_index);
+    if (opt == -1) {
+      break;
+    }
+    switch (opt) {
+      case 'n':
+        nums_of_node = std::stoi(std::string(optarg));
+        if (nums_of_node <= 0) {
+          AERROR << "Invalid numbers of node. It should be grater than 0";
+          exit(-1);
+        }
+        break;
+      case 'm':
+        nums_of_channel = std::stoi(std::string(optarg));
+        if (nums_of_channel <= 0) {
+          AERROR << "Invalid numbers of channel. It should be grater than 0";
+          exit(-1);
+        }
+        break;
+      case 't':
+        timeout_s = std::stoi(std::string(optarg));
+        if (timeout_s <= 0) {
+          AERROR << "Invalid timeout. It should be grater than 0";
+          exit(-1);
+        }
+        break;
+      case 'h':
+        DisplayUsage();
+        exit(0);
+      default:
+        break;
+    }
+  } while (true);
+
+  if (optind < argc) {
+    AINFO << "Found non-option ARGV-element \"" << argv[optind++] << "\"";
+    DisplayUsage();
+    exit(1);
+  }
+}
+
+std::string ChannelName(int node_index, int channel_index) {
+  return "/apollo/cyber/topology_benchmark/" + std::to_string(node_index) +
+         "/" + std::to_string(channel_index);
+}
+
+struct NodeResult {
+  int node_index;
+  // milliseconds from the start of the benchmark, -1 on timeout
+  double joined_ms;
+  double connected_ms;
+};
+
+double ElapsedMs(const std::chrono::steady_clock::time_point& start) {
+  return std::chrono::duration<double, std::milli>(
+             std::chrono::steady_clock::now() - start)
+      .count();
+}
+
+// runs in the child process, the monotonic clock is shared by all processes
+void RunNode(int node_index, const std::chrono::steady_clock::time_point& start,
+             int result_fd, int release_fd) {
+  NodeResult result{node_index, -1.0, -1.0};
+  apollo::cyber::Init(BINARY_NAME.c_str(),
+                      BINARY_NAME + "_" + std::to_string(node_index));
+  auto node = apollo::cyber::CreateNode(BINARY_NAME + "_node_" +
+                                        std::to_string(node_index));
+
+  std::vector<std::shared_ptr<apollo::cyber::Writer<BenchmarkMsg>>> writers;
+  std::vector<std::shared_ptr<apollo::cyber::Reader<BenchmarkMsg>>> readers;
+  int peer_index = (node_index + 1) % nums_of_node;
+  for (int i = 0; i < nums_of_channel; ++i) {
+    writers.emplace_back(
+        node->CreateWriter<BenchmarkMsg>(ChannelName(node_index, i)));
+    readers.emplace_back(node->CreateReader<BenchmarkMsg>(
+        ChannelName(peer_index, i),
+        [](const std::shared_ptr<BenchmarkMsg>& msg) {}));
+  }
+  result.joined_ms = ElapsedMs(start);
+
+  auto deadline = start + std::chrono::seconds(timeout_s);
+  while (std::chrono::steady_clock::now() < deadline) {
+    bool connected =
+        std::all_of(writers.begin(), writers.end(),
+                    [](const auto& writer) { return writer->HasReader(); }) &&
+        std::all_of(readers.begin(), readers.end(),
+                    [](const auto& reader) { return reader->HasWriter(); });
+    if (connected) {
+      result.connected_ms = ElapsedMs(start);
+      break;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+
+  if (write(result_fd, &result, sizeof(result)) != sizeof(result)) {
+    AERROR << "node " << node_index << " failed to report its result";
+  }
+  // keep the roles in the topology until every node has reported, or the
+  // late ones would never see their peers
+  char c;
+  while (read(release_fd, &c, 1) > 0) {
+  }
+  apollo::cyber::Clear();
+}
+
+int main(int argc, char** argv) {
+  GetOptions(argc, argv);
+
+  int result_pipe[2];
+  int release_pipe[2];
+  if (pipe(result_pipe) != 0 || pipe(release_pipe) != 0) {
+    AERROR << "create pipe failed.";
+    return -1;
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  std::vector<pid_t> children;
+  for (int i = 0; i < nums_of_node; ++i) {
+    pid_t pid = fork();
+    if (pid < 0) {
+      AERROR << "fork failed.";
+      break;
+    }
+    if (pid == 0) {
+      close(result_pipe[0]);
+      close(release_pipe[1]);
+      RunNode(i, start, result_pipe[1], release_pipe[0]);
+      _exit(0);
+    }
+    children.push_back(pid);
+  }
+  close(result_pipe[1]);
+  close(release_pipe[0]);
+
+  std::vector<NodeResult> results;
+  NodeResult result;
+  while (results.size() < children.size() &&
+         read(result_pipe[0], &result, sizeof(result)) == sizeof(result)) {
+    results.push_back(result);
+  }
+  close(release_pipe[1]);
+  for (auto pid : children) {
+    waitpid(pid, nullptr, 0);
+  }
+  close(result_pipe[0]);
+
+  int timeout_num = 0;
+  double max_joined_ms = 0.0;
+  double max_connected_ms = 0.0;
+  double sum_connected_ms = 0.0;
+  for (auto& item : results) {
+    max_joined_ms = std::max(max_joined_ms, item.joined_ms);
+    if (item.connected_ms < 0) {
+      ++timeout_num;
+      continue;
+    }
+    max_connected_ms = std::max(max_connected_ms, item.connected_ms);
+    sum_connected_ms += item.connected_ms;
+  }
+  int connected_num = static_cast<int>(results.size()) - timeout_num;
+
+  std::cout << std::fixed << std::setprecision(3) << "nodes: " << nums_of_node
+            << ", channels per node: " << nums_of_channel
+            << ", writers and readers: " << 2 * nums_of_node * nums_of_channel
+            << std::endl
+            << "max time to join:             " << max_joined_ms << " ms"
+            << std::endl
+            << "mean time to fully connected: "
+            << (connected_num > 0 ? sum_connected_ms / connected_num : 0.0)
+            << " ms" << std::endl
+            << "max time to fully connected:  " << max_connected_ms << " ms"
+            << std::endl
+            << "nodes timed out:              " << timeout_num << "/"
+            << nums_of_node << std::endl;
+  return timeout_num == 0 && connected_num == nums_of_node ? 0 : 1;
+}
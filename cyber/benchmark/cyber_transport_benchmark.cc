@@ -0,0 +1,614 @@
+/******************************************************************************
+ * Copyright 2024 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include <getopt.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "cyber/benchmark/benchmark_msg.pb.h"
+#include "cyber/common/global_data.h"
+#include "cyber/cyber.h"
+#include "cyber/message/message_traits.h"
+#include "cyber/transport/common/identity.h"
+#include "cyber/transport/transport.h"
+
+using apollo::cyber::benchmark::BenchmarkMsg;
+using apollo::cyber::proto::OptionalMode;
+using apollo::cyber::proto::RoleAttributes;
+using apollo::cyber::transport::Identity;
+using apollo::cyber::transport::MessageInfo;
+using apollo::cyber::transport::Transport;
+
+std::string BINARY_NAME = "cyber_transport_benchmark";  // NOLINT
+
+// channels of the arena mode have to be listed in the arena_shm_conf of
+// cyber.pb.conf, the other modes use a channel which is not
+const char TRANSPORT_CHANNEL[] = "/apollo/cyber/benchmark/transport";
+const char ARENA_CHANNEL[] = "/apollo/cyber/benchmark/arena";
+
+std::string mode = "shm";              // NOLINT
+std::string message_size_str = "64B";  // NOLINT
+std::string output_filename = "";      // NOLINT
+int message_size = 64;
+int nums_of_reader = 1;
+int transport_freq = 100;
+int running_time = 10;
+int warmup_time_ms = 2000;
+int drain_time_ms = 1000;
+
+void DisplayUsage() {
+  AINFO << "Usage: \n    " << BINARY_NAME << " [OPTION]...\n"
+        << "Description: \n"
+        << "    Publish on one channel with an explicit transport and report "
+           "the latency percentiles, throughput, cpu time per message and "
+           "peak memory of one run as a json line. Readers run in the writer "
+           "process with intra, in a process of their own otherwise.\n"
+        << "Options: \n"
+        << "    -h, --help: help information \n"
+        << "    -m, --mode=mode: intra, shm, arena or rtps, default value is "
+           "shm\n"
+        << "    -s, --message_size=message_size: payload size with a B, K or "
+           "M suffix, default value is 64B\n"
+        << "    -n, --nums_of_reader=nums_of_reader: numbers of reader, "
+           "default value is 1\n"
+        << "    -t, --transport_freq=transmission_frequency: messages per "
+           "second, 0 publishes as fast as possible, default value is 100\n"
+        << "    -T, --time=time: measured running time in seconds, default "
+           "value is 10\n"
+        << "    -w, --warmup=warmup: milliseconds of unmeasured messages sent "
+           "before the run, default value is 2000\n"
+        << "    -d, --drain=drain: milliseconds to wait for messages in "
+           "flight after the run, default value is 1000\n"
+        << "    -o, --output=filename: append the json result to the file "
+           "instead of printing it\n"
+        << "Example:\n"
+        << "    " << BINARY_NAME << " -h\n"
+        << "    " << BINARY_NAME << " -m shm -s 64K -n 2 -t 100\n"
+        << "    " << BINARY_NAME << " -m arena -s 8M -n 1 -t 0 -o result.json";
+}
+
+bool ParseSize(const std::string& arg, int* size) {
+  if (arg.size() < 2) {
+    return false;
+  }
+  int base_size = 1;
+  switch (arg[arg.length() - 1]) {
+    case 'B':
+      base_size = 1;
+      break;
+    case 'K':
+      base_size = 1024;
+      break;
+    case 'M':
+      base_size = 1024 * 1024;
+      break;
+    default:
+      return false;
+  }
+  *size = std::stoi(arg.substr(0, arg.length() - 1)) * base_size;
+  return *size > 0;
+}
+
+void GetOptions(const int argc, char* const argv[]) {
+  opterr = 0;  // extern int opterr
+  int long_index = 0;
+  const std::string short_opts = "hm:s:n:t:T:w:d:o:";
+  static const struct option long_opts[] = {
+      {"help", no_argument, nullptr, 'h'},
+      {"mode", required_argument, nullptr, 'm'},
+      {"message_size", required_argument, nullptr, 's'},
+      {"nums_of_reader", required_argument, nullptr, 'n'},
+      {"transport_freq", required_argument, nullptr, 't'},
+      {"time", required_argument, nullptr, 'T'},
+      {"warmup", required_argument, nullptr, 'w'},
+      {"drain", required_argument, nullptr, 'd'},
+      {"output", required_argument, nullptr, 'o'},
+      {NULL, no_argument, nullptr, 0}};
+
+  do {
+    int opt =
+        getopt_long(argc, argv, short_opts.c_str(), long_opts, &long_index);
+    if (opt == -1) {
+      break;
+    }
+    switch (opt) {
+      case 'm':
+        mode = std::string(optarg);
+        if (mode != "intra" && mode != "shm" && mode != "arena" &&
+            mode != "rtps") {
+          AERROR << "Invalid mode. It should be intra, shm, arena or rtps";
+          exit(-1);
+        }
+        break;
+      case 's':
+        message_size_str = std::string(optarg);
+        if (!ParseSize(message_size_str, &message_size)) {
+          AERROR << "Invalid message size. It should end with 'K' or 'M' or "
+                    "'B'";
+          exit(-1);
+        }
+        break;
+      case 'n':
+        nums_of_reader = std::stoi(std::string(optarg));
+        if (nums_of_reader <= 0) {
+          AERROR << "Invalid numbers of reader. It should be grater than 0";
+          exit(-1);
+        }
+        break;
+      case 't':
+        transport_freq = std::stoi(std::string(optarg));
+        if (transport_freq < 0) {
+          AERROR << "Invalid frequency. It should not be less than 0";
+          exit(-1);
+        }
+        break;
+      case 'T':
+        running_time = std::stoi(std::string(optarg));
+        if (running_time <= 0) {
+          AERROR << "Invalid running time. It should greater than 0";
+          exit(-1);
+        }
+        break;
+      case 'w':
+        warmup_time_ms = std::stoi(std::string(optarg));
+        break;
+      case 'd':
+        drain_time_ms = std::stoi(std::string(optarg));
+        break;
+      case 'o':
+        output_filename = std::string(optarg);
+        break;
+      case 'h':
+        DisplayUsage();
+        exit(0);
+      default:
+        break;
+    }
+  } while (true);
+
+  if (optind < argc) {
+    AINFO << "Found non-option ARGV-element \"" << argv[optind++] << "\"";
+    DisplayUsage();
+    exit(1);
+  }
+}
+
+uint64_t NowNs() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+double CpuTimeUs(int who) {
+  struct rusage usage;
+  getrusage(who, &usage);
+  return static_cast<double>(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) *
+             1e6 +
+         static_cast<double>(usage.ru_utime.tv_usec + usage.ru_stime.tv_usec);
+}
+
+int64_t MaxRssKb(int who) {
+  struct rusage usage;
+  getrusage(who, &usage);
+  return usage.ru_maxrss;
+}
+
+OptionalMode TransportMode() {
+  if (mode == "intra") {
+    return OptionalMode::INTRA;
+  }
+  if (mode == "rtps") {
+    return OptionalMode::RTPS;
+  }
+  return OptionalMode::SHM;
+}
+
+RoleAttributes MakeAttr(const std::string& channel_name) {
+  auto global_data = apollo::cyber::common::GlobalData::Instance();
+  RoleAttributes attr;
+  attr.set_channel_name(channel_name);
+  attr.set_channel_id(global_data->RegisterChannel(channel_name));
+  attr.set_host_name(global_data->HostName());
+  attr.set_host_ip(global_data->HostIp());
+  attr.set_process_id(global_data->ProcessId());
+  attr.set_message_type(apollo::cyber::message::MessageType<BenchmarkMsg>());
+  Identity id;
+  attr.set_id(id.HashValue());
+  auto qos = attr.mutable_qos_profile();
+  qos->set_history(apollo::cyber::proto::QosHistoryPolicy::HISTORY_KEEP_LAST);
+  qos->set_depth(10);
+  qos->set_reliability(
+      apollo::cyber::proto::QosReliabilityPolicy::RELIABILITY_RELIABLE);
+  return attr;
+}
+
+struct ReaderResult {
+  uint64_t received = 0;
+  uint64_t latency_num = 0;
+  double cpu_us = 0.0;
+  int64_t max_rss_kb = 0;
+};
+
+/**
+ * @brief Records the latency of every measured message, the samples are
+ * reserved upfront so that the listener does not allocate while measuring.
+ * The process cpu time is sampled at the first and the last measured message,
+ * which leaves warm up, idle and drain time out.
+ */
+class LatencyRecorder {
+ public:
+  LatencyRecorder() { latencies_us_.reserve(EstimatedMessages()); }
+
+  void OnMessage(const std::shared_ptr<BenchmarkMsg>& msg) {
+    uint64_t now = NowNs();
+    if (msg->seq() == 0) {
+      return;
+    }
+    double cpu_us = CpuTimeUs(RUSAGE_SELF);
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (received_ == 0) {
+      first_cpu_us_ = cpu_us;
+    }
+    last_cpu_us_ = std::max(last_cpu_us_, cpu_us);
+    ++received_;
+    latencies_us_.push_back(static_cast<double>(now - msg->send_time()) /
+                            1000.0);
+  }
+
+  uint64_t received() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return received_;
+  }
+
+  std::vector<double> latencies_us() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return latencies_us_;
+  }
+
+  double cpu_us() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return received_ > 0 ? last_cpu_us_ - first_cpu_us_ : 0.0;
+  }
+
+ private:
+  static size_t EstimatedMessages() {
+    // as fast as possible has no estimate, the vector grows then
+    return transport_freq > 0
+               ? static_cast<size_t>(transport_freq) * running_time + 1
+               : 1024 * 1024;
+  }
+
+  std::mutex mutex_;
+  uint64_t received_ = 0;
+  double first_cpu_us_ = 0.0;
+  double last_cpu_us_ = 0.0;
+  std::vector<double> latencies_us_;
+};
+
+using ReceiverPtr =
+    std::shared_ptr<apollo::cyber::transport::Receiver<BenchmarkMsg>>;
+
+ReceiverPtr CreateReceiver(const std::string& channel_name,
+                           LatencyRecorder* recorder) {
+  return Transport::Instance()->CreateReceiver<BenchmarkMsg>(
+      MakeAttr(channel_name),
+      [recorder](const std::shared_ptr<BenchmarkMsg>& msg, const MessageInfo&,
+                 const RoleAttributes&) { recorder->OnMessage(msg); },
+      TransportMode());
+}
+
+bool WriteAll(int fd, const void* data, size_t size) {
+  auto ptr = reinterpret_cast<const char*>(data);
+  while (size > 0) {
+    ssize_t n = write(fd, ptr, size);
+    if (n <= 0) {
+      return false;
+    }
+    ptr += n;
+    size -= n;
+  }
+  return true;
+}
+
+bool ReadAll(int fd, void* data, size_t size) {
+  auto ptr = reinterpret_cast<char*>(data);
+  while (size > 0) {
+    ssize_t n = read(fd, ptr, size);
+    if (n <= 0) {
+      return false;
+    }
+    ptr += n;
+    size -= n;
+  }
+  return true;
+}
+
+// runs in the child process, reports ready on the result pipe, receives until
+// the release pipe is closed and then reports the result on the result pipe
+void RunReader(int reader_index, const std::string& channel_name, int result_fd,
+               int release_fd) {
+  apollo::cyber::Init(BINARY_NAME.c_str(),
+                      BINARY_NAME + "_reader_" + std::to_string(reader_index));
+  LatencyRecorder recorder;
+  auto receiver = CreateReceiver(channel_name, &recorder);
+  char ready = receiver != nullptr ? 1 : 0;
+  WriteAll(result_fd, &ready, 1);
+
+  char c;
+  while (read(release_fd, &c, 1) > 0) {
+  }
+  receiver = nullptr;
+
+  ReaderResult result;
+  auto latencies = recorder.latencies_us();
+  result.received = recorder.received();
+  result.latency_num = latencies.size();
+  result.cpu_us = recorder.cpu_us();
+  result.max_rss_kb = MaxRssKb(RUSAGE_SELF);
+  if (!WriteAll(result_fd, &result, sizeof(result)) ||
+      !WriteAll(result_fd, latencies.data(),
+                latencies.size() * sizeof(double))) {
+    AERROR << "reader " << reader_index << " failed to report its result";
+  }
+  Transport::Instance()->Shutdown();
+  apollo::cyber::Clear();
+}
+
+// nearest rank percentile of sorted samples
+double Percentile(const std::vector<double>& sorted, double p) {
+  if (sorted.empty()) {
+    return 0.0;
+  }
+  size_t rank = static_cast<size_t>(std::ceil(p / 100.0 * sorted.size()));
+  return sorted[std::min(std::max<size_t>(rank, 1), sorted.size()) - 1];
+}
+
+int main(int argc, char** argv) {
+  GetOptions(argc, argv);
+  std::string channel_name =
+      mode == "arena" ? ARENA_CHANNEL : TRANSPORT_CHANNEL;
+
+  // readers of the other modes live in processes of their own, forked
+  // before the writer initializes cyber
+  std::vector<pid_t> children;
+  std::vector<int> result_fds;
+  int release_pipe[2] = {-1, -1};
+  if (mode != "intra") {
+    if (pipe(release_pipe) != 0) {
+      AERROR << "create pipe failed.";
+      return -1;
+    }
+    for (int i = 0; i < nums_of_reader; ++i) {
+      int result_pipe[2];
+      if (pipe(result_pipe) != 0) {
+        AERROR << "create pipe failed.";
+        break;
+      }
+      pid_t pid = fork();
+      if (pid < 0) {
+        AERROR << "fork failed.";
+        close(result_pipe[0]);
+        close(result_pipe[1]);
+        break;
+      }
+      if (pid == 0) {
+        close(result_pipe[0]);
+        close(release_pipe[1]);
+        for (auto fd : result_fds) {
+          close(fd);
+        }
+        RunReader(i, channel_name, result_pipe[1], release_pipe[0]);
+        _exit(0);
+      }
+      close(result_pipe[1]);
+      children.push_back(pid);
+      result_fds.push_back(result_pipe[0]);
+    }
+    close(release_pipe[0]);
+  }
+
+  apollo::cyber::Init(argv[0], BINARY_NAME);
+  bool ok = mode == "intra" || static_cast<int>(children.size()) ==
+                                   nums_of_reader;
+  if (ok && mode == "arena" &&
+      !apollo::cyber::common::GlobalData::Instance()->IsChannelEnableArenaShm(
+          channel_name)) {
+    AERROR << "arena mode needs an arena_channel_conf of " << channel_name
+           << " in cyber.pb.conf.";
+    ok = false;
+  }
+  for (auto fd : result_fds) {
+    char ready = 0;
+    if (!ReadAll(fd, &ready, 1) || ready != 1) {
+      AERROR << "reader failed to start.";
+      ok = false;
+    }
+  }
+
+  std::vector<std::unique_ptr<LatencyRecorder>> recorders;
+  std::vector<ReceiverPtr> receivers;
+  if (ok && mode == "intra") {
+    for (int i = 0; i < nums_of_reader; ++i) {
+      recorders.emplace_back(new LatencyRecorder());
+      receivers.emplace_back(
+          CreateReceiver(channel_name, recorders.back().get()));
+    }
+  }
+
+  auto transmitter = Transport::Instance()->CreateTransmitter<BenchmarkMsg>(
+      MakeAttr(channel_name), TransportMode());
+  if (transmitter == nullptr) {
+    ok = false;
+  } else {
+    // what the hybrid transmitter does for every reader it discovers
+    for (int i = 0; i < nums_of_reader; ++i) {
+      transmitter->Enable(MakeAttr(channel_name));
+    }
+  }
+
+  std::string payload(message_size, '\0');
+  for (int i = 0; i < message_size; ++i) {
+    payload[i] = static_cast<char>(i);
+  }
+  auto publish = [&](uint64_t seq) {
+    std::shared_ptr<BenchmarkMsg> msg(nullptr);
+    if (!transmitter->AcquireMessage(msg)) {
+      msg = std::make_shared<BenchmarkMsg>();
+    }
+    msg->set_data_bytes(payload);
+    msg->set_seq(seq);
+    msg->set_send_time(NowNs());
+    return transmitter->Transmit(msg);
+  };
+
+  uint64_t sent = 0;
+  double test_time_s = 0.0;
+  double writer_cpu_us = 0.0;
+  if (ok) {
+    auto period = std::chrono::nanoseconds(
+        transport_freq > 0 ? 1000000000LL / transport_freq : 0);
+    auto warmup_end = std::chrono::steady_clock::now() +
+                      std::chrono::milliseconds(warmup_time_ms);
+    while (std::chrono::steady_clock::now() < warmup_end) {
+      publish(0);
+      std::this_thread::sleep_for(std::max(
+          period, std::chrono::nanoseconds(std::chrono::milliseconds(10))));
+    }
+
+    double cpu_start = CpuTimeUs(RUSAGE_SELF);
+    auto start = std::chrono::steady_clock::now();
+    auto end = start + std::chrono::seconds(running_time);
+    auto next = start;
+    while (std::chrono::steady_clock::now() < end) {
+      if (publish(sent + 1)) {
+        ++sent;
+      }
+      if (transport_freq > 0) {
+        next += period;
+        std::this_thread::sleep_until(next);
+      }
+    }
+    test_time_s = std::chrono::duration<double>(
+                      std::chrono::steady_clock::now() - start)
+                      .count();
+    writer_cpu_us = CpuTimeUs(RUSAGE_SELF) - cpu_start;
+    std::this_thread::sleep_for(std::chrono::milliseconds(drain_time_ms));
+  }
+
+  // collect the results, the intra readers are part of the writer process
+  uint64_t received = 0;
+  double reader_cpu_us = 0.0;
+  int64_t reader_max_rss_kb = 0;
+  std::vector<double> latencies;
+  for (auto& recorder : recorders) {
+    received += recorder->received();
+    auto samples = recorder->latencies_us();
+    latencies.insert(latencies.end(), samples.begin(), samples.end());
+  }
+  receivers.clear();
+  if (release_pipe[1] >= 0) {
+    close(release_pipe[1]);
+  }
+  for (auto fd : result_fds) {
+    ReaderResult result;
+    if (!ReadAll(fd, &result, sizeof(result))) {
+      AERROR << "read reader result failed.";
+      ok = false;
+      close(fd);
+      continue;
+    }
+    std::vector<double> samples(result.latency_num);
+    if (!ReadAll(fd, samples.data(), samples.size() * sizeof(double))) {
+      AERROR << "read reader latencies failed.";
+      ok = false;
+    }
+    received += result.received;
+    reader_cpu_us += result.cpu_us;
+    reader_max_rss_kb = std::max(reader_max_rss_kb, result.max_rss_kb);
+    latencies.insert(latencies.end(), samples.begin(), samples.end());
+    close(fd);
+  }
+  for (auto pid : children) {
+    waitpid(pid, nullptr, 0);
+  }
+  transmitter = nullptr;
+  int64_t writer_max_rss_kb = MaxRssKb(RUSAGE_SELF);
+  Transport::Instance()->Shutdown();
+  apollo::cyber::Clear();
+  if (!ok) {
+    return -1;
+  }
+
+  std::sort(latencies.begin(), latencies.end());
+  double mean =
+      latencies.empty()
+          ? 0.0
+          : std::accumulate(latencies.begin(), latencies.end(), 0.0) /
+                static_cast<double>(latencies.size());
+  uint64_t expected = sent * nums_of_reader;
+  std::ostringstream json;
+  json << std::fixed << std::setprecision(3) << "{\"mode\": \"" << mode
+       << "\", \"message_size\": " << message_size
+       << ", \"readers\": " << nums_of_reader
+       << ", \"frequency\": " << transport_freq
+       << ", \"test_time_s\": " << test_time_s << ", \"sent\": " << sent
+       << ", \"received\": " << received
+       << ", \"lost\": " << (expected > received ? expected - received : 0)
+       << ", \"latency_us\": {\"mean\": " << mean
+       << ", \"p50\": " << Percentile(latencies, 50.0)
+       << ", \"p99\": " << Percentile(latencies, 99.0)
+       << ", \"p99.9\": " << Percentile(latencies, 99.9)
+       << ", \"max\": " << (latencies.empty() ? 0.0 : latencies.back())
+       << "}, \"throughput_msgs_per_s\": "
+       << (test_time_s > 0 ? static_cast<double>(received) / test_time_s : 0.0)
+       << ", \"throughput_mb_per_s\": "
+       << (test_time_s > 0 ? static_cast<double>(received) * message_size /
+                                 (1024.0 * 1024.0) / test_time_s
+                           : 0.0)
+       << ", \"writer_cpu_us_per_msg\": "
+       << (sent > 0 ? writer_cpu_us / static_cast<double>(sent) : 0.0)
+       << ", \"reader_cpu_us_per_msg\": "
+       << (received > 0 ? reader_cpu_us / static_cast<double>(received) : 0.0)
+       << ", \"writer_max_rss_kb\": " << writer_max_rss_kb
+       << ", \"reader_max_rss_kb\": " << reader_max_rss_kb << "}";
+
+  if (output_filename.empty()) {
+    std::cout << json.str() << std::endl;
+  } else {
+    std::ofstream output(output_filename, std::ios::app);
+    if (!output.is_open()) {
+      AERROR << "open " << output_filename << " failed.";
+      return -1;
+    }
+    output << json.str() << std::endl;
+  }
+  return 0;
+}
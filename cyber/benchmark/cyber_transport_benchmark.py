@@ -0,0 +1,272 @@
+#!/usr/bin/env python3
+# ****************************************************************************
+# Copyright 2024 The Apollo Authors. All Rights Reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+#  You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ****************************************************************************
+"""
+cyber transport benchmark suite
+
+Sweeps cyber_transport_benchmark over transport modes, message sizes, reader
+numbers and frequencies, and saves the results of all runs in one json file.
+Two result files, e.g. of two commits, are compared with --compare.
+"""
+
+import os
+import re
+import sys
+import json
+import time
+import socket
+import argparse
+import itertools
+import subprocess
+import tempfile
+
+BINARY = "cyber_transport_benchmark"
+
+# metric path in a result, and whether a larger value is better
+METRICS = [
+    (("latency_us", "p50"), False),
+    (("latency_us", "p99"), False),
+    (("latency_us", "p99.9"), False),
+    (("throughput_msgs_per_s",), True),
+    (("writer_cpu_us_per_msg",), False),
+    (("reader_cpu_us_per_msg",), False),
+    (("writer_max_rss_kb",), False),
+    (("reader_max_rss_kb",), False),
+]
+
+# a change of these beyond the threshold fails the comparison, the others are
+# only reported because they are noisier
+GATED_METRICS = [("latency_us", "p99"), ("writer_cpu_us_per_msg",),
+                 ("reader_cpu_us_per_msg",)]
+
+
+def case_key(result):
+    """
+    the parameters identifying a run
+    """
+    return (result["mode"], result["message_size"], result["readers"],
+            result["frequency"])
+
+
+def case_name(key):
+    """
+    readable name of a run
+    """
+    return "mode:{}/size:{}/readers:{}/frequency:{}".format(*key)
+
+
+def metric_value(result, path):
+    """
+    value of a metric, None if missing
+    """
+    value = result
+    for k in path:
+        if not isinstance(value, dict) or k not in value:
+            return None
+        value = value[k]
+    return value
+
+
+def git_commit():
+    """
+    commit the benchmark is run on, if it is run from a work tree
+    """
+    try:
+        return subprocess.check_output(
+            ["git", "rev-parse", "HEAD"], stderr=subprocess.DEVNULL,
+            universal_newlines=True).strip()
+    except (OSError, subprocess.CalledProcessError):
+        return "unknown"
+
+
+def run_case(params, mode, size, readers, frequency):
+    """
+    run one case, return its result or None on failure
+    """
+    fd, output = tempfile.mkstemp(suffix=".json")
+    os.close(fd)
+    args = [params.binary, "-m", mode, "-s", size, "-n", str(readers),
+            "-t", str(frequency), "-T", str(params.time),
+            "-w", str(params.warmup), "-o", output]
+    timeout = params.time + (params.warmup + 1000) / 1000.0 + 60
+    try:
+        ret = subprocess.run(args, stdout=subprocess.DEVNULL,
+                             stderr=subprocess.DEVNULL, timeout=timeout)
+        if ret.returncode != 0:
+            print("  failed with return code {}".format(ret.returncode))
+            return None
+        with open(output, "r") as f:
+            return json.loads(f.readline())
+    except subprocess.TimeoutExpired:
+        print("  timed out after {} s".format(timeout))
+        return None
+    except (OSError, ValueError) as err:
+        print("  failed: {}".format(err))
+        return None
+    finally:
+        os.remove(output)
+
+
+def run(params):
+    """
+    run the sweep and save the results
+    """
+    report = {
+        "commit": git_commit(),
+        "host": socket.gethostname(),
+        "time": int(time.time()),
+        "results": [],
+    }
+    failed = 0
+    cases = list(itertools.product(params.modes, params.data_size,
+                                   params.reader_nums, params.frequency))
+    for i, (mode, size, readers, frequency) in enumerate(cases):
+        print("[{}/{}] {}".format(i + 1, len(cases), case_name(
+            (mode, size, readers, frequency))))
+        result = run_case(params, mode, size, readers, frequency)
+        if result is None:
+            failed += 1
+            continue
+        latency = result["latency_us"]
+        print("  p50: {} us, p99: {} us, p99.9: {} us, {} msgs/s, lost: {}".format(
+            latency["p50"], latency["p99"], latency["p99.9"],
+            result["throughput_msgs_per_s"], result["lost"]))
+        report["results"].append(result)
+        # results are saved as they come, a long sweep is not lost at once
+        with open(params.output, "w") as f:
+            json.dump(report, f, indent=2)
+
+    print("{} of {} cases done, results saved to {}".format(
+        len(cases) - failed, len(cases), params.output))
+    return 0 if failed == 0 else 1
+
+
+def compare(params):
+    """
+    compare the results of two sweeps, fail on a regression of the gated
+    metrics beyond the threshold
+    """
+    with open(params.compare[0], "r") as f:
+        base = json.load(f)
+    with open(params.compare[1], "r") as f:
+        head = json.load(f)
+    print("base: {} ({})".format(base.get("commit"), params.compare[0]))
+    print("head: {} ({})".format(head.get("commit"), params.compare[1]))
+
+    base_results = {case_key(r): r for r in base["results"]}
+    regressions = 0
+    for result in head["results"]:
+        key = case_key(result)
+        if key not in base_results:
+            continue
+        print(case_name(key))
+        base_result = base_results[key]
+        for path, larger_is_better in METRICS:
+            old = metric_value(base_result, path)
+            new = metric_value(result, path)
+            if old is None or new is None:
+                continue
+            change = (new - old) / old * 100.0 if old else 0.0
+            worse = -change if larger_is_better else change
+            regressed = path in GATED_METRICS and worse > params.threshold
+            regressions += regressed
+            print("  {:<24}{:>14.3f}{:>14.3f}{:>+10.1f}%{}".format(
+                ".".join(path), old, new, change,
+                "  REGRESSION" if regressed else ""))
+        if result["lost"] > base_result["lost"]:
+            print("  {:<24}{:>14}{:>14}".format(
+                "lost", base_result["lost"], result["lost"]))
+
+    print("{} regressions beyond {}%".format(regressions, params.threshold))
+    return 0 if regressions == 0 else 1
+
+
+def param_parse(params):
+    """
+    parse user parameters
+    """
+    pattern = re.compile(r'^\d+[kKmMbB]$')
+    for i in range(len(params.data_size)):
+        param = params.data_size[i]
+        if not pattern.match(param):
+            print("data size {} is invalid".format(param))
+            sys.exit(2)
+        params.data_size[i] = param[:-1] + param[-1].upper()
+    for mode in params.modes:
+        if mode not in ("intra", "shm", "arena", "rtps"):
+            print("mode {} is invalid".format(mode))
+            sys.exit(2)
+    if params.output is None:
+        params.output = "transport_benchmark_{}.json".format(int(time.time()))
+    return params
+
+
+def main():
+    """
+    entry
+    """
+    parser = argparse.ArgumentParser(description='cyber transport benchmark')
+    parser.add_argument(
+        '-m', '--modes', nargs='*', metavar='*',
+        default=['intra', 'shm', 'arena', 'rtps'],
+        help='transport modes, intra, shm, arena or rtps'
+    )
+    parser.add_argument(
+        '-s', '--data_size', nargs='*', metavar='*',
+        default=['64B', '1K', '64K', '1M', '8M', '32M'],
+        type=str.lstrip, help='message size, default is 64B - 32M'
+    )
+    parser.add_argument(
+        '-r', '--reader_nums', nargs='*', metavar='*', type=int,
+        default=[1, 2, 4], help='how many readers receive the message'
+    )
+    parser.add_argument(
+        '-f', '--frequency', nargs='*', metavar='*', type=int,
+        default=[10, 100, 0],
+        help='messages per second, 0 means as fast as possible'
+    )
+    parser.add_argument(
+        '-t', '--time', type=int, default=10,
+        help='measured seconds of every case, default is 10s'
+    )
+    parser.add_argument(
+        '-w', '--warmup', type=int, default=2000,
+        help='unmeasured milliseconds before every case, default is 2000ms'
+    )
+    parser.add_argument(
+        '-o', '--output', type=str, default=None,
+        help='result file, default is transport_benchmark_<time>.json'
+    )
+    parser.add_argument(
+        '-b', '--binary', type=str, default=BINARY,
+        help='path of cyber_transport_benchmark'
+    )
+    parser.add_argument(
+        '-c', '--compare', nargs=2, metavar=('BASE', 'HEAD'),
+        help='compare two result files instead of running'
+    )
+    parser.add_argument(
+        '--threshold', type=float, default=10.0,
+        help='percent a gated metric may get worse by, default is 10'
+    )
+    params = param_parse(parser.parse_args(sys.argv[1:]))
+    if params.compare:
+        sys.exit(compare(params))
+    sys.exit(run(params))
+
+
+if __name__ == "__main__":
+    main()
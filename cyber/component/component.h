@@ -355,7 +355,8 @@ bool Component<M0, M1, NullType, NullType>::Initialize(
   for (auto& reader : readers_) {
     config_list.emplace_back(reader->ChannelId(), reader->PendingQueueSize());
   }
-  auto dv = std::make_shared<data::DataVisitor<M0, M1>>(config_list);
+  auto dv = std::make_shared<data::DataVisitor<M0, M1>>(config_list,
+                                                        config.fusion());
   croutine::RoutineFactory factory =
       croutine::CreateRoutineFactory<M0, M1>(func, dv);
   return sched->CreateTask(factory, node_->Name());
@@ -495,7 +496,8 @@ bool Component<M0, M1, M2, NullType>::Initialize(
   for (auto& reader : readers_) {
     config_list.emplace_back(reader->ChannelId(), reader->PendingQueueSize());
   }
-  auto dv = std::make_shared<data::DataVisitor<M0, M1, M2>>(config_list);
+  auto dv = std::make_shared<data::DataVisitor<M0, M1, M2>>(config_list,
+                                                            config.fusion());
   croutine::RoutineFactory factory =
       croutine::CreateRoutineFactory<M0, M1, M2>(func, dv);
   return sched->CreateTask(factory, node_->Name());
@@ -647,7 +649,8 @@ bool Component<M0, M1, M2, M3>::Initialize(const ComponentConfig& config) {
   for (auto& reader : readers_) {
     config_list.emplace_back(reader->ChannelId(), reader->PendingQueueSize());
   }
-  auto dv = std::make_shared<data::DataVisitor<M0, M1, M2, M3>>(config_list);
+  auto dv = std::make_shared<data::DataVisitor<M0, M1, M2, M3>>(
+      config_list, config.fusion());
   croutine::RoutineFactory factory =
       croutine::CreateRoutineFactory<M0, M1, M2, M3>(func, dv);
   return sched->CreateTask(factory, node_->Name());
@@ -60,7 +60,13 @@ bool TimerComponent::Initialize(const TimerComponentConfig& config) {
     statistics::Statistics::Instance()->SamplingProcLatency<
                   uint64_t>(*role_attr, (end_time-start_time)/1000);
   };
-  timer_.reset(new Timer(config.interval(), func, false));
+  TimerOption opt(config.interval(), func, false);
+  if (config.high_resolution()) {
+    opt.period_us = static_cast<uint64_t>(config.interval()) * 1000;
+    opt.dispatch = TimerDispatch::CROUTINE;
+    opt.croutine_name = config.name();
+  }
+  timer_.reset(new Timer(opt));
   timer_->Start();
   return true;
 }
@@ -39,7 +39,10 @@ enum class RoutineState { READY, FINISHED, SLEEP, IO_WAIT, DATA_WAIT };
 
 class CRoutine {
  public:
-  explicit CRoutine(const RoutineFunc &func);
+  /**
+   * @param stack_size in bytes, 0 means the default of StackAllocator
+   */
+  explicit CRoutine(const RoutineFunc &func, size_t stack_size = 0);
   virtual ~CRoutine();
 
   // static interfaces
@@ -88,6 +91,10 @@ class CRoutine {
 
   std::chrono::steady_clock::time_point wake_time() const;
 
+  // high water mark of the stack in bytes
+  size_t stack_usage() const;
+  size_t stack_size() const { return context_->stack_size; }
+
   void set_group_name(const std::string &group_name) {
     group_name_ = group_name;
   }
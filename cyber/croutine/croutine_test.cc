@@ -18,6 +18,7 @@
 #include "gtest/gtest.h"
 
 #include "cyber/common/global_data.h"
+#include "cyber/croutine/detail/stack_allocator.h"
 #include "cyber/cyber.h"
 #include "cyber/init.h"
 
@@ -27,6 +28,14 @@ namespace croutine {
 
 void function() { CRoutine::Yield(RoutineState::IO_WAIT); }
 
+void deep_function() {
+  volatile char buf[32 * 1024];
+  for (size_t i = 0; i < sizeof(buf); ++i) {
+    buf[i] = static_cast<char>(i);
+  }
+  CRoutine::Yield(RoutineState::IO_WAIT);
+}
+
 TEST(Croutine, croutinetest) {
   apollo::cyber::Init("croutine_test");
   std::shared_ptr<CRoutine> cr = std::make_shared<CRoutine>(function);
@@ -49,6 +58,33 @@ TEST(Croutine, croutinetest) {
   EXPECT_EQ(cr->Resume(), RoutineState::FINISHED);
 }
 
+TEST(Croutine, stack) {
+  const size_t stack_size = 128 * 1024;
+  auto cr = std::make_shared<CRoutine>(deep_function, stack_size);
+  EXPECT_EQ(cr->stack_size(), stack_size);
+  EXPECT_LT(cr->stack_usage(), 32 * 1024);
+  cr->Resume();
+  EXPECT_EQ(cr->state(), RoutineState::IO_WAIT);
+  EXPECT_GE(cr->stack_usage(), 32 * 1024);
+  EXPECT_LT(cr->stack_usage(), stack_size);
+
+  auto allocator = StackAllocator::Instance();
+  char* stack = cr->GetContext()->stack;
+  size_t pooled_num = allocator->pooled_num();
+  cr = nullptr;
+  EXPECT_EQ(allocator->pooled_num(), pooled_num + 1);
+  EXPECT_GE(allocator->peak_usage(), 32 * 1024);
+
+  // the released stack is reused with its pages dropped
+  cr = std::make_shared<CRoutine>(function, stack_size);
+  EXPECT_EQ(cr->GetContext()->stack, stack);
+  EXPECT_EQ(allocator->pooled_num(), pooled_num);
+  EXPECT_LT(cr->stack_usage(), 32 * 1024);
+
+  auto default_cr = std::make_shared<CRoutine>(function);
+  EXPECT_EQ(default_cr->stack_size(), allocator->default_stack_size());
+}
+
 }  // namespace croutine
 }  // namespace cyber
 }  // namespace apollo
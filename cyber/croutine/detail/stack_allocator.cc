@@ -0,0 +1,170 @@
+/******************************************************************************
+ * Copyright 2024 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/croutine/detail/stack_allocator.h"
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <algorithm>
+
+#include "cyber/common/global_data.h"
+#include "cyber/common/log.h"
+
+namespace apollo {
+namespace cyber {
+namespace croutine {
+
+StackAllocator::StackAllocator() {
+  uint32_t routine_num = common::GlobalData::Instance()->ComponentNums();
+  auto& global_conf = common::GlobalData::Instance()->Config();
+  if (global_conf.has_scheduler_conf()) {
+    auto& sched_conf = global_conf.scheduler_conf();
+    if (sched_conf.has_routine_num()) {
+      routine_num = std::max(routine_num, sched_conf.routine_num());
+    }
+    if (sched_conf.default_stack_size_kb() > 0) {
+      default_stack_size_ =
+          static_cast<size_t>(sched_conf.default_stack_size_kb()) * 1024;
+    }
+  }
+  max_pooled_num_ = routine_num;
+}
+
+StackAllocator::~StackAllocator() { Shutdown(); }
+
+size_t StackAllocator::PageSize() {
+  static const size_t page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  return page_size;
+}
+
+char* StackAllocator::MapStack(size_t stack_size) {
+  {
+    std::lock_guard<std::mutex> lock(pool_mutex_);
+    auto it = pool_.find(stack_size);
+    if (it != pool_.end() && !it->second.empty()) {
+      char* stack = it->second.back();
+      it->second.pop_back();
+      --pooled_num_;
+      return stack;
+    }
+  }
+
+  // [guard page][stack ... top), pages are committed on first touch
+  const size_t page_size = PageSize();
+  void* addr = mmap(nullptr, stack_size + page_size, PROT_READ | PROT_WRITE,
+                    MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+  if (addr == MAP_FAILED) {
+    AERROR << "mmap croutine stack of " << stack_size << " bytes failed.";
+    return nullptr;
+  }
+  if (mprotect(addr, page_size, PROT_NONE) != 0) {
+    AWARN << "mprotect croutine stack guard page failed.";
+  }
+  return static_cast<char*>(addr) + page_size;
+}
+
+void StackAllocator::UnmapStack(char* stack, size_t stack_size) {
+  const size_t page_size = PageSize();
+  munmap(stack - page_size, stack_size + page_size);
+}
+
+std::shared_ptr<RoutineContext> StackAllocator::CreateContext(
+    size_t stack_size) {
+  if (stack_size == 0) {
+    stack_size = default_stack_size_;
+  }
+  const size_t page_size = PageSize();
+  stack_size = (stack_size + page_size - 1) / page_size * page_size;
+
+  auto ctx = new RoutineContext();
+  ctx->stack_size = stack_size;
+  ctx->stack = MapStack(stack_size);
+  if (ctx->stack == nullptr) {
+    ctx->stack = new char[stack_size];
+    return std::shared_ptr<RoutineContext>(ctx, [](RoutineContext* ctx) {
+      delete[] ctx->stack;
+      delete ctx;
+    });
+  }
+  return std::shared_ptr<RoutineContext>(
+      ctx, [this](RoutineContext* ctx) { ReleaseContext(ctx); });
+}
+
+void StackAllocator::ReleaseContext(RoutineContext* ctx) {
+  size_t usage = StackUsage(*ctx);
+  size_t peak = peak_usage_.load();
+  while (usage > peak && !peak_usage_.compare_exchange_weak(peak, usage)) {
+  }
+
+  bool pooled = false;
+  {
+    std::lock_guard<std::mutex> lock(pool_mutex_);
+    if (pooled_num_ < max_pooled_num_) {
+      // drop the touched pages so an idle stack costs no memory
+      madvise(ctx->stack, ctx->stack_size, MADV_DONTNEED);
+      pool_[ctx->stack_size].push_back(ctx->stack);
+      ++pooled_num_;
+      pooled = true;
+    }
+  }
+  if (!pooled) {
+    UnmapStack(ctx->stack, ctx->stack_size);
+  }
+  delete ctx;
+}
+
+size_t StackAllocator::StackUsage(const RoutineContext& ctx) {
+  const size_t page_size = PageSize();
+  if (ctx.stack == nullptr ||
+      reinterpret_cast<uintptr_t>(ctx.stack) % page_size != 0) {
+    return 0;
+  }
+  // the stack grows down, so the lowest resident page is the high water mark
+  size_t page_num = ctx.stack_size / page_size;
+  std::vector<unsigned char> resident(page_num);
+  if (mincore(ctx.stack, ctx.stack_size, resident.data()) != 0) {
+    return 0;
+  }
+  for (size_t i = 0; i < page_num; ++i) {
+    if (resident[i] & 1) {
+      return (page_num - i) * page_size;
+    }
+  }
+  return 0;
+}
+
+size_t StackAllocator::pooled_num() const {
+  std::lock_guard<std::mutex> lock(pool_mutex_);
+  return pooled_num_;
+}
+
+void StackAllocator::Shutdown() {
+  std::lock_guard<std::mutex> lock(pool_mutex_);
+  for (auto& stacks : pool_) {
+    for (auto stack : stacks.second) {
+      UnmapStack(stack, stacks.first);
+    }
+  }
+  pool_.clear();
+  pooled_num_ = 0;
+  // stacks released from now on are unmapped right away
+  max_pooled_num_ = 0;
+}
+
+}  // namespace croutine
+}  // namespace cyber
+}  // namespace apollo
@@ -0,0 +1,85 @@
+/******************************************************************************
+ * Copyright 2024 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_CROUTINE_DETAIL_STACK_ALLOCATOR_H_
+#define CYBER_CROUTINE_DETAIL_STACK_ALLOCATOR_H_
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "cyber/common/macros.h"
+#include "cyber/croutine/detail/routine_context.h"
+
+namespace apollo {
+namespace cyber {
+namespace croutine {
+
+/**
+ * @class StackAllocator
+ * @brief Hands out croutine stacks mmap'd with a PROT_NONE guard page below
+ * them, so an overflow faults instead of corrupting the neighbouring memory.
+ * Pages are only committed when touched, and stacks of released routines are
+ * kept (with their pages dropped) for reuse, up to `routine_num` of them.
+ */
+class StackAllocator {
+ public:
+  ~StackAllocator();
+
+  /**
+   * @brief Create a context owning a fresh stack, stack_size 0 means
+   * `default_stack_size_kb` of the scheduler conf (STACK_SIZE if unset)
+   */
+  std::shared_ptr<RoutineContext> CreateContext(size_t stack_size = 0);
+
+  /**
+   * @brief High water mark of the stack in bytes, at page granularity
+   */
+  static size_t StackUsage(const RoutineContext& ctx);
+
+  size_t default_stack_size() const { return default_stack_size_; }
+  size_t pooled_num() const;
+  // highest StackUsage seen when routines were released
+  size_t peak_usage() const { return peak_usage_.load(); }
+
+  void Shutdown();
+
+ private:
+  static size_t PageSize();
+  char* MapStack(size_t stack_size);
+  void UnmapStack(char* stack, size_t stack_size);
+  void ReleaseContext(RoutineContext* ctx);
+
+  size_t default_stack_size_ = STACK_SIZE;
+  size_t max_pooled_num_ = 0;
+
+  mutable std::mutex pool_mutex_;
+  // key: stack size
+  std::unordered_map<size_t, std::vector<char*>> pool_;
+  size_t pooled_num_ = 0;
+  std::atomic<size_t> peak_usage_ = {0};
+
+  DECLARE_SINGLETON(StackAllocator)
+};
+
+}  // namespace croutine
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_CROUTINE_DETAIL_STACK_ALLOCATOR_H_
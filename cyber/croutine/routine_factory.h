@@ -17,8 +17,11 @@
 #ifndef CYBER_CROUTINE_ROUTINE_FACTORY_H_
 #define CYBER_CROUTINE_ROUTINE_FACTORY_H_
 
+#include <chrono>
+#include <limits>
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "cyber/common/global_data.h"
 #include "cyber/common/log.h"
@@ -69,6 +72,55 @@ RoutineFactory CreateRoutineFactory(
   return factory;
 }
 
+/**
+ * @brief Routine draining every pending message of a single channel per
+ * wakeup and handing them to f as one batch. A partial batch is held back
+ * (the routine sleeps, ignoring notifies) until it reaches max_batch_size or
+ * its first message has waited max_delay_us; max_batch_size == 0 means
+ * unbounded and max_delay_us == 0 dispatches whatever is available.
+ */
+template <typename M0, typename F>
+RoutineFactory CreateBatchRoutineFactory(
+    F&& f, const std::shared_ptr<data::DataVisitor<M0>>& dv,
+    uint32_t max_batch_size, uint64_t max_delay_us) {
+  RoutineFactory factory;
+  factory.SetDataVisitor(dv);
+  const uint64_t batch_size = max_batch_size == 0
+                                  ? std::numeric_limits<uint64_t>::max()
+                                  : max_batch_size;
+  const auto max_delay = std::chrono::microseconds(max_delay_us);
+  factory.create_routine = [=]() {
+    return [=]() {
+      std::vector<std::shared_ptr<M0>> msgs;
+      std::chrono::steady_clock::time_point batch_start;
+      for (;;) {
+        CRoutine::GetCurrentRoutine()->set_state(RoutineState::DATA_WAIT);
+        bool was_empty = msgs.empty();
+        dv->TryFetchBatch(batch_size - msgs.size(), &msgs);
+        if (msgs.empty()) {
+          CRoutine::Yield();
+          continue;
+        }
+        if (was_empty) {
+          batch_start = std::chrono::steady_clock::now();
+        }
+        if (msgs.size() < batch_size && max_delay_us > 0) {
+          auto waited = std::chrono::steady_clock::now() - batch_start;
+          if (waited < max_delay) {
+            CRoutine::GetCurrentRoutine()->Sleep(
+                std::chrono::duration_cast<Duration>(max_delay - waited));
+            continue;
+          }
+        }
+        f(msgs);
+        msgs.clear();
+        CRoutine::Yield(RoutineState::READY);
+      }
+    };
+  };
+  return factory;
+}
+
 template <typename M0, typename M1, typename F>
 RoutineFactory CreateRoutineFactory(
     F&& f, const std::shared_ptr<data::DataVisitor<M0, M1>>& dv) {
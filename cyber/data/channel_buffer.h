@@ -45,6 +45,12 @@ class ChannelBuffer {
 
   bool FetchMulti(uint64_t fetch_size, std::vector<std::shared_ptr<T>>* vec);
 
+  // Appends every message from *index up to the tail (at most max_size) to
+  // vec under a single lock, and advances *index past the last one fetched.
+  // An index of 0 starts from the oldest message still buffered.
+  bool FetchBatch(uint64_t* index, uint64_t max_size,
+                  std::vector<std::shared_ptr<T>>* vec);
+
   uint64_t channel_id() const { return channel_id_; }
   std::shared_ptr<BufferType> Buffer() const { return buffer_; }
 
@@ -104,6 +110,35 @@ bool ChannelBuffer<T>::FetchMulti(uint64_t fetch_size,
   return true;
 }
 
+template <typename T>
+bool ChannelBuffer<T>::FetchBatch(uint64_t* index, uint64_t max_size,
+                                  std::vector<std::shared_ptr<T>>* vec) {
+  std::lock_guard<std::mutex> lock(buffer_->Mutex());
+  if (buffer_->Empty() || max_size == 0) {
+    return false;
+  }
+
+  if (*index == 0) {
+    *index = buffer_->Head();
+  } else if (*index == buffer_->Tail() + 1) {
+    return false;
+  } else if (*index < buffer_->Head()) {
+    auto interval = buffer_->Head() - *index;
+    AWARN << "channel[" << GlobalData::GetChannelById(channel_id_) << "] "
+          << "read buffer overflow, drop_message[" << interval << "] pre_index["
+          << *index << "] current_index[" << buffer_->Head() << "] ";
+    *index = buffer_->Head();
+  }
+
+  auto num = std::min(buffer_->Tail() - *index + 1, max_size);
+  vec->reserve(vec->size() + num);
+  for (uint64_t i = 0; i < num; ++i) {
+    vec->emplace_back(buffer_->at(*index + i));
+  }
+  *index += num;
+  return true;
+}
+
 }  // namespace data
 }  // namespace cyber
 }  // namespace apollo
@@ -98,6 +98,39 @@ TEST(ChannelBufferTest, FetchMulti) {
   EXPECT_EQ(2, *vector[1]);
 }
 
+TEST(ChannelBufferTest, FetchBatch) {
+  auto cache_buffer = new CacheBuffer<std::shared_ptr<int>>(4);
+  auto buffer = std::make_shared<ChannelBuffer<int>>(channel0, cache_buffer);
+  std::vector<std::shared_ptr<int>> vector;
+  uint64_t index = 0;
+  EXPECT_FALSE(buffer->FetchBatch(&index, 10, &vector));
+  buffer->Buffer()->Fill(std::make_shared<int>(1));
+  buffer->Buffer()->Fill(std::make_shared<int>(2));
+  buffer->Buffer()->Fill(std::make_shared<int>(3));
+  EXPECT_TRUE(buffer->FetchBatch(&index, 2, &vector));
+  EXPECT_EQ(2, vector.size());
+  EXPECT_EQ(1, *vector[0]);
+  EXPECT_EQ(2, *vector[1]);
+  EXPECT_EQ(3, index);
+
+  EXPECT_TRUE(buffer->FetchBatch(&index, 10, &vector));
+  EXPECT_EQ(3, vector.size());
+  EXPECT_EQ(3, *vector[2]);
+  EXPECT_EQ(4, index);
+  EXPECT_FALSE(buffer->FetchBatch(&index, 10, &vector));
+
+  // overflow keeps everything still buffered
+  vector.clear();
+  for (int i = 4; i <= 9; ++i) {
+    buffer->Buffer()->Fill(std::make_shared<int>(i));
+  }
+  EXPECT_TRUE(buffer->FetchBatch(&index, 10, &vector));
+  EXPECT_EQ(4, vector.size());
+  EXPECT_EQ(6, *vector[0]);
+  EXPECT_EQ(9, *vector[3]);
+  EXPECT_EQ(10, index);
+}
+
 }  // namespace data
 }  // namespace cyber
 }  // namespace apollo
@@ -22,12 +22,15 @@
 #include <memory>
 #include <vector>
 
+#include "cyber/proto/component_conf.pb.h"
+
 #include "cyber/common/log.h"
 #include "cyber/data/channel_buffer.h"
 #include "cyber/data/data_dispatcher.h"
 #include "cyber/data/data_visitor_base.h"
 #include "cyber/data/fusion/all_latest.h"
 #include "cyber/data/fusion/data_fusion.h"
+#include "cyber/data/fusion/time_sync.h"
 
 namespace apollo {
 namespace cyber {
@@ -47,7 +50,9 @@ template <typename M0, typename M1 = NullType, typename M2 = NullType,
           typename M3 = NullType>
 class DataVisitor : public DataVisitorBase {
  public:
-  explicit DataVisitor(const std::vector<VisitorConfig>& configs)
+  explicit DataVisitor(
+      const std::vector<VisitorConfig>& configs,
+      const proto::FusionConf& fusion_conf = proto::FusionConf())
       : buffer_m0_(configs[0].channel_id,
                    new BufferType<M0>(configs[0].queue_size)),
         buffer_m1_(configs[1].channel_id,
@@ -60,9 +65,15 @@ class DataVisitor : public DataVisitorBase {
     DataDispatcher<M1>::Instance()->AddBuffer(buffer_m1_);
     DataDispatcher<M2>::Instance()->AddBuffer(buffer_m2_);
     DataDispatcher<M3>::Instance()->AddBuffer(buffer_m3_);
-    data_notifier_->AddNotifier(buffer_m0_.channel_id(), notifier_);
-    data_fusion_ = new fusion::AllLatest<M0, M1, M2, M3>(
-        buffer_m0_, buffer_m1_, buffer_m2_, buffer_m3_);
+    if (fusion_conf.policy() == proto::FusionConf::ALL_LATEST) {
+      data_notifier_->AddNotifier(buffer_m0_.channel_id(), notifier_);
+      data_fusion_ = new fusion::AllLatest<M0, M1, M2, M3>(
+          buffer_m0_, buffer_m1_, buffer_m2_, buffer_m3_);
+    } else {
+      data_fusion_ = new fusion::TimeSync<M0, M1, M2, M3>(
+          fusion_conf, FusedCallback(), buffer_m0_, buffer_m1_, buffer_m2_,
+          buffer_m3_);
+    }
   }
 
   ~DataVisitor() {
@@ -92,7 +103,9 @@ class DataVisitor : public DataVisitorBase {
 template <typename M0, typename M1, typename M2>
 class DataVisitor<M0, M1, M2, NullType> : public DataVisitorBase {
  public:
-  explicit DataVisitor(const std::vector<VisitorConfig>& configs)
+  explicit DataVisitor(
+      const std::vector<VisitorConfig>& configs,
+      const proto::FusionConf& fusion_conf = proto::FusionConf())
       : buffer_m0_(configs[0].channel_id,
                    new BufferType<M0>(configs[0].queue_size)),
         buffer_m1_(configs[1].channel_id,
@@ -102,9 +115,14 @@ class DataVisitor<M0, M1, M2, NullType> : public DataVisitorBase {
     DataDispatcher<M0>::Instance()->AddBuffer(buffer_m0_);
     DataDispatcher<M1>::Instance()->AddBuffer(buffer_m1_);
     DataDispatcher<M2>::Instance()->AddBuffer(buffer_m2_);
-    data_notifier_->AddNotifier(buffer_m0_.channel_id(), notifier_);
-    data_fusion_ =
-        new fusion::AllLatest<M0, M1, M2>(buffer_m0_, buffer_m1_, buffer_m2_);
+    if (fusion_conf.policy() == proto::FusionConf::ALL_LATEST) {
+      data_notifier_->AddNotifier(buffer_m0_.channel_id(), notifier_);
+      data_fusion_ = new fusion::AllLatest<M0, M1, M2>(buffer_m0_, buffer_m1_,
+                                                       buffer_m2_);
+    } else {
+      data_fusion_ = new fusion::TimeSync<M0, M1, M2>(
+          fusion_conf, FusedCallback(), buffer_m0_, buffer_m1_, buffer_m2_);
+    }
   }
 
   ~DataVisitor() {
@@ -133,15 +151,22 @@ class DataVisitor<M0, M1, M2, NullType> : public DataVisitorBase {
 template <typename M0, typename M1>
 class DataVisitor<M0, M1, NullType, NullType> : public DataVisitorBase {
  public:
-  explicit DataVisitor(const std::vector<VisitorConfig>& configs)
+  explicit DataVisitor(
+      const std::vector<VisitorConfig>& configs,
+      const proto::FusionConf& fusion_conf = proto::FusionConf())
       : buffer_m0_(configs[0].channel_id,
                    new BufferType<M0>(configs[0].queue_size)),
         buffer_m1_(configs[1].channel_id,
                    new BufferType<M1>(configs[1].queue_size)) {
     DataDispatcher<M0>::Instance()->AddBuffer(buffer_m0_);
     DataDispatcher<M1>::Instance()->AddBuffer(buffer_m1_);
-    data_notifier_->AddNotifier(buffer_m0_.channel_id(), notifier_);
-    data_fusion_ = new fusion::AllLatest<M0, M1>(buffer_m0_, buffer_m1_);
+    if (fusion_conf.policy() == proto::FusionConf::ALL_LATEST) {
+      data_notifier_->AddNotifier(buffer_m0_.channel_id(), notifier_);
+      data_fusion_ = new fusion::AllLatest<M0, M1>(buffer_m0_, buffer_m1_);
+    } else {
+      data_fusion_ = new fusion::TimeSync<M0, M1>(fusion_conf, FusedCallback(),
+                                                  buffer_m0_, buffer_m1_);
+    }
   }
 
   ~DataVisitor() {
@@ -188,6 +213,11 @@ class DataVisitor<M0, NullType, NullType, NullType> : public DataVisitorBase {
     return false;
   }
 
+  bool TryFetchBatch(uint64_t max_size,
+                     std::vector<std::shared_ptr<M0>>* msgs) {
+    return buffer_.FetchBatch(&next_msg_index_, max_size, msgs);
+  }
+
  private:
   ChannelBuffer<M0> buffer_;
 };
@@ -42,6 +42,17 @@ class DataVisitorBase {
   DataVisitorBase(const DataVisitorBase&) = delete;
   DataVisitorBase& operator=(const DataVisitorBase&) = delete;
 
+  // notifies the visitor directly, for the fusions that are not driven by
+  // the data notifier of a single channel
+  std::function<void()> FusedCallback() const {
+    auto notifier = notifier_;
+    return [notifier]() {
+      if (notifier->callback) {
+        notifier->callback();
+      }
+    };
+  }
+
   uint64_t next_msg_index_ = 0;
   DataNotifier* data_notifier_ = DataNotifier::Instance();
   std::shared_ptr<Notifier> notifier_;
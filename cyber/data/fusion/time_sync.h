@@ -0,0 +1,419 @@
+/******************************************************************************
+ * Copyright 2024 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_DATA_FUSION_TIME_SYNC_H_
+#define CYBER_DATA_FUSION_TIME_SYNC_H_
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "cyber/proto/component_conf.pb.h"
+
+#include "cyber/common/types.h"
+#include "cyber/data/channel_buffer.h"
+#include "cyber/data/fusion/data_fusion.h"
+
+namespace apollo {
+namespace cyber {
+namespace data {
+namespace fusion {
+
+template <typename T, typename = void>
+struct HasHeaderTimestamp : std::false_type {};
+
+template <typename T>
+struct HasHeaderTimestamp<
+    T, decltype(std::declval<const T&>().header().timestamp_sec(), void())>
+    : std::true_type {};
+
+/**
+ * @brief Header timestamp of a message in nanosecond, messages without a
+ * `header().timestamp_sec()` are stamped with their arrival time instead.
+ */
+template <typename T>
+typename std::enable_if<HasHeaderTimestamp<T>::value, uint64_t>::type
+MessageTime(const T& msg) {
+  return static_cast<uint64_t>(msg.header().timestamp_sec() * 1e9);
+}
+
+template <typename T>
+typename std::enable_if<!HasHeaderTimestamp<T>::value, uint64_t>::type
+MessageTime(const T& msg) {
+  (void)msg;
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::system_clock::now().time_since_epoch())
+      .count();
+}
+
+/**
+ * @class TimeSyncCore
+ * @brief Type erased matching of `TimeSync`. The newest of the oldest
+ * message of every channel is the pivot: once every channel holds a message
+ * within `slop` of it, the closest ones are fused and everything up to them
+ * is consumed. A pivot some channel has nothing close to, and will never have
+ * since its messages are all newer, is dropped. Exact time is a zero slop.
+ */
+class TimeSyncCore {
+ public:
+  using Messages = std::vector<std::shared_ptr<void>>;
+  using FusedCallback = std::function<void(const Messages&)>;
+
+  TimeSyncCore(uint32_t channel_num, uint64_t slop_ns, uint32_t queue_size,
+               const FusedCallback& callback)
+      : slop_ns_(slop_ns),
+        queue_size_(std::max(queue_size, 1U)),
+        queues_(channel_num),
+        callback_(callback) {}
+
+  void Add(uint32_t channel, uint64_t time_ns,
+           const std::shared_ptr<void>& msg) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (time_ns + slop_ns_ < last_pivot_ns_) {
+      // older than the last fused tuple allows
+      ++dropped_;
+      return;
+    }
+    auto& queue = queues_[channel];
+    auto pos = std::upper_bound(
+        queue.begin(), queue.end(), time_ns,
+        [](uint64_t time, const Entry& entry) { return time < entry.first; });
+    queue.emplace(pos, time_ns, msg);
+    if (queue.size() > queue_size_) {
+      queue.pop_front();
+      ++dropped_;
+    }
+    Match();
+  }
+
+  // messages consumed without being fused
+  uint64_t dropped() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return dropped_;
+  }
+
+ private:
+  using Entry = std::pair<uint64_t, std::shared_ptr<void>>;
+
+  void Match() {
+    Messages fused(queues_.size());
+    std::vector<size_t> chosen(queues_.size());
+    while (true) {
+      uint64_t pivot = 0;
+      size_t pivot_channel = 0;
+      for (size_t i = 0; i < queues_.size(); ++i) {
+        if (queues_[i].empty()) {
+          return;
+        }
+        if (queues_[i].front().first >= pivot) {
+          pivot = queues_[i].front().first;
+          pivot_channel = i;
+        }
+      }
+      uint64_t lower = pivot > slop_ns_ ? pivot - slop_ns_ : 0;
+      uint64_t upper = pivot + slop_ns_;
+
+      bool drop_pivot = false;
+      bool stale = false;
+      for (size_t i = 0; i < queues_.size(); ++i) {
+        auto& queue = queues_[i];
+        auto it = std::lower_bound(queue.begin(), queue.end(), lower,
+                                   [](const Entry& entry, uint64_t time) {
+                                     return entry.first < time;
+                                   });
+        if (it == queue.end()) {
+          // too old for this pivot and any later one
+          dropped_ += queue.size();
+          queue.clear();
+          stale = true;
+          continue;
+        }
+        if (it->first > upper) {
+          drop_pivot = true;
+          continue;
+        }
+        // closest to the pivot within the slop
+        size_t best = it - queue.begin();
+        for (size_t j = best + 1; j < queue.size(); ++j) {
+          if (queue[j].first > upper) {
+            break;
+          }
+          if (Distance(queue[j].first, pivot) <
+              Distance(queue[best].first, pivot)) {
+            best = j;
+          }
+        }
+        chosen[i] = best;
+      }
+      if (drop_pivot) {
+        queues_[pivot_channel].pop_front();
+        ++dropped_;
+        continue;
+      }
+      if (stale) {
+        return;
+      }
+
+      for (size_t i = 0; i < queues_.size(); ++i) {
+        auto& queue = queues_[i];
+        fused[i] = queue[chosen[i]].second;
+        dropped_ += chosen[i];
+        queue.erase(queue.begin(), queue.begin() + chosen[i] + 1);
+      }
+      last_pivot_ns_ = pivot;
+      callback_(fused);
+    }
+  }
+
+  static uint64_t Distance(uint64_t lhs, uint64_t rhs) {
+    return lhs > rhs ? lhs - rhs : rhs - lhs;
+  }
+
+  const uint64_t slop_ns_;
+  const uint32_t queue_size_;
+  std::mutex mutex_;
+  std::vector<std::deque<Entry>> queues_;
+  uint64_t last_pivot_ns_ = 0;
+  uint64_t dropped_ = 0;
+  FusedCallback callback_;
+};
+
+inline uint64_t SlopNs(const proto::FusionConf& conf) {
+  if (conf.policy() != proto::FusionConf::APPROXIMATE_TIME ||
+      conf.slop_ms() <= 0.0) {
+    return 0;
+  }
+  return static_cast<uint64_t>(conf.slop_ms() * 1e6);
+}
+
+/**
+ * @class TimeSync
+ * @brief `EXACT_TIME` and `APPROXIMATE_TIME` fusion. Unlike `AllLatest`,
+ * which is driven by M0, a message of any channel may complete a tuple, so
+ * `on_fused` is invoked for every fused tuple and the visitor is notified
+ * from there instead of by the M0 channel.
+ */
+template <typename M0, typename M1 = NullType, typename M2 = NullType,
+          typename M3 = NullType>
+class TimeSync : public DataFusion<M0, M1, M2, M3> {
+  using FusionDataType = std::tuple<std::shared_ptr<M0>, std::shared_ptr<M1>,
+                                    std::shared_ptr<M2>, std::shared_ptr<M3>>;
+
+ public:
+  TimeSync(const proto::FusionConf& conf, const std::function<void()>& on_fused,
+           const ChannelBuffer<M0>& buffer_0, const ChannelBuffer<M1>& buffer_1,
+           const ChannelBuffer<M2>& buffer_2, const ChannelBuffer<M3>& buffer_3)
+      : buffer_m0_(buffer_0),
+        buffer_m1_(buffer_1),
+        buffer_m2_(buffer_2),
+        buffer_m3_(buffer_3),
+        buffer_fusion_(buffer_m0_.channel_id(),
+                       new CacheBuffer<std::shared_ptr<FusionDataType>>(
+                           buffer_0.Buffer()->Capacity() - uint64_t(1))),
+        core_(4, SlopNs(conf), conf.queue_size(),
+              [this, on_fused](const TimeSyncCore::Messages& msgs) {
+                auto data = std::make_shared<FusionDataType>(
+                    std::static_pointer_cast<M0>(msgs[0]),
+                    std::static_pointer_cast<M1>(msgs[1]),
+                    std::static_pointer_cast<M2>(msgs[2]),
+                    std::static_pointer_cast<M3>(msgs[3]));
+                {
+                  std::lock_guard<std::mutex> lg(
+                      buffer_fusion_.Buffer()->Mutex());
+                  buffer_fusion_.Buffer()->Fill(data);
+                }
+                if (on_fused) {
+                  on_fused();
+                }
+              }) {
+    buffer_m0_.Buffer()->SetFusionCallback(
+        [this](const std::shared_ptr<M0>& m) {
+          core_.Add(0, MessageTime(*m), m);
+        });
+    buffer_m1_.Buffer()->SetFusionCallback(
+        [this](const std::shared_ptr<M1>& m) {
+          core_.Add(1, MessageTime(*m), m);
+        });
+    buffer_m2_.Buffer()->SetFusionCallback(
+        [this](const std::shared_ptr<M2>& m) {
+          core_.Add(2, MessageTime(*m), m);
+        });
+    buffer_m3_.Buffer()->SetFusionCallback(
+        [this](const std::shared_ptr<M3>& m) {
+          core_.Add(3, MessageTime(*m), m);
+        });
+  }
+
+  bool Fusion(uint64_t* index, std::shared_ptr<M0>& m0, std::shared_ptr<M1>& m1,
+              std::shared_ptr<M2>& m2, std::shared_ptr<M3>& m3) override {
+    std::shared_ptr<FusionDataType> fusion_data;
+    if (!buffer_fusion_.Fetch(index, fusion_data)) {
+      return false;
+    }
+    m0 = std::get<0>(*fusion_data);
+    m1 = std::get<1>(*fusion_data);
+    m2 = std::get<2>(*fusion_data);
+    m3 = std::get<3>(*fusion_data);
+    return true;
+  }
+
+  uint64_t dropped() { return core_.dropped(); }
+
+ private:
+  ChannelBuffer<M0> buffer_m0_;
+  ChannelBuffer<M1> buffer_m1_;
+  ChannelBuffer<M2> buffer_m2_;
+  ChannelBuffer<M3> buffer_m3_;
+  ChannelBuffer<FusionDataType> buffer_fusion_;
+  TimeSyncCore core_;
+};
+
+template <typename M0, typename M1, typename M2>
+class TimeSync<M0, M1, M2, NullType> : public DataFusion<M0, M1, M2> {
+  using FusionDataType =
+      std::tuple<std::shared_ptr<M0>, std::shared_ptr<M1>, std::shared_ptr<M2>>;
+
+ public:
+  TimeSync(const proto::FusionConf& conf, const std::function<void()>& on_fused,
+           const ChannelBuffer<M0>& buffer_0, const ChannelBuffer<M1>& buffer_1,
+           const ChannelBuffer<M2>& buffer_2)
+      : buffer_m0_(buffer_0),
+        buffer_m1_(buffer_1),
+        buffer_m2_(buffer_2),
+        buffer_fusion_(buffer_m0_.channel_id(),
+                       new CacheBuffer<std::shared_ptr<FusionDataType>>(
+                           buffer_0.Buffer()->Capacity() - uint64_t(1))),
+        core_(3, SlopNs(conf), conf.queue_size(),
+              [this, on_fused](const TimeSyncCore::Messages& msgs) {
+                auto data = std::make_shared<FusionDataType>(
+                    std::static_pointer_cast<M0>(msgs[0]),
+                    std::static_pointer_cast<M1>(msgs[1]),
+                    std::static_pointer_cast<M2>(msgs[2]));
+                {
+                  std::lock_guard<std::mutex> lg(
+                      buffer_fusion_.Buffer()->Mutex());
+                  buffer_fusion_.Buffer()->Fill(data);
+                }
+                if (on_fused) {
+                  on_fused();
+                }
+              }) {
+    buffer_m0_.Buffer()->SetFusionCallback(
+        [this](const std::shared_ptr<M0>& m) {
+          core_.Add(0, MessageTime(*m), m);
+        });
+    buffer_m1_.Buffer()->SetFusionCallback(
+        [this](const std::shared_ptr<M1>& m) {
+          core_.Add(1, MessageTime(*m), m);
+        });
+    buffer_m2_.Buffer()->SetFusionCallback(
+        [this](const std::shared_ptr<M2>& m) {
+          core_.Add(2, MessageTime(*m), m);
+        });
+  }
+
+  bool Fusion(uint64_t* index, std::shared_ptr<M0>& m0, std::shared_ptr<M1>& m1,
+              std::shared_ptr<M2>& m2) override {
+    std::shared_ptr<FusionDataType> fusion_data;
+    if (!buffer_fusion_.Fetch(index, fusion_data)) {
+      return false;
+    }
+    m0 = std::get<0>(*fusion_data);
+    m1 = std::get<1>(*fusion_data);
+    m2 = std::get<2>(*fusion_data);
+    return true;
+  }
+
+  uint64_t dropped() { return core_.dropped(); }
+
+ private:
+  ChannelBuffer<M0> buffer_m0_;
+  ChannelBuffer<M1> buffer_m1_;
+  ChannelBuffer<M2> buffer_m2_;
+  ChannelBuffer<FusionDataType> buffer_fusion_;
+  TimeSyncCore core_;
+};
+
+template <typename M0, typename M1>
+class TimeSync<M0, M1, NullType, NullType> : public DataFusion<M0, M1> {
+  using FusionDataType = std::tuple<std::shared_ptr<M0>, std::shared_ptr<M1>>;
+
+ public:
+  TimeSync(const proto::FusionConf& conf, const std::function<void()>& on_fused,
+           const ChannelBuffer<M0>& buffer_0, const ChannelBuffer<M1>& buffer_1)
+      : buffer_m0_(buffer_0),
+        buffer_m1_(buffer_1),
+        buffer_fusion_(buffer_m0_.channel_id(),
+                       new CacheBuffer<std::shared_ptr<FusionDataType>>(
+                           buffer_0.Buffer()->Capacity() - uint64_t(1))),
+        core_(2, SlopNs(conf), conf.queue_size(),
+              [this, on_fused](const TimeSyncCore::Messages& msgs) {
+                auto data = std::make_shared<FusionDataType>(
+                    std::static_pointer_cast<M0>(msgs[0]),
+                    std::static_pointer_cast<M1>(msgs[1]));
+                {
+                  std::lock_guard<std::mutex> lg(
+                      buffer_fusion_.Buffer()->Mutex());
+                  buffer_fusion_.Buffer()->Fill(data);
+                }
+                if (on_fused) {
+                  on_fused();
+                }
+              }) {
+    buffer_m0_.Buffer()->SetFusionCallback(
+        [this](const std::shared_ptr<M0>& m) {
+          core_.Add(0, MessageTime(*m), m);
+        });
+    buffer_m1_.Buffer()->SetFusionCallback(
+        [this](const std::shared_ptr<M1>& m) {
+          core_.Add(1, MessageTime(*m), m);
+        });
+  }
+
+  bool Fusion(uint64_t* index, std::shared_ptr<M0>& m0,
+              std::shared_ptr<M1>& m1) override {
+    std::shared_ptr<FusionDataType> fusion_data;
+    if (!buffer_fusion_.Fetch(index, fusion_data)) {
+      return false;
+    }
+    m0 = std::get<0>(*fusion_data);
+    m1 = std::get<1>(*fusion_data);
+    return true;
+  }
+
+  uint64_t dropped() { return core_.dropped(); }
+
+ private:
+  ChannelBuffer<M0> buffer_m0_;
+  ChannelBuffer<M1> buffer_m1_;
+  ChannelBuffer<FusionDataType> buffer_fusion_;
+  TimeSyncCore core_;
+};
+
+}  // namespace fusion
+}  // namespace data
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_DATA_FUSION_TIME_SYNC_H_
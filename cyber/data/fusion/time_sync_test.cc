@@ -0,0 +1,169 @@
+/******************************************************************************
+ * Copyright 2024 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/data/fusion/time_sync.h"
+
+#include <memory>
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include "cyber/message/raw_message.h"
+
+namespace apollo {
+namespace cyber {
+namespace data {
+
+using apollo::cyber::message::RawMessage;
+
+struct StampedMessage {
+  struct Header {
+    double timestamp_sec() const { return timestamp; }
+    double timestamp = 0.0;
+  };
+  explicit StampedMessage(double timestamp) { header_.timestamp = timestamp; }
+  const Header& header() const { return header_; }
+  Header header_;
+};
+
+using Stamped = StampedMessage;
+
+std::shared_ptr<Stamped> Msg(double timestamp) {
+  return std::make_shared<Stamped>(timestamp);
+}
+
+TEST(TimeSyncTest, message_time) {
+  EXPECT_TRUE(fusion::HasHeaderTimestamp<Stamped>::value);
+  EXPECT_FALSE(fusion::HasHeaderTimestamp<RawMessage>::value);
+  EXPECT_EQ(fusion::MessageTime(Stamped(1.5)), 1500000000UL);
+  EXPECT_GT(fusion::MessageTime(RawMessage("raw")), 0);
+}
+
+TEST(TimeSyncTest, exact_time) {
+  auto cache0 = new CacheBuffer<std::shared_ptr<Stamped>>(10);
+  auto cache1 = new CacheBuffer<std::shared_ptr<Stamped>>(10);
+  ChannelBuffer<Stamped> buffer0(0, cache0);
+  ChannelBuffer<Stamped> buffer1(1, cache1);
+  proto::FusionConf conf;
+  conf.set_policy(proto::FusionConf::EXACT_TIME);
+  int notified = 0;
+  fusion::TimeSync<Stamped, Stamped> fusion(
+      conf, [&notified]() { ++notified; }, buffer0, buffer1);
+
+  std::shared_ptr<Stamped> m0;
+  std::shared_ptr<Stamped> m1;
+  uint64_t index = 0;
+  cache0->Fill(Msg(1.0));
+  cache0->Fill(Msg(2.0));
+  EXPECT_FALSE(fusion.Fusion(&index, m0, m1));
+  cache1->Fill(Msg(1.5));
+  EXPECT_FALSE(fusion.Fusion(&index, m0, m1));
+  // completed by the second channel
+  cache1->Fill(Msg(2.0));
+  EXPECT_EQ(notified, 1);
+  EXPECT_TRUE(fusion.Fusion(&index, m0, m1));
+  index++;
+  EXPECT_EQ(m0->header().timestamp_sec(), 2.0);
+  EXPECT_EQ(m1->header().timestamp_sec(), 2.0);
+  EXPECT_FALSE(fusion.Fusion(&index, m0, m1));
+  // 1.0 and 1.5 never matched
+  EXPECT_EQ(fusion.dropped(), 2);
+
+  // older than the last tuple
+  cache0->Fill(Msg(1.9));
+  EXPECT_EQ(fusion.dropped(), 3);
+}
+
+TEST(TimeSyncTest, approximate_time) {
+  auto cache0 = new CacheBuffer<std::shared_ptr<Stamped>>(10);
+  auto cache1 = new CacheBuffer<std::shared_ptr<Stamped>>(10);
+  ChannelBuffer<Stamped> buffer0(0, cache0);
+  ChannelBuffer<Stamped> buffer1(1, cache1);
+  proto::FusionConf conf;
+  conf.set_policy(proto::FusionConf::APPROXIMATE_TIME);
+  conf.set_slop_ms(10.0);
+  int notified = 0;
+  fusion::TimeSync<Stamped, Stamped> fusion(
+      conf, [&notified]() { ++notified; }, buffer0, buffer1);
+
+  // lidar at 10hz on channel 0, camera at ~30hz on channel 1
+  std::shared_ptr<Stamped> m0;
+  std::shared_ptr<Stamped> m1;
+  uint64_t index = 0;
+  for (int i = 0; i < 10; ++i) {
+    cache1->Fill(Msg(i * 0.033 + 0.001));
+  }
+  for (int i = 0; i < 3; ++i) {
+    cache0->Fill(Msg(i * 0.1));
+    EXPECT_EQ(notified, i + 1);
+    ASSERT_TRUE(fusion.Fusion(&index, m0, m1));
+    index++;
+    EXPECT_DOUBLE_EQ(m0->header().timestamp_sec(), i * 0.1);
+    EXPECT_NEAR(m1->header().timestamp_sec(), i * 0.1, 0.01);
+    EXPECT_FALSE(fusion.Fusion(&index, m0, m1));
+  }
+
+  // nothing within the slop of 0.315, the lidar message is dropped once the
+  // camera is past it
+  cache0->Fill(Msg(0.315));
+  cache1->Fill(Msg(0.33));
+  EXPECT_EQ(notified, 3);
+  EXPECT_FALSE(fusion.Fusion(&index, m0, m1));
+  cache0->Fill(Msg(0.4));
+  cache1->Fill(Msg(0.396));
+  EXPECT_EQ(notified, 4);
+  EXPECT_TRUE(fusion.Fusion(&index, m0, m1));
+  EXPECT_DOUBLE_EQ(m0->header().timestamp_sec(), 0.4);
+  EXPECT_DOUBLE_EQ(m1->header().timestamp_sec(), 0.396);
+}
+
+TEST(TimeSyncTest, three_channels) {
+  auto cache0 = new CacheBuffer<std::shared_ptr<Stamped>>(10);
+  auto cache1 = new CacheBuffer<std::shared_ptr<Stamped>>(10);
+  auto cache2 = new CacheBuffer<std::shared_ptr<Stamped>>(10);
+  ChannelBuffer<Stamped> buffer0(0, cache0);
+  ChannelBuffer<Stamped> buffer1(1, cache1);
+  ChannelBuffer<Stamped> buffer2(2, cache2);
+  proto::FusionConf conf;
+  conf.set_policy(proto::FusionConf::APPROXIMATE_TIME);
+  conf.set_slop_ms(5.0);
+  conf.set_queue_size(2);
+  fusion::TimeSync<Stamped, Stamped, Stamped> fusion(conf, nullptr, buffer0,
+                                                     buffer1, buffer2);
+
+  std::shared_ptr<Stamped> m0;
+  std::shared_ptr<Stamped> m1;
+  std::shared_ptr<Stamped> m2;
+  uint64_t index = 0;
+  // channel 2 is late, only the last queue_size messages wait for it
+  for (int i = 0; i < 5; ++i) {
+    cache0->Fill(Msg(i * 0.1));
+    cache1->Fill(Msg(i * 0.1 + 0.002));
+  }
+  EXPECT_FALSE(fusion.Fusion(&index, m0, m1, m2));
+  cache2->Fill(Msg(0.1));
+  EXPECT_FALSE(fusion.Fusion(&index, m0, m1, m2));
+  cache2->Fill(Msg(0.301));
+  EXPECT_TRUE(fusion.Fusion(&index, m0, m1, m2));
+  index++;
+  EXPECT_DOUBLE_EQ(m0->header().timestamp_sec(), 0.3);
+  EXPECT_DOUBLE_EQ(m1->header().timestamp_sec(), 0.302);
+  EXPECT_DOUBLE_EQ(m2->header().timestamp_sec(), 0.301);
+}
+
+}  // namespace data
+}  // namespace cyber
+}  // namespace apollo
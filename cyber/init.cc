@@ -31,6 +31,7 @@
 #include "gflags/gflags.h"
 
 #include "cyber/proto/clock.pb.h"
+#include "cyber/proto/latency_trace.pb.h"
 
 #include "cyber/binary.h"
 #include "cyber/common/file.h"
@@ -40,6 +41,7 @@
 #include "cyber/node/node.h"
 #include "cyber/scheduler/scheduler.h"
 #include "cyber/service_discovery/topology_manager.h"
+#include "cyber/statistics/latency_tracer.h"
 #include "cyber/statistics/statistics.h"
 #include "cyber/sysmo/sysmo.h"
 #include "cyber/task/task.h"
@@ -54,10 +56,12 @@ namespace {
 
 const std::string& kClockChannel = "/clock";
 const std::string& kClockNode = "clock";
+const std::string& kLatencyTraceNode = "latency_trace";
 
 bool g_atexit_registered = false;
 std::mutex g_mutex;
 std::unique_ptr<Node> clock_node;
+std::unique_ptr<Node> latency_trace_node;
 
 logger::AsyncLogger* async_logger = nullptr;
 
@@ -138,6 +142,22 @@ bool Init(const char* binary_name, const std::string& dag_info) {
     clock_node->CreateReader<apollo::cyber::proto::Clock>(kClockChannel, cb);
   }
 
+  auto tracer = statistics::LatencyTracer::Instance();
+  if (tracer->IsEnabled()) {
+    // publish the reports so cyber_monitor can show them like any channel
+    auto node_name = kLatencyTraceNode + std::to_string(getpid());
+    latency_trace_node = std::unique_ptr<Node>(new Node(node_name));
+    auto writer =
+        latency_trace_node->CreateWriter<proto::LatencyTraceReport>(
+            tracer->conf().report_channel());
+    if (writer != nullptr) {
+      tracer->SetReportCallback(
+          [writer](const proto::LatencyTraceReport& report) {
+            writer->Write(report);
+          });
+    }
+  }
+
   if (dag_info != "") {
     std::string dump_path;
     if (dag_info.length() > 200) {
@@ -164,6 +184,8 @@ void Clear() {
     return;
   }
   SysMo::CleanUp();
+  statistics::LatencyTracer::CleanUp();
+  latency_trace_node.reset();
   TaskManager::CleanUp();
   TimingWheel::CleanUp();
   scheduler::CleanUp();
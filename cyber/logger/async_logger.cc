@@ -16,12 +16,18 @@
 
 #include "cyber/logger/async_logger.h"
 
+#include <time.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
 #include <cstdlib>
 #include <string>
 #include <thread>
 #include <unordered_map>
 
 #include "cyber/base/macros.h"
+#include "cyber/common/global_data.h"
 #include "cyber/logger/logger_util.h"
 
 namespace apollo {
@@ -31,32 +37,124 @@ namespace logger {
 static const std::unordered_map<char, int> log_level_map = {
     {'F', 3}, {'E', 2}, {'W', 1}, {'I', 0}};
 
-AsyncLogger::AsyncLogger(google::base::Logger* wrapped) : wrapped_(wrapped) {
-  active_buf_.reset(new std::deque<Msg>());
-  flushing_buf_.reset(new std::deque<Msg>());
+namespace {
+
+std::atomic<uint64_t> next_logger_id = {1};
+
+uint64_t MonoTimeNs() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return static_cast<uint64_t>(ts.tv_sec) * 1000000000UL + ts.tv_nsec;
+}
+
+proto::AsyncLogConf GetAsyncLogConf() {
+  auto& global_conf = common::GlobalData::Instance()->Config();
+  if (global_conf.has_async_log_conf()) {
+    return global_conf.async_log_conf();
+  }
+  return proto::AsyncLogConf();
 }
 
-AsyncLogger::~AsyncLogger() { Stop(); }
+}  // namespace
+
+AsyncLogger::AsyncLogger(google::base::Logger* wrapped)
+    : AsyncLogger(wrapped, GetAsyncLogConf()) {}
+
+AsyncLogger::AsyncLogger(google::base::Logger* wrapped,
+                         const proto::AsyncLogConf& conf)
+    : wrapped_(wrapped), id_(next_logger_id.fetch_add(1)), conf_(conf) {}
+
+AsyncLogger::~AsyncLogger() {
+  Stop();
+  if (log_thread_.joinable()) {
+    log_thread_.join();
+  }
+}
 
 void AsyncLogger::Start() {
   CHECK_EQ(state_.load(std::memory_order_acquire), INITTED);
   state_.store(RUNNING, std::memory_order_release);
   log_thread_ = std::thread(&AsyncLogger::RunThread, this);
+  log_thread_id_.store(log_thread_.get_id(), std::memory_order_release);
   // std::cout << "Async Logger Start!" << std::endl;
 }
 
 void AsyncLogger::Stop() {
-  state_.store(STOPPED, std::memory_order_release);
-  if (log_thread_.joinable()) {
+  State state = state_.load(std::memory_order_acquire);
+  while (state == INITTED || state == RUNNING) {
+    if (state_.compare_exchange_weak(state, STOPPING,
+                                     std::memory_order_acq_rel)) {
+      break;
+    }
+  }
+  if (state == STOPPING || state == STOPPED) {
+    // another call stops it, wait until everything is drained unless this is
+    // the logger thread it is joining
+    if (std::this_thread::get_id() !=
+        log_thread_id_.load(std::memory_order_acquire)) {
+      while (state_.load(std::memory_order_acquire) != STOPPED) {
+        std::this_thread::yield();
+      }
+    }
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(wake_mutex_);
+    wake_cv_.notify_all();
+  }
+  // a FATAL message written by the logger thread itself can not join it, the
+  // destructor does
+  if (state == RUNNING && std::this_thread::get_id() !=
+                              log_thread_id_.load(std::memory_order_acquire)) {
     log_thread_.join();
   }
 
-  FlushBuffer(active_buf_);
-  ACHECK(active_buf_->empty());
-  ACHECK(flushing_buf_->empty());
+  Drain();
+  state_.store(STOPPED, std::memory_order_release);
   // std::cout << "Async Logger Stop!" << std::endl;
 }
 
+LogRingBuffer* AsyncLogger::GetRingBuffer() {
+  // the last logger written by this thread, which is nearly always the only
+  // one of the process
+  static thread_local uint64_t cached_id = 0;
+  static thread_local LogRingBuffer* cached_ring = nullptr;
+  static thread_local std::unordered_map<uint64_t,
+                                         std::weak_ptr<LogRingBuffer>>
+      thread_rings;
+  static thread_local const auto thread_alive = std::make_shared<bool>(true);
+  if (cyber_likely(cached_id == id_)) {
+    return cached_ring;
+  }
+
+  auto ring = thread_rings[id_].lock();
+  if (ring == nullptr) {
+    // forget the rings of the loggers which are gone
+    for (auto it = thread_rings.begin(); it != thread_rings.end();) {
+      if (it->second.expired()) {
+        it = thread_rings.erase(it);
+      } else {
+        ++it;
+      }
+    }
+    ring = std::make_shared<LogRingBuffer>(conf_.buffer_size_kb() * 1024);
+    thread_rings[id_] = ring;
+    std::lock_guard<std::mutex> lock(rings_mutex_);
+    rings_.push_back({ring, thread_alive});
+  }
+  cached_id = id_;
+  cached_ring = ring.get();
+  return cached_ring;
+}
+
+void AsyncLogger::WakeUp() {
+  if (!urgent_.exchange(true, std::memory_order_acq_rel)) {
+    std::lock_guard<std::mutex> lock(wake_mutex_);
+    wake_cv_.notify_one();
+  }
+}
+
 void AsyncLogger::Write(bool force_flush, time_t timestamp, const char* message,
                         int message_len) {
   if (cyber_unlikely(state_.load(std::memory_order_acquire) != RUNNING)) {
@@ -64,13 +162,30 @@ void AsyncLogger::Write(bool force_flush, time_t timestamp, const char* message,
     return;
   }
   if (message_len > 0) {
-    auto msg_str = std::string(message, message_len);
-    while (flag_.test_and_set(std::memory_order_acquire)) {
-      cpu_relax();
+    auto ring = GetRingBuffer();
+    auto len = static_cast<uint32_t>(message_len);
+    bool written = ring->TryWrite(timestamp, MonoTimeNs(), message, len);
+    if (cyber_unlikely(!written)) {
+      if (conf_.overflow_policy() != proto::AsyncLogConf::BLOCK ||
+          !ring->Fits(len) ||
+          std::this_thread::get_id() ==
+              log_thread_id_.load(std::memory_order_acquire)) {
+        drop_count_.fetch_add(1, std::memory_order_relaxed);
+        return;
+      }
+      block_count_.fetch_add(1, std::memory_order_relaxed);
+      do {
+        if (state_.load(std::memory_order_acquire) != RUNNING) {
+          drop_count_.fetch_add(1, std::memory_order_relaxed);
+          return;
+        }
+        WakeUp();
+        std::this_thread::yield();
+      } while (!ring->TryWrite(timestamp, MonoTimeNs(), message, len));
+    }
+    if (force_flush || ring->Used() * 2 > ring->capacity()) {
+      WakeUp();
     }
-    active_buf_->emplace_back(timestamp, std::move(msg_str),
-                              log_level_map.at(message[0]));
-    flag_.clear(std::memory_order_release);
   }
 
   if (force_flush && timestamp == 0 && message && message_len == 0) {
@@ -86,42 +201,135 @@ void AsyncLogger::Flush() {
 
 uint32_t AsyncLogger::LogSize() { return wrapped_->LogSize(); }
 
+AsyncLoggerStats AsyncLogger::GetStats() const {
+  AsyncLoggerStats stats;
+  stats.written = write_count_.load(std::memory_order_relaxed);
+  stats.dropped = drop_count_.load(std::memory_order_relaxed);
+  stats.blocked = block_count_.load(std::memory_order_relaxed);
+  stats.max_latency_us = max_latency_us_.load(std::memory_order_relaxed);
+  if (stats.written > 0) {
+    stats.mean_latency_us =
+        static_cast<double>(total_latency_us_.load(std::memory_order_relaxed)) /
+        static_cast<double>(stats.written);
+  }
+  return stats;
+}
+
 void AsyncLogger::RunThread() {
+  const auto interval = std::chrono::milliseconds(conf_.flush_interval_ms());
   while (state_ == RUNNING) {
-    while (flag_.test_and_set(std::memory_order_acquire)) {
-      cpu_relax();
-    }
-    active_buf_.swap(flushing_buf_);
-    flag_.clear(std::memory_order_release);
-    FlushBuffer(flushing_buf_);
-    if (active_buf_->size() < 800) {
-      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    urgent_.store(false, std::memory_order_release);
+    Drain();
+    std::unique_lock<std::mutex> lock(wake_mutex_);
+    wake_cv_.wait_for(lock, interval, [this] {
+      return urgent_.load(std::memory_order_acquire) || state_ != RUNNING;
+    });
+  }
+}
+
+void AsyncLogger::Drain() {
+  {
+    std::lock_guard<std::mutex> lock(rings_mutex_);
+    rings_.erase(std::remove_if(rings_.begin(), rings_.end(),
+                                [](const ThreadRing& thread_ring) {
+                                  return thread_ring.thread_alive.expired() &&
+                                         thread_ring.ring->Empty();
+                                }),
+                 rings_.end());
+    drain_rings_.clear();
+    for (const auto& thread_ring : rings_) {
+      drain_rings_.push_back(thread_ring.ring);
     }
   }
+
+  drain_records_.clear();
+  drain_positions_.resize(drain_rings_.size());
+  for (size_t i = 0; i < drain_rings_.size(); ++i) {
+    drain_positions_[i] =
+        drain_rings_[i]->Visit([this](const LogRingBuffer::Record& record) {
+          drain_records_.emplace_back(record);
+        });
+  }
+  // every ring is in order, merge them into the order of Write
+  std::stable_sort(
+      drain_records_.begin(), drain_records_.end(),
+      [](const LogRingBuffer::Record& lhs, const LogRingBuffer::Record& rhs) {
+        return lhs.enqueue_ns < rhs.enqueue_ns;
+      });
+
+  uint64_t now = MonoTimeNs();
+  uint64_t total_latency = 0;
+  uint64_t max_latency = 0;
+  for (auto& record : drain_records_) {
+    WriteMessage(record.ts, record.data, record.len);
+    uint64_t latency = now > record.enqueue_ns ? now - record.enqueue_ns : 0;
+    total_latency += latency;
+    max_latency = std::max(max_latency, latency);
+  }
+  for (size_t i = 0; i < drain_rings_.size(); ++i) {
+    drain_rings_[i]->Consume(drain_positions_[i]);
+  }
+  drain_rings_.clear();
+
+  uint64_t dropped = drop_count_.load(std::memory_order_relaxed);
+  if (cyber_unlikely(dropped != reported_drop_count_)) {
+    WriteDropMessage(dropped - reported_drop_count_);
+    reported_drop_count_ = dropped;
+  }
+
+  if (drain_records_.empty()) {
+    return;
+  }
+  write_count_.fetch_add(drain_records_.size(), std::memory_order_relaxed);
+  total_latency_us_.fetch_add(total_latency / 1000, std::memory_order_relaxed);
+  if (max_latency / 1000 > max_latency_us_.load(std::memory_order_relaxed)) {
+    max_latency_us_.store(max_latency / 1000, std::memory_order_relaxed);
+  }
+  flush_count_.fetch_add(1, std::memory_order_relaxed);
+  Flush();
 }
 
-void AsyncLogger::FlushBuffer(const std::unique_ptr<std::deque<Msg>>& buffer) {
-  std::string module_name = "";
-  while (!buffer->empty()) {
-    auto& msg = buffer->front();
-    FindModuleName(&(msg.message), &module_name);
+void AsyncLogger::WriteMessage(time_t ts, const char* data, uint32_t len) {
+  message_.assign(data, len);
+  module_name_.clear();
+  FindModuleName(&message_, &module_name_);
 
-    if (module_logger_map_.find(module_name) == module_logger_map_.end()) {
-      std::string file_name = module_name + ".log.INFO.";
-      if (!FLAGS_log_dir.empty()) {
-        file_name = FLAGS_log_dir + "/" + file_name;
-      }
-      module_logger_map_[module_name].reset(
-          new LogFileObject(google::INFO, file_name.c_str()));
-      module_logger_map_[module_name]->SetSymlinkBasename(module_name.c_str());
+  auto it = module_logger_map_.find(module_name_);
+  if (it == module_logger_map_.end()) {
+    std::string file_name = module_name_ + ".log.INFO.";
+    if (!FLAGS_log_dir.empty()) {
+      file_name = FLAGS_log_dir + "/" + file_name;
     }
-    const bool force_flush = msg.level > 0;
-    module_logger_map_.find(module_name)
-        ->second->Write(force_flush, msg.ts, msg.message.data(),
-                        static_cast<int>(msg.message.size()));
-    buffer->pop_front();
+    it = module_logger_map_
+             .emplace(module_name_, std::unique_ptr<LogFileObject>(
+                                        new LogFileObject(google::INFO,
+                                                          file_name.c_str())))
+             .first;
+    it->second->SetSymlinkBasename(module_name_.c_str());
+  }
+  auto level = log_level_map.find(message_[0]);
+  const bool force_flush = level != log_level_map.end() && level->second > 0;
+  it->second->Write(force_flush, ts, message_.data(),
+                    static_cast<int>(message_.size()));
+}
+
+void AsyncLogger::WriteDropMessage(uint64_t dropped) {
+  // same layout as the glog prefix, so it lands in the process log
+  time_t ts = time(nullptr);
+  struct tm tm_time;
+  localtime_r(&ts, &tm_time);
+  char buf[256];
+  int len = snprintf(buf, sizeof(buf),
+                     "W%02d%02d %02d:%02d:%02d.000000 %5d async_logger.cc] "
+                     "Dropped %lu log messages, the log ring buffer is full, "
+                     "please check [async_log_conf] in config file.\n",
+                     tm_time.tm_mon + 1, tm_time.tm_mday, tm_time.tm_hour,
+                     tm_time.tm_min, tm_time.tm_sec, GetMainThreadPid(),
+                     static_cast<unsigned long>(dropped));  // NOLINT
+  if (len > 0) {
+    WriteMessage(ts, buf,
+                 static_cast<uint32_t>(std::min<int>(len, sizeof(buf) - 1)));
   }
-  Flush();
 }
 
 }  // namespace logger
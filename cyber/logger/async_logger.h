@@ -21,7 +21,6 @@
 #include <condition_variable>
 #include <cstdint>
 #include <ctime>
-#include <deque>
 #include <iostream>
 #include <memory>
 #include <mutex>
@@ -33,29 +32,48 @@
 
 #include "glog/logging.h"
 
+#include "cyber/proto/log_conf.pb.h"
+
 #include "cyber/common/macros.h"
 #include "cyber/logger/log_file_object.h"
+#include "cyber/logger/log_ring_buffer.h"
 
 namespace apollo {
 namespace cyber {
 namespace logger {
 
+/**
+ * @brief Counters of an `AsyncLogger`, all since it was created
+ */
+struct AsyncLoggerStats {
+  uint64_t written = 0;
+  uint64_t dropped = 0;
+  // times a writer had to wait for room with the BLOCK overflow policy
+  uint64_t blocked = 0;
+  // from Write to the message handed to its log file, in microsecond
+  uint64_t max_latency_us = 0;
+  double mean_latency_us = 0.0;
+};
+
 /**
  * @class AsyncLogger
  * @brief .
  * Wrapper for a glog Logger which asynchronously writes log messages.
  * This class starts a new thread responsible for forwarding the messages
- * to the logger, and performs double buffering. Writers append to the
- * current buffer and then wake up the logger thread. The logger swaps in
- * a new buffer and writes any accumulated messages to the wrapped
- * Logger.
+ * to the logger. Every thread that logs gets its own lock-free ring buffer
+ * (see `LogRingBuffer`) it copies the glog formatted message into, so Write
+ * never takes a lock nor allocates. The logger thread is the single consumer
+ * of all of them: it merges what they hold by write time, splits messages per
+ * module and writes them to the module log files.
+ *
+ * Everything but the glog formatting itself is deferred to the logger thread:
+ * the level, the module name lookup and the copy into a std::string happen
+ * there. glog hands loggers the already formatted line, so the arguments
+ * can not be captured in binary without bypassing it.
  *
- * This double-buffering design dramatically improves performance, especially
- * for logging messages which require flushing the underlying file (i.e WARNING
- * and above for default). The flush can take a couple of milliseconds, and in
- * some cases can even block for hundreds of milliseconds or more. With the
- * double-buffered approach, threads can proceed with useful work while the IO
- * thread blocks.
+ * The logger thread wakes up every `flush_interval_ms`, or right away when a
+ * ring buffer gets half full or a message asks for a flush, which is WARNING
+ * and above by default ('--logbuflevel').
  *
  * The semantics provided by this wrapper are slightly weaker than the default
  * glog semantics. By default, glog will immediately (synchronously) flush
@@ -66,14 +84,21 @@ namespace logger {
  * worth it. We do take care that a glog FATAL message flushes all buffered log
  * messages before exiting.
  *
- * @warning The logger limits the total amount of buffer space, so if the
- * underlying log blocks for too long, eventually the threads generating the log
- * messages will block as well. This prevents runaway memory usage.
+ * @warning The ring buffers are bounded, so if the underlying log blocks for
+ * too long they fill up. The BLOCK overflow policy (default) then makes the
+ * writers wait, so no line is lost like with the unbounded queue before,
+ * while the DROP policy drops and counts messages, the count being logged
+ * once there is room again.
  */
 class AsyncLogger : public google::base::Logger {
  public:
+  /**
+   * @brief use the `async_log_conf` of cyber.pb.conf
+   */
   explicit AsyncLogger(google::base::Logger* wrapped);
 
+  AsyncLogger(google::base::Logger* wrapped, const proto::AsyncLogConf& conf);
+
   ~AsyncLogger();
 
   /**
@@ -85,7 +110,9 @@ class AsyncLogger : public google::base::Logger {
    * @brief Stop the thread. Flush() and Write() must not be called after this.
    * NOTE: this is currently only used in tests: in real life, we enable async
    * logging once when the program starts and then never disable it.
-   * REQUIRES: Start() must have been called.
+   * It may be called by several threads at once, e.g. by a FATAL message and
+   * by the destructor: one of them stops the thread and drains the buffers,
+   * the others wait for it.
    */
   void Stop();
 
@@ -125,49 +152,24 @@ class AsyncLogger : public google::base::Logger {
    */
   std::thread* LogThread() { return &log_thread_; }
 
- private:
-  // A buffered message.
-  //
-  // TODO(todd): using std::string for buffered messages is convenient but not
-  // as efficient as it could be. It's better to make the buffers just be
-  // Arenas and allocate both the message data and Msg struct from them, forming
-  // a linked list.
-  struct Msg {
-    time_t ts;
-    std::string message;
-    int32_t level;
-    Msg() : ts(0), message(), level(google::INFO) {}
-    Msg(time_t ts, std::string&& message, int32_t level)
-        : ts(ts), message(std::move(message)), level(level) {}
-    Msg(const Msg& rsh) {
-      ts = rsh.ts;
-      message = rsh.message;
-      level = rsh.level;
-    }
-    Msg(Msg&& rsh) {
-      ts = rsh.ts;
-      message = rsh.message;
-      level = rsh.level;
-    }
-    Msg& operator=(Msg&& rsh) {
-      ts = rsh.ts;
-      message = std::move(rsh.message);
-      level = rsh.level;
-      return *this;
-    }
-    Msg& operator=(const Msg& rsh) {
-      ts = rsh.ts;
-      message = rsh.message;
-      level = rsh.level;
-      return *this;
-    }
-  };
+  AsyncLoggerStats GetStats() const;
 
+ private:
+  LogRingBuffer* GetRingBuffer();
+  void WakeUp();
   void RunThread();
-  void FlushBuffer(const std::unique_ptr<std::deque<Msg>>& msg);
+  // write everything buffered so far to the module log files
+  void Drain();
+  void WriteMessage(time_t ts, const char* data, uint32_t len);
+  void WriteDropMessage(uint64_t dropped);
 
   google::base::Logger* const wrapped_;
   std::thread log_thread_;
+  // read by the writers while Stop may be joining log_thread_
+  std::atomic<std::thread::id> log_thread_id_;
+
+  const uint64_t id_;
+  proto::AsyncLogConf conf_;
 
   // Count of how many times the writer thread has flushed the buffers.
   // 64 bits should be enough to never worry about overflow.
@@ -175,19 +177,42 @@ class AsyncLogger : public google::base::Logger {
 
   // Count of how many times the writer thread has dropped the log messages.
   // 64 bits should be enough to never worry about overflow.
-  uint64_t drop_count_ = 0;
-
-  // The buffer to which application threads append new log messages.
-  std::unique_ptr<std::deque<Msg>> active_buf_;
-
-  // The buffer currently being flushed by the logger thread, cleared
-  // after a successful flush.
-  std::unique_ptr<std::deque<Msg>> flushing_buf_;
+  std::atomic<uint64_t> drop_count_ = {0};
+  uint64_t reported_drop_count_ = 0;
+
+  std::atomic<uint64_t> write_count_ = {0};
+  std::atomic<uint64_t> block_count_ = {0};
+  std::atomic<uint64_t> total_latency_us_ = {0};
+  std::atomic<uint64_t> max_latency_us_ = {0};
+
+  // the ring buffer of a thread is owned by the logger, the thread only holds
+  // it weakly, so it is freed with the logger even if the thread lives on
+  struct ThreadRing {
+    std::shared_ptr<LogRingBuffer> ring;
+    // expires when the thread exits
+    std::weak_ptr<bool> thread_alive;
+  };
 
-  // Trigger for the logger thread to stop.
-  enum State { INITTED, RUNNING, STOPPED };
+  // ring buffers of all the threads that have written, those of exited
+  // threads are removed once drained
+  std::mutex rings_mutex_;
+  std::vector<ThreadRing> rings_;
+
+  // only touched by the logger thread, or by Stop once it is joined
+  std::vector<std::shared_ptr<LogRingBuffer>> drain_rings_;
+  std::vector<uint64_t> drain_positions_;
+  std::vector<LogRingBuffer::Record> drain_records_;
+  std::string message_;
+  std::string module_name_;
+
+  std::mutex wake_mutex_;
+  std::condition_variable wake_cv_;
+  std::atomic<bool> urgent_ = {false};
+
+  // Trigger for the logger thread to stop, STOPPING while a Stop call joins
+  // the thread and drains the buffers.
+  enum State { INITTED, RUNNING, STOPPING, STOPPED };
   std::atomic<State> state_ = {INITTED};
-  std::atomic_flag flag_ = ATOMIC_FLAG_INIT;
   std::unordered_map<std::string, std::unique_ptr<LogFileObject>>
       module_logger_map_;
 
@@ -16,6 +16,10 @@
 
 #include "cyber/logger/async_logger.h"
 
+#include <string>
+#include <thread>
+#include <vector>
+
 #include "gtest/gtest.h"
 
 #include "glog/logging.h"
@@ -69,6 +73,82 @@ TEST(AsyncLoggerTest, SetLoggerToGlog) {
   google::ShutdownGoogleLogging();
 }
 
+void WriteConcurrently(AsyncLogger* logger, int thread_num, int msg_num) {
+  std::vector<std::thread> threads;
+  for (int i = 0; i < thread_num; ++i) {
+    threads.emplace_back([logger, i, msg_num]() {
+      std::string message = "I0909 99:99:99.999999 99999 logger_test.cc:999] ";
+      message.append(LEFT_BRACKET);
+      message.append("AsyncLoggerTest");
+      message.append(RIGHT_BRACKET);
+      message.append("writer " + std::to_string(i) + "\n");
+      for (int j = 0; j < msg_num; ++j) {
+        logger->Write(false, time(nullptr), message.c_str(),
+                      static_cast<int>(message.length()));
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+
+TEST(AsyncLoggerTest, OverflowPolicy) {
+  proto::AsyncLogConf conf;
+  conf.set_buffer_size_kb(1);
+  conf.set_flush_interval_ms(1);
+
+  conf.set_overflow_policy(proto::AsyncLogConf::BLOCK);
+  AsyncLogger block_logger(google::base::GetLogger(google::INFO), conf);
+  block_logger.Start();
+  WriteConcurrently(&block_logger, 4, 1000);
+  block_logger.Stop();
+  auto stats = block_logger.GetStats();
+  EXPECT_EQ(stats.written, 4000);
+  EXPECT_EQ(stats.dropped, 0);
+  EXPECT_GE(stats.max_latency_us, stats.mean_latency_us);
+
+  conf.set_overflow_policy(proto::AsyncLogConf::DROP);
+  AsyncLogger drop_logger(google::base::GetLogger(google::INFO), conf);
+  drop_logger.Start();
+  WriteConcurrently(&drop_logger, 4, 1000);
+  drop_logger.Stop();
+  stats = drop_logger.GetStats();
+  EXPECT_EQ(stats.blocked, 0);
+  EXPECT_EQ(stats.written + stats.dropped, 4000);
+
+  // by default a burst larger than the ring of its thread loses nothing
+  AsyncLogger default_logger(google::base::GetLogger(google::INFO),
+                             proto::AsyncLogConf());
+  default_logger.Start();
+  WriteConcurrently(&default_logger, 1, 10000);
+  default_logger.Stop();
+  stats = default_logger.GetStats();
+  EXPECT_EQ(stats.written, 10000);
+  EXPECT_EQ(stats.dropped, 0);
+}
+
+TEST(AsyncLoggerTest, ConcurrentStop) {
+  proto::AsyncLogConf conf;
+  conf.set_flush_interval_ms(1);
+  for (int round = 0; round < 20; ++round) {
+    AsyncLogger logger(google::base::GetLogger(google::INFO), conf);
+    logger.Start();
+    WriteConcurrently(&logger, 2, 100);
+    // a FATAL message stops the logger from the thread writing it, while
+    // another one stops it as well
+    std::vector<std::thread> threads;
+    threads.emplace_back([&logger]() { logger.Write(true, 0, "", 0); });
+    threads.emplace_back([&logger]() { logger.Stop(); });
+    logger.Stop();
+    // every caller returns once all of it is written
+    EXPECT_EQ(logger.GetStats().written, 200);
+    for (auto& thread : threads) {
+      thread.join();
+    }
+  }
+}
+
 }  // namespace logger
 }  // namespace cyber
 }  // namespace apollo
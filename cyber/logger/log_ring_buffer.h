@@ -0,0 +1,161 @@
+/******************************************************************************
+ * Copyright 2024 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_LOGGER_LOG_RING_BUFFER_H_
+#define CYBER_LOGGER_LOG_RING_BUFFER_H_
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <ctime>
+#include <memory>
+
+#include "cyber/base/macros.h"
+
+namespace apollo {
+namespace cyber {
+namespace logger {
+
+/**
+ * @class LogRingBuffer
+ * @brief Single producer single consumer byte ring holding variable sized log
+ * records. The producer never locks nor allocates, a record that does not fit
+ * is refused and it is up to the caller to drop or retry it.
+ */
+class LogRingBuffer {
+ public:
+  struct Record {
+    time_t ts;
+    // monotonic time the record was written, in nanosecond
+    uint64_t enqueue_ns;
+    const char* data;
+    uint32_t len;
+  };
+
+  explicit LogRingBuffer(uint32_t capacity) {
+    capacity_ = 64;
+    while (capacity_ < capacity) {
+      capacity_ <<= 1;
+    }
+    buffer_.reset(new char[capacity_]);
+  }
+
+  uint32_t capacity() const { return capacity_; }
+
+  bool Empty() const {
+    return head_.load(std::memory_order_acquire) ==
+           tail_.load(std::memory_order_acquire);
+  }
+
+  uint64_t Used() const {
+    return head_.load(std::memory_order_acquire) -
+           tail_.load(std::memory_order_acquire);
+  }
+
+  bool Fits(uint32_t len) const { return RecordSize(len) <= capacity_; }
+
+  /**
+   * @brief Called by the producer only
+   */
+  bool TryWrite(time_t ts, uint64_t enqueue_ns, const char* data,
+                uint32_t len) {
+    uint64_t size = RecordSize(len);
+    uint64_t head = head_.load(std::memory_order_relaxed);
+    uint64_t tail = tail_.load(std::memory_order_acquire);
+    uint64_t pos = head & (capacity_ - 1);
+    // a record never wraps, the tail of the ring is skipped instead
+    uint64_t skip = capacity_ - pos < size ? capacity_ - pos : 0;
+    bool fit = head + skip + size - tail <= capacity_;
+    if (skip > 0 && (fit || head + skip - tail <= capacity_)) {
+      Header* padding = reinterpret_cast<Header*>(buffer_.get() + pos);
+      padding->size = static_cast<uint32_t>(skip);
+      padding->len = kPadding;
+      head += skip;
+      pos = 0;
+      if (!fit) {
+        // publish the padding anyway, or a record longer than the space left
+        // before the end could never be written
+        head_.store(head, std::memory_order_release);
+      }
+    }
+    if (cyber_unlikely(!fit)) {
+      return false;
+    }
+    Header* header = reinterpret_cast<Header*>(buffer_.get() + pos);
+    header->size = static_cast<uint32_t>(size);
+    header->len = len;
+    header->ts = static_cast<int64_t>(ts);
+    header->enqueue_ns = enqueue_ns;
+    std::memcpy(buffer_.get() + pos + sizeof(Header), data, len);
+    head_.store(head + size, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * @brief Called by the consumer only. Visits the records written so far
+   * without consuming them, the returned position has to be passed to
+   * `Consume` once the records are no longer referenced.
+   */
+  template <typename F>
+  uint64_t Visit(F&& f) const {
+    uint64_t tail = tail_.load(std::memory_order_relaxed);
+    uint64_t head = head_.load(std::memory_order_acquire);
+    while (tail < head) {
+      const Header* header = reinterpret_cast<const Header*>(
+          buffer_.get() + (tail & (capacity_ - 1)));
+      if (header->len != kPadding) {
+        Record record;
+        record.ts = static_cast<time_t>(header->ts);
+        record.enqueue_ns = header->enqueue_ns;
+        record.data = reinterpret_cast<const char*>(header + 1);
+        record.len = header->len;
+        f(record);
+      }
+      tail += header->size;
+    }
+    return tail;
+  }
+
+  void Consume(uint64_t position) {
+    tail_.store(position, std::memory_order_release);
+  }
+
+ private:
+  // the padding header only needs `size` and `len`, which fit in the 8 bytes
+  // always left at the end of the ring
+  struct Header {
+    uint32_t size;
+    uint32_t len;
+    int64_t ts;
+    uint64_t enqueue_ns;
+  };
+  static constexpr uint32_t kPadding = UINT32_MAX;
+
+  static uint64_t RecordSize(uint32_t len) {
+    return (sizeof(Header) + static_cast<uint64_t>(len) + 7) & ~uint64_t(7);
+  }
+
+  uint32_t capacity_ = 0;
+  std::unique_ptr<char[]> buffer_;
+  alignas(CACHELINE_SIZE) std::atomic<uint64_t> head_ = {0};
+  alignas(CACHELINE_SIZE) std::atomic<uint64_t> tail_ = {0};
+};
+
+}  // namespace logger
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_LOGGER_LOG_RING_BUFFER_H_
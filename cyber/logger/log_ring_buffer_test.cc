@@ -0,0 +1,108 @@
+/******************************************************************************
+ * Copyright 2024 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/logger/log_ring_buffer.h"
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace cyber {
+namespace logger {
+
+TEST(LogRingBufferTest, WriteAndVisit) {
+  LogRingBuffer ring(100);
+  EXPECT_EQ(ring.capacity(), 128);
+  EXPECT_TRUE(ring.Empty());
+  EXPECT_TRUE(ring.Fits(104));
+  EXPECT_FALSE(ring.Fits(105));
+
+  std::string msg = "0123456789";
+  EXPECT_TRUE(ring.TryWrite(1, 10, msg.data(), 10));
+  EXPECT_TRUE(ring.TryWrite(2, 20, msg.data(), 5));
+  EXPECT_TRUE(ring.TryWrite(3, 30, msg.data(), 10));
+  // 3 records of 40 bytes
+  EXPECT_FALSE(ring.TryWrite(4, 40, msg.data(), 1));
+  EXPECT_FALSE(ring.Empty());
+
+  std::vector<std::string> msgs;
+  auto position = ring.Visit([&msgs](const LogRingBuffer::Record& record) {
+    EXPECT_EQ(record.enqueue_ns, record.ts * 10);
+    msgs.emplace_back(record.data, record.len);
+  });
+  ASSERT_EQ(msgs.size(), 3);
+  EXPECT_EQ(msgs[0], msg);
+  EXPECT_EQ(msgs[1], "01234");
+  EXPECT_EQ(msgs[2], msg);
+  EXPECT_FALSE(ring.Empty());
+  ring.Consume(position);
+  EXPECT_TRUE(ring.Empty());
+
+  // does not fit before the end, the tail of the ring is skipped
+  EXPECT_TRUE(ring.TryWrite(5, 50, msg.data(), 10));
+  msgs.clear();
+  ring.Consume(ring.Visit([&msgs](const LogRingBuffer::Record& record) {
+    msgs.emplace_back(record.data, record.len);
+  }));
+  ASSERT_EQ(msgs.size(), 1);
+  EXPECT_EQ(msgs[0], msg);
+
+  // longer than the space left before the end even with an empty ring, the
+  // padding is written first and the record once it is consumed
+  std::string long_msg(80, 'x');
+  EXPECT_TRUE(ring.Empty());
+  EXPECT_FALSE(ring.TryWrite(6, 60, long_msg.data(), 80));
+  EXPECT_FALSE(ring.Empty());
+  ring.Consume(ring.Visit([](const LogRingBuffer::Record&) {
+    ADD_FAILURE() << "padding visited";
+  }));
+  EXPECT_TRUE(ring.TryWrite(6, 60, long_msg.data(), 80));
+}
+
+TEST(LogRingBufferTest, SingleProducerSingleConsumer) {
+  LogRingBuffer ring(1024);
+  const uint64_t num = 20000;
+  std::thread producer([&ring, num]() {
+    for (uint64_t i = 0; i < num; ++i) {
+      std::string msg(i % 50 + 1, static_cast<char>('a' + i % 26));
+      while (!ring.TryWrite(0, i, msg.data(),
+                            static_cast<uint32_t>(msg.size()))) {
+        std::this_thread::yield();
+      }
+    }
+  });
+
+  uint64_t expected = 0;
+  while (expected < num) {
+    ring.Consume(
+        ring.Visit([&expected](const LogRingBuffer::Record& record) {
+          EXPECT_EQ(record.enqueue_ns, expected);
+          EXPECT_EQ(record.len, expected % 50 + 1);
+          EXPECT_EQ(record.data[0], static_cast<char>('a' + expected % 26));
+          ++expected;
+        }));
+    std::this_thread::yield();
+  }
+  producer.join();
+  EXPECT_TRUE(ring.Empty());
+}
+
+}  // namespace logger
+}  // namespace cyber
+}  // namespace apollo
@@ -17,6 +17,7 @@
 #ifndef CYBER_MESSAGE_MESSAGE_TRAITS_H_
 #define CYBER_MESSAGE_MESSAGE_TRAITS_H_
 
+#include <cstring>
 #include <string>
 #include <typeinfo>
 
@@ -27,6 +28,7 @@
 #include "cyber/message/protobuf_traits.h"
 #include "cyber/message/py_message_traits.h"
 #include "cyber/message/raw_message_traits.h"
+#include "cyber/message/zero_copy_message_traits.h"
 
 namespace apollo {
 namespace cyber {
@@ -50,8 +52,9 @@ template <typename T>
 class HasSerializer {
  public:
   static constexpr bool value =
-      HasSerializeToString<T>::value && HasParseFromString<T>::value &&
-      HasSerializeToArray<T>::value && HasParseFromArray<T>::value;
+      (HasSerializeToString<T>::value && HasParseFromString<T>::value &&
+       HasSerializeToArray<T>::value && HasParseFromArray<T>::value) ||
+      IsZeroCopyMessage<T>::value;
 };
 
 // avoid potential ODR violation
@@ -131,12 +134,20 @@ typename std::enable_if<HasByteSize<T>::value, int>::type ByteSize(
 }
 
 template <typename T>
-typename std::enable_if<!HasByteSize<T>::value, int>::type ByteSize(
-    const T& message) {
+typename std::enable_if<
+    !HasByteSize<T>::value && !IsZeroCopyMessage<T>::value, int>::type
+ByteSize(const T& message) {
   (void)message;
   return -1;
 }
 
+template <typename T>
+typename std::enable_if<IsZeroCopyMessage<T>::value, int>::type ByteSize(
+    const T& message) {
+  (void)message;
+  return static_cast<int>(sizeof(T));
+}
+
 template <typename T>
 int FullByteSize(const T& message) {
   int content_size = ByteSize(message);
@@ -173,11 +184,22 @@ typename std::enable_if<HasParseFromArray<T>::value, bool>::type ParseFromArray(
 }
 
 template <typename T>
-typename std::enable_if<!HasParseFromArray<T>::value, bool>::type
+typename std::enable_if<
+    !HasParseFromArray<T>::value && !IsZeroCopyMessage<T>::value, bool>::type
 ParseFromArray(const void* data, int size, T* message) {
   return false;
 }
 
+template <typename T>
+typename std::enable_if<IsZeroCopyMessage<T>::value, bool>::type
+ParseFromArray(const void* data, int size, T* message) {
+  if (data == nullptr || size != static_cast<int>(sizeof(T))) {
+    return false;
+  }
+  std::memcpy(static_cast<void*>(message), data, sizeof(T));
+  return true;
+}
+
 template <typename T>
 typename std::enable_if<HasParseFromString<T>::value, bool>::type
 ParseFromString(const std::string& str, T* message) {
@@ -185,11 +207,18 @@ ParseFromString(const std::string& str, T* message) {
 }
 
 template <typename T>
-typename std::enable_if<!HasParseFromString<T>::value, bool>::type
+typename std::enable_if<
+    !HasParseFromString<T>::value && !IsZeroCopyMessage<T>::value, bool>::type
 ParseFromString(const std::string& str, T* message) {
   return false;
 }
 
+template <typename T>
+typename std::enable_if<IsZeroCopyMessage<T>::value, bool>::type
+ParseFromString(const std::string& str, T* message) {
+  return ParseFromArray(str.data(), static_cast<int>(str.size()), message);
+}
+
 template <typename T>
 typename std::enable_if<HasParseFromArray<T>::value, bool>::type ParseFromHC(
     const void* data, int size, T* message) {
@@ -237,11 +266,22 @@ SerializeToArray(const T& message, void* data, int size) {
 }
 
 template <typename T>
-typename std::enable_if<!HasSerializeToArray<T>::value, bool>::type
+typename std::enable_if<
+    !HasSerializeToArray<T>::value && !IsZeroCopyMessage<T>::value, bool>::type
 SerializeToArray(const T& message, void* data, int size) {
   return false;
 }
 
+template <typename T>
+typename std::enable_if<IsZeroCopyMessage<T>::value, bool>::type
+SerializeToArray(const T& message, void* data, int size) {
+  if (data == nullptr || size < static_cast<int>(sizeof(T))) {
+    return false;
+  }
+  std::memcpy(data, static_cast<const void*>(&message), sizeof(T));
+  return true;
+}
+
 template <typename T>
 typename std::enable_if<HasSerializeToString<T>::value, bool>::type
 SerializeToString(const T& message, std::string* str) {
@@ -249,11 +289,20 @@ SerializeToString(const T& message, std::string* str) {
 }
 
 template <typename T>
-typename std::enable_if<!HasSerializeToString<T>::value, bool>::type
+typename std::enable_if<
+    !HasSerializeToString<T>::value && !IsZeroCopyMessage<T>::value,
+    bool>::type
 SerializeToString(const T& message, std::string* str) {
   return false;
 }
 
+template <typename T>
+typename std::enable_if<IsZeroCopyMessage<T>::value, bool>::type
+SerializeToString(const T& message, std::string* str) {
+  str->assign(reinterpret_cast<const char*>(&message), sizeof(T));
+  return true;
+}
+
 template <typename T>
 typename std::enable_if<HasSerializeToArray<T>::value, bool>::type
 SerializeToHC(const T& message, void* data, int size) {
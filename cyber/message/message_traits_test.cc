@@ -22,6 +22,17 @@
 
 #include "cyber/proto/unit_test.pb.h"
 
+namespace {
+
+struct PodMessage {
+  uint64_t timestamp;
+  double value[3];
+};
+
+}  // namespace
+
+CYBER_REGISTER_ZERO_COPY_MESSAGE(PodMessage)
+
 namespace apollo {
 namespace cyber {
 namespace message {
@@ -268,6 +279,32 @@ TEST(MessageTraitsTest, serialize_parse_hc) {
   EXPECT_EQ(pb_msg->content(), "chatter msg");
 }
 
+TEST(MessageTraitsTest, zero_copy) {
+  EXPECT_TRUE(IsZeroCopyMessage<PodMessage>::value);
+  EXPECT_FALSE(IsZeroCopyMessage<Message>::value);
+  EXPECT_FALSE(IsZeroCopyMessage<proto::UnitTest>::value);
+  EXPECT_TRUE(HasSerializer<PodMessage>::value);
+
+  PodMessage msg{42, {1.0, 2.0, 3.0}};
+  EXPECT_EQ(ByteSize(msg), sizeof(PodMessage));
+
+  char array[sizeof(PodMessage)] = {0};
+  EXPECT_FALSE(SerializeToArray(msg, array, sizeof(array) - 1));
+  EXPECT_TRUE(SerializeToArray(msg, array, sizeof(array)));
+  PodMessage parsed{0, {0.0, 0.0, 0.0}};
+  EXPECT_FALSE(ParseFromArray(array, sizeof(array) - 1, &parsed));
+  EXPECT_TRUE(ParseFromArray(array, sizeof(array), &parsed));
+  EXPECT_EQ(parsed.timestamp, 42);
+  EXPECT_EQ(parsed.value[2], 3.0);
+
+  std::string str;
+  EXPECT_TRUE(SerializeToString(msg, &str));
+  EXPECT_EQ(str.size(), sizeof(PodMessage));
+  parsed.timestamp = 0;
+  EXPECT_TRUE(ParseFromString(str, &parsed));
+  EXPECT_EQ(parsed.timestamp, 42);
+}
+
 TEST(MessageTraitsTest, message_type) {
   std::string msg_type = MessageType<proto::UnitTest>();
   EXPECT_EQ(msg_type, "apollo.cyber.proto.UnitTest");
@@ -21,6 +21,7 @@
 #include <cstring>
 #include <memory>
 #include <string>
+#include <utility>
 
 #include "cyber/message/arena_message_wrapper.h"
 #include "cyber/message/protobuf_factory.h"
@@ -34,6 +35,9 @@ struct RawMessage {
 
   explicit RawMessage(const std::string &data) : message(data), timestamp(0) {}
 
+  explicit RawMessage(std::string &&data)
+      : message(std::move(data)), timestamp(0) {}
+
   RawMessage(const std::string &data, uint64_t ts)
       : message(data), timestamp(ts) {}
 
@@ -0,0 +1,57 @@
+/******************************************************************************
+ * Copyright 2024 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_MESSAGE_ZERO_COPY_MESSAGE_TRAITS_H_
+#define CYBER_MESSAGE_ZERO_COPY_MESSAGE_TRAITS_H_
+
+#include <type_traits>
+
+namespace apollo {
+namespace cyber {
+namespace message {
+
+/**
+ * @brief A zero copy message is a plain struct whose bytes are its wire
+ * format. It is constructed in place in a shared memory block by
+ * `Writer::Loan` and is copied out by readers without any parsing, so it must
+ * be trivially copyable and must not hold pointers.
+ *
+ * Register a type with CYBER_REGISTER_ZERO_COPY_MESSAGE at global scope:
+ *
+ *   struct Pose { double x; double y; double heading; };
+ *   CYBER_REGISTER_ZERO_COPY_MESSAGE(Pose)
+ */
+template <typename T>
+struct IsZeroCopyMessage : std::false_type {};
+
+}  // namespace message
+}  // namespace cyber
+}  // namespace apollo
+
+#define CYBER_REGISTER_ZERO_COPY_MESSAGE(T)                             \
+  namespace apollo {                                                    \
+  namespace cyber {                                                     \
+  namespace message {                                                   \
+  template <>                                                           \
+  struct IsZeroCopyMessage<T> : std::true_type {                        \
+    static_assert(std::is_trivially_copyable<T>::value,                 \
+                  #T " must be trivially copyable to be zero copied."); \
+  };                                                                    \
+  }                                                                     \
+  }                                                                     \
+  }
+
+#endif  // CYBER_MESSAGE_ZERO_COPY_MESSAGE_TRAITS_H_
@@ -0,0 +1,120 @@
+/******************************************************************************
+ * Copyright 2024 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_NODE_BATCH_READER_H_
+#define CYBER_NODE_BATCH_READER_H_
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "cyber/node/reader.h"
+
+namespace apollo {
+namespace cyber {
+
+template <typename M0>
+using BatchCallbackFunc =
+    std::function<void(const std::vector<std::shared_ptr<M0>>&)>;
+
+/**
+ * @brief Bounds of a single batch handed to a `BatchCallbackFunc`
+ */
+struct BatchReaderOption {
+  /// max messages per batch, 0 means everything buffered
+  uint32_t max_batch_size = 0;
+  /// max time the first message of a partial batch may wait before the batch
+  /// is dispatched anyway, 0 means dispatch as soon as anything is available
+  uint64_t max_delay_us = 0;
+};
+
+/**
+ * @class BatchReader
+ * @brief Reader that drains everything available in its `ChannelBuffer` at
+ * each wakeup and invokes the callback once with the whole batch, so a high
+ * rate channel costs one croutine switch per batch instead of per message.
+ * Messages are still pushed to the `Blocker` one by one, so `Observe` works as
+ * it does for `Reader`.
+ * @warning `pending_queue_size` is raised to `max_batch_size` if smaller,
+ * otherwise a full batch could never be buffered.
+ */
+template <typename MessageT>
+class BatchReader : public Reader<MessageT> {
+ public:
+  BatchReader(const proto::RoleAttributes& role_attr,
+              const BatchCallbackFunc<MessageT>& batch_func,
+              const BatchReaderOption& option,
+              uint32_t pending_queue_size = DEFAULT_PENDING_QUEUE_SIZE);
+  virtual ~BatchReader() = default;
+
+  const BatchReaderOption& option() const { return option_; }
+
+ protected:
+  croutine::RoutineFactory CreateRoutineFactory() override;
+
+ private:
+  BatchCallbackFunc<MessageT> batch_func_;
+  BatchReaderOption option_;
+};
+
+template <typename MessageT>
+BatchReader<MessageT>::BatchReader(
+    const proto::RoleAttributes& role_attr,
+    const BatchCallbackFunc<MessageT>& batch_func,
+    const BatchReaderOption& option, uint32_t pending_queue_size)
+    : Reader<MessageT>(role_attr, nullptr,
+                       std::max(pending_queue_size, option.max_batch_size)),
+      batch_func_(batch_func),
+      option_(option) {}
+
+template <typename MessageT>
+croutine::RoutineFactory BatchReader<MessageT>::CreateRoutineFactory() {
+  auto func = [this](const std::vector<std::shared_ptr<MessageT>>& msgs) {
+    for (const auto& msg : msgs) {
+      this->Enqueue(msg);
+    }
+    if (batch_func_ == nullptr) {
+      return;
+    }
+    uint64_t trace_start_time = this->trace_ ? LatencyTracer::Now() : 0;
+    batch_func_(msgs);
+    if (this->trace_) {
+      uint64_t trace_end_time = LatencyTracer::Now();
+      for (const auto& msg : msgs) {
+        LatencyTracer::Instance()->OnCallback(
+            this->trace_, this->role_attr_.channel_id(), msg.get(),
+            trace_start_time, trace_end_time);
+      }
+    }
+    // sampling proc latency of the newest message in microsecond
+    uint64_t proc_done_time = Time::Now().ToMicrosecond();
+    uint64_t proc_start_time =
+        static_cast<uint64_t>(this->latest_recv_time_sec_ * 1000000UL);
+    statistics::Statistics::Instance()->SamplingProcLatency<uint64_t>(
+        this->role_attr_, (proc_done_time - proc_start_time));
+  };
+  auto dv = std::make_shared<data::DataVisitor<MessageT>>(
+      this->role_attr_.channel_id(), this->pending_queue_size_);
+  return croutine::CreateBatchRoutineFactory<MessageT>(
+      std::move(func), dv, option_.max_batch_size, option_.max_delay_us);
+}
+
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_NODE_BATCH_READER_H_
@@ -123,6 +123,23 @@ class Node {
                     const CallbackFunc<MessageT>& reader_func = nullptr)
       -> std::shared_ptr<cyber::Reader<MessageT>>;
 
+  /**
+   * @brief Create a Reader whose callback receives every message buffered
+   * since the last invocation at once, see `BatchReader`
+   *
+   * @tparam MessageT Message Type
+   * @param config instance of `ReaderConfig`,
+   * include channel name, qos and pending queue size
+   * @param batch_func invoked with a batch of received messages
+   * @param option max batch size and max delay of a batch
+   * @return std::shared_ptr<cyber::Reader<MessageT>> result Reader Object
+   */
+  template <typename MessageT>
+  auto CreateBatchReader(const ReaderConfig& config,
+                         const BatchCallbackFunc<MessageT>& batch_func,
+                         const BatchReaderOption& option = BatchReaderOption())
+      -> std::shared_ptr<cyber::Reader<MessageT>>;
+
   /**
    * @brief Create a Service object with specific `service_name`
    *
@@ -254,6 +271,25 @@ auto Node::CreateReader(const std::string& channel_name,
   return reader;
 }
 
+template <typename MessageT>
+auto Node::CreateBatchReader(const ReaderConfig& config,
+                             const BatchCallbackFunc<MessageT>& batch_func,
+                             const BatchReaderOption& option)
+    -> std::shared_ptr<cyber::Reader<MessageT>> {
+  std::lock_guard<std::mutex> lg(readers_mutex_);
+  if (readers_.find(config.channel_name) != readers_.end()) {
+    AWARN << "Failed to create reader: reader with the same channel already "
+             "exists.";
+    return nullptr;
+  }
+  auto reader = node_channel_impl_->template CreateBatchReader<MessageT>(
+      config, batch_func, option);
+  if (reader != nullptr) {
+    readers_.emplace(std::make_pair(config.channel_name, reader));
+  }
+  return reader;
+}
+
 template <typename Request, typename Response>
 auto Node::CreateService(
     const std::string& service_name,
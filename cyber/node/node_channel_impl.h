@@ -26,6 +26,7 @@
 #include "cyber/blocker/intra_writer.h"
 #include "cyber/common/global_data.h"
 #include "cyber/message/message_traits.h"
+#include "cyber/node/batch_reader.h"
 #include "cyber/node/reader.h"
 #include "cyber/node/writer.h"
 
@@ -139,6 +140,12 @@ class NodeChannelImpl {
   auto CreateReader(const proto::RoleAttributes& role_attr)
       -> std::shared_ptr<Reader<MessageT>>;
 
+  template <typename MessageT>
+  auto CreateBatchReader(const ReaderConfig& config,
+                         const BatchCallbackFunc<MessageT>& batch_func,
+                         const BatchReaderOption& option)
+      -> std::shared_ptr<Reader<MessageT>>;
+
   template <typename MessageT>
   void FillInAttr(proto::RoleAttributes* attr);
 
@@ -231,6 +238,41 @@ auto NodeChannelImpl::CreateReader(const proto::RoleAttributes& role_attr)
   return this->template CreateReader<MessageT>(role_attr, nullptr);
 }
 
+template <typename MessageT>
+auto NodeChannelImpl::CreateBatchReader(
+    const ReaderConfig& config, const BatchCallbackFunc<MessageT>& batch_func,
+    const BatchReaderOption& option) -> std::shared_ptr<Reader<MessageT>> {
+  if (config.channel_name.empty()) {
+    AERROR << "Can't create a reader with empty channel name!";
+    return nullptr;
+  }
+
+  proto::RoleAttributes new_attr;
+  new_attr.set_channel_name(config.channel_name);
+  new_attr.mutable_qos_profile()->CopyFrom(config.qos_profile);
+  FillInAttr<MessageT>(&new_attr);
+
+  std::shared_ptr<Reader<MessageT>> reader_ptr = nullptr;
+  if (!is_reality_mode_) {
+    // blocker delivers synchronously, there is nothing to batch
+    CallbackFunc<MessageT> reader_func = nullptr;
+    if (batch_func != nullptr) {
+      reader_func = [batch_func](const std::shared_ptr<MessageT>& msg) {
+        batch_func({msg});
+      };
+    }
+    reader_ptr =
+        std::make_shared<blocker::IntraReader<MessageT>>(new_attr, reader_func);
+  } else {
+    reader_ptr = std::make_shared<BatchReader<MessageT>>(
+        new_attr, batch_func, option, config.pending_queue_size);
+  }
+
+  RETURN_VAL_IF_NULL(reader_ptr, nullptr);
+  RETURN_VAL_IF(!reader_ptr->Init(), nullptr);
+  return reader_ptr;
+}
+
 template <typename MessageT>
 void NodeChannelImpl::FillInAttr(proto::RoleAttributes* attr) {
   attr->set_host_name(node_attr_.host_name());
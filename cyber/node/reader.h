@@ -35,6 +35,7 @@
 #include "cyber/node/reader_base.h"
 #include "cyber/scheduler/scheduler_factory.h"
 #include "cyber/service_discovery/topology_manager.h"
+#include "cyber/statistics/latency_tracer.h"
 #include "cyber/statistics/statistics.h"
 #include "cyber/time/time.h"
 #include "cyber/transport/transport.h"
@@ -46,6 +47,7 @@ template <typename M0>
 using CallbackFunc = std::function<void(const std::shared_ptr<M0>&)>;
 
 using proto::RoleType;
+using statistics::LatencyTracer;
 
 const uint32_t DEFAULT_PENDING_QUEUE_SIZE = 1;
 
@@ -211,6 +213,14 @@ class Reader : public ReaderBase {
   double latest_recv_time_sec_ = -1.0;
   double second_to_lastest_recv_time_sec_ = -1.0;
   uint32_t pending_queue_size_;
+  // set when latency tracing is enabled
+  statistics::ReaderTracePtr trace_ = nullptr;
+
+  /**
+   * @brief Build the routine that moves messages from the `ChannelBuffer` to
+   * the callback, invoked by `Init` before the task is created
+   */
+  virtual croutine::RoutineFactory CreateRoutineFactory();
 
  private:
   void JoinTheTopology();
@@ -256,14 +266,7 @@ void Reader<MessageT>::Observe() {
 }
 
 template <typename MessageT>
-bool Reader<MessageT>::Init() {
-  if (init_.exchange(true)) {
-    return true;
-  }
-  auto statistics_center = statistics::Statistics::Instance();
-  if (!statistics_center->RegisterChanVar(role_attr_)) {
-    AWARN << "Failed to register reader var!";
-  }
+croutine::RoutineFactory Reader<MessageT>::CreateRoutineFactory() {
   std::function<void(const std::shared_ptr<MessageT>&)> func;
   if (reader_func_ != nullptr) {
     func = [this](const std::shared_ptr<MessageT>& msg) {
@@ -271,8 +274,14 @@ bool Reader<MessageT>::Init() {
       uint64_t proc_done_time;
       uint64_t proc_start_time;
 
+      uint64_t trace_start_time = trace_ ? LatencyTracer::Now() : 0;
       this->Enqueue(msg);
       this->reader_func_(msg);
+      if (trace_) {
+        LatencyTracer::Instance()->OnCallback(trace_, role_attr_.channel_id(),
+                                              msg.get(), trace_start_time,
+                                              LatencyTracer::Now());
+      }
       // sampling proc latency in microsecond
       proc_done_time = Time::Now().ToMicrosecond();
       proc_start_time =
@@ -292,14 +301,25 @@ bool Reader<MessageT>::Init() {
   } else {
     func = [this](const std::shared_ptr<MessageT>& msg) { this->Enqueue(msg); };
   }
-  auto sched = scheduler::Instance();
-  croutine_name_ = role_attr_.node_name() + "_" + role_attr_.channel_name();
   auto dv = std::make_shared<data::DataVisitor<MessageT>>(
       role_attr_.channel_id(), pending_queue_size_);
   // Using factory to wrap templates.
-  croutine::RoutineFactory factory =
-      croutine::CreateRoutineFactory<MessageT>(std::move(func), dv);
-  if (!sched->CreateTask(factory, croutine_name_)) {
+  return croutine::CreateRoutineFactory<MessageT>(std::move(func), dv);
+}
+
+template <typename MessageT>
+bool Reader<MessageT>::Init() {
+  if (init_.exchange(true)) {
+    return true;
+  }
+  auto statistics_center = statistics::Statistics::Instance();
+  if (!statistics_center->RegisterChanVar(role_attr_)) {
+    AWARN << "Failed to register reader var!";
+  }
+  trace_ = LatencyTracer::Instance()->RegisterReader(role_attr_);
+  auto sched = scheduler::Instance();
+  croutine_name_ = role_attr_.node_name() + "_" + role_attr_.channel_name();
+  if (!sched->CreateTask(CreateRoutineFactory(), croutine_name_)) {
     AERROR << "Create Task Failed!";
     init_.store(false);
     return false;
@@ -331,8 +351,9 @@ void Reader<MessageT>::Shutdown() {
 template <typename MessageT>
 void Reader<MessageT>::JoinTheTopology() {
   // add listener
-  change_conn_ = channel_manager_->AddChangeListener(std::bind(
-      &Reader<MessageT>::OnChannelChange, this, std::placeholders::_1));
+  change_conn_ = channel_manager_->AddChangeListener(
+      this->role_attr_.channel_id(),
+      std::bind(&Reader<MessageT>::OnChannelChange, this, std::placeholders::_1));
 
   // get peer writers
   const std::string& channel_name = this->role_attr_.channel_name();
@@ -26,6 +26,7 @@
 #include "cyber/common/macros.h"
 #include "cyber/common/util.h"
 #include "cyber/event/perf_event_cache.h"
+#include "cyber/statistics/latency_tracer.h"
 #include "cyber/transport/transport.h"
 
 namespace apollo {
@@ -214,6 +215,10 @@ auto ReceiverManager<MessageT>::GetReceiver(
               PerfEventCache::Instance()->AddTransportEvent(
                   TransPerf::DISPATCH, reader_attr.channel_id(),
                   msg_info.seq_num());
+              // registered before the readers can see the message
+              statistics::LatencyTracer::Instance()->OnDispatch(
+                  reader_attr.channel_id(), msg.get(),
+                  msg_info.trace_stamps());
               data::DataDispatcher<MessageT>::Instance()->Dispatch(
                   reader_attr.channel_id(), msg);
               PerfEventCache::Instance()->AddTransportEvent(
@@ -19,6 +19,7 @@
 
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "cyber/proto/topology_change.pb.h"
@@ -84,6 +85,28 @@ class Writer : public WriterBase {
    */
   virtual bool Write(const std::shared_ptr<MessageT>& msg_ptr);
 
+  /**
+   * @brief Loan a zero copy message to fill in and `Publish`. When some reader
+   * is in another process, the message is constructed in place in a shared
+   * memory block which is handed to the readers as is, without serialization
+   * nor copy. Otherwise it is allocated on the heap. Keep a single loan
+   * outstanding per writer, and give it back quickly since the block stays
+   * locked until then.
+   *
+   * @return the loaned message, invalid if the writer is not initialized
+   */
+  transport::LoanedMessage<MessageT> Loan();
+
+  /**
+   * @brief Publish a message obtained by `Loan`, the loan is consumed either
+   * way
+   *
+   * @param loaned the loaned message
+   * @return true if publish successfully
+   * @return false if publish failed
+   */
+  bool Publish(transport::LoanedMessage<MessageT>&& loaned);
+
   /**
    * @brief Is there any Reader that subscribes our Channel?
    * You can publish message when this return true
@@ -175,11 +198,32 @@ bool Writer<MessageT>::Write(const std::shared_ptr<MessageT>& msg_ptr) {
   return transmitter_->Transmit(msg_ptr);
 }
 
+template <typename MessageT>
+transport::LoanedMessage<MessageT> Writer<MessageT>::Loan() {
+  static_assert(message::IsZeroCopyMessage<MessageT>::value,
+                "only zero copy messages can be loaned, see "
+                "CYBER_REGISTER_ZERO_COPY_MESSAGE.");
+  transport::LoanedMessage<MessageT> loaned;
+  if (WriterBase::IsInit() && !transmitter_->Loan(&loaned)) {
+    loaned.Allocate();
+  }
+  return loaned;
+}
+
+template <typename MessageT>
+bool Writer<MessageT>::Publish(transport::LoanedMessage<MessageT>&& loaned) {
+  transport::LoanedMessage<MessageT> local(std::move(loaned));
+  RETURN_VAL_IF(!WriterBase::IsInit(), false);
+  RETURN_VAL_IF(!local.IsValid(), false);
+  return transmitter_->Publish(&local);
+}
+
 template <typename MessageT>
 void Writer<MessageT>::JoinTheTopology() {
   // add listener
-  change_conn_ = channel_manager_->AddChangeListener(std::bind(
-      &Writer<MessageT>::OnChannelChange, this, std::placeholders::_1));
+  change_conn_ = channel_manager_->AddChangeListener(
+      this->role_attr_.channel_id(),
+      std::bind(&Writer<MessageT>::OnChannelChange, this, std::placeholders::_1));
 
   // get peer readers
   const std::string& channel_name = this->role_attr_.channel_name();
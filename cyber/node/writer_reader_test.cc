@@ -26,6 +26,7 @@
 #include "cyber/common/global_data.h"
 #include "cyber/cyber.h"
 #include "cyber/init.h"
+#include "cyber/node/batch_reader.h"
 #include "cyber/node/reader.h"
 #include "cyber/node/writer.h"
 
@@ -164,6 +165,56 @@ TEST(WriterReaderTest, messaging) {
   reader_b.Shutdown();
 }
 
+TEST(WriterReaderTest, batch_messaging) {
+  proto::RoleAttributes attr;
+  attr.set_node_name("writer");
+  attr.set_channel_name("batch_messaging");
+  auto channel_id = common::GlobalData::RegisterChannel(attr.channel_name());
+  attr.set_channel_id(channel_id);
+
+  Writer<proto::UnitTest> writer(attr);
+  EXPECT_TRUE(writer.Init());
+
+  std::mutex mtx;
+  std::vector<size_t> batch_sizes;
+  BatchReaderOption option;
+  option.max_batch_size = 4;
+  option.max_delay_us = 100000;
+  attr.set_node_name("batch_reader");
+  BatchReader<proto::UnitTest> reader(
+      attr,
+      [&](const std::vector<std::shared_ptr<proto::UnitTest>>& msgs) {
+        std::lock_guard<std::mutex> lck(mtx);
+        batch_sizes.emplace_back(msgs.size());
+      },
+      option, 16);
+  EXPECT_EQ(reader.PendingQueueSize(), 16);
+  EXPECT_TRUE(reader.Init());
+
+  auto msg = std::make_shared<proto::UnitTest>();
+  msg->set_class_name("WriterReaderTest");
+  msg->set_case_name("batch_messaging");
+  for (int i = 0; i < 6; ++i) {
+    writer.Write(msg);
+  }
+  std::this_thread::sleep_for(std::chrono::milliseconds(500));
+
+  {
+    std::lock_guard<std::mutex> lck(mtx);
+    size_t total = 0;
+    for (auto size : batch_sizes) {
+      EXPECT_LE(size, 4);
+      total += size;
+    }
+    EXPECT_EQ(total, 6);
+    // the trailing partial batch is flushed by the delay bound
+    EXPECT_LT(batch_sizes.size(), 6);
+  }
+
+  writer.Shutdown();
+  reader.Shutdown();
+}
+
 TEST(WriterReaderTest, observe) {
   proto::RoleAttributes attr;
   attr.set_node_name("node");
@@ -0,0 +1,125 @@
+/******************************************************************************
+ * Copyright 2024 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/record/file/chunk_compressor.h"
+
+#include <zlib.h>
+
+#include <cstdint>
+#include <cstring>
+
+#include "cyber/common/log.h"
+
+namespace apollo {
+namespace cyber {
+namespace record {
+
+using apollo::cyber::proto::ChunkBody;
+using apollo::cyber::proto::CompressType;
+
+namespace {
+
+constexpr size_t kRawSizeLength = sizeof(uint64_t);
+
+bool ZlibCompress(const std::string& raw, std::string* payload) {
+  uLongf bound = compressBound(static_cast<uLong>(raw.size()));
+  payload->resize(kRawSizeLength + bound);
+  uint64_t raw_size = raw.size();
+  std::memcpy(&(*payload)[0], &raw_size, kRawSizeLength);
+  int ret = compress2(
+      reinterpret_cast<Bytef*>(&(*payload)[kRawSizeLength]), &bound,
+      reinterpret_cast<const Bytef*>(raw.data()),
+      static_cast<uLong>(raw.size()), Z_BEST_SPEED);
+  if (ret != Z_OK) {
+    AERROR << "zlib compress failed, ret: " << ret;
+    return false;
+  }
+  payload->resize(kRawSizeLength + bound);
+  return true;
+}
+
+bool ZlibDecompress(const std::string& payload, std::string* raw) {
+  if (payload.size() < kRawSizeLength) {
+    AERROR << "Compressed chunk is too short, size: " << payload.size();
+    return false;
+  }
+  uint64_t raw_size = 0;
+  std::memcpy(&raw_size, payload.data(), kRawSizeLength);
+  raw->resize(raw_size);
+  uLongf dest_len = static_cast<uLongf>(raw_size);
+  int ret = uncompress(
+      reinterpret_cast<Bytef*>(&(*raw)[0]), &dest_len,
+      reinterpret_cast<const Bytef*>(payload.data() + kRawSizeLength),
+      static_cast<uLong>(payload.size() - kRawSizeLength));
+  if (ret != Z_OK || dest_len != raw_size) {
+    AERROR << "zlib uncompress failed, ret: " << ret
+           << ", expect size: " << raw_size << ", actual size: " << dest_len;
+    return false;
+  }
+  return true;
+}
+
+}  // namespace
+
+bool ChunkCompressor::IsSupported(CompressType type) {
+  return type == CompressType::COMPRESS_NONE ||
+         type == CompressType::COMPRESS_ZLIB;
+}
+
+bool ChunkCompressor::Compress(CompressType type, const ChunkBody& body,
+                               std::string* payload) {
+  std::string raw;
+  if (!body.SerializeToString(&raw)) {
+    AERROR << "Serialize chunk body failed.";
+    return false;
+  }
+  switch (type) {
+    case CompressType::COMPRESS_NONE:
+      payload->swap(raw);
+      return true;
+    case CompressType::COMPRESS_ZLIB:
+      return ZlibCompress(raw, payload);
+    default:
+      AERROR << "Unsupported compress type: " << type;
+      return false;
+  }
+}
+
+bool ChunkCompressor::Decompress(CompressType type, const std::string& payload,
+                                 ChunkBody* body) {
+  std::string raw;
+  switch (type) {
+    case CompressType::COMPRESS_NONE:
+      return body->ParseFromString(payload);
+    case CompressType::COMPRESS_ZLIB:
+      if (!ZlibDecompress(payload, &raw)) {
+        return false;
+      }
+      break;
+    default:
+      AERROR << "Unsupported compress type: " << type;
+      return false;
+  }
+  if (!body->ParseFromString(raw)) {
+    AERROR << "Parse decompressed chunk body failed.";
+    return false;
+  }
+  return true;
+}
+
+}  // namespace record
+}  // namespace cyber
+}  // namespace apollo
@@ -0,0 +1,57 @@
+/******************************************************************************
+ * Copyright 2024 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_RECORD_FILE_CHUNK_COMPRESSOR_H_
+#define CYBER_RECORD_FILE_CHUNK_COMPRESSOR_H_
+
+#include <string>
+
+#include "cyber/proto/record.pb.h"
+
+namespace apollo {
+namespace cyber {
+namespace record {
+
+/**
+ * @brief Codec of chunk body sections. A compressed section holds the
+ * serialized size of the chunk body as a little endian uint64, followed by
+ * the compressed bytes.
+ */
+class ChunkCompressor {
+ public:
+  /**
+   * @brief Whether chunk bodies of this compress type can be written and read.
+   */
+  static bool IsSupported(proto::CompressType type);
+
+  /**
+   * @brief Serialize and compress a chunk body into a section payload.
+   */
+  static bool Compress(proto::CompressType type, const proto::ChunkBody& body,
+                       std::string* payload);
+
+  /**
+   * @brief Decompress and parse a section payload into a chunk body.
+   */
+  static bool Decompress(proto::CompressType type, const std::string& payload,
+                         proto::ChunkBody* body);
+};
+
+}  // namespace record
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_RECORD_FILE_CHUNK_COMPRESSOR_H_
@@ -0,0 +1,264 @@
+/******************************************************************************
+ * Copyright 2024 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/record/file/direct_file_writer.h"
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+
+#include "cyber/common/log.h"
+
+namespace apollo {
+namespace cyber {
+namespace record {
+
+namespace {
+
+size_t AlignUp(size_t size) {
+  return (size + DirectFileWriter::kAlignment - 1) /
+         DirectFileWriter::kAlignment * DirectFileWriter::kAlignment;
+}
+
+uint64_t ElapsedUs(const std::chrono::steady_clock::time_point& start) {
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+             std::chrono::steady_clock::now() - start)
+      .count();
+}
+
+}  // namespace
+
+DirectFileWriter::DirectFileWriter(int fd, const proto::RecordWriteConf& conf)
+    : fd_(fd),
+      buffer_size_(AlignUp(std::max<size_t>(conf.io_buffer_size_kb(), 4) *
+                           1024)),
+      buffer_num_(std::max<uint32_t>(conf.io_buffer_num(), 2)),
+      thread_num_(std::max<uint32_t>(conf.io_thread_num(), 1)),
+      sync_interval_bytes_(static_cast<uint64_t>(conf.sync_interval_mb())
+                           << 20) {}
+
+DirectFileWriter::~DirectFileWriter() {
+  Close();
+  for (auto& buffer : buffers_) {
+    free(buffer.data);
+  }
+}
+
+bool DirectFileWriter::Init() {
+  buffers_.resize(buffer_num_);
+  for (auto& buffer : buffers_) {
+    void* data = nullptr;
+    if (posix_memalign(&data, kAlignment, buffer_size_) != 0) {
+      AERROR << "Allocate aligned buffer failed, size: " << buffer_size_;
+      return false;
+    }
+    buffer.data = static_cast<char*>(data);
+    free_.push_back(&buffer);
+  }
+  for (uint32_t i = 0; i < thread_num_; ++i) {
+    threads_.emplace_back([this]() { this->Run(); });
+  }
+  return true;
+}
+
+bool DirectFileWriter::AcquireBuffer() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  if (free_.empty()) {
+    auto start = std::chrono::steady_clock::now();
+    free_cv_.wait(lock, [this] { return !free_.empty() || error_.load(); });
+    stats_.wait_time_us += ElapsedUs(start);
+  }
+  if (error_.load()) {
+    return false;
+  }
+  current_ = free_.back();
+  free_.pop_back();
+  current_->used = 0;
+  current_->offset = submitted_bytes_;
+  return true;
+}
+
+void DirectFileWriter::Submit() {
+  submitted_bytes_ += current_->used;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    pending_.push_back(current_);
+    stats_.queued_buffers = pending_.size();
+    stats_.max_queued_buffers =
+        std::max(stats_.max_queued_buffers, stats_.queued_buffers);
+  }
+  current_ = nullptr;
+  pending_cv_.notify_one();
+}
+
+bool DirectFileWriter::Next(void** data, int* size) {
+  if (closed_ || error_.load()) {
+    return false;
+  }
+  if (current_ != nullptr && current_->used == buffer_size_) {
+    Submit();
+  }
+  if (current_ == nullptr && !AcquireBuffer()) {
+    return false;
+  }
+  *data = current_->data + current_->used;
+  *size = static_cast<int>(buffer_size_ - current_->used);
+  current_->used = buffer_size_;
+  return true;
+}
+
+void DirectFileWriter::BackUp(int count) {
+  if (current_ != nullptr) {
+    current_->used -= std::min(static_cast<size_t>(count), current_->used);
+  }
+}
+
+int64_t DirectFileWriter::ByteCount() const {
+  return submitted_bytes_ +
+         (current_ == nullptr ? 0 : static_cast<int64_t>(current_->used));
+}
+
+bool DirectFileWriter::Write(const void* data, size_t size) {
+  auto src = static_cast<const char*>(data);
+  while (size > 0) {
+    void* dst = nullptr;
+    int capacity = 0;
+    if (!Next(&dst, &capacity)) {
+      return false;
+    }
+    size_t n = std::min(size, static_cast<size_t>(capacity));
+    std::memcpy(dst, src, n);
+    BackUp(capacity - static_cast<int>(n));
+    src += n;
+    size -= n;
+  }
+  return true;
+}
+
+void DirectFileWriter::Run() {
+  while (true) {
+    Buffer* buffer = nullptr;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      pending_cv_.wait(lock, [this] { return !pending_.empty() || stop_; });
+      if (pending_.empty()) {
+        return;
+      }
+      buffer = pending_.front();
+      pending_.pop_front();
+      stats_.queued_buffers = pending_.size();
+      ++in_flight_;
+    }
+
+    // only the last buffer is partly used, it is padded and cut off later
+    size_t size = AlignUp(buffer->used);
+    size_t written = 0;
+    auto start = std::chrono::steady_clock::now();
+    while (written < size && !error_.load()) {
+      ssize_t count = pwrite(fd_, buffer->data + written, size - written,
+                             buffer->offset + written);
+      if (count <= 0) {
+        AERROR << "pwrite failed, fd: " << fd_
+               << ", offset: " << buffer->offset + written
+               << ", errno: " << errno;
+        error_ = true;
+        break;
+      }
+      written += count;
+    }
+    uint64_t write_us = ElapsedUs(start);
+
+    bool need_sync = false;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stats_.bytes_written += buffer->used;
+      ++stats_.write_num;
+      stats_.write_time_us += write_us;
+      stats_.max_write_us = std::max(stats_.max_write_us, write_us);
+      unsynced_bytes_ += buffer->used;
+      if (sync_interval_bytes_ > 0 && unsynced_bytes_ >= sync_interval_bytes_) {
+        unsynced_bytes_ = 0;
+        need_sync = true;
+      }
+      free_.push_back(buffer);
+      --in_flight_;
+    }
+    free_cv_.notify_all();
+    if (need_sync && !error_.load()) {
+      Sync();
+    }
+  }
+}
+
+void DirectFileWriter::Sync() {
+  auto start = std::chrono::steady_clock::now();
+  if (fdatasync(fd_) != 0) {
+    AERROR << "fdatasync failed, fd: " << fd_ << ", errno: " << errno;
+  }
+  uint64_t sync_us = ElapsedUs(start);
+  std::lock_guard<std::mutex> lock(mutex_);
+  ++stats_.sync_num;
+  stats_.sync_time_us += sync_us;
+  stats_.max_sync_us = std::max(stats_.max_sync_us, sync_us);
+}
+
+bool DirectFileWriter::Close() {
+  if (closed_) {
+    return ok();
+  }
+  closed_ = true;
+  if (current_ != nullptr) {
+    if (current_->used > 0) {
+      Submit();
+    } else {
+      std::lock_guard<std::mutex> lock(mutex_);
+      free_.push_back(current_);
+      current_ = nullptr;
+    }
+  }
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    free_cv_.wait(lock, [this] {
+      return (pending_.empty() && in_flight_ == 0) || error_.load();
+    });
+    stop_ = true;
+  }
+  pending_cv_.notify_all();
+  for (auto& thread : threads_) {
+    if (thread.joinable()) {
+      thread.join();
+    }
+  }
+  threads_.clear();
+  if (ftruncate(fd_, submitted_bytes_) != 0) {
+    AERROR << "ftruncate failed, fd: " << fd_ << ", size: " << submitted_bytes_
+           << ", errno: " << errno;
+    error_ = true;
+  }
+  return ok();
+}
+
+DirectFileWriter::Stats DirectFileWriter::GetStats() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return stats_;
+}
+
+}  // namespace record
+}  // namespace cyber
+}  // namespace apollo
@@ -0,0 +1,128 @@
+/******************************************************************************
+ * Copyright 2024 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_RECORD_FILE_DIRECT_FILE_WRITER_H_
+#define CYBER_RECORD_FILE_DIRECT_FILE_WRITER_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "google/protobuf/io/zero_copy_stream.h"
+
+#include "cyber/proto/record_conf.pb.h"
+
+namespace apollo {
+namespace cyber {
+namespace record {
+
+/**
+ * @class DirectFileWriter
+ * @brief Appends to a file from offset 0 through a fixed pool of aligned
+ * buffers. Sections are serialized straight into the buffers, full buffers
+ * are written by a pool of threads with pwrite at their own offsets, so a
+ * file opened with O_DIRECT is written without going through the page cache.
+ * The memory is bounded by the pool, a writer waits for a free buffer when
+ * the disk falls behind. The sync interval counts the bytes written by the
+ * threads, not the ones still in the buffers.
+ */
+class DirectFileWriter : public google::protobuf::io::ZeroCopyOutputStream {
+ public:
+  // offsets, sizes and addresses of O_DIRECT writes are aligned to it
+  static constexpr size_t kAlignment = 4096;
+
+  struct Stats {
+    uint64_t bytes_written = 0;
+    uint64_t write_num = 0;
+    uint64_t write_time_us = 0;
+    uint64_t max_write_us = 0;
+    // full buffers waiting for a writer thread
+    uint64_t queued_buffers = 0;
+    uint64_t max_queued_buffers = 0;
+    // time spent waiting for a free buffer
+    uint64_t wait_time_us = 0;
+    // fdatasync issued every sync_interval_mb written
+    uint64_t sync_num = 0;
+    uint64_t sync_time_us = 0;
+    uint64_t max_sync_us = 0;
+  };
+
+  DirectFileWriter(int fd, const proto::RecordWriteConf& conf);
+  ~DirectFileWriter() override;
+
+  DirectFileWriter(const DirectFileWriter&) = delete;
+  DirectFileWriter& operator=(const DirectFileWriter&) = delete;
+
+  bool Init();
+  bool Write(const void* data, size_t size);
+
+  bool Next(void** data, int* size) override;
+  void BackUp(int count) override;
+  int64_t ByteCount() const override;
+
+  /**
+   * @brief Write what is buffered, wait for the writer threads and cut the
+   * padding of the last buffer off, the file is ByteCount() long afterwards.
+   */
+  bool Close();
+
+  bool ok() const { return !error_.load(); }
+  Stats GetStats();
+
+ private:
+  struct Buffer {
+    char* data = nullptr;
+    size_t used = 0;
+    int64_t offset = 0;
+  };
+
+  bool AcquireBuffer();
+  void Submit();
+  void Run();
+  void Sync();
+
+  int fd_;
+  size_t buffer_size_;
+  uint32_t buffer_num_;
+  uint32_t thread_num_;
+  uint64_t sync_interval_bytes_;
+  std::vector<Buffer> buffers_;
+  std::vector<std::thread> threads_;
+  Buffer* current_ = nullptr;
+  int64_t submitted_bytes_ = 0;
+  std::atomic<bool> error_ = {false};
+  bool closed_ = false;
+
+  std::mutex mutex_;
+  std::condition_variable pending_cv_;
+  std::condition_variable free_cv_;
+  std::deque<Buffer*> pending_;
+  std::vector<Buffer*> free_;
+  uint32_t in_flight_ = 0;
+  uint64_t unsynced_bytes_ = 0;
+  bool stop_ = false;
+  Stats stats_;
+};
+
+}  // namespace record
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_RECORD_FILE_DIRECT_FILE_WRITER_H_
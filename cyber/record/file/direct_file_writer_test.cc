@@ -0,0 +1,147 @@
+/******************************************************************************
+ * Copyright 2024 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/record/file/direct_file_writer.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include "cyber/proto/record.pb.h"
+
+namespace apollo {
+namespace cyber {
+namespace record {
+
+constexpr char kTestFile[] = "direct_file_writer_test.bin";
+
+std::string ReadFile(const std::string& path) {
+  std::ifstream input(path, std::ios::binary);
+  std::stringstream content;
+  content << input.rdbuf();
+  return content.str();
+}
+
+proto::RecordWriteConf SmallBufferConf() {
+  proto::RecordWriteConf conf;
+  conf.set_io_buffer_size_kb(4);
+  conf.set_io_buffer_num(2);
+  conf.set_io_thread_num(2);
+  return conf;
+}
+
+TEST(DirectFileWriterTest, write_across_buffers) {
+  int fd = open(kTestFile, O_CREAT | O_WRONLY | O_TRUNC, S_IRUSR | S_IWUSR);
+  ASSERT_GE(fd, 0);
+  std::string expected;
+  {
+    DirectFileWriter writer(fd, SmallBufferConf());
+    ASSERT_TRUE(writer.Init());
+    // 10 buffers through a pool of 2, the writer has to wait for free ones
+    for (int i = 0; i < 1000; ++i) {
+      std::string piece(41, static_cast<char>('a' + i % 26));
+      ASSERT_TRUE(writer.Write(piece.data(), piece.size()));
+      expected += piece;
+    }
+    EXPECT_EQ(writer.ByteCount(), static_cast<int64_t>(expected.size()));
+    ASSERT_TRUE(writer.Close());
+    auto stats = writer.GetStats();
+    EXPECT_EQ(stats.bytes_written, expected.size());
+    EXPECT_EQ(stats.write_num, 11);
+    EXPECT_EQ(stats.queued_buffers, 0);
+  }
+  close(fd);
+  // the padding of the last buffer is cut off
+  EXPECT_EQ(ReadFile(kTestFile), expected);
+  ASSERT_FALSE(remove(kTestFile));
+}
+
+TEST(DirectFileWriterTest, serialize) {
+  int fd = open(kTestFile, O_CREAT | O_WRONLY | O_TRUNC, S_IRUSR | S_IWUSR);
+  ASSERT_GE(fd, 0);
+  proto::ChunkBody body;
+  for (int i = 0; i < 100; ++i) {
+    auto message = body.add_messages();
+    message->set_channel_name("/test");
+    message->set_time(i);
+    message->set_content(std::string(100, static_cast<char>(i)));
+  }
+  {
+    DirectFileWriter writer(fd, SmallBufferConf());
+    ASSERT_TRUE(writer.Init());
+    ASSERT_TRUE(writer.Write("head", 4));
+    ASSERT_TRUE(body.SerializeToZeroCopyStream(&writer));
+    EXPECT_EQ(writer.ByteCount(),
+              static_cast<int64_t>(4 + body.ByteSizeLong()));
+    ASSERT_TRUE(writer.Close());
+  }
+  close(fd);
+
+  std::string content = ReadFile(kTestFile);
+  ASSERT_EQ(content.size(), 4 + body.ByteSizeLong());
+  EXPECT_EQ(content.substr(0, 4), "head");
+  proto::ChunkBody parsed;
+  ASSERT_TRUE(parsed.ParseFromString(content.substr(4)));
+  ASSERT_EQ(parsed.messages_size(), 100);
+  EXPECT_EQ(parsed.messages(99).content(), body.messages(99).content());
+  ASSERT_FALSE(remove(kTestFile));
+}
+
+TEST(DirectFileWriterTest, sync_written_bytes) {
+  int fd = open(kTestFile, O_CREAT | O_WRONLY | O_TRUNC, S_IRUSR | S_IWUSR);
+  ASSERT_GE(fd, 0);
+  proto::RecordWriteConf conf = SmallBufferConf();
+  conf.set_io_buffer_size_kb(64);
+  conf.set_sync_interval_mb(1);
+  {
+    DirectFileWriter writer(fd, conf);
+    ASSERT_TRUE(writer.Init());
+    // the last half is still buffered after the loop and written on close
+    std::string piece(1024, 'x');
+    for (int i = 0; i < 3 * 1024 + 512; ++i) {
+      ASSERT_TRUE(writer.Write(piece.data(), piece.size()));
+    }
+    ASSERT_TRUE(writer.Close());
+    auto stats = writer.GetStats();
+    EXPECT_EQ(stats.bytes_written, (3 * 1024 + 512) * 1024);
+    EXPECT_EQ(stats.sync_num, 3);
+  }
+  close(fd);
+  ASSERT_FALSE(remove(kTestFile));
+}
+
+TEST(DirectFileWriterTest, close_empty) {
+  int fd = open(kTestFile, O_CREAT | O_WRONLY | O_TRUNC, S_IRUSR | S_IWUSR);
+  ASSERT_GE(fd, 0);
+  {
+    DirectFileWriter writer(fd, SmallBufferConf());
+    ASSERT_TRUE(writer.Init());
+    ASSERT_TRUE(writer.Close());
+    EXPECT_FALSE(writer.Write("x", 1));
+  }
+  close(fd);
+  EXPECT_TRUE(ReadFile(kTestFile).empty());
+  ASSERT_FALSE(remove(kTestFile));
+}
+
+}  // namespace record
+}  // namespace cyber
+}  // namespace apollo
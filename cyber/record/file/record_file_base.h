@@ -37,7 +37,7 @@ class RecordFileBase {
   const std::string& GetPath() const { return path_; }
   const proto::Header& GetHeader() const { return header_; }
   const proto::Index& GetIndex() const { return index_; }
-  int64_t CurrentPosition();
+  virtual int64_t CurrentPosition();
   bool SetPosition(int64_t position);
 
  protected:
@@ -16,13 +16,119 @@
 
 #include "cyber/record/file/record_file_reader.h"
 
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include <algorithm>
+
+#include "google/protobuf/wire_format_lite.h"
+
 #include "cyber/common/file.h"
+#include "cyber/record/file/chunk_compressor.h"
 
 namespace apollo {
 namespace cyber {
 namespace record {
 
+using apollo::cyber::proto::ChunkBody;
 using apollo::cyber::proto::SectionType;
+using google::protobuf::internal::WireFormatLite;
+
+namespace {
+
+constexpr size_t kReadAheadChunkNum = 4;
+// bytes after the current chunk body the kernel is asked to read ahead
+constexpr size_t kMmapReadAheadSize = 64 * 1024 * 1024;
+
+// reads a length delimited field and returns its bytes
+bool ReadBytesView(CodedInputStream* input, const char* base,
+                   std::string_view* view) {
+  uint32_t length = 0;
+  if (!input->ReadVarint32(&length)) {
+    return false;
+  }
+  const char* begin = base + input->CurrentPosition();
+  if (!input->Skip(static_cast<int>(length))) {
+    return false;
+  }
+  *view = std::string_view(begin, length);
+  return true;
+}
+
+bool ParseMessageView(const char* data, int size, MessageView* message) {
+  CodedInputStream input(reinterpret_cast<const uint8_t*>(data), size);
+  // absent fields are empty views, but never null ones
+  message->channel_name = std::string_view(data, 0);
+  message->content = std::string_view(data, 0);
+  message->time = 0;
+  uint32_t tag = 0;
+  while ((tag = input.ReadTag()) != 0) {
+    switch (WireFormatLite::GetTagFieldNumber(tag)) {
+      case proto::SingleMessage::kChannelNameFieldNumber:
+        if (!ReadBytesView(&input, data, &message->channel_name)) {
+          return false;
+        }
+        break;
+      case proto::SingleMessage::kTimeFieldNumber:
+        if (!input.ReadVarint64(&message->time)) {
+          return false;
+        }
+        break;
+      case proto::SingleMessage::kContentFieldNumber:
+        if (!ReadBytesView(&input, data, &message->content)) {
+          return false;
+        }
+        break;
+      default:
+        if (!WireFormatLite::SkipField(&input, tag)) {
+          return false;
+        }
+        break;
+    }
+  }
+  return input.ConsumedEntireMessage();
+}
+
+bool ParseChunkBodyView(const char* data, int size,
+                        std::vector<MessageView>* messages) {
+  CodedInputStream input(reinterpret_cast<const uint8_t*>(data), size);
+  uint32_t tag = 0;
+  while ((tag = input.ReadTag()) != 0) {
+    if (WireFormatLite::GetTagFieldNumber(tag) !=
+        proto::ChunkBody::kMessagesFieldNumber) {
+      if (!WireFormatLite::SkipField(&input, tag)) {
+        return false;
+      }
+      continue;
+    }
+    std::string_view bytes;
+    if (!ReadBytesView(&input, data, &bytes)) {
+      return false;
+    }
+    messages->emplace_back();
+    if (!ParseMessageView(bytes.data(), static_cast<int>(bytes.size()),
+                          &messages->back())) {
+      return false;
+    }
+  }
+  return input.ConsumedEntireMessage();
+}
+
+bool ReadFully(int fd, int64_t offset, size_t size, char* buf) {
+  size_t done = 0;
+  while (done < size) {
+    ssize_t count = pread(fd, buf + done, size - done, offset + done);
+    if (count <= 0) {
+      AERROR << "Read fd failed, fd: " << fd << ", offset: " << offset + done
+             << ", count: " << count << ", errno: " << errno;
+      return false;
+    }
+    done += count;
+  }
+  return true;
+}
+
+}  // namespace
 
 bool RecordFileReader::Open(const std::string& path) {
   std::lock_guard<std::mutex> lock(mutex_);
@@ -46,6 +152,15 @@ bool RecordFileReader::Open(const std::string& path) {
 }
 
 void RecordFileReader::Close() {
+  // the read ahead tasks use fd_, wait for them before closing it
+  read_ahead_.clear();
+  decompress_pool_ = nullptr;
+  chunk_body_positions_.clear();
+  if (mapped_ != nullptr) {
+    munmap(const_cast<char*>(mapped_), mapped_size_);
+    mapped_ = nullptr;
+    mapped_size_ = 0;
+  }
   if (fd_ >= 0) {
     close(fd_);
     fd_ = -1;
@@ -147,6 +262,173 @@ bool RecordFileReader::SkipSection(int64_t size) {
   return true;
 }
 
+template <>
+bool RecordFileReader::ReadSection<ChunkBody>(int64_t size, ChunkBody* body) {
+  if (header_.compress() == proto::CompressType::COMPRESS_NONE) {
+    return ParseSection(size, body);
+  }
+  if (size < 0 || size > std::numeric_limits<int>::max()) {
+    AERROR << "Size value greater than the range of int value.";
+    return false;
+  }
+  return ReadChunkBody(size, body);
+}
+
+bool RecordFileReader::ReadChunkBody(int64_t size, ChunkBody* body) {
+  int64_t position = CurrentPosition() - sizeof(struct Section);
+  ChunkBodyPtr loaded = nullptr;
+  auto search = read_ahead_.find(position);
+  if (search != read_ahead_.end() && search->second.valid()) {
+    loaded = search->second.get();
+  }
+  if (loaded != nullptr) {
+    body->Swap(loaded.get());
+    if (!SetPosition(position + sizeof(struct Section) + size)) {
+      return false;
+    }
+  } else {
+    std::string payload(size, '\0');
+    if (!ReadFully(fd_, position + sizeof(struct Section), size,
+                   &payload[0]) ||
+        !SetPosition(position + sizeof(struct Section) + size)) {
+      AERROR << "Read chunk body section fail, file: " << path_;
+      return false;
+    }
+    if (!ChunkCompressor::Decompress(header_.compress(), payload, body)) {
+      AERROR << "Decompress chunk body fail, file: " << path_
+             << ", position: " << position;
+      return false;
+    }
+  }
+  ReadAhead(position);
+  return true;
+}
+
+RecordFileReader::ChunkBodyPtr RecordFileReader::LoadChunkBody(
+    int64_t position) {
+  auto body = std::make_shared<ChunkBody>();
+  if (!ReadChunkBodyAt(position, body.get())) {
+    return nullptr;
+  }
+  return body;
+}
+
+bool RecordFileReader::ReadChunkBodyAt(int64_t position, ChunkBody* body) {
+  Section section;
+  if (!ReadFully(fd_, position, sizeof(section),
+                 reinterpret_cast<char*>(&section)) ||
+      section.type != SectionType::SECTION_CHUNK_BODY || section.size < 0) {
+    AERROR << "Read chunk body section fail, file: " << path_
+           << ", position: " << position;
+    return false;
+  }
+  std::string payload(section.size, '\0');
+  if (!ReadFully(fd_, position + sizeof(section), section.size,
+                 &payload[0])) {
+    return false;
+  }
+  if (!ChunkCompressor::Decompress(header_.compress(), payload, body)) {
+    AERROR << "Decompress chunk body fail, file: " << path_
+           << ", position: " << position;
+    return false;
+  }
+  return true;
+}
+
+void RecordFileReader::ReadAhead(int64_t position) {
+  if (chunk_body_positions_.empty()) {
+    for (const auto& single_idx : index_.indexes()) {
+      if (single_idx.type() == SectionType::SECTION_CHUNK_BODY) {
+        chunk_body_positions_.push_back(single_idx.position());
+      }
+    }
+    std::sort(chunk_body_positions_.begin(), chunk_body_positions_.end());
+  }
+  if (chunk_body_positions_.empty()) {
+    // no index, e.g. a record being written, read chunk by chunk
+    return;
+  }
+  if (decompress_pool_ == nullptr) {
+    decompress_pool_.reset(new base::ThreadPool(kReadAheadChunkNum));
+  }
+
+  auto begin = std::upper_bound(chunk_body_positions_.begin(),
+                                chunk_body_positions_.end(), position);
+  auto end = begin + std::min<size_t>(kReadAheadChunkNum,
+                                      chunk_body_positions_.end() - begin);
+  // drop chunks left behind or out of the window after a seek
+  for (auto it = read_ahead_.begin(); it != read_ahead_.end();) {
+    if (it->first <= position || (end != chunk_body_positions_.end() &&
+                                  it->first >= *end)) {
+      it = read_ahead_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  for (auto it = begin; it != end; ++it) {
+    int64_t next = *it;
+    if (read_ahead_.count(next) == 0) {
+      read_ahead_[next] = decompress_pool_->Enqueue(
+          [this, next]() { return LoadChunkBody(next); });
+    }
+  }
+}
+
+bool RecordFileReader::MapFile() {
+  if (mapped_ != nullptr) {
+    return true;
+  }
+  struct stat file_stat;
+  if (fd_ < 0 || fstat(fd_, &file_stat) != 0 || file_stat.st_size <= 0) {
+    AERROR << "Stat file failed, file: " << path_ << ", errno: " << errno;
+    return false;
+  }
+  void* addr = mmap(nullptr, file_stat.st_size, PROT_READ, MAP_SHARED, fd_, 0);
+  if (addr == MAP_FAILED) {
+    AERROR << "Map file failed, file: " << path_ << ", errno: " << errno;
+    return false;
+  }
+  if (madvise(addr, file_stat.st_size, MADV_SEQUENTIAL) != 0) {
+    AWARN << "madvise sequential failed, file: " << path_
+          << ", errno: " << errno;
+  }
+  mapped_ = static_cast<const char*>(addr);
+  mapped_size_ = file_stat.st_size;
+  return true;
+}
+
+bool RecordFileReader::ReadChunkBodyView(int64_t size,
+                                         std::vector<MessageView>* messages) {
+  messages->clear();
+  int64_t position = CurrentPosition();
+  if (mapped_ == nullptr || position < 0 || size < 0 ||
+      size > std::numeric_limits<int>::max() ||
+      static_cast<uint64_t>(position + size) > mapped_size_) {
+    AERROR << "Chunk body out of the mapped file, position: " << position
+           << ", size: " << size << ", file size: " << mapped_size_;
+    return false;
+  }
+  if (!ParseChunkBodyView(mapped_ + position, static_cast<int>(size),
+                          messages)) {
+    AERROR << "Parse chunk body failed, file: " << path_
+           << ", position: " << position;
+    return false;
+  }
+  int64_t next = position + size;
+  if (!SetPosition(next)) {
+    return false;
+  }
+
+  // ask for the following chunks while this one is consumed
+  static const int64_t page_size = sysconf(_SC_PAGESIZE);
+  int64_t begin = next / page_size * page_size;
+  int64_t length = std::min<int64_t>(kMmapReadAheadSize, mapped_size_ - begin);
+  if (length > 0) {
+    madvise(const_cast<char*>(mapped_) + begin, length, MADV_WILLNEED);
+  }
+  return true;
+}
+
 RecordFileReader::~RecordFileReader() {
   Close();
 }
@@ -18,10 +18,14 @@
 #define CYBER_RECORD_FILE_RECORD_FILE_READER_H_
 
 #include <fstream>
+#include <future>
+#include <map>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include <limits>
 #include "google/protobuf/io/coded_stream.h"
@@ -29,6 +33,7 @@
 #include "google/protobuf/message.h"
 #include "google/protobuf/text_format.h"
 
+#include "cyber/base/thread_pool.h"
 #include "cyber/common/log.h"
 #include "cyber/record/file/record_file_base.h"
 #include "cyber/record/file/section.h"
@@ -42,6 +47,15 @@ using google::protobuf::io::CodedInputStream;
 using google::protobuf::io::FileInputStream;
 using google::protobuf::io::ZeroCopyInputStream;
 
+/**
+ * @brief A message of a chunk body which points into the mapped record file.
+ */
+struct MessageView {
+  std::string_view channel_name;
+  std::string_view content;
+  uint64_t time = 0;
+};
+
 class RecordFileReader : public RecordFileBase {
  public:
   RecordFileReader() = default;
@@ -56,13 +70,59 @@ class RecordFileReader : public RecordFileBase {
   bool ReadIndex();
   bool EndOfFile() { return end_of_file_; }
 
+  /**
+   * @brief Map the opened file read only, to read chunk bodies as views.
+   */
+  bool MapFile();
+  bool IsMapped() const { return mapped_ != nullptr; }
+  /**
+   * @brief Parse the uncompressed chunk body at the current position of a
+   * mapped file without copying the message contents.
+   */
+  bool ReadChunkBodyView(int64_t size, std::vector<MessageView>* messages);
+  /**
+   * @brief Read and decompress the chunk body section at position with
+   * pread. The file position is left alone, so it may be called from several
+   * threads at once.
+   */
+  bool ReadChunkBodyAt(int64_t position, proto::ChunkBody* body);
+
  private:
+  using ChunkBodyPtr = std::shared_ptr<proto::ChunkBody>;
+
   bool ReadHeader();
+  template <typename T>
+  bool ParseSection(int64_t size, T* message);
+  bool ReadChunkBody(int64_t size, proto::ChunkBody* body);
+  ChunkBodyPtr LoadChunkBody(int64_t position);
+  void ReadAhead(int64_t position);
   bool end_of_file_ = false;
+
+  // compressed chunk bodies after the one being read are loaded and
+  // decompressed in parallel, keyed by the section position in the index
+  std::unique_ptr<base::ThreadPool> decompress_pool_ = nullptr;
+  std::map<int64_t, std::future<ChunkBodyPtr>> read_ahead_;
+  std::vector<int64_t> chunk_body_positions_;
+
+  const char* mapped_ = nullptr;
+  size_t mapped_size_ = 0;
 };
 
 template <typename T>
 bool RecordFileReader::ReadSection(int64_t size, T* message) {
+  return ParseSection(size, message);
+}
+
+/**
+ * @brief Chunk bodies of a compressed record are decompressed, and taken from
+ * the ones read ahead when they are there.
+ */
+template <>
+bool RecordFileReader::ReadSection<proto::ChunkBody>(int64_t size,
+                                                     proto::ChunkBody* body);
+
+template <typename T>
+bool RecordFileReader::ParseSection(int64_t size, T* message) {
   if (size < std::numeric_limits<int>::min() ||
       size > std::numeric_limits<int>::max()) {
     AERROR << "Size value greater than the range of int value.";
@@ -16,7 +16,10 @@
 
 #include <unistd.h>
 #include <atomic>
+#include <chrono>
+#include <memory>
 #include <string>
+#include <thread>
 
 #include "gflags/gflags.h"
 #include "gtest/gtest.h"
@@ -24,6 +27,7 @@
 #include "cyber/record/file/record_file_base.h"
 #include "cyber/record/file/record_file_reader.h"
 #include "cyber/record/file/record_file_writer.h"
+#include "cyber/record/file/write_budget.h"
 #include "cyber/record/header_builder.h"
 
 namespace apollo {
@@ -308,6 +312,210 @@ TEST(RecordFileTest, TestIndex) {
   }
 }
 
+TEST(RecordFileTest, TestDirectIo) {
+  proto::RecordWriteConf conf;
+  conf.set_direct_io(true);
+  conf.set_io_buffer_size_kb(4);
+  conf.set_io_buffer_num(4);
+  conf.set_sync_interval_mb(1);
+  auto budget = std::make_shared<WriteBudget>(conf);
+  const std::string content(1000, 'x');
+  {
+    RecordFileWriter rfw(conf, budget);
+    ASSERT_TRUE(rfw.Open(kTestFile1));
+    // a chunk every 10 messages
+    Header header = HeaderBuilder::GetHeaderWithChunkParams(0, 9000);
+    header.set_segment_interval(0);
+    header.set_segment_raw_size(0);
+    ASSERT_TRUE(rfw.WriteHeader(header));
+
+    Channel chan1;
+    chan1.set_name(kChan1);
+    chan1.set_message_type(kMsgType);
+    ASSERT_TRUE(rfw.WriteChannel(chan1));
+    for (int i = 1; i <= 2000; ++i) {
+      SingleMessage msg;
+      msg.set_channel_name(kChan1);
+      msg.set_content(content);
+      msg.set_time(i);
+      ASSERT_TRUE(budget->Acquire(kChan1, content.size()));
+      ASSERT_TRUE(rfw.WriteMessage(msg));
+    }
+    rfw.Close();
+    ASSERT_TRUE(rfw.GetHeader().is_complete());
+    ASSERT_EQ(2000, rfw.GetHeader().message_number());
+
+    auto stats = rfw.GetWriteStats();
+    EXPECT_EQ(stats.chunk_num, rfw.GetHeader().chunk_number());
+    EXPECT_GT(stats.io.write_num, 0);
+    EXPECT_GT(stats.sync_num, 1);
+    // every chunk written gave its messages back
+    EXPECT_EQ(stats.budget.used_bytes, 0);
+  }
+
+  RecordFileReader rfr;
+  ASSERT_TRUE(rfr.Open(kTestFile1));
+  ASSERT_TRUE(rfr.GetHeader().is_complete());
+  ASSERT_TRUE(rfr.ReadIndex());
+  rfr.Reset();
+  uint64_t message_number = 0;
+  Section section;
+  while (rfr.ReadSection(&section)) {
+    if (section.type == SectionType::SECTION_CHUNK_BODY) {
+      ChunkBody body;
+      ASSERT_TRUE(rfr.ReadSection<ChunkBody>(section.size, &body));
+      for (const auto& message : body.messages()) {
+        ASSERT_EQ(message.time(), ++message_number);
+        ASSERT_EQ(message.content(), content);
+      }
+    } else if (!rfr.SkipSection(section.size)) {
+      break;
+    }
+  }
+  EXPECT_EQ(2000, message_number);
+  ASSERT_FALSE(remove(kTestFile1));
+}
+
+TEST(RecordFileTest, TestWriteBudget) {
+  proto::RecordWriteConf conf;
+  conf.set_memory_limit_mb(1);
+  conf.set_overflow_policy(proto::RecordWriteConf::DROP);
+  conf.set_block_timeout_ms(10);
+  auto channel_policy = conf.add_channel_policy();
+  channel_policy->set_channel_name(kChan2);
+  channel_policy->set_overflow_policy(proto::RecordWriteConf::BLOCK);
+  WriteBudget budget(conf);
+
+  const uint64_t half = 512 * 1024;
+  ASSERT_TRUE(budget.Acquire(kChan1, half));
+  EXPECT_FALSE(budget.UnderPressure());
+  ASSERT_TRUE(budget.Acquire(kChan1, half));
+  EXPECT_TRUE(budget.UnderPressure());
+
+  // dropped at once
+  EXPECT_FALSE(budget.Acquire(kChan1, 1));
+  // dropped after waiting in vain
+  EXPECT_FALSE(budget.Acquire(kChan2, 1));
+
+  // larger than the whole budget, admitted once nothing else is buffered
+  budget.Release(half);
+  EXPECT_FALSE(budget.Acquire(kChan1, 4 * half));
+  budget.Release(half);
+  EXPECT_TRUE(budget.Acquire(kChan1, 4 * half));
+
+  auto stats = budget.GetStats();
+  EXPECT_EQ(stats.used_bytes, 4 * half);
+  EXPECT_EQ(stats.max_used_bytes, 4 * half);
+  EXPECT_EQ(stats.dropped_num, 3);
+  EXPECT_EQ(stats.dropped_by_channel[kChan1], 2);
+  EXPECT_EQ(stats.dropped_by_channel[kChan2], 1);
+  EXPECT_EQ(stats.blocked_num, 1);
+
+  // a blocked message is admitted as soon as a chunk is written
+  conf.set_block_timeout_ms(5000);
+  WriteBudget blocking_budget(conf);
+  ASSERT_TRUE(blocking_budget.Acquire(kChan2, 2 * half));
+  std::thread release([&blocking_budget, half]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    blocking_budget.Release(half);
+  });
+  EXPECT_TRUE(blocking_budget.Acquire(kChan2, half));
+  release.join();
+  stats = blocking_budget.GetStats();
+  EXPECT_EQ(stats.used_bytes, 2 * half);
+  EXPECT_EQ(stats.blocked_num, 1);
+  EXPECT_EQ(stats.dropped_num, 0);
+
+  // the defaults neither bound nor drop anything
+  WriteBudget default_budget{proto::RecordWriteConf()};
+  ASSERT_TRUE(default_budget.Acquire(kChan1, 4096ULL << 20));
+  EXPECT_TRUE(default_budget.Acquire(kChan1, 4096ULL << 20));
+  EXPECT_FALSE(default_budget.UnderPressure());
+  stats = default_budget.GetStats();
+  EXPECT_EQ(stats.used_bytes, 8192ULL << 20);
+  EXPECT_EQ(stats.blocked_num, 0);
+  EXPECT_EQ(stats.dropped_num, 0);
+}
+
+TEST(RecordFileTest, TestWriteBudgetWhileFlushing) {
+  proto::RecordWriteConf conf;
+  conf.set_memory_limit_mb(1);
+  conf.set_overflow_policy(proto::RecordWriteConf::BLOCK);
+  // long enough for any chunk to be written, a message never admitted fails
+  // the test instead of hanging it
+  conf.set_block_timeout_ms(2000);
+  auto budget = std::make_shared<WriteBudget>(conf);
+  const uint64_t kb = 1024;
+  uint64_t message_number = 0;
+  {
+    RecordFileWriter rfw(conf, budget);
+    ASSERT_TRUE(rfw.Open(kTestFile1));
+    // chunks are only handed over under pressure
+    Header header = HeaderBuilder::GetHeaderWithChunkParams(0, 0);
+    header.set_segment_interval(0);
+    header.set_segment_raw_size(0);
+    ASSERT_TRUE(rfw.WriteHeader(header));
+    Channel chan1;
+    chan1.set_name(kChan1);
+    chan1.set_message_type(kMsgType);
+    ASSERT_TRUE(rfw.WriteChannel(chan1));
+    auto write = [&rfw, &message_number](uint64_t size) {
+      SingleMessage msg;
+      msg.set_channel_name(kChan1);
+      msg.set_content(std::string(size, 'x'));
+      msg.set_time(++message_number);
+      return rfw.WriteMessage(msg);
+    };
+
+    // the first message is handed over under pressure, the second one is
+    // buffered while it may still be in flight and the third one only fits
+    // once the second one is written as well
+    for (int i = 0; i < 20; ++i) {
+      for (uint64_t size : {520 * kb, 400 * kb, 700 * kb}) {
+        ASSERT_TRUE(budget->Acquire(kChan1, size));
+        ASSERT_TRUE(write(size));
+      }
+    }
+
+    // a buffered message below the pressure holds the budget alone, it is
+    // handed over by the message which waits for it
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    ASSERT_TRUE(budget->Acquire(kChan1, 100 * kb));
+    ASSERT_TRUE(write(100 * kb));
+    EXPECT_FALSE(budget->UnderPressure());
+    auto start = std::chrono::steady_clock::now();
+    ASSERT_TRUE(budget->Acquire(kChan1, 1000 * kb,
+                                [&rfw]() { rfw.HandOffChunk(); }));
+    EXPECT_LT(std::chrono::steady_clock::now() - start,
+              std::chrono::milliseconds(1000));
+    ASSERT_TRUE(write(1000 * kb));
+
+    rfw.Close();
+    ASSERT_EQ(message_number, rfw.GetHeader().message_number());
+    EXPECT_EQ(budget->GetStats().used_bytes, 0);
+    EXPECT_EQ(budget->GetStats().dropped_num, 0);
+  }
+
+  RecordFileReader rfr;
+  ASSERT_TRUE(rfr.Open(kTestFile1));
+  uint64_t read_number = 0;
+  Section section;
+  while (rfr.ReadSection(&section)) {
+    if (section.type == SectionType::SECTION_CHUNK_BODY) {
+      ChunkBody body;
+      ASSERT_TRUE(rfr.ReadSection<ChunkBody>(section.size, &body));
+      for (const auto& message : body.messages()) {
+        ASSERT_EQ(message.time(), ++read_number);
+      }
+    } else if (section.type == SectionType::SECTION_INDEX ||
+               !rfr.SkipSection(section.size)) {
+      break;
+    }
+  }
+  EXPECT_EQ(message_number, read_number);
+  ASSERT_FALSE(remove(kTestFile1));
+}
+
 }  // namespace record
 }  // namespace cyber
 }  // namespace apollo
@@ -17,8 +17,13 @@
 #include "cyber/record/file/record_file_writer.h"
 
 #include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <unordered_set>
 
 #include "cyber/common/file.h"
+#include "cyber/record/file/chunk_compressor.h"
 #include "cyber/time/time.h"
 
 namespace apollo {
@@ -31,12 +36,23 @@ using apollo::cyber::proto::ChunkBody;
 using apollo::cyber::proto::ChunkBodyCache;
 using apollo::cyber::proto::ChunkHeader;
 using apollo::cyber::proto::ChunkHeaderCache;
+using apollo::cyber::proto::CompressType;
 using apollo::cyber::proto::Header;
 using apollo::cyber::proto::SectionType;
 using apollo::cyber::proto::SingleIndex;
 
+namespace {
+// chunks being compressed at the same time, also bounds the memory held by
+// chunks waiting to be written
+constexpr size_t kMaxCompressTaskNum = 4;
+}  // namespace
+
 RecordFileWriter::RecordFileWriter() : is_writing_(false) {}
 
+RecordFileWriter::RecordFileWriter(const proto::RecordWriteConf& conf,
+                                   std::shared_ptr<WriteBudget> budget)
+    : conf_(conf), budget_(budget), is_writing_(false) {}
+
 RecordFileWriter::~RecordFileWriter() { Close(); }
 
 bool RecordFileWriter::Open(const std::string& path) {
@@ -45,13 +61,31 @@ bool RecordFileWriter::Open(const std::string& path) {
   if (::apollo::cyber::common::PathExists(path_)) {
     AWARN << "File exist and overwrite, file: " << path_;
   }
-  fd_ = open(path_.data(), O_CREAT | O_WRONLY,
-             S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);
+  int flags = O_CREAT | O_WRONLY;
+  mode_t mode = S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH;
+  if (conf_.direct_io()) {
+    fd_ = open(path_.data(), flags | O_DIRECT, mode);
+    if (fd_ < 0 && errno == EINVAL) {
+      AWARN << "O_DIRECT is not supported by the file system, write through "
+               "the page cache, file: "
+            << path_;
+    }
+  }
+  if (fd_ < 0) {
+    fd_ = open(path_.data(), flags, mode);
+  }
   if (fd_ < 0) {
     AERROR << "Open file failed, file: " << path_ << ", fd: " << fd_
            << ", errno: " << errno;
     return false;
   }
+  if (conf_.direct_io()) {
+    direct_writer_.reset(new DirectFileWriter(fd_, conf_));
+    if (!direct_writer_->Init()) {
+      AERROR << "Init direct writer failed, file: " << path_;
+      return false;
+    }
+  }
   chunk_active_.reset(new Chunk());
   chunk_flush_.reset(new Chunk());
   is_writing_ = true;
@@ -100,6 +134,27 @@ void RecordFileWriter::Close() {
       flush_thread_->join();
       flush_thread_ = nullptr;
     }
+    compress_pool_ = nullptr;
+
+    if (direct_writer_ != nullptr) {
+      // the index and the header are written through the page cache, the
+      // header is not aligned
+      if (!direct_writer_->Close()) {
+        AERROR << "Write chunks failed, file: " << path_;
+      }
+      int64_t end = direct_writer_->ByteCount();
+      {
+        std::lock_guard<std::mutex> lock(stats_mutex_);
+        stats_.io = direct_writer_->GetStats();
+        direct_writer_ = nullptr;
+      }
+      int flags = fcntl(fd_, F_GETFL);
+      if (flags < 0 || fcntl(fd_, F_SETFL, flags & ~O_DIRECT) < 0) {
+        AERROR << "Clear O_DIRECT failed, file: " << path_
+               << ", errno: " << errno;
+      }
+      SetPosition(end);
+    }
 
     if (!WriteIndex()) {
       AERROR << "Write index section failed, file: " << path_;
@@ -110,6 +165,9 @@ void RecordFileWriter::Close() {
       AERROR << "Overwrite header section failed, file: " << path_;
     }
 
+    if (conf_.direct_io() || conf_.sync_interval_mb() > 0) {
+      Sync();
+    }
     if (close(fd_) < 0) {
       AERROR << "Close file failed, file: " << path_ << ", fd: " << fd_
              << ", errno: " << errno;
@@ -117,9 +175,25 @@ void RecordFileWriter::Close() {
   }
 }
 
+int64_t RecordFileWriter::CurrentPosition() {
+  if (direct_writer_ != nullptr) {
+    return direct_writer_->ByteCount();
+  }
+  return RecordFileBase::CurrentPosition();
+}
+
 bool RecordFileWriter::WriteHeader(const Header& header) {
   std::lock_guard<std::mutex> lock(mutex_);
   header_ = header;
+  if (!ChunkCompressor::IsSupported(header_.compress())) {
+    AWARN << "Compress type " << header_.compress()
+          << " is not supported, write chunks uncompressed.";
+    header_.set_compress(CompressType::COMPRESS_NONE);
+  }
+  if (header_.compress() != CompressType::COMPRESS_NONE &&
+      compress_pool_ == nullptr) {
+    compress_pool_.reset(new base::ThreadPool(kMaxCompressTaskNum));
+  }
   if (!WriteSection<Header>(header_)) {
     AERROR << "Write header section fail";
     return false;
@@ -169,7 +243,8 @@ bool RecordFileWriter::WriteChannel(const Channel& channel) {
 }
 
 bool RecordFileWriter::WriteChunk(const ChunkHeader& chunk_header,
-                                  const ChunkBody& chunk_body) {
+                                  const ChunkBody& chunk_body,
+                                  const std::string* compressed_body) {
   std::lock_guard<std::mutex> lock(mutex_);
   uint64_t pos = CurrentPosition();
   if (!WriteSection<ChunkHeader>(chunk_header)) {
@@ -184,10 +259,20 @@ bool RecordFileWriter::WriteChunk(const ChunkHeader& chunk_header,
   chunk_header_cache->set_end_time(chunk_header.end_time());
   chunk_header_cache->set_message_number(chunk_header.message_number());
   chunk_header_cache->set_raw_size(chunk_header.raw_size());
+  std::unordered_set<std::string> channel_names;
+  for (const auto& message : chunk_body.messages()) {
+    if (channel_names.insert(message.channel_name()).second) {
+      chunk_header_cache->add_channel_names(message.channel_name());
+    }
+  }
   single_index->set_allocated_chunk_header_cache(chunk_header_cache);
 
   pos = CurrentPosition();
-  if (!WriteSection<ChunkBody>(chunk_body)) {
+  bool body_written =
+      compressed_body == nullptr
+          ? WriteSection<ChunkBody>(chunk_body)
+          : WriteRawSection(SectionType::SECTION_CHUNK_BODY, *compressed_body);
+  if (!body_written) {
     AERROR << "Write chunk body fail";
     return false;
   }
@@ -207,8 +292,42 @@ bool RecordFileWriter::WriteChunk(const ChunkHeader& chunk_header,
   return true;
 }
 
+bool RecordFileWriter::WriteRawSection(SectionType type,
+                                       const std::string& payload) {
+  Section section;
+  /// zero out whole struct even if padded
+  memset(&section, 0, sizeof(section));
+  section = {type, static_cast<int64_t>(payload.size())};
+  if (!WriteBytes(&section, sizeof(section)) ||
+      !WriteBytes(payload.data(), payload.size())) {
+    return false;
+  }
+  header_.set_size(CurrentPosition());
+  return true;
+}
+
+bool RecordFileWriter::WriteBytes(const void* data, size_t size) {
+  if (direct_writer_ != nullptr) {
+    if (!direct_writer_->Write(data, size)) {
+      AERROR << "Write direct writer failed, fd: " << fd_;
+      return false;
+    }
+    return true;
+  }
+  auto ptr = static_cast<const char*>(data);
+  size_t written = 0;
+  while (written < size) {
+    ssize_t count = write(fd_, ptr + written, size - written);
+    if (count < 0) {
+      AERROR << "Write fd failed, fd: " << fd_ << ", errno: " << errno;
+      return false;
+    }
+    written += count;
+  }
+  return true;
+}
+
 bool RecordFileWriter::WriteMessage(const proto::SingleMessage& message) {
-  chunk_active_->add(message);
   auto it = channel_message_number_map_.find(message.channel_name());
   if (it != channel_message_number_map_.end()) {
     it->second++;
@@ -216,6 +335,9 @@ bool RecordFileWriter::WriteMessage(const proto::SingleMessage& message) {
     channel_message_number_map_.insert(
         std::make_pair(message.channel_name(), 1));
   }
+  // the flush thread may take the active chunk on its own
+  std::unique_lock<std::mutex> flush_lock(flush_mutex_);
+  chunk_active_->add(message);
   bool need_flush = false;
   if (header_.chunk_interval() > 0 &&
       message.time() - chunk_active_->header_.begin_time() >
@@ -226,35 +348,179 @@ bool RecordFileWriter::WriteMessage(const proto::SingleMessage& message) {
       chunk_active_->header_.raw_size() > header_.chunk_raw_size()) {
     need_flush = true;
   }
-  if (!need_flush) {
-    return true;
+  // do not sit on buffered messages while others wait for the memory
+  if (budget_ != nullptr && budget_->UnderPressure()) {
+    need_flush = true;
   }
-  {
-    std::unique_lock<std::mutex> flush_lock(flush_mutex_);
+  if (need_flush) {
+    HandOffActiveChunk();
+  }
+  return true;
+}
+
+void RecordFileWriter::HandOffChunk() {
+  std::unique_lock<std::mutex> flush_lock(flush_mutex_);
+  if (!chunk_active_->empty()) {
+    HandOffActiveChunk();
+  }
+}
+
+void RecordFileWriter::HandOffActiveChunk() {
+  if (chunk_flush_->empty()) {
     chunk_flush_.swap(chunk_active_);
     flush_cv_.notify_one();
+  } else {
+    // the flush thread has not taken the last one, it takes this one as
+    // soon as it is done, the budget may be held by nothing else
+    hand_off_ = true;
   }
-  return true;
 }
 
 void RecordFileWriter::Flush() {
+  std::unique_ptr<Chunk> chunk(new Chunk());
   while (is_writing_) {
-    std::unique_lock<std::mutex> flush_lock(flush_mutex_);
-    flush_cv_.wait(flush_lock,
-                   [this] { return !chunk_flush_->empty() || !is_writing_; });
-    if (!is_writing_) {
-      break;
+    {
+      std::unique_lock<std::mutex> flush_lock(flush_mutex_);
+      auto has_work = [this] {
+        return !chunk_flush_->empty() || !is_writing_ ||
+               (hand_off_ && !chunk_active_->empty());
+      };
+      if (compress_tasks_.empty()) {
+        flush_cv_.wait(flush_lock, has_work);
+      } else {
+        // wake up now and then to write the chunks compressed meanwhile
+        flush_cv_.wait_for(flush_lock, std::chrono::milliseconds(10),
+                           has_work);
+      }
+      if (!is_writing_) {
+        break;
+      }
+      if (!chunk_flush_->empty()) {
+        in_writing_ = true;
+        // take the chunk out, the writer can hand over the next one while
+        // this one is compressed and written
+        chunk.swap(chunk_flush_);
+      } else if (hand_off_ && !chunk_active_->empty()) {
+        in_writing_ = true;
+        hand_off_ = false;
+        chunk.swap(chunk_active_);
+      }
+    }
+    if (!chunk->empty()) {
+      if (compress_pool_ == nullptr) {
+        if (!WriteChunk(chunk->header_, *(chunk->body_.get()))) {
+          AERROR << "Write chunk fail.";
+        }
+        OnChunkDone(*chunk);
+        chunk->clear();
+      } else {
+        CompressChunk(std::move(chunk));
+        chunk.reset(new Chunk());
+      }
+      in_writing_ = false;
     }
-    if (chunk_flush_->empty()) {
+    WriteCompressedChunks(false);
+  }
+  WriteCompressedChunks(true);
+}
+
+void RecordFileWriter::CompressChunk(std::unique_ptr<Chunk> chunk) {
+  auto task = std::make_shared<CompressTask>();
+  task->chunk = std::move(chunk);
+  CompressType type = header_.compress();
+  CompressTask* raw_task = task.get();
+  task->result = compress_pool_->Enqueue([raw_task, type]() {
+    return ChunkCompressor::Compress(type, *(raw_task->chunk->body_),
+                                     &raw_task->payload);
+  });
+  compress_tasks_.push_back(task);
+}
+
+void RecordFileWriter::WriteCompressedChunks(bool wait_all) {
+  while (!compress_tasks_.empty()) {
+    auto& task = compress_tasks_.front();
+    if (!task->result.valid()) {
+      AERROR << "Compress pool is stopped, drop chunk.";
+      OnChunkDone(*task->chunk);
+      compress_tasks_.pop_front();
       continue;
     }
-    in_writing_ = true;
-    if (!WriteChunk(chunk_flush_->header_, *(chunk_flush_->body_.get()))) {
+    bool must_wait = wait_all || compress_tasks_.size() > kMaxCompressTaskNum;
+    if (!must_wait && task->result.wait_for(std::chrono::seconds(0)) !=
+                          std::future_status::ready) {
+      break;
+    }
+    const auto& chunk = task->chunk;
+    if (!task->result.get()) {
+      AERROR << "Compress chunk fail, drop " << chunk->header_.message_number()
+             << " messages.";
+    } else if (!WriteChunk(chunk->header_, *(chunk->body_), &task->payload)) {
       AERROR << "Write chunk fail.";
     }
-    in_writing_ = false;
-    chunk_flush_->clear();
+    OnChunkDone(*chunk);
+    compress_tasks_.pop_front();
+  }
+}
+
+void RecordFileWriter::OnChunkDone(const Chunk& chunk) {
+  if (budget_ != nullptr) {
+    budget_->Release(chunk.header_.raw_size());
+  }
+  uint64_t position = 0;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    position = static_cast<uint64_t>(CurrentPosition());
+  }
+  uint64_t written = 0;
+  {
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    written = position - std::min(position, stats_.bytes_written);
+    stats_.bytes_written = position;
+    ++stats_.chunk_num;
+  }
+  // the direct writer syncs what its threads have written on its own
+  if (direct_writer_ != nullptr) {
+    return;
+  }
+  unsynced_bytes_ += written;
+  if (conf_.sync_interval_mb() > 0 &&
+      unsynced_bytes_ >= (static_cast<uint64_t>(conf_.sync_interval_mb())
+                          << 20)) {
+    Sync();
+  }
+}
+
+void RecordFileWriter::Sync() {
+  auto start = std::chrono::steady_clock::now();
+  if (fdatasync(fd_) != 0) {
+    AERROR << "fdatasync failed, file: " << path_ << ", errno: " << errno;
+  }
+  uint64_t sync_us = std::chrono::duration_cast<std::chrono::microseconds>(
+                         std::chrono::steady_clock::now() - start)
+                         .count();
+  unsynced_bytes_ = 0;
+  std::lock_guard<std::mutex> lock(stats_mutex_);
+  ++stats_.sync_num;
+  stats_.sync_time_us += sync_us;
+  stats_.max_sync_us = std::max(stats_.max_sync_us, sync_us);
+}
+
+RecordWriteStats RecordFileWriter::GetWriteStats() {
+  RecordWriteStats stats;
+  {
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    stats = stats_;
+    if (direct_writer_ != nullptr) {
+      stats.io = direct_writer_->GetStats();
+    }
+  }
+  stats.sync_num += stats.io.sync_num;
+  stats.sync_time_us += stats.io.sync_time_us;
+  stats.max_sync_us = std::max(stats.max_sync_us, stats.io.max_sync_us);
+  if (budget_ != nullptr) {
+    stats.budget = budget_->GetStats();
   }
+  return stats;
 }
 
 uint64_t RecordFileWriter::GetMessageNumber(
@@ -18,7 +18,9 @@
 #define CYBER_RECORD_FILE_RECORD_FILE_WRITER_H_
 
 #include <condition_variable>
+#include <deque>
 #include <fstream>
+#include <future>
 #include <memory>
 #include <string>
 #include <thread>
@@ -30,9 +32,14 @@
 #include "google/protobuf/message.h"
 #include "google/protobuf/text_format.h"
 
+#include "cyber/proto/record_conf.pb.h"
+
+#include "cyber/base/thread_pool.h"
 #include "cyber/common/log.h"
+#include "cyber/record/file/direct_file_writer.h"
 #include "cyber/record/file/record_file_base.h"
 #include "cyber/record/file/section.h"
+#include "cyber/record/file/write_budget.h"
 #include "cyber/time/time.h"
 
 namespace apollo {
@@ -74,24 +81,71 @@ struct Chunk {
   std::unique_ptr<proto::ChunkBody> body_ = nullptr;
 };
 
+struct RecordWriteStats {
+  uint64_t bytes_written = 0;
+  uint64_t chunk_num = 0;
+  uint64_t sync_num = 0;
+  uint64_t sync_time_us = 0;
+  uint64_t max_sync_us = 0;
+  // the aligned buffers and writer threads of direct_io
+  DirectFileWriter::Stats io;
+  // messages recorded but not written yet, blocked and dropped ones
+  WriteBudget::Stats budget;
+};
+
 class RecordFileWriter : public RecordFileBase {
  public:
   RecordFileWriter();
+  /**
+   * @brief Chunks given back to the budget once written, the memory is not
+   * bounded without it.
+   */
+  explicit RecordFileWriter(const proto::RecordWriteConf& conf,
+                            std::shared_ptr<WriteBudget> budget = nullptr);
   virtual ~RecordFileWriter();
   bool Open(const std::string& path) override;
   void Close() override;
+  int64_t CurrentPosition() override;
   bool WriteHeader(const proto::Header& header);
   bool WriteChannel(const proto::Channel& channel);
   bool WriteMessage(const proto::SingleMessage& message);
+  /**
+   * @brief Hand the buffered messages to the flush thread now, or as soon as
+   * it is done with the chunk it holds.
+   */
+  void HandOffChunk();
   uint64_t GetMessageNumber(const std::string& channel_name) const;
+  RecordWriteStats GetWriteStats();
 
  private:
+  // a chunk handed to the compress pool, written in submission order
+  struct CompressTask {
+    std::shared_ptr<Chunk> chunk;
+    std::string payload;
+    std::future<bool> result;
+  };
+
   bool WriteChunk(const proto::ChunkHeader& chunk_header,
-                  const proto::ChunkBody& chunk_body);
+                  const proto::ChunkBody& chunk_body,
+                  const std::string* compressed_body = nullptr);
   template <typename T>
   bool WriteSection(const T& message);
+  bool WriteRawSection(proto::SectionType type, const std::string& payload);
+  bool WriteBytes(const void* data, size_t size);
   bool WriteIndex();
   void Flush();
+  // with flush_mutex_ held
+  void HandOffActiveChunk();
+  void CompressChunk(std::unique_ptr<Chunk> chunk);
+  void WriteCompressedChunks(bool wait_all);
+  void OnChunkDone(const Chunk& chunk);
+  void Sync();
+  proto::RecordWriteConf conf_;
+  std::shared_ptr<WriteBudget> budget_ = nullptr;
+  std::unique_ptr<DirectFileWriter> direct_writer_ = nullptr;
+  std::mutex stats_mutex_;
+  RecordWriteStats stats_;
+  uint64_t unsynced_bytes_ = 0;
   std::atomic_bool is_writing_;
   std::atomic_bool in_writing_{false};
   std::unique_ptr<Chunk> chunk_active_ = nullptr;
@@ -99,7 +153,11 @@ class RecordFileWriter : public RecordFileBase {
   std::shared_ptr<std::thread> flush_thread_ = nullptr;
   std::mutex flush_mutex_;
   std::condition_variable flush_cv_;
+  // the active chunk waits for the flush thread, guarded by flush_mutex_
+  bool hand_off_ = false;
   std::unordered_map<std::string, uint64_t> channel_message_number_map_;
+  std::unique_ptr<base::ThreadPool> compress_pool_ = nullptr;
+  std::deque<std::shared_ptr<CompressTask>> compress_tasks_;
 };
 
 template <typename T>
@@ -127,32 +185,22 @@ bool RecordFileWriter::WriteSection(const T& message) {
   /// zero out whole struct even if padded
   memset(&section, 0, sizeof(section));
   section = {type, static_cast<int64_t>(message.ByteSizeLong())};
-  ssize_t count = write(fd_, &section, sizeof(section));
-  if (count < 0) {
-    AERROR << "Write fd failed, fd: " << fd_ << ", errno: " << errno;
-    return false;
-  }
-  if (count != sizeof(section)) {
-    AERROR << "Write fd failed, fd: " << fd_
-           << ", expect count: " << sizeof(section)
-           << ", actual count: " << count;
+  if (!WriteBytes(&section, sizeof(section))) {
     return false;
   }
-  {
+  if (direct_writer_ != nullptr) {
+    // serialized straight into the aligned buffers
+    if (!message.SerializeToZeroCopyStream(direct_writer_.get())) {
+      AERROR << "Write section to direct writer failed, fd: " << fd_;
+      return false;
+    }
+  } else {
     google::protobuf::io::FileOutputStream raw_output(fd_);
     message.SerializeToZeroCopyStream(&raw_output);
   }
   if (type == proto::SectionType::SECTION_HEADER) {
     static char blank[HEADER_LENGTH] = {'0'};
-    count = write(fd_, &blank, HEADER_LENGTH - message.ByteSizeLong());
-    if (count < 0) {
-      AERROR << "Write fd failed, fd: " << fd_ << ", errno: " << errno;
-      return false;
-    }
-    if (static_cast<size_t>(count) != HEADER_LENGTH - message.ByteSizeLong()) {
-      AERROR << "Write fd failed, fd: " << fd_
-             << ", expect count: " << sizeof(section)
-             << ", actual count: " << count;
+    if (!WriteBytes(&blank, HEADER_LENGTH - message.ByteSizeLong())) {
       return false;
     }
   }
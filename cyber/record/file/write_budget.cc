@@ -0,0 +1,105 @@
+/******************************************************************************
+ * Copyright 2024 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/record/file/write_budget.h"
+
+#include <algorithm>
+#include <chrono>
+
+namespace apollo {
+namespace cyber {
+namespace record {
+
+using apollo::cyber::proto::RecordWriteConf;
+
+WriteBudget::WriteBudget(const RecordWriteConf& conf)
+    : limit_bytes_(static_cast<uint64_t>(conf.memory_limit_mb()) << 20),
+      default_policy_(conf.overflow_policy()),
+      block_timeout_ms_(conf.block_timeout_ms()) {
+  for (const auto& channel_policy : conf.channel_policy()) {
+    channel_policies_[channel_policy.channel_name()] =
+        channel_policy.overflow_policy();
+  }
+}
+
+RecordWriteConf::OverflowPolicy WriteBudget::PolicyOf(
+    const std::string& channel_name) const {
+  auto it = channel_policies_.find(channel_name);
+  return it == channel_policies_.end() ? default_policy_ : it->second;
+}
+
+bool WriteBudget::Acquire(const std::string& channel_name, uint64_t size,
+                          const std::function<void()>& on_full) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  auto fits = [this, size] {
+    return limit_bytes_ == 0 || stats_.used_bytes == 0 ||
+           stats_.used_bytes + size <= limit_bytes_;
+  };
+  if (!fits() && on_full) {
+    // not under the lock, the flush thread releases while it is handed over
+    lock.unlock();
+    on_full();
+    lock.lock();
+  }
+  if (!fits()) {
+    bool admitted = false;
+    if (PolicyOf(channel_name) == RecordWriteConf::BLOCK) {
+      auto start = std::chrono::steady_clock::now();
+      if (block_timeout_ms_ == 0) {
+        cv_.wait(lock, fits);
+        admitted = true;
+      } else {
+        admitted = cv_.wait_for(
+            lock, std::chrono::milliseconds(block_timeout_ms_), fits);
+      }
+      ++stats_.blocked_num;
+      stats_.blocked_time_us +=
+          std::chrono::duration_cast<std::chrono::microseconds>(
+              std::chrono::steady_clock::now() - start)
+              .count();
+    }
+    if (!admitted) {
+      ++stats_.dropped_num;
+      ++stats_.dropped_by_channel[channel_name];
+      return false;
+    }
+  }
+  stats_.used_bytes += size;
+  stats_.max_used_bytes = std::max(stats_.max_used_bytes, stats_.used_bytes);
+  return true;
+}
+
+void WriteBudget::Release(uint64_t size) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats_.used_bytes -= std::min(size, stats_.used_bytes);
+  }
+  cv_.notify_all();
+}
+
+bool WriteBudget::UnderPressure() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return limit_bytes_ > 0 && stats_.used_bytes > limit_bytes_ / 2;
+}
+
+WriteBudget::Stats WriteBudget::GetStats() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return stats_;
+}
+
+}  // namespace record
+}  // namespace cyber
+}  // namespace apollo
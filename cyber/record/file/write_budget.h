@@ -0,0 +1,94 @@
+/******************************************************************************
+ * Copyright 2024 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_RECORD_FILE_WRITE_BUDGET_H_
+#define CYBER_RECORD_FILE_WRITE_BUDGET_H_
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "cyber/proto/record_conf.pb.h"
+
+namespace apollo {
+namespace cyber {
+namespace record {
+
+/**
+ * @class WriteBudget
+ * @brief Bounds the memory held by recorded messages which are not written
+ * yet. A message takes its size out of the budget before it is buffered and
+ * the file writer gives it back once the chunk holding it is written. When
+ * the budget is used up the overflow policy of the channel decides whether
+ * the message waits or is dropped.
+ */
+class WriteBudget {
+ public:
+  struct Stats {
+    uint64_t used_bytes = 0;
+    uint64_t max_used_bytes = 0;
+    uint64_t blocked_num = 0;
+    uint64_t blocked_time_us = 0;
+    uint64_t dropped_num = 0;
+    std::unordered_map<std::string, uint64_t> dropped_by_channel;
+  };
+
+  explicit WriteBudget(const proto::RecordWriteConf& conf);
+
+  /**
+   * @brief Take size bytes out of the budget, false if the message is dropped.
+   * A message larger than the whole budget is admitted once nothing else is
+   * buffered, so it can never wait forever. Without a memory limit every
+   * message is admitted at once. on_full is called before the message waits
+   * or is dropped, it should hand the buffered messages to the flush thread,
+   * they may be all that holds the budget.
+   */
+  bool Acquire(const std::string& channel_name, uint64_t size,
+               const std::function<void()>& on_full = nullptr);
+
+  void Release(uint64_t size);
+
+  /**
+   * @brief More than half of the budget is used, buffered chunks should be
+   * handed to the flush thread early.
+   */
+  bool UnderPressure();
+
+  Stats GetStats();
+
+ private:
+  proto::RecordWriteConf::OverflowPolicy PolicyOf(
+      const std::string& channel_name) const;
+
+  uint64_t limit_bytes_;
+  proto::RecordWriteConf::OverflowPolicy default_policy_;
+  std::unordered_map<std::string, proto::RecordWriteConf::OverflowPolicy>
+      channel_policies_;
+  uint64_t block_timeout_ms_;
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  Stats stats_;
+};
+
+}  // namespace record
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_RECORD_FILE_WRITE_BUDGET_H_
@@ -19,6 +19,7 @@
 
 #include <cstdint>
 #include <string>
+#include <string_view>
 
 namespace apollo {
 namespace cyber {
@@ -62,6 +63,22 @@ struct RecordMessage {
    * @brief The time (nanosecond) of the message.
    */
   uint64_t time;
+
+  /**
+   * @brief The content in the mapped record file. Only set by readers in mmap
+   * mode, which leave content empty. Valid as long as the reader is alive.
+   */
+  std::string_view content_view;
+
+  /**
+   * @brief Get the content, either the copied or the mapped one.
+   *
+   * @return The content.
+   */
+  std::string_view GetContent() const {
+    return content_view.data() != nullptr ? content_view
+                                          : std::string_view(content);
+  }
 };
 
 }  // namespace record
@@ -16,6 +16,7 @@
 
 #include "cyber/record/record_reader.h"
 
+#include <algorithm>
 #include <utility>
 
 namespace apollo {
@@ -29,7 +30,7 @@ using apollo::cyber::proto::SectionType;
 
 RecordReader::~RecordReader() {}
 
-RecordReader::RecordReader(const std::string& file) {
+RecordReader::RecordReader(const std::string& file, bool use_mmap) {
   file_reader_.reset(new RecordFileReader());
   if (!file_reader_->Open(file)) {
     AERROR << "Failed to open record file: " << file;
@@ -38,6 +39,13 @@ RecordReader::RecordReader(const std::string& file) {
   chunk_.reset(new ChunkBody());
   is_valid_ = true;
   header_ = file_reader_->GetHeader();
+  if (use_mmap) {
+    if (header_.compress() != proto::CompressType::COMPRESS_NONE) {
+      AWARN << "Record is compressed, read without mmap, file: " << file;
+    } else {
+      use_mmap_ = file_reader_->MapFile();
+    }
+  }
   if (file_reader_->ReadIndex()) {
     index_ = file_reader_->GetIndex();
     for (int i = 0; i < index_.indexes_size(); ++i) {
@@ -53,15 +61,112 @@ RecordReader::RecordReader(const std::string& file) {
       channel_info_.insert(
           std::make_pair(channel_cache->name(), *channel_cache));
     }
+    BuildChunkIndex();
   }
   file_reader_->Reset();
 }
 
+void RecordReader::BuildChunkIndex() {
+  bool has_channel_names = true;
+  for (int i = 0; i < index_.indexes_size(); ++i) {
+    const auto& single_idx = index_.indexes(i);
+    if (single_idx.type() != SectionType::SECTION_CHUNK_HEADER ||
+        !single_idx.has_chunk_header_cache()) {
+      continue;
+    }
+    const auto& cache = single_idx.chunk_header_cache();
+    ChunkIndex chunk;
+    chunk.position = single_idx.position();
+    chunk.begin_time = cache.begin_time();
+    chunk.end_time = cache.end_time();
+    chunk.max_end_time = chunk.end_time;
+    if (!chunk_index_.empty()) {
+      chunk.max_end_time =
+          std::max(chunk.max_end_time, chunk_index_.back().max_end_time);
+    }
+    chunk_index_.push_back(chunk);
+
+    // records written before the per-channel index have no channel names
+    if (cache.channel_names_size() == 0) {
+      has_channel_names = false;
+    }
+    if (!has_channel_names) {
+      continue;
+    }
+    for (const auto& name : cache.channel_names()) {
+      auto& chunks = channel_chunk_index_[name];
+      chunk.max_end_time = chunk.end_time;
+      if (!chunks.empty()) {
+        chunk.max_end_time =
+            std::max(chunk.max_end_time, chunks.back().max_end_time);
+      }
+      chunks.push_back(chunk);
+    }
+  }
+  if (!has_channel_names) {
+    channel_chunk_index_.clear();
+  }
+  ADEBUG << "Chunk index size: " << chunk_index_.size()
+         << ", indexed channels: " << channel_chunk_index_.size();
+}
+
 void RecordReader::Reset() {
   file_reader_->Reset();
   reach_end_ = false;
   message_index_ = 0;
+  seek_time_ = 0;
   chunk_.reset(new ChunkBody());
+  chunk_views_.clear();
+}
+
+bool RecordReader::Seek(uint64_t timestamp) {
+  if (!is_valid_) {
+    return false;
+  }
+  return SeekChunk(chunk_index_, timestamp);
+}
+
+bool RecordReader::Seek(uint64_t timestamp, const std::string& channel_name) {
+  if (!is_valid_) {
+    return false;
+  }
+  if (channel_chunk_index_.empty()) {
+    return SeekChunk(chunk_index_, timestamp);
+  }
+  auto search = channel_chunk_index_.find(channel_name);
+  if (search == channel_chunk_index_.end()) {
+    AWARN << "No message of channel " << channel_name << " in record "
+          << file_reader_->GetPath();
+    return false;
+  }
+  return SeekChunk(search->second, timestamp);
+}
+
+bool RecordReader::SeekChunk(const ChunkIndexList& chunks, uint64_t timestamp) {
+  if (chunks.empty()) {
+    AERROR << "No chunk index in record " << file_reader_->GetPath();
+    return false;
+  }
+  message_index_ = 0;
+  chunk_.reset(new ChunkBody());
+  chunk_views_.clear();
+  seek_time_ = timestamp;
+  auto it = std::lower_bound(chunks.begin(), chunks.end(), timestamp,
+                             [](const ChunkIndex& chunk, uint64_t time) {
+                               return chunk.max_end_time < time;
+                             });
+  if (it == chunks.end()) {
+    reach_end_ = true;
+    return true;
+  }
+  if (!file_reader_->SetPosition(static_cast<int64_t>(it->position))) {
+    AERROR << "Failed to seek to chunk at position " << it->position
+           << ", file: " << file_reader_->GetPath();
+    Reset();
+    return false;
+  }
+  reach_end_ = false;
+  return true;
 }
 
 std::set<std::string> RecordReader::GetChannelList() const {
@@ -78,13 +183,16 @@ bool RecordReader::ReadMessage(RecordMessage* message, uint64_t begin_time,
     return false;
   }
 
+  begin_time = std::max(begin_time, seek_time_);
   if (begin_time > header_.end_time() || end_time < header_.begin_time()) {
     return false;
   }
 
-  while (message_index_ < chunk_->messages_size()) {
-    const auto& next_message = chunk_->messages(message_index_);
-    uint64_t time = next_message.time();
+  int message_num = use_mmap_ ? static_cast<int>(chunk_views_.size())
+                              : chunk_->messages_size();
+  while (message_index_ < message_num) {
+    uint64_t time = use_mmap_ ? chunk_views_[message_index_].time
+                              : chunk_->messages(message_index_).time();
     if (time > end_time) {
       return false;
     }
@@ -93,8 +201,17 @@ bool RecordReader::ReadMessage(RecordMessage* message, uint64_t begin_time,
       continue;
     }
 
-    message->channel_name = next_message.channel_name();
-    message->content = next_message.content();
+    if (use_mmap_) {
+      const auto& next_message = chunk_views_[message_index_ - 1];
+      message->channel_name.assign(next_message.channel_name);
+      message->content.clear();
+      message->content_view = next_message.content;
+    } else {
+      const auto& next_message = chunk_->messages(message_index_ - 1);
+      message->channel_name = next_message.channel_name();
+      message->content = next_message.content();
+      message->content_view = std::string_view();
+    }
     message->time = time;
     return true;
   }
@@ -154,6 +271,13 @@ bool RecordReader::ReadNextChunk(uint64_t begin_time, uint64_t end_time) {
           break;
         }
 
+        if (use_mmap_) {
+          if (!file_reader_->ReadChunkBodyView(section.size, &chunk_views_)) {
+            AERROR << "Failed to read chunk body section.";
+            return false;
+          }
+          return true;
+        }
         chunk_.reset(new ChunkBody());
         if (!file_reader_->ReadSection<ChunkBody>(section.size, chunk_.get())) {
           AERROR << "Failed to read chunk body section.";
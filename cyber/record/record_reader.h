@@ -22,6 +22,7 @@
 #include <set>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "cyber/proto/record.pb.h"
 
@@ -45,8 +46,11 @@ class RecordReader : public RecordBase {
    * @brief The constructor with record file path as parameter.
    *
    * @param file
+   * @param use_mmap map the file and hand out message contents as views into
+   * the mapping through RecordMessage::content_view instead of copies.
+   * Compressed records are always read by copy.
    */
-  explicit RecordReader(const std::string& file);
+  explicit RecordReader(const std::string& file, bool use_mmap = false);
 
   /**
    * @brief The destructor.
@@ -77,6 +81,30 @@ class RecordReader : public RecordBase {
    */
   void Reset();
 
+  /**
+   * @brief Move the reader to the first chunk that may hold messages not
+   * earlier than timestamp, found by binary search over the chunk positions
+   * of the index section. Messages earlier than timestamp are skipped by the
+   * following ReadMessage calls until the next Reset.
+   *
+   * @param timestamp
+   *
+   * @return True for success, false for not.
+   */
+  bool Seek(uint64_t timestamp);
+
+  /**
+   * @brief Like Seek(timestamp), but only chunks holding messages of
+   * channel_name are considered. Records without the per-channel index fall
+   * back to Seek(timestamp).
+   *
+   * @param timestamp
+   * @param channel_name
+   *
+   * @return True for success, false for not.
+   */
+  bool Seek(uint64_t timestamp, const std::string& channel_name);
+
   /**
    * @brief Get message number by channel name.
    *
@@ -114,14 +142,31 @@ class RecordReader : public RecordBase {
   std::set<std::string> GetChannelList() const override;
 
  private:
+  struct ChunkIndex {
+    uint64_t position = 0;
+    uint64_t begin_time = 0;
+    uint64_t end_time = 0;
+    // max end_time of this chunk and all chunks before it in the same list,
+    // chunks are not strictly ordered by time so this is the search key
+    uint64_t max_end_time = 0;
+  };
+  using ChunkIndexList = std::vector<ChunkIndex>;
+
+  void BuildChunkIndex();
+  bool SeekChunk(const ChunkIndexList& chunks, uint64_t timestamp);
   bool ReadNextChunk(uint64_t begin_time, uint64_t end_time);
 
   bool is_valid_ = false;
   bool reach_end_ = false;
+  bool use_mmap_ = false;
   std::unique_ptr<proto::ChunkBody> chunk_ = nullptr;
+  std::vector<MessageView> chunk_views_;
   proto::Index index_;
   int message_index_ = 0;
   ChannelInfoMap channel_info_;
+  ChunkIndexList chunk_index_;
+  std::unordered_map<std::string, ChunkIndexList> channel_chunk_index_;
+  uint64_t seek_time_ = 0;
   FileReaderPtr file_reader_;
 };
 
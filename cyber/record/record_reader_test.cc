@@ -16,10 +16,13 @@
 
 #include "cyber/record/record_reader.h"
 
+#include <chrono>
 #include <string>
+#include <thread>
 
 #include "gtest/gtest.h"
 
+#include "cyber/record/header_builder.h"
 #include "cyber/record/record_writer.h"
 
 namespace apollo {
@@ -29,6 +32,7 @@ namespace record {
 using apollo::cyber::message::RawMessage;
 
 constexpr char kChannelName1[] = "/test/channel1";
+constexpr char kChannelName2[] = "/test/channel2";
 constexpr char kMessageType1[] = "apollo.cyber.proto.Test";
 constexpr char kProtoDesc[] = "1234567890";
 constexpr char kStr10B[] = "1234567890";
@@ -122,6 +126,131 @@ TEST(RecordTest, TestReaderOrder) {
   ASSERT_FALSE(remove(kTestFile));
 }
 
+TEST(RecordTest, TestSeek) {
+  // one chunk per 110ns of messages, channel2 only shows up from 500
+  RecordWriter writer(HeaderBuilder::GetHeaderWithChunkParams(95, 0));
+  writer.SetSizeOfFileSegmentation(0);
+  writer.SetIntervalOfFileSegmentation(0);
+  writer.Open(kTestFile);
+  writer.WriteChannel(kChannelName1, kMessageType1, kProtoDesc);
+  writer.WriteChannel(kChannelName2, kMessageType1, kProtoDesc);
+  const uint64_t msg_num = 100;
+  for (uint64_t i = 1; i <= msg_num; ++i) {
+    auto msg = std::make_shared<RawMessage>(std::to_string(i));
+    if (i * 10 >= 500) {
+      writer.WriteMessage(kChannelName2, msg, i * 10);
+    }
+    writer.WriteMessage(kChannelName1, msg, i * 10);
+    // give the flush thread time to write the finished chunk
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  writer.Close();
+
+  RecordReader reader(kTestFile);
+  RecordMessage message;
+  ASSERT_TRUE(reader.IsValid());
+
+  ASSERT_TRUE(reader.Seek(300));
+  ASSERT_TRUE(reader.ReadMessage(&message));
+  EXPECT_EQ(300, message.time);
+  uint64_t count = 1;
+  while (reader.ReadMessage(&message)) {
+    EXPECT_LE(300, message.time);
+    ++count;
+  }
+  EXPECT_EQ(msg_num - 29 + msg_num / 2 + 1, count);
+
+  // seeking backwards works as well
+  ASSERT_TRUE(reader.Seek(100));
+  ASSERT_TRUE(reader.ReadMessage(&message));
+  EXPECT_EQ(100, message.time);
+
+  // the chunks without channel2 are skipped
+  ASSERT_TRUE(reader.Seek(0, kChannelName2));
+  ASSERT_TRUE(reader.ReadMessage(&message));
+  EXPECT_EQ(450, message.time);
+  EXPECT_FALSE(reader.Seek(0, "/test/unknown"));
+
+  // nothing left after the end of record
+  ASSERT_TRUE(reader.Seek(msg_num * 10 + 1));
+  EXPECT_FALSE(reader.ReadMessage(&message));
+
+  reader.Reset();
+  ASSERT_TRUE(reader.ReadMessage(&message));
+  EXPECT_EQ(10, message.time);
+  ASSERT_FALSE(remove(kTestFile));
+}
+
+TEST(RecordTest, TestCompressedRecord) {
+  auto header = HeaderBuilder::GetHeaderWithChunkParams(95, 0);
+  header.set_compress(proto::CompressType::COMPRESS_ZLIB);
+  RecordWriter writer(header);
+  writer.SetSizeOfFileSegmentation(0);
+  writer.SetIntervalOfFileSegmentation(0);
+  writer.Open(kTestFile);
+  writer.WriteChannel(kChannelName1, kMessageType1, kProtoDesc);
+  const uint64_t msg_num = 100;
+  const std::string content(4096, 'a');
+  for (uint64_t i = 1; i <= msg_num; ++i) {
+    auto msg = std::make_shared<RawMessage>(content + std::to_string(i));
+    writer.WriteMessage(kChannelName1, msg, i * 10);
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  writer.Close();
+
+  RecordReader reader(kTestFile);
+  ASSERT_TRUE(reader.IsValid());
+  EXPECT_EQ(proto::CompressType::COMPRESS_ZLIB, reader.GetHeader().compress());
+  EXPECT_GT(msg_num * content.size() / 10, reader.GetHeader().size());
+  RecordMessage message;
+  for (uint64_t i = 1; i <= msg_num; ++i) {
+    ASSERT_TRUE(reader.ReadMessage(&message));
+    EXPECT_EQ(i * 10, message.time);
+    EXPECT_EQ(content + std::to_string(i), message.content);
+  }
+  EXPECT_FALSE(reader.ReadMessage(&message));
+
+  // the read ahead window follows a seek
+  ASSERT_TRUE(reader.Seek(500));
+  ASSERT_TRUE(reader.ReadMessage(&message));
+  EXPECT_EQ(500, message.time);
+  ASSERT_FALSE(remove(kTestFile));
+}
+
+TEST(RecordTest, TestMmapReader) {
+  RecordWriter writer(HeaderBuilder::GetHeaderWithChunkParams(95, 0));
+  writer.SetSizeOfFileSegmentation(0);
+  writer.SetIntervalOfFileSegmentation(0);
+  writer.Open(kTestFile);
+  writer.WriteChannel(kChannelName1, kMessageType1, kProtoDesc);
+  writer.WriteChannel(kChannelName2, kMessageType1, kProtoDesc);
+  const uint64_t msg_num = 50;
+  for (uint64_t i = 1; i <= msg_num; ++i) {
+    auto msg = std::make_shared<RawMessage>(std::string(i, 'x'));
+    writer.WriteMessage(i % 2 ? kChannelName1 : kChannelName2, msg, i * 10);
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  writer.Close();
+
+  RecordReader reader(kTestFile, true);
+  ASSERT_TRUE(reader.IsValid());
+  RecordMessage message;
+  for (uint64_t i = 1; i <= msg_num; ++i) {
+    ASSERT_TRUE(reader.ReadMessage(&message));
+    EXPECT_EQ(i % 2 ? kChannelName1 : kChannelName2, message.channel_name);
+    EXPECT_EQ(i * 10, message.time);
+    EXPECT_TRUE(message.content.empty());
+    EXPECT_EQ(std::string(i, 'x'), message.GetContent());
+  }
+  EXPECT_FALSE(reader.ReadMessage(&message));
+
+  ASSERT_TRUE(reader.Seek(255));
+  ASSERT_TRUE(reader.ReadMessage(&message));
+  EXPECT_EQ(260, message.time);
+  EXPECT_EQ(std::string(26, 'x'), message.GetContent());
+  ASSERT_FALSE(remove(kTestFile));
+}
+
 }  // namespace record
 }  // namespace cyber
 }  // namespace apollo
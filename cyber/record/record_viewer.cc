@@ -82,6 +82,10 @@ RecordViewer::Iterator RecordViewer::curr_itr() { return itr_; }
 
 void RecordViewer::set_curr_itr(const Iterator& curr_itr) { itr_ = curr_itr; }
 
+RecordViewer::Iterator RecordViewer::Seek(uint64_t timestamp) {
+  return Iterator(this, timestamp);
+}
+
 void RecordViewer::Init() {
   // Init the channel list
   for (auto& reader : readers_) {
@@ -113,6 +117,28 @@ void RecordViewer::Reset() {
   msg_buffer_.clear();
 }
 
+void RecordViewer::Reset(uint64_t seek_time) {
+  Reset();
+  if (seek_time <= begin_time_) {
+    return;
+  }
+  for (size_t i = 0; i < readers_.size(); ++i) {
+    auto& reader = readers_[i];
+    if (reader->GetHeader().end_time() < seek_time) {
+      readers_finished_[i] = true;
+      continue;
+    }
+    bool ok = channels_.size() == 1
+                  ? reader->Seek(seek_time, *channels_.begin())
+                  : reader->Seek(seek_time);
+    if (!ok) {
+      // fall back to the sequential scan from the beginning
+      reader->Reset();
+    }
+  }
+  curr_begin_time_ = seek_time;
+}
+
 void RecordViewer::UpdateTime() {
   uint64_t min_begin_time = std::numeric_limits<uint64_t>::max();
   uint64_t max_end_time = 0;
@@ -190,6 +216,14 @@ RecordViewer::Iterator::Iterator(RecordViewer* viewer, bool end)
   }
 }
 
+RecordViewer::Iterator::Iterator(RecordViewer* viewer, uint64_t seek_time)
+    : viewer_(viewer) {
+  viewer_->Reset(seek_time);
+  if (!viewer_->IsValid() || !viewer_->Update(&message_instance_)) {
+    end_ = true;
+  }
+}
+
 bool RecordViewer::Iterator::operator==(Iterator const& other) const {
   if (other.end_) {
     return end_;
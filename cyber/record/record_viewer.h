@@ -156,6 +156,10 @@ class RecordViewer {
     reference operator*();
 
    private:
+    friend class RecordViewer;
+
+    Iterator(RecordViewer* viewer, uint64_t seek_time);
+
     bool end_ = false;
     uint64_t index_ = 0;
     RecordViewer* viewer_ = nullptr;
@@ -185,11 +189,23 @@ class RecordViewer {
 
   void set_curr_itr(const Iterator& curr_itr);
 
+  /**
+   * @brief Get the iterator of the first message not earlier than timestamp.
+   * The readers jump to the matching chunks through the record index instead
+   * of reading every chunk before timestamp.
+   *
+   * @param timestamp
+   *
+   * @return The iterator, equal to end() if no message is left.
+   */
+  Iterator Seek(uint64_t timestamp);
+
  private:
   friend class Iterator;
 
   void Init();
   void Reset();
+  void Reset(uint64_t seek_time);
   void UpdateTime();
   bool FillBuffer();
   bool Update(RecordMessage* message);
@@ -224,6 +224,34 @@ TEST(RecordTest, mult_iterator_test) {
   ASSERT_FALSE(remove(kTestFile));
 }
 
+TEST(RecordTest, seek_test) {
+  uint64_t msg_num = 200;
+  uint64_t begin_time = 100000000;
+  uint64_t step_time = 100000000;  // 100ms
+  ConstructRecord(msg_num, begin_time, step_time);
+
+  auto reader = std::make_shared<RecordReader>(kTestFile);
+  RecordViewer viewer(reader);
+  EXPECT_TRUE(viewer.IsValid());
+
+  uint64_t i = 150;
+  for (auto it = viewer.Seek(begin_time + step_time * i); it != viewer.end();
+       ++it) {
+    EXPECT_EQ(begin_time + step_time * i, it->time);
+    EXPECT_EQ(std::to_string(i), it->content);
+    i++;
+  }
+  EXPECT_EQ(msg_num, i);
+
+  // seek before the record begins starts from the first message
+  auto it = viewer.Seek(0);
+  ASSERT_TRUE(it != viewer.end());
+  EXPECT_EQ(begin_time, it->time);
+
+  EXPECT_TRUE(viewer.Seek(begin_time + step_time * msg_num) == viewer.end());
+  ASSERT_FALSE(remove(kTestFile));
+}
+
 }  // namespace record
 }  // namespace cyber
 }  // namespace apollo
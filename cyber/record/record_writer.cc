@@ -16,6 +16,7 @@
 
 #include "cyber/record/record_writer.h"
 
+#include <algorithm>
 #include <iomanip>
 #include <iostream>
 
@@ -30,9 +31,39 @@ using apollo::cyber::common::UnixSecondsToString;
 using proto::Channel;
 using proto::SingleMessage;
 
-RecordWriter::RecordWriter() { header_ = HeaderBuilder::GetHeader(); }
+namespace {
 
-RecordWriter::RecordWriter(const proto::Header& header) { header_ = header; }
+void AddFileStats(const RecordWriteStats& file, RecordWriteStats* total) {
+  total->bytes_written += file.bytes_written;
+  total->chunk_num += file.chunk_num;
+  total->sync_num += file.sync_num;
+  total->sync_time_us += file.sync_time_us;
+  total->max_sync_us = std::max(total->max_sync_us, file.max_sync_us);
+  total->io.bytes_written += file.io.bytes_written;
+  total->io.write_num += file.io.write_num;
+  total->io.write_time_us += file.io.write_time_us;
+  total->io.max_write_us =
+      std::max(total->io.max_write_us, file.io.max_write_us);
+  total->io.queued_buffers = file.io.queued_buffers;
+  total->io.max_queued_buffers =
+      std::max(total->io.max_queued_buffers, file.io.max_queued_buffers);
+  total->io.wait_time_us += file.io.wait_time_us;
+  total->io.sync_num += file.io.sync_num;
+  total->io.sync_time_us += file.io.sync_time_us;
+  total->io.max_sync_us = std::max(total->io.max_sync_us, file.io.max_sync_us);
+}
+
+}  // namespace
+
+RecordWriter::RecordWriter() {
+  header_ = HeaderBuilder::GetHeader();
+  budget_ = std::make_shared<WriteBudget>(write_conf_);
+}
+
+RecordWriter::RecordWriter(const proto::Header& header) {
+  header_ = header;
+  budget_ = std::make_shared<WriteBudget>(write_conf_);
+}
 
 RecordWriter::~RecordWriter() { Close(); }
 
@@ -48,7 +79,7 @@ bool RecordWriter::Open(const std::string& file) {
   } else {
     path_ = file_;
   }
-  file_writer_.reset(new RecordFileWriter());
+  file_writer_.reset(new RecordFileWriter(write_conf_, budget_));
   if (!file_writer_->Open(path_)) {
     AERROR << "Failed to open output record file: " << path_;
     return false;
@@ -70,7 +101,7 @@ void RecordWriter::Close() {
 }
 
 bool RecordWriter::SplitOutfile() {
-  file_writer_.reset(new RecordFileWriter());
+  file_writer_.reset(new RecordFileWriter(write_conf_, budget_));
   if (file_index_ > 99999) {
     AWARN << "More than 99999 record files had been recored, will restart "
           << "counting from 0.";
@@ -126,7 +157,27 @@ bool RecordWriter::WriteChannel(const std::string& channel_name,
 }
 
 bool RecordWriter::WriteMessage(const SingleMessage& message) {
+  // wait for the memory before taking the lock, so that the channels which
+  // drop are not held up by the ones which block
+  auto hand_off = [this]() {
+    std::lock_guard<std::mutex> lg(mutex_);
+    if (file_writer_ != nullptr) {
+      file_writer_->HandOffChunk();
+    }
+  };
+  if (!budget_->Acquire(message.channel_name(), message.content().size(),
+                        hand_off)) {
+    AWARN_EVERY(1000) << "Memory limit of the record writer is reached, drop "
+                         "message of channel: "
+                      << message.channel_name();
+    return false;
+  }
   std::lock_guard<std::mutex> lg(mutex_);
+  if (file_writer_ == nullptr) {
+    budget_->Release(message.content().size());
+    AERROR << "Record file is not opened.";
+    return false;
+  }
   OnNewMessage(message.channel_name());
   if (!file_writer_->WriteMessage(message)) {
     AERROR << "Write message is failed.";
@@ -147,6 +198,7 @@ bool RecordWriter::WriteMessage(const SingleMessage& message) {
        segment_raw_size_ > header_.segment_raw_size())) {
     file_writer_backup_.swap(file_writer_);
     file_writer_backup_->Close();
+    AddFileStats(file_writer_backup_->GetWriteStats(), &closed_files_stats_);
     if (!SplitOutfile()) {
       AERROR << "Split out file is failed.";
       return false;
@@ -173,6 +225,26 @@ bool RecordWriter::SetIntervalOfFileSegmentation(uint64_t time_sec) {
   return true;
 }
 
+bool RecordWriter::SetWriteConf(const proto::RecordWriteConf& conf) {
+  if (is_opened_) {
+    AWARN << "Please call this interface before opening file.";
+    return false;
+  }
+  write_conf_ = conf;
+  budget_ = std::make_shared<WriteBudget>(write_conf_);
+  return true;
+}
+
+RecordWriteStats RecordWriter::GetWriteStats() {
+  std::lock_guard<std::mutex> lg(mutex_);
+  RecordWriteStats stats = closed_files_stats_;
+  if (file_writer_ != nullptr) {
+    AddFileStats(file_writer_->GetWriteStats(), &stats);
+  }
+  stats.budget = budget_->GetStats();
+  return stats;
+}
+
 bool RecordWriter::IsNewChannel(const std::string& channel_name) const {
   return channel_message_number_map_.find(channel_name) ==
          channel_message_number_map_.end();
@@ -26,6 +26,7 @@
 #include <unordered_map>
 
 #include "cyber/proto/record.pb.h"
+#include "cyber/proto/record_conf.pb.h"
 
 #include "cyber/common/log.h"
 #include "cyber/message/message_traits.h"
@@ -126,6 +127,24 @@ class RecordWriter : public RecordBase {
    */
   bool SetIntervalOfFileSegmentation(uint64_t time_sec);
 
+  /**
+   * @brief Set the memory limit, the overflow policies and the io backend of
+   * the writer.
+   *
+   * @param conf
+   *
+   * @return True for success, false for fail.
+   */
+  bool SetWriteConf(const proto::RecordWriteConf& conf);
+
+  /**
+   * @brief Get bytes written, buffered, blocked and dropped messages and io
+   * metrics, the counters are summed over the segmented files.
+   *
+   * @return Write statistics.
+   */
+  RecordWriteStats GetWriteStats();
+
   /**
    * @brief Get message number by channel name.
    *
@@ -186,6 +205,9 @@ class RecordWriter : public RecordBase {
   MessageProtoDescMap channel_proto_desc_map_;
   FileWriterPtr file_writer_ = nullptr;
   FileWriterPtr file_writer_backup_ = nullptr;
+  proto::RecordWriteConf write_conf_;
+  std::shared_ptr<WriteBudget> budget_ = nullptr;
+  RecordWriteStats closed_files_stats_;
   std::mutex mutex_;
   std::stringstream sstream_;
 };
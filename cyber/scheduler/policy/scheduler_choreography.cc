@@ -76,6 +76,10 @@ SchedulerChoreography::SchedulerChoreography()
 
     for (const auto& task : choreography_conf.tasks()) {
       cr_confs_[task.name()] = task;
+      if (task.stack_size_kb() > 0) {
+        stack_sizes_[task.name()] =
+            static_cast<size_t>(task.stack_size_kb()) * 1024;
+      }
     }
   }
 
@@ -60,6 +60,10 @@ SchedulerClassic::SchedulerClassic() {
       for (auto task : group.tasks()) {
         task.set_group_name(group_name);
         cr_confs_[task.name()] = task;
+        if (task.stack_size_kb() > 0) {
+          stack_sizes_[task.name()] =
+              static_cast<size_t>(task.stack_size_kb()) * 1024;
+        }
       }
     }
   } else {
@@ -0,0 +1,64 @@
+/******************************************************************************
+ * Copyright 2024 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_SCHEDULER_POLICY_SCHEDULER_WORK_STEALING_H_
+#define CYBER_SCHEDULER_POLICY_SCHEDULER_WORK_STEALING_H_
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "cyber/croutine/croutine.h"
+#include "cyber/proto/classic_conf.pb.h"
+#include "cyber/scheduler/scheduler.h"
+
+namespace apollo {
+namespace cyber {
+namespace scheduler {
+
+using apollo::cyber::croutine::CRoutine;
+using apollo::cyber::proto::ClassicConf;
+using apollo::cyber::proto::ClassicTask;
+
+/**
+ * @brief Scheduler with the groups and priorities of SchedulerClassic, but
+ * with per processor ready queues fed by notifications and work stealing
+ * inside a group, see WorkStealingContext. It reads classic_conf.
+ */
+class SchedulerWorkStealing : public Scheduler {
+ public:
+  bool RemoveCRoutine(uint64_t crid) override;
+  bool RemoveTask(const std::string& name) override;
+  bool DispatchTask(const std::shared_ptr<CRoutine>&) override;
+
+ private:
+  friend Scheduler* Instance();
+  SchedulerWorkStealing();
+
+  void CreateProcessor();
+  bool NotifyProcessor(uint64_t crid) override;
+
+  std::unordered_map<std::string, ClassicTask> cr_confs_;
+
+  ClassicConf classic_conf_;
+};
+
+}  // namespace scheduler
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_SCHEDULER_POLICY_SCHEDULER_WORK_STEALING_H_
@@ -0,0 +1,340 @@
+/******************************************************************************
+ * Copyright 2024 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/scheduler/policy/work_stealing_context.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace apollo {
+namespace cyber {
+namespace scheduler {
+
+using apollo::cyber::base::AtomicRWLock;
+using apollo::cyber::base::ReadLockGuard;
+using apollo::cyber::base::WriteLockGuard;
+using apollo::cyber::croutine::CRoutine;
+using apollo::cyber::croutine::RoutineState;
+
+alignas(CACHELINE_SIZE) WS_CTX_GROUP WorkStealingContext::ctx_group_;
+alignas(CACHELINE_SIZE) READY_TASKS WorkStealingContext::tasks_;
+alignas(CACHELINE_SIZE) AtomicRWLock WorkStealingContext::ctx_lock_;
+alignas(CACHELINE_SIZE) AtomicRWLock WorkStealingContext::tasks_lock_;
+alignas(CACHELINE_SIZE) std::unordered_map<std::string, uint32_t>
+    WorkStealingContext::next_home_;
+
+namespace {
+
+bool SleeperGreater(
+    const std::pair<std::chrono::steady_clock::time_point,
+                    std::weak_ptr<ReadyTask>>& lhs,
+    const std::pair<std::chrono::steady_clock::time_point,
+                    std::weak_ptr<ReadyTask>>& rhs) {
+  return lhs.first > rhs.first;
+}
+
+}  // namespace
+
+WorkStealingContext::WorkStealingContext() { InitGroup(DEFAULT_GROUP_NAME); }
+
+WorkStealingContext::WorkStealingContext(const std::string& group_name) {
+  InitGroup(group_name);
+}
+
+WorkStealingContext::~WorkStealingContext() {
+  WriteLockGuard<AtomicRWLock> lk(ctx_lock_);
+  // keep the slot so that the home index of other croutines stays valid
+  ctx_group_[current_grp][index_] = nullptr;
+}
+
+void WorkStealingContext::InitGroup(const std::string& group_name) {
+  for (auto& rq : rq_) {
+    rq.Init(kReadyQueueSize);
+  }
+  current_grp = group_name;
+
+  WriteLockGuard<AtomicRWLock> lk(ctx_lock_);
+  auto& ctxs = ctx_group_[group_name];
+  index_ = static_cast<uint32_t>(ctxs.size());
+  ctxs.emplace_back(this);
+}
+
+std::shared_ptr<CRoutine> WorkStealingContext::NextRoutine() {
+  if (cyber_unlikely(stop_.load())) {
+    return nullptr;
+  }
+
+  if (last_task_ != nullptr) {
+    Requeue(last_task_);
+    last_task_.reset();
+  }
+  WakeSleepers();
+
+  auto cr = PopFrom(this);
+  if (cr != nullptr) {
+    return cr;
+  }
+
+  // bounded stealing: at most one croutine from each sibling. ctx_lock_ is
+  // not re-entrant and a writer waiting for it blocks new readers, so it is
+  // released before PopFrom, which may enqueue. The contexts of a group live
+  // as long as its processors.
+  {
+    ReadLockGuard<AtomicRWLock> lk(ctx_lock_);
+    auto it = ctx_group_.find(current_grp);
+    if (it == ctx_group_.end()) {
+      return nullptr;
+    }
+    siblings_.assign(it->second.begin(), it->second.end());
+  }
+  for (size_t i = 1; i < siblings_.size(); ++i) {
+    auto sibling = siblings_[(index_ + i) % siblings_.size()];
+    if (sibling == nullptr) {
+      continue;
+    }
+    cr = PopFrom(sibling);
+    if (cr != nullptr) {
+      return cr;
+    }
+  }
+  return nullptr;
+}
+
+std::shared_ptr<CRoutine> WorkStealingContext::PopFrom(
+    WorkStealingContext* ctx) {
+  uint64_t crid = 0;
+  for (int i = MAX_PRIO - 1; i >= 0; --i) {
+    while (ctx->rq_[i].Dequeue(&crid)) {
+      auto task = GetTask(crid);
+      if (task == nullptr) {
+        // removed after it was enqueued
+        continue;
+      }
+      task->queued.clear();
+      auto cr = TryRun(task);
+      if (cr != nullptr) {
+        last_task_ = task;
+        return cr;
+      }
+    }
+  }
+  return nullptr;
+}
+
+std::shared_ptr<CRoutine> WorkStealingContext::TryRun(
+    const std::shared_ptr<ReadyTask>& task) {
+  auto& cr = task->cr;
+  if (!AcquireOrDefer(task)) {
+    return nullptr;
+  }
+
+  auto state = cr->UpdateState();
+  if (state == RoutineState::READY) {
+    return cr;
+  }
+  if (state == RoutineState::SLEEP) {
+    sleepers_.emplace_back(cr->wake_time(), task);
+    std::push_heap(sleepers_.begin(), sleepers_.end(), SleeperGreater);
+  }
+  ReleaseAndCheck(task);
+  return nullptr;
+}
+
+void WorkStealingContext::Requeue(const std::shared_ptr<ReadyTask>& task) {
+  auto& cr = task->cr;
+  if (!AcquireOrDefer(task)) {
+    return;
+  }
+  auto state = cr->UpdateState();
+  auto wake_time = cr->wake_time();
+  ReleaseAndCheck(task);
+
+  if (state == RoutineState::READY) {
+    Enqueue(task);
+  } else if (state == RoutineState::SLEEP) {
+    sleepers_.emplace_back(wake_time, task);
+    std::push_heap(sleepers_.begin(), sleepers_.end(), SleeperGreater);
+  }
+}
+
+bool WorkStealingContext::AcquireOrDefer(
+    const std::shared_ptr<ReadyTask>& task) {
+  auto& cr = task->cr;
+  if (!cr->Acquire()) {
+    // the croutine is held by another processor, which may have checked its
+    // update flag already. Leave the notification to the holder and retry
+    // once in case it released the croutine before seeing it.
+    task->pending.store(true);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (!cr->Acquire()) {
+      return false;
+    }
+  }
+  task->pending.store(false);
+  return true;
+}
+
+void WorkStealingContext::ReleaseAndCheck(
+    const std::shared_ptr<ReadyTask>& task) {
+  task->cr->Release();
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (task->pending.exchange(false)) {
+    Enqueue(task);
+  }
+}
+
+void WorkStealingContext::WakeSleepers() {
+  auto now = std::chrono::steady_clock::now();
+  while (!sleepers_.empty() && sleepers_.front().first <= now) {
+    auto task = sleepers_.front().second.lock();
+    std::pop_heap(sleepers_.begin(), sleepers_.end(), SleeperGreater);
+    sleepers_.pop_back();
+    if (task != nullptr) {
+      Enqueue(task);
+    }
+  }
+}
+
+void WorkStealingContext::Wait() {
+  auto wait_time = std::chrono::steady_clock::now() +
+                   std::chrono::milliseconds(1000);
+  if (!sleepers_.empty() && sleepers_.front().first < wait_time) {
+    wait_time = sleepers_.front().first;
+  }
+
+  std::unique_lock<std::mutex> lk(mtx_);
+  idle_.store(true);
+  cv_.wait_until(lk, wait_time, [&]() { return notify_ > 0; });
+  idle_.store(false);
+  if (notify_ > 0) {
+    notify_--;
+  }
+}
+
+void WorkStealingContext::Shutdown() {
+  stop_.store(true);
+  mtx_.lock();
+  notify_ = std::numeric_limits<unsigned char>::max();
+  mtx_.unlock();
+  cv_.notify_all();
+}
+
+void WorkStealingContext::Notify() {
+  mtx_.lock();
+  notify_++;
+  mtx_.unlock();
+  cv_.notify_one();
+}
+
+bool WorkStealingContext::AddCRoutine(const std::shared_ptr<CRoutine>& cr) {
+  auto task = std::make_shared<ReadyTask>();
+  task->cr = cr;
+  {
+    // spread croutines of a group over its processors
+    WriteLockGuard<AtomicRWLock> lk(ctx_lock_);
+    auto& ctxs = ctx_group_[cr->group_name()];
+    if (ctxs.empty()) {
+      AERROR << "no processor in group " << cr->group_name();
+      return false;
+    }
+    task->home = next_home_[cr->group_name()]++ % ctxs.size();
+  }
+  {
+    WriteLockGuard<AtomicRWLock> lk(tasks_lock_);
+    if (tasks_.find(cr->id()) != tasks_.end()) {
+      return false;
+    }
+    tasks_[cr->id()] = task;
+  }
+  Enqueue(task);
+  return true;
+}
+
+bool WorkStealingContext::RemoveCRoutine(const std::shared_ptr<CRoutine>& cr) {
+  {
+    WriteLockGuard<AtomicRWLock> lk(tasks_lock_);
+    if (tasks_.erase(cr->id()) == 0) {
+      return false;
+    }
+  }
+  cr->Stop();
+  while (!cr->Acquire()) {
+    std::this_thread::sleep_for(std::chrono::microseconds(1));
+    AINFO_EVERY(1000) << "waiting for task " << cr->name() << " completion";
+  }
+  cr->Release();
+  return true;
+}
+
+void WorkStealingContext::Enqueue(uint64_t crid) {
+  auto task = GetTask(crid);
+  if (task != nullptr) {
+    Enqueue(task);
+  }
+}
+
+void WorkStealingContext::Enqueue(const std::shared_ptr<ReadyTask>& task) {
+  // a croutine sits in at most one ready queue
+  if (task->queued.test_and_set()) {
+    return;
+  }
+
+  auto prio = task->cr->priority();
+  ReadLockGuard<AtomicRWLock> lk(ctx_lock_);
+  auto it = ctx_group_.find(task->cr->group_name());
+  if (it == ctx_group_.end()) {
+    AERROR << "no processor in group " << task->cr->group_name();
+    task->queued.clear();
+    return;
+  }
+  auto& ctxs = it->second;
+  WorkStealingContext* target = nullptr;
+  for (size_t i = 0; i < ctxs.size() && target == nullptr; ++i) {
+    auto ctx = ctxs[(task->home + i) % ctxs.size()];
+    if (ctx != nullptr && ctx->rq_[prio].Enqueue(task->cr->id())) {
+      target = ctx;
+    }
+  }
+  if (target == nullptr) {
+    AERROR << "fail to enqueue " << task->cr->name() << ", ready queue full.";
+    task->queued.clear();
+    return;
+  }
+
+  // wake the owner of the queue, or an idle sibling to steal from it
+  if (!target->idle_.load()) {
+    for (auto ctx : ctxs) {
+      if (ctx != nullptr && ctx->idle_.load()) {
+        target = ctx;
+        break;
+      }
+    }
+  }
+  target->Notify();
+}
+
+std::shared_ptr<ReadyTask> WorkStealingContext::GetTask(uint64_t crid) {
+  ReadLockGuard<AtomicRWLock> lk(tasks_lock_);
+  auto it = tasks_.find(crid);
+  if (it == tasks_.end()) {
+    return nullptr;
+  }
+  return it->second;
+}
+
+}  // namespace scheduler
+}  // namespace cyber
+}  // namespace apollo
@@ -0,0 +1,128 @@
+/******************************************************************************
+ * Copyright 2024 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_SCHEDULER_POLICY_WORK_STEALING_CONTEXT_H_
+#define CYBER_SCHEDULER_POLICY_WORK_STEALING_CONTEXT_H_
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "cyber/base/atomic_rw_lock.h"
+#include "cyber/base/bounded_queue.h"
+#include "cyber/croutine/croutine.h"
+#include "cyber/scheduler/policy/classic_context.h"
+#include "cyber/scheduler/processor_context.h"
+
+namespace apollo {
+namespace cyber {
+namespace scheduler {
+
+// A croutine known by the work stealing policy. It is only put in the ready
+// queue of its home processor when it has something to do.
+struct ReadyTask {
+  std::shared_ptr<CRoutine> cr;
+  std::atomic_flag queued = ATOMIC_FLAG_INIT;
+  // set by a processor that dequeued the croutine while another one held it,
+  // the holder re-enqueues it after release
+  std::atomic<bool> pending = {false};
+  uint32_t home = 0;
+};
+
+class WorkStealingContext;
+using READY_QUEUE = base::BoundedQueue<uint64_t>;
+using MULTI_PRIO_READY_QUEUE = std::array<READY_QUEUE, MAX_PRIO>;
+using WS_CTX_GROUP =
+    std::unordered_map<std::string, std::vector<WorkStealingContext *>>;
+using READY_TASKS = std::unordered_map<uint64_t, std::shared_ptr<ReadyTask>>;
+
+/**
+ * @brief Processor context with ready-only runqueues.
+ *
+ * Unlike ClassicContext, which polls every croutine of the group on each
+ * wakeup, croutines are enqueued by id into the lock-free queue of their home
+ * processor when they are notified, and NextRoutine only pops. An idle
+ * processor steals at most one croutine from each sibling of its group.
+ */
+class WorkStealingContext : public ProcessorContext {
+ public:
+  WorkStealingContext();
+  explicit WorkStealingContext(const std::string &group_name);
+  virtual ~WorkStealingContext();
+
+  std::shared_ptr<CRoutine> NextRoutine() override;
+  void Wait() override;
+  void Shutdown() override;
+
+  static bool AddCRoutine(const std::shared_ptr<CRoutine> &cr);
+  static bool RemoveCRoutine(const std::shared_ptr<CRoutine> &cr);
+  static void Enqueue(uint64_t crid);
+
+  static constexpr uint64_t kReadyQueueSize = 1024;
+
+ private:
+  void InitGroup(const std::string &group_name);
+  void Notify();
+
+  std::shared_ptr<CRoutine> PopFrom(WorkStealingContext *ctx);
+  std::shared_ptr<CRoutine> TryRun(const std::shared_ptr<ReadyTask> &task);
+  void Requeue(const std::shared_ptr<ReadyTask> &task);
+  bool AcquireOrDefer(const std::shared_ptr<ReadyTask> &task);
+  void ReleaseAndCheck(const std::shared_ptr<ReadyTask> &task);
+  void WakeSleepers();
+
+  static std::shared_ptr<ReadyTask> GetTask(uint64_t crid);
+  static void Enqueue(const std::shared_ptr<ReadyTask> &task);
+
+  alignas(CACHELINE_SIZE) static WS_CTX_GROUP ctx_group_;
+  alignas(CACHELINE_SIZE) static READY_TASKS tasks_;
+  alignas(CACHELINE_SIZE) static base::AtomicRWLock ctx_lock_;
+  alignas(CACHELINE_SIZE) static base::AtomicRWLock tasks_lock_;
+  alignas(CACHELINE_SIZE) static std::unordered_map<std::string, uint32_t>
+      next_home_;
+
+  MULTI_PRIO_READY_QUEUE rq_;
+  std::string current_grp;
+  uint32_t index_ = 0;
+
+  // the group copied out of ctx_lock_ for stealing, kept to reuse its memory
+  std::vector<WorkStealingContext *> siblings_;
+
+  // the task resumed by the last NextRoutine, owned by this processor until
+  // it is requeued
+  std::shared_ptr<ReadyTask> last_task_;
+  using Sleeper =
+      std::pair<std::chrono::steady_clock::time_point, std::weak_ptr<ReadyTask>>;
+  std::vector<Sleeper> sleepers_;
+
+  std::mutex mtx_;
+  std::condition_variable cv_;
+  int notify_ = 0;
+  std::atomic<bool> idle_ = {false};
+};
+
+}  // namespace scheduler
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_SCHEDULER_POLICY_WORK_STEALING_CONTEXT_H_
@@ -0,0 +1,257 @@
+/******************************************************************************
+ * Copyright 2024 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/scheduler/policy/work_stealing_context.h"
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "cyber/croutine/croutine.h"
+#include "cyber/scheduler/processor.h"
+
+namespace apollo {
+namespace cyber {
+namespace scheduler {
+
+using croutine::RoutineState;
+
+TEST(WorkStealingContextTest, run_and_steal) {
+  const std::string group = "work_stealing_test";
+  std::vector<std::shared_ptr<Processor>> procs;
+  std::vector<std::shared_ptr<WorkStealingContext>> ctxs;
+  for (int i = 0; i < 2; ++i) {
+    auto ctx = std::make_shared<WorkStealingContext>(group);
+    auto proc = std::make_shared<Processor>();
+    proc->BindContext(ctx);
+    ctxs.emplace_back(ctx);
+    procs.emplace_back(proc);
+  }
+
+  std::atomic<int> count = {0};
+  std::vector<std::shared_ptr<CRoutine>> crs;
+  for (uint64_t i = 0; i < 8; ++i) {
+    auto cr = std::make_shared<CRoutine>([&count]() {
+      while (true) {
+        count++;
+        CRoutine::GetCurrentRoutine()->HangUp();
+      }
+    });
+    cr->set_id(1000 + i);
+    cr->set_name("ws_task_" + std::to_string(i));
+    cr->set_group_name(group);
+    EXPECT_TRUE(WorkStealingContext::AddCRoutine(cr));
+    crs.emplace_back(cr);
+  }
+  EXPECT_FALSE(WorkStealingContext::AddCRoutine(crs[0]));
+
+  auto wait_count = [&count](int expected) {
+    for (int i = 0; i < 1000 && count.load() < expected; ++i) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return count.load();
+  };
+  EXPECT_EQ(wait_count(8), 8);
+
+  // only the notified croutines run again
+  for (int i = 0; i < 3; ++i) {
+    crs[i]->SetUpdateFlag();
+    WorkStealingContext::Enqueue(crs[i]->id());
+  }
+  EXPECT_EQ(wait_count(11), 11);
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  EXPECT_EQ(count.load(), 11);
+
+  for (auto& cr : crs) {
+    EXPECT_TRUE(WorkStealingContext::RemoveCRoutine(cr));
+  }
+  EXPECT_FALSE(WorkStealingContext::RemoveCRoutine(crs[0]));
+  for (auto& proc : procs) {
+    proc->Stop();
+  }
+}
+
+TEST(WorkStealingContextTest, sleep) {
+  const std::string group = "work_stealing_sleep_test";
+  auto ctx = std::make_shared<WorkStealingContext>(group);
+  auto proc = std::make_shared<Processor>();
+  proc->BindContext(ctx);
+
+  std::atomic<int> count = {0};
+  auto cr = std::make_shared<CRoutine>([&count]() {
+    while (true) {
+      count++;
+      CRoutine::GetCurrentRoutine()->Sleep(std::chrono::milliseconds(10));
+    }
+  });
+  cr->set_id(2000);
+  cr->set_name("ws_sleep_task");
+  cr->set_group_name(group);
+  EXPECT_TRUE(WorkStealingContext::AddCRoutine(cr));
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(105));
+  EXPECT_GE(count.load(), 5);
+  EXPECT_TRUE(WorkStealingContext::RemoveCRoutine(cr));
+  proc->Stop();
+}
+
+TEST(WorkStealingContextTest, no_lost_notification) {
+  const std::string group = "work_stealing_notify_test";
+  std::vector<std::shared_ptr<Processor>> procs;
+  std::vector<std::shared_ptr<WorkStealingContext>> ctxs;
+  for (int i = 0; i < 4; ++i) {
+    auto ctx = std::make_shared<WorkStealingContext>(group);
+    auto proc = std::make_shared<Processor>();
+    proc->BindContext(ctx);
+    ctxs.emplace_back(ctx);
+    procs.emplace_back(proc);
+  }
+
+  // each run consumes every notification sent before it
+  std::atomic<uint64_t> sent = {0};
+  std::atomic<uint64_t> seen = {0};
+  auto cr = std::make_shared<CRoutine>([&sent, &seen]() {
+    while (true) {
+      seen.store(sent.load());
+      CRoutine::GetCurrentRoutine()->HangUp();
+    }
+  });
+  cr->set_id(3000);
+  cr->set_name("ws_notify_task");
+  cr->set_group_name(group);
+  EXPECT_TRUE(WorkStealingContext::AddCRoutine(cr));
+
+  auto notify = [&sent, &cr]() {
+    sent++;
+    cr->SetUpdateFlag();
+    WorkStealingContext::Enqueue(cr->id());
+  };
+  auto wait_seen = [&sent, &seen]() {
+    auto deadline =
+        std::chrono::steady_clock::now() + std::chrono::milliseconds(100);
+    while (seen.load() < sent.load() &&
+           std::chrono::steady_clock::now() < deadline) {
+      std::this_thread::yield();
+    }
+    return seen.load() >= sent.load();
+  };
+
+  // in each round every notifier notifies once at the same time, then nothing
+  // is sent until the croutine has seen all of them, so a lost notification
+  // is not covered by a later one
+  const int kNotifiers = 8;
+  const int kRounds = 10000;
+  std::atomic<int> round = {0};
+  std::atomic<int> done = {0};
+  std::vector<std::thread> notifiers;
+  for (int i = 0; i < kNotifiers; ++i) {
+    notifiers.emplace_back([&]() {
+      for (int r = 1; r <= kRounds; ++r) {
+        while (round.load() < r) {
+          std::this_thread::yield();
+        }
+        notify();
+        done++;
+      }
+    });
+  }
+
+  int lost = 0;
+  for (int r = 1; r <= kRounds; ++r) {
+    round.store(r);
+    while (done.load() < r * kNotifiers) {
+      std::this_thread::yield();
+    }
+    if (!wait_seen()) {
+      lost++;
+      // recover to keep the following rounds meaningful
+      notify();
+      wait_seen();
+    }
+  }
+  for (auto& t : notifiers) {
+    t.join();
+  }
+  EXPECT_EQ(lost, 0);
+
+  EXPECT_TRUE(WorkStealingContext::RemoveCRoutine(cr));
+  for (auto& proc : procs) {
+    proc->Stop();
+  }
+}
+
+TEST(WorkStealingContextTest, steal_while_locked_for_write) {
+  const std::string group = "work_stealing_lock_test";
+  std::vector<std::shared_ptr<Processor>> procs;
+  std::vector<std::shared_ptr<WorkStealingContext>> ctxs;
+  for (int i = 0; i < 2; ++i) {
+    auto ctx = std::make_shared<WorkStealingContext>(group);
+    auto proc = std::make_shared<Processor>();
+    proc->BindContext(ctx);
+    ctxs.emplace_back(ctx);
+    procs.emplace_back(proc);
+  }
+
+  // the croutines notify themselves while running, so the processors keep
+  // stealing them from each other and enqueueing them again
+  std::atomic<uint64_t> count = {0};
+  std::vector<std::shared_ptr<CRoutine>> crs;
+  for (uint64_t i = 0; i < 4; ++i) {
+    auto cr = std::make_shared<CRoutine>([&count]() {
+      while (true) {
+        count++;
+        auto self = CRoutine::GetCurrentRoutine();
+        self->SetUpdateFlag();
+        WorkStealingContext::Enqueue(self->id());
+        self->HangUp();
+      }
+    });
+    cr->set_id(4000 + i);
+    cr->set_name("ws_lock_task_" + std::to_string(i));
+    cr->set_group_name(group);
+    EXPECT_TRUE(WorkStealingContext::AddCRoutine(cr));
+    crs.emplace_back(cr);
+  }
+
+  // contexts of another group take the write lock of the groups over and over
+  for (int i = 0; i < 2000; ++i) {
+    WorkStealingContext other("work_stealing_lock_other");
+  }
+
+  // the processors still make progress
+  auto before = count.load();
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+  while (count.load() == before &&
+         std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  EXPECT_GT(count.load(), before);
+
+  for (auto& cr : crs) {
+    EXPECT_TRUE(WorkStealingContext::RemoveCRoutine(cr));
+  }
+  for (auto& proc : procs) {
+    proc->Stop();
+  }
+}
+
+}  // namespace scheduler
+}  // namespace cyber
+}  // namespace apollo
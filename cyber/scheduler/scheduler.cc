@@ -49,7 +49,12 @@ bool Scheduler::CreateTask(std::function<void()>&& func,
 
   auto task_id = GlobalData::RegisterTaskName(name);
 
-  auto cr = std::make_shared<CRoutine>(func);
+  size_t stack_size = 0;
+  auto it = stack_sizes_.find(name);
+  if (it != stack_sizes_.end()) {
+    stack_size = it->second;
+  }
+  auto cr = std::make_shared<CRoutine>(func, stack_size);
   cr->set_id(task_id);
   cr->set_name(name);
   AINFO << "create croutine: " << name;
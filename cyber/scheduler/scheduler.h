@@ -96,6 +96,8 @@ class Scheduler {
   std::vector<std::shared_ptr<Processor>> processors_;
 
   std::unordered_map<std::string, InnerThread> inner_thr_confs_;
+  // croutine name -> stack size in bytes, filled from the task confs
+  std::unordered_map<std::string, size_t> stack_sizes_;
 
   std::string process_level_cpuset_;
   uint32_t proc_num_ = 0;
@@ -95,6 +95,8 @@ Graph::Graph() {}
 Graph::~Graph() {
   edges_.clear();
   list_.clear();
+  successors_.clear();
+  reachable_.clear();
 }
 
 void Graph::Insert(const Edge& e) {
@@ -146,14 +148,39 @@ FlowDirection Graph::GetDirectionOf(const Vertice& lhs, const Vertice& rhs) {
   if (lhs.IsDummy() || rhs.IsDummy()) {
     return UNREACHABLE;
   }
-  ReadLockGuard<AtomicRWLock> lock(rw_lock_);
-  if (list_.count(lhs.GetKey()) == 0 || list_.count(rhs.GetKey()) == 0) {
+  auto& lhs_k = lhs.GetKey();
+  auto& rhs_k = rhs.GetKey();
+  bool upstream = false;
+  bool downstream = false;
+  {
+    ReadLockGuard<AtomicRWLock> lock(rw_lock_);
+    if (list_.count(lhs_k) == 0 || list_.count(rhs_k) == 0) {
+      return UNREACHABLE;
+    }
+    if (lhs_k == rhs_k) {
+      return UPSTREAM;
+    }
+    if (FindReachable(lhs_k, rhs_k, &upstream) &&
+        (upstream || FindReachable(rhs_k, lhs_k, &downstream))) {
+      return upstream ? UPSTREAM : (downstream ? DOWNSTREAM : UNREACHABLE);
+    }
+  }
+
+  // not cached yet
+  WriteLockGuard<AtomicRWLock> lock(rw_lock_);
+  if (list_.count(lhs_k) == 0 || list_.count(rhs_k) == 0) {
     return UNREACHABLE;
   }
-  if (LevelTraverse(lhs, rhs)) {
+  if (reachable_.count(lhs_k) == 0) {
+    AddReachable(lhs_k, &reachable_[lhs_k]);
+  }
+  if (reachable_[lhs_k].count(rhs_k) > 0) {
     return UPSTREAM;
   }
-  if (LevelTraverse(rhs, lhs)) {
+  if (reachable_.count(rhs_k) == 0) {
+    AddReachable(rhs_k, &reachable_[rhs_k]);
+  }
+  if (reachable_[rhs_k].count(lhs_k) > 0) {
     return DOWNSTREAM;
   }
   return UNREACHABLE;
@@ -208,7 +235,10 @@ void Graph::InsertCompleteEdge(const Edge& e) {
   if (list_.find(dst_v_k) == list_.end()) {
     list_[dst_v_k] = VerticeSet();
   }
-  list_[src_v_k][e.GetKey()] = e.dst();
+  if (list_[src_v_k].emplace(e.GetKey(), e.dst()).second &&
+      ++successors_[src_v_k][dst_v_k] == 1) {
+    OnNodeEdgeInserted(src_v_k, dst_v_k);
+  }
 }
 
 void Graph::DeleteOutgoingEdge(const Edge& e) {
@@ -253,29 +283,69 @@ void Graph::DeleteIncomingEdge(const Edge& e) {
 
 void Graph::DeleteCompleteEdge(const Edge& e) {
   auto& src_v_k = e.src().GetKey();
-  list_[src_v_k].erase(e.GetKey());
+  if (list_[src_v_k].erase(e.GetKey()) == 0) {
+    return;
+  }
+  auto& dst_v_k = e.dst().GetKey();
+  auto& dst_num = successors_[src_v_k];
+  if (--dst_num[dst_v_k] == 0) {
+    dst_num.erase(dst_v_k);
+    OnNodeEdgeDeleted(src_v_k, dst_v_k);
+  }
+}
+
+void Graph::OnNodeEdgeInserted(const std::string& src,
+                               const std::string& dst) {
+  // everything reaching src now reaches dst and what follows it
+  for (auto& item : reachable_) {
+    if (item.first != src && item.second.count(src) == 0) {
+      continue;
+    }
+    if (item.second.count(dst) == 0) {
+      item.second.emplace(dst);
+      AddReachable(dst, &item.second);
+    }
+  }
 }
 
-bool Graph::LevelTraverse(const Vertice& start, const Vertice& end) {
-  std::unordered_map<std::string, bool> visited;
-  visited[end.GetKey()] = false;
-  std::queue<Vertice> unvisited;
+void Graph::OnNodeEdgeDeleted(const std::string& src, const std::string& dst) {
+  // the nodes reached through src may now be unreachable
+  for (auto it = reachable_.begin(); it != reachable_.end();) {
+    if (it->first == src || it->second.count(src) > 0) {
+      it = reachable_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+bool Graph::FindReachable(const std::string& start, const std::string& end,
+                          bool* reachable) {
+  auto it = reachable_.find(start);
+  if (it == reachable_.end()) {
+    return false;
+  }
+  *reachable = it->second.count(end) > 0;
+  return true;
+}
+
+void Graph::AddReachable(const std::string& start,
+                         std::unordered_set<std::string>* reachable) {
+  std::queue<std::string> unvisited;
   unvisited.emplace(start);
   while (!unvisited.empty()) {
     auto curr = unvisited.front();
     unvisited.pop();
-    if (visited[curr.GetKey()]) {
+    auto search = successors_.find(curr);
+    if (search == successors_.end()) {
       continue;
     }
-    visited[curr.GetKey()] = true;
-    if (curr == end) {
-      break;
-    }
-    for (auto& item : list_[curr.GetKey()]) {
-      unvisited.push(item.second);
+    for (auto& item : search->second) {
+      if (reachable->emplace(item.first).second) {
+        unvisited.emplace(item.first);
+      }
     }
   }
-  return visited[end.GetKey()];
 }
 
 }  // namespace service_discovery
@@ -20,6 +20,7 @@
 #include <cstdint>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 
 #include "cyber/base/atomic_rw_lock.h"
 
@@ -119,10 +120,22 @@ class Graph {
   void DeleteOutgoingEdge(const Edge& e);
   void DeleteIncomingEdge(const Edge& e);
   void DeleteCompleteEdge(const Edge& e);
-  bool LevelTraverse(const Vertice& start, const Vertice& end);
+  void OnNodeEdgeInserted(const std::string& src, const std::string& dst);
+  void OnNodeEdgeDeleted(const std::string& src, const std::string& dst);
+  bool FindReachable(const std::string& start, const std::string& end,
+                     bool* reachable);
+  void AddReachable(const std::string& start,
+                    std::unordered_set<std::string>* reachable);
 
   EdgeInfo edges_;
   AdjacencyList list_;
+  // number of channels flowing from a node to another
+  std::unordered_map<std::string, std::unordered_map<std::string, uint32_t>>
+      successors_;
+  // nodes reachable from a node, computed on query, extended in place when an
+  // edge is inserted and dropped when an edge it may depend on is deleted
+  std::unordered_map<std::string, std::unordered_set<std::string>>
+      reachable_;
   base::AtomicRWLock rw_lock_;
 };
 
@@ -205,6 +205,49 @@ TEST(GraphTest, graph) {
   g.Delete(qa);
 }
 
+TEST(GraphTest, cached_reachability) {
+  Graph g;
+  Vertice a("a");
+  Vertice b("b");
+  Vertice c("c");
+  Vertice d("d");
+  Edge ab(a, b, "ab");
+  Edge ab2(a, b, "ab2");
+  Edge bc(b, c, "bc");
+  g.Insert(ab);
+  g.Insert(ab2);
+  g.Insert(bc);
+  EXPECT_EQ(g.GetDirectionOf(a, c), UPSTREAM);
+  EXPECT_EQ(g.GetDirectionOf(c, a), DOWNSTREAM);
+
+  // inserting extends the cached results
+  Edge cd(c, d, "cd");
+  g.Insert(cd);
+  EXPECT_EQ(g.GetDirectionOf(a, d), UPSTREAM);
+  EXPECT_EQ(g.GetDirectionOf(d, b), DOWNSTREAM);
+
+  // a still flows to b through the other channel
+  g.Delete(ab);
+  EXPECT_EQ(g.GetDirectionOf(a, d), UPSTREAM);
+  g.Delete(ab2);
+  EXPECT_EQ(g.GetDirectionOf(a, b), UNREACHABLE);
+  EXPECT_EQ(g.GetDirectionOf(a, d), UNREACHABLE);
+  EXPECT_EQ(g.GetDirectionOf(b, d), UPSTREAM);
+
+  // a cycle makes every node both upstream and downstream of the others,
+  // the upstream check comes first
+  Edge da(d, a, "da");
+  g.Insert(da);
+  g.Insert(ab);
+  EXPECT_EQ(g.GetDirectionOf(d, c), UPSTREAM);
+  EXPECT_EQ(g.GetDirectionOf(c, d), UPSTREAM);
+  g.Delete(cd);
+  EXPECT_EQ(g.GetDirectionOf(c, d), DOWNSTREAM);
+  EXPECT_EQ(g.GetDirectionOf(c, a), DOWNSTREAM);
+  EXPECT_EQ(g.GetDirectionOf(d, c), UPSTREAM);
+  EXPECT_EQ(g.GetNumOfEdge(), 3);
+}
+
 }  // namespace service_discovery
 }  // namespace cyber
 }  // namespace apollo
@@ -40,6 +40,24 @@ ChannelManager::ChannelManager() {
 
 ChannelManager::~ChannelManager() {}
 
+void ChannelManager::Shutdown() {
+  Manager::Shutdown();
+  std::lock_guard<std::mutex> lock(channel_signals_mutex_);
+  for (auto& item : channel_signals_) {
+    item.second->DisconnectAllSlots();
+  }
+}
+
+ChannelManager::ChangeConnection ChannelManager::AddChangeListener(
+    uint64_t channel_id, const ChangeFunc& func) {
+  std::lock_guard<std::mutex> lock(channel_signals_mutex_);
+  auto& signal = channel_signals_[channel_id];
+  if (signal == nullptr) {
+    signal.reset(new ChangeSignal());
+  }
+  return signal->Connect(func);
+}
+
 void ChannelManager::GetChannelNames(std::vector<std::string>* channels) {
   RETURN_IF_NULL(channels);
 
@@ -227,12 +245,32 @@ bool ChannelManager::Check(const RoleAttributes& attr) {
 }
 
 void ChannelManager::Dispose(const ChangeMsg& msg) {
+  bool changed = false;
   if (msg.operate_type() == OperateType::OPT_JOIN) {
-    DisposeJoin(msg);
+    changed = DisposeJoin(msg);
   } else {
-    DisposeLeave(msg);
+    changed = DisposeLeave(msg);
+  }
+  // repeated join or leave of the same role changes nothing in the topology
+  if (changed) {
+    Notify(msg);
+    NotifyChannel(msg);
+  }
+}
+
+void ChannelManager::NotifyChannel(const ChangeMsg& msg) {
+  ChangeSignal* signal = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(channel_signals_mutex_);
+    auto it = channel_signals_.find(msg.role_attr().channel_id());
+    if (it == channel_signals_.end()) {
+      return;
+    }
+    // signals are never erased before destruction, so it is safe to emit
+    // without holding the lock
+    signal = it->second.get();
   }
-  Notify(msg);
+  (*signal)(msg);
 }
 
 void ChannelManager::OnTopoModuleLeave(const std::string& host_name,
@@ -253,19 +291,29 @@ void ChannelManager::OnTopoModuleLeave(const std::string& host_name,
   for (auto& writer : writers_to_remove) {
     Convert(writer->attributes(), RoleType::ROLE_WRITER, OperateType::OPT_LEAVE,
             &msg);
-    DisposeLeave(msg);
-    Notify(msg);
+    if (DisposeLeave(msg)) {
+      Notify(msg);
+      NotifyChannel(msg);
+    }
   }
 
   for (auto& reader : readers_to_remove) {
     Convert(reader->attributes(), RoleType::ROLE_READER, OperateType::OPT_LEAVE,
             &msg);
-    DisposeLeave(msg);
-    Notify(msg);
+    if (DisposeLeave(msg)) {
+      Notify(msg);
+      NotifyChannel(msg);
+    }
   }
 }
 
-void ChannelManager::DisposeJoin(const ChangeMsg& msg) {
+bool ChannelManager::DisposeJoin(const ChangeMsg& msg) {
+  std::lock_guard<std::mutex> lock(roles_mutex_);
+  auto& role_ids =
+      msg.role_type() == RoleType::ROLE_WRITER ? writer_ids_ : reader_ids_;
+  if (!role_ids.insert(msg.role_attr().id()).second) {
+    return false;
+  }
   ScanMessageType(msg);
 
   Vertice v(msg.role_attr().node_name());
@@ -288,9 +336,16 @@ void ChannelManager::DisposeJoin(const ChangeMsg& msg) {
     e.set_dst(v);
   }
   node_graph_.Insert(e);
+  return true;
 }
 
-void ChannelManager::DisposeLeave(const ChangeMsg& msg) {
+bool ChannelManager::DisposeLeave(const ChangeMsg& msg) {
+  std::lock_guard<std::mutex> lock(roles_mutex_);
+  auto& role_ids =
+      msg.role_type() == RoleType::ROLE_WRITER ? writer_ids_ : reader_ids_;
+  if (role_ids.erase(msg.role_attr().id()) == 0) {
+    return false;
+  }
   Vertice v(msg.role_attr().node_name());
   Edge e;
   e.set_value(msg.role_attr().channel_name());
@@ -306,6 +361,7 @@ void ChannelManager::DisposeLeave(const ChangeMsg& msg) {
     e.set_dst(v);
   }
   node_graph_.Delete(e);
+  return true;
 }
 
 void ChannelManager::ScanMessageType(const ChangeMsg& msg) {
@@ -18,6 +18,7 @@
 #define CYBER_SERVICE_DISCOVERY_SPECIFIC_MANAGER_CHANNEL_MANAGER_H_
 
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
@@ -59,6 +60,25 @@ class ChannelManager : public Manager {
    */
   virtual ~ChannelManager();
 
+  /**
+   * @brief Shutdown module, listeners of every channel are disconnected too
+   */
+  void Shutdown() override;
+
+  using Manager::AddChangeListener;
+
+  /**
+   * @brief Add topology change listener of a single channel, func is only
+   * called when a writer or reader of `channel_id` joins or leaves, instead of
+   * on every change of the whole topology.
+   *
+   * @param channel_id id of the channel we want to listen
+   * @param func the callback function
+   * @return ChangeConnection Store it to use when you want to stop listening.
+   */
+  ChangeConnection AddChangeListener(uint64_t channel_id,
+                                     const ChangeFunc& func);
+
   /**
    * @brief Get all channel names in the topology
    *
@@ -197,8 +217,9 @@ class ChannelManager : public Manager {
   void Dispose(const ChangeMsg& msg) override;
   void OnTopoModuleLeave(const std::string& host_name, int process_id) override;
 
-  void DisposeJoin(const ChangeMsg& msg);
-  void DisposeLeave(const ChangeMsg& msg);
+  bool DisposeJoin(const ChangeMsg& msg);
+  bool DisposeLeave(const ChangeMsg& msg);
+  void NotifyChannel(const ChangeMsg& msg);
 
   void ScanMessageType(const ChangeMsg& msg);
 
@@ -212,6 +233,15 @@ class ChannelManager : public Manager {
   // key: channel_id
   WriterWarehouse channel_writers_;
   ReaderWarehouse channel_readers_;
+
+  // key: role id, used to drop the repeated join and leave messages
+  std::mutex roles_mutex_;
+  std::unordered_set<uint64_t> writer_ids_;
+  std::unordered_set<uint64_t> reader_ids_;
+
+  // key: channel_id
+  std::mutex channel_signals_mutex_;
+  std::unordered_map<uint64_t, std::unique_ptr<ChangeSignal>> channel_signals_;
 };
 
 }  // namespace service_discovery
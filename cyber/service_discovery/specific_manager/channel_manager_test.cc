@@ -269,6 +269,59 @@ TEST_F(ChannelManagerTest, change) {
   EXPECT_TRUE(channel_manager_.HasWriter("channel_0"));
 }
 
+TEST_F(ChannelManagerTest, channel_listener) {
+  uint64_t channel_id =
+      common::GlobalData::Instance()->RegisterChannel("listened");
+  int channel_changes = 0;
+  int all_changes = 0;
+  auto channel_conn = channel_manager_.AddChangeListener(
+      channel_id, [&](const ChangeMsg& msg) {
+        EXPECT_EQ(msg.role_attr().channel_id(), channel_id);
+        ++channel_changes;
+      });
+  auto all_conn = channel_manager_.AddChangeListener(
+      [&](const ChangeMsg& msg) { ++all_changes; });
+
+  RoleAttributes role_attr;
+  role_attr.set_host_name(common::GlobalData::Instance()->HostName());
+  role_attr.set_process_id(common::GlobalData::Instance()->ProcessId());
+  role_attr.set_node_name("listener");
+  role_attr.set_node_id(common::GlobalData::RegisterNode("listener"));
+  role_attr.set_channel_name("listened");
+  role_attr.set_channel_id(channel_id);
+  role_attr.set_id(transport::Identity().HashValue());
+  channel_manager_.Join(role_attr, RoleType::ROLE_WRITER);
+  EXPECT_EQ(channel_changes, 1);
+  EXPECT_EQ(all_changes, 1);
+
+  // joining again changes nothing
+  channel_manager_.Join(role_attr, RoleType::ROLE_WRITER);
+  EXPECT_EQ(channel_changes, 1);
+  EXPECT_EQ(all_changes, 1);
+  std::vector<proto::RoleAttributes> writers;
+  channel_manager_.GetWritersOfChannel("listened", &writers);
+  EXPECT_EQ(writers.size(), 1);
+
+  // changes of other channels are not delivered to the channel listener
+  role_attr.set_channel_name("not_listened");
+  role_attr.set_channel_id(
+      common::GlobalData::Instance()->RegisterChannel("not_listened"));
+  role_attr.set_id(transport::Identity().HashValue());
+  channel_manager_.Join(role_attr, RoleType::ROLE_READER);
+  EXPECT_EQ(channel_changes, 1);
+  EXPECT_EQ(all_changes, 2);
+
+  channel_manager_.GetWritersOfChannel("listened", &writers);
+  channel_manager_.Leave(writers[0], RoleType::ROLE_WRITER);
+  channel_manager_.Leave(writers[0], RoleType::ROLE_WRITER);
+  EXPECT_EQ(channel_changes, 2);
+  EXPECT_EQ(all_changes, 3);
+  EXPECT_FALSE(channel_manager_.HasWriter("listened"));
+
+  channel_manager_.RemoveChangeListener(channel_conn);
+  channel_manager_.RemoveChangeListener(all_conn);
+}
+
 TEST_F(ChannelManagerTest, get_upstream_downstream) {
   std::vector<proto::RoleAttributes> nodes;
   for (int i = 0; i < channel_num_; ++i) {
@@ -0,0 +1,122 @@
+/******************************************************************************
+ * Copyright 2024 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_STATISTICS_LATENCY_HISTOGRAM_H_
+#define CYBER_STATISTICS_LATENCY_HISTOGRAM_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace apollo {
+namespace cyber {
+namespace statistics {
+
+/**
+ * @brief Lock free HDR style histogram. Every power of two range is split
+ * into kSubBucketNum linear buckets, so a recorded value is known within
+ * 1/kSubBucketNum (~6%) of itself from 1 up to 2^kMaxExponent.
+ */
+class LatencyHistogram {
+ public:
+  static constexpr uint32_t kSubBucketBits = 4;
+  static constexpr uint32_t kSubBucketNum = 1 << kSubBucketBits;
+  static constexpr uint32_t kMaxExponent = 36;
+  static constexpr uint32_t kBucketNum =
+      (kMaxExponent - kSubBucketBits + 2) * kSubBucketNum;
+
+  void Add(uint64_t value) {
+    value = std::min(value, (uint64_t(1) << (kMaxExponent + 1)) - 1);
+    counts_[BucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+    count_.fetch_add(1, std::memory_order_relaxed);
+    sum_.fetch_add(value, std::memory_order_relaxed);
+    uint64_t max = max_.load(std::memory_order_relaxed);
+    while (value > max &&
+           !max_.compare_exchange_weak(max, value, std::memory_order_relaxed)) {
+    }
+  }
+
+  uint64_t count() const { return count_.load(std::memory_order_relaxed); }
+  uint64_t max() const { return max_.load(std::memory_order_relaxed); }
+
+  double Mean() const {
+    uint64_t count = this->count();
+    return count == 0
+               ? 0.0
+               : static_cast<double>(sum_.load(std::memory_order_relaxed)) /
+                     static_cast<double>(count);
+  }
+
+  // highest value equivalent to the bucket holding the given percentile
+  uint64_t Percentile(double percentile) const {
+    uint64_t count = this->count();
+    if (count == 0) {
+      return 0;
+    }
+    uint64_t target = static_cast<uint64_t>(
+        static_cast<double>(count) * std::min(percentile, 100.0) / 100.0);
+    target = std::max<uint64_t>(target, 1);
+    uint64_t seen = 0;
+    for (uint32_t i = 0; i < kBucketNum; ++i) {
+      seen += counts_[i].load(std::memory_order_relaxed);
+      if (seen >= target) {
+        return std::min(BucketUpperBound(i), max());
+      }
+    }
+    return max();
+  }
+
+  void Reset() {
+    for (auto& c : counts_) {
+      c.store(0, std::memory_order_relaxed);
+    }
+    count_.store(0, std::memory_order_relaxed);
+    sum_.store(0, std::memory_order_relaxed);
+    max_.store(0, std::memory_order_relaxed);
+  }
+
+  static uint32_t BucketIndex(uint64_t value) {
+    if (value < kSubBucketNum) {
+      return static_cast<uint32_t>(value);
+    }
+    uint32_t shift = 63 - __builtin_clzll(value) - kSubBucketBits;
+    return (shift + 1) * kSubBucketNum +
+           static_cast<uint32_t>((value >> shift) - kSubBucketNum);
+  }
+
+  static uint64_t BucketUpperBound(uint32_t index) {
+    if (index < kSubBucketNum) {
+      return index;
+    }
+    uint32_t shift = index / kSubBucketNum - 1;
+    uint64_t low = static_cast<uint64_t>(kSubBucketNum + index % kSubBucketNum)
+                   << shift;
+    return low + (uint64_t(1) << shift) - 1;
+  }
+
+ private:
+  std::atomic<uint64_t> counts_[kBucketNum] = {};
+  std::atomic<uint64_t> count_ = {0};
+  std::atomic<uint64_t> sum_ = {0};
+  std::atomic<uint64_t> max_ = {0};
+};
+
+}  // namespace statistics
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_STATISTICS_LATENCY_HISTOGRAM_H_
@@ -0,0 +1,68 @@
+/******************************************************************************
+ * Copyright 2024 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/statistics/latency_histogram.h"
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace cyber {
+namespace statistics {
+
+TEST(LatencyHistogramTest, bucket) {
+  for (uint64_t v = 0; v < LatencyHistogram::kSubBucketNum; ++v) {
+    EXPECT_EQ(LatencyHistogram::BucketIndex(v), v);
+    EXPECT_EQ(LatencyHistogram::BucketUpperBound(v), v);
+  }
+  uint32_t prev = 0;
+  for (uint64_t v = 1; v < (uint64_t(1) << 37); v = v * 3 / 2 + 1) {
+    auto index = LatencyHistogram::BucketIndex(v);
+    EXPECT_LT(index, LatencyHistogram::kBucketNum);
+    EXPECT_GE(index, prev);
+    EXPECT_GE(LatencyHistogram::BucketUpperBound(index), v);
+    // within one sub bucket of the value
+    EXPECT_LE(LatencyHistogram::BucketUpperBound(index) - v,
+              v / LatencyHistogram::kSubBucketNum);
+    prev = index;
+  }
+}
+
+TEST(LatencyHistogramTest, percentile) {
+  LatencyHistogram hist;
+  EXPECT_EQ(hist.count(), 0);
+  EXPECT_EQ(hist.Percentile(99), 0);
+
+  for (uint64_t v = 1; v <= 1000; ++v) {
+    hist.Add(v);
+  }
+  EXPECT_EQ(hist.count(), 1000);
+  EXPECT_EQ(hist.max(), 1000);
+  EXPECT_DOUBLE_EQ(hist.Mean(), 500.5);
+  EXPECT_NEAR(hist.Percentile(50), 500, 500 / 16);
+  EXPECT_NEAR(hist.Percentile(99), 990, 990 / 16);
+  EXPECT_EQ(hist.Percentile(100), 1000);
+
+  hist.Add(uint64_t(1) << 50);
+  EXPECT_EQ(hist.max(), (uint64_t(1) << 37) - 1);
+
+  hist.Reset();
+  EXPECT_EQ(hist.count(), 0);
+  EXPECT_EQ(hist.max(), 0);
+}
+
+}  // namespace statistics
+}  // namespace cyber
+}  // namespace apollo
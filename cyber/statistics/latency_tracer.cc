@@ -0,0 +1,232 @@
+/******************************************************************************
+ * Copyright 2024 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/statistics/latency_tracer.h"
+
+#include <time.h>
+
+#include <chrono>
+
+#include "cyber/common/file.h"
+#include "cyber/common/global_data.h"
+#include "cyber/common/log.h"
+
+namespace apollo {
+namespace cyber {
+namespace statistics {
+
+using common::GlobalData;
+using transport::TRACE_ACQUIRED;
+using transport::TRACE_DISPATCHED;
+using transport::TRACE_RECEIVED;
+using transport::TRACE_SERIALIZED;
+using transport::TRACE_TRANSMIT;
+
+namespace {
+
+void AddSpan(uint64_t begin_ns, uint64_t end_ns, LatencyHistogram* hist) {
+  if (begin_ns == 0 || end_ns == 0 || end_ns < begin_ns) {
+    return;
+  }
+  hist->Add((end_ns - begin_ns) / 1000);
+}
+
+}  // namespace
+
+const char* TraceSpanName(TraceSpan span) {
+  switch (span) {
+    case SPAN_SHM_WRITE:
+      return "shm_write";
+    case SPAN_SERIALIZE:
+      return "serialize";
+    case SPAN_NOTIFY:
+      return "notify";
+    case SPAN_DISPATCH:
+      return "dispatch";
+    case SPAN_SCHED_QUEUE:
+      return "sched_queue";
+    case SPAN_CALLBACK:
+      return "callback";
+    case SPAN_TOTAL:
+      return "total";
+    default:
+      return "unknown";
+  }
+}
+
+LatencyTracer::LatencyTracer() {
+  auto& global_conf = GlobalData::Instance()->Config();
+  if (global_conf.has_trace_conf()) {
+    conf_.CopyFrom(global_conf.trace_conf());
+    enabled_ = conf_.enable();
+  }
+  if (enabled_ && conf_.report_interval_ms() > 0) {
+    report_thread_ = std::thread(&LatencyTracer::Report, this);
+  }
+}
+
+LatencyTracer::~LatencyTracer() { Shutdown(); }
+
+uint64_t LatencyTracer::Now() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return static_cast<uint64_t>(ts.tv_sec) * 1000000000UL + ts.tv_nsec;
+}
+
+ReaderTracePtr LatencyTracer::RegisterReader(
+    const proto::RoleAttributes& role_attr) {
+  if (!enabled_) {
+    return nullptr;
+  }
+  std::lock_guard<std::mutex> lock(readers_mutex_);
+  for (auto& reader : readers_) {
+    if (reader->channel_name == role_attr.channel_name() &&
+        reader->node_name == role_attr.node_name()) {
+      return reader;
+    }
+  }
+  auto reader = std::make_shared<ReaderTrace>();
+  reader->channel_name = role_attr.channel_name();
+  reader->node_name = role_attr.node_name();
+  readers_.emplace_back(reader);
+  return reader;
+}
+
+LatencyTracer::ChannelTraces* LatencyTracer::GetChannelTraces(
+    uint64_t channel_id) {
+  std::lock_guard<std::mutex> lock(channels_mutex_);
+  auto& traces = channels_[channel_id];
+  if (traces == nullptr) {
+    traces.reset(new ChannelTraces());
+  }
+  return traces.get();
+}
+
+void LatencyTracer::OnDispatch(uint64_t channel_id, const void* msg,
+                               const TraceStamps& stamps) {
+  if (!enabled_) {
+    return;
+  }
+  auto traces = GetChannelTraces(channel_id);
+  std::lock_guard<std::mutex> lock(traces->mutex);
+  auto& pending = traces->ring[traces->next++ % kPendingTraceNum];
+  pending.msg = msg;
+  pending.stamps = stamps;
+  pending.stamps[TRACE_DISPATCHED] = Now();
+}
+
+void LatencyTracer::OnCallback(const ReaderTracePtr& reader,
+                               uint64_t channel_id, const void* msg,
+                               uint64_t start_ns, uint64_t end_ns) {
+  if (reader == nullptr) {
+    return;
+  }
+  AddSpan(start_ns, end_ns, &reader->spans[SPAN_CALLBACK]);
+
+  TraceStamps stamps = {};
+  bool found = false;
+  auto traces = GetChannelTraces(channel_id);
+  {
+    std::lock_guard<std::mutex> lock(traces->mutex);
+    // newest first, an address may be reused once its message is released
+    for (uint32_t i = 1; i <= kPendingTraceNum && i <= traces->next; ++i) {
+      auto& pending = traces->ring[(traces->next - i) % kPendingTraceNum];
+      if (pending.msg == msg) {
+        stamps = pending.stamps;
+        found = true;
+        break;
+      }
+    }
+  }
+  if (!found) {
+    return;
+  }
+
+  auto* spans = reader->spans;
+  AddSpan(stamps[TRACE_TRANSMIT], stamps[TRACE_ACQUIRED],
+          &spans[SPAN_SHM_WRITE]);
+  AddSpan(stamps[TRACE_ACQUIRED], stamps[TRACE_SERIALIZED],
+          &spans[SPAN_SERIALIZE]);
+  AddSpan(stamps[TRACE_SERIALIZED], stamps[TRACE_RECEIVED],
+          &spans[SPAN_NOTIFY]);
+  AddSpan(stamps[TRACE_RECEIVED], stamps[TRACE_DISPATCHED],
+          &spans[SPAN_DISPATCH]);
+  AddSpan(stamps[TRACE_DISPATCHED], start_ns, &spans[SPAN_SCHED_QUEUE]);
+  AddSpan(stamps[TRACE_TRANSMIT], end_ns, &spans[SPAN_TOTAL]);
+}
+
+void LatencyTracer::GetReport(proto::LatencyTraceReport* report) {
+  report->Clear();
+  report->set_process_name(GlobalData::Instance()->ProcessGroup());
+  report->set_process_id(GlobalData::Instance()->ProcessId());
+  report->set_timestamp(Now());
+  std::lock_guard<std::mutex> lock(readers_mutex_);
+  for (auto& reader : readers_) {
+    auto reader_latency = report->add_readers();
+    reader_latency->set_channel_name(reader->channel_name);
+    reader_latency->set_node_name(reader->node_name);
+    for (uint32_t span = 0; span < SPAN_NUM; ++span) {
+      auto& hist = reader->spans[span];
+      auto stage = reader_latency->add_stages();
+      stage->set_stage(TraceSpanName(static_cast<TraceSpan>(span)));
+      stage->set_count(hist.count());
+      stage->set_mean_us(hist.Mean());
+      stage->set_p50_us(hist.Percentile(50));
+      stage->set_p90_us(hist.Percentile(90));
+      stage->set_p99_us(hist.Percentile(99));
+      stage->set_max_us(hist.max());
+    }
+  }
+}
+
+void LatencyTracer::SetReportCallback(const ReportCallback& callback) {
+  std::lock_guard<std::mutex> lock(report_mutex_);
+  report_callback_ = callback;
+}
+
+void LatencyTracer::Report() {
+  proto::LatencyTraceReport report;
+  std::unique_lock<std::mutex> lock(report_mutex_);
+  while (!shutdown_.load()) {
+    report_cv_.wait_for(lock,
+                        std::chrono::milliseconds(conf_.report_interval_ms()),
+                        [this] { return shutdown_.load(); });
+    GetReport(&report);
+    if (report_callback_ != nullptr) {
+      report_callback_(report);
+    }
+    if (!conf_.dump_file().empty() &&
+        !common::SetProtoToASCIIFile(report, conf_.dump_file())) {
+      AWARN << "Failed to dump latency trace to " << conf_.dump_file();
+    }
+  }
+}
+
+void LatencyTracer::Shutdown() {
+  if (shutdown_.exchange(true)) {
+    return;
+  }
+  report_cv_.notify_all();
+  if (report_thread_.joinable()) {
+    report_thread_.join();
+  }
+  std::lock_guard<std::mutex> lock(report_mutex_);
+  report_callback_ = nullptr;
+}
+
+}  // namespace statistics
+}  // namespace cyber
+}  // namespace apollo
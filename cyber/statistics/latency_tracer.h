@@ -0,0 +1,148 @@
+/******************************************************************************
+ * Copyright 2024 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_STATISTICS_LATENCY_TRACER_H_
+#define CYBER_STATISTICS_LATENCY_TRACER_H_
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "cyber/proto/latency_trace.pb.h"
+#include "cyber/proto/perf_conf.pb.h"
+#include "cyber/proto/role_attributes.pb.h"
+
+#include "cyber/common/macros.h"
+#include "cyber/statistics/latency_histogram.h"
+#include "cyber/transport/message/trace_stamps.h"
+
+namespace apollo {
+namespace cyber {
+namespace statistics {
+
+using transport::TraceStamps;
+
+/**
+ * @brief Latencies aggregated per reader, each one between two stamps.
+ */
+enum TraceSpan : uint32_t {
+  SPAN_SHM_WRITE = 0,  // TRANSMIT -> ACQUIRED
+  SPAN_SERIALIZE,      // ACQUIRED -> SERIALIZED
+  SPAN_NOTIFY,         // SERIALIZED -> RECEIVED
+  SPAN_DISPATCH,       // RECEIVED -> DISPATCHED
+  SPAN_SCHED_QUEUE,    // DISPATCHED -> callback start
+  SPAN_CALLBACK,       // callback start -> callback end
+  SPAN_TOTAL,          // TRANSMIT -> callback end
+  SPAN_NUM,
+};
+
+const char* TraceSpanName(TraceSpan span);
+
+struct ReaderTrace {
+  std::string channel_name;
+  std::string node_name;
+  // in microsecond
+  LatencyHistogram spans[SPAN_NUM];
+};
+using ReaderTracePtr = std::shared_ptr<ReaderTrace>;
+
+/**
+ * @class LatencyTracer
+ * @brief Opt-in (`trace_conf.enable` in cyber.pb.conf) end to end latency
+ * tracing. The receive path registers the stamps of every dispatched message
+ * under its address, and the reader callback looks them up to split its
+ * transmit to callback latency into `TraceSpan`s.
+ */
+class LatencyTracer {
+ public:
+  using ReportCallback =
+      std::function<void(const proto::LatencyTraceReport& report)>;
+
+  ~LatencyTracer();
+
+  bool IsEnabled() const { return enabled_; }
+  const proto::TraceConf& conf() const { return conf_; }
+
+  static uint64_t Now();
+
+  /**
+   * @brief Get the histograms of a reader, nullptr when tracing is disabled
+   */
+  ReaderTracePtr RegisterReader(const proto::RoleAttributes& role_attr);
+
+  void OnDispatch(uint64_t channel_id, const void* msg,
+                  const TraceStamps& stamps);
+  void OnCallback(const ReaderTracePtr& reader, uint64_t channel_id,
+                  const void* msg, uint64_t start_ns, uint64_t end_ns);
+
+  void GetReport(proto::LatencyTraceReport* report);
+
+  /**
+   * @brief Invoked with a fresh report every `report_interval_ms`
+   */
+  void SetReportCallback(const ReportCallback& callback);
+
+  void Shutdown();
+
+ private:
+  // enough to cover the pending_queue_size of any sane reader
+  static const uint32_t kPendingTraceNum = 64;
+
+  struct PendingTrace {
+    const void* msg = nullptr;
+    TraceStamps stamps = {};
+  };
+
+  struct ChannelTraces {
+    std::mutex mutex;
+    std::array<PendingTrace, kPendingTraceNum> ring;
+    uint64_t next = 0;
+  };
+
+  ChannelTraces* GetChannelTraces(uint64_t channel_id);
+  void Report();
+
+  bool enabled_ = false;
+  proto::TraceConf conf_;
+
+  std::mutex channels_mutex_;
+  std::unordered_map<uint64_t, std::unique_ptr<ChannelTraces>> channels_;
+
+  std::mutex readers_mutex_;
+  std::vector<ReaderTracePtr> readers_;
+
+  std::mutex report_mutex_;
+  std::condition_variable report_cv_;
+  ReportCallback report_callback_;
+  std::thread report_thread_;
+  std::atomic<bool> shutdown_ = {false};
+
+  DECLARE_SINGLETON(LatencyTracer)
+};
+
+}  // namespace statistics
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_STATISTICS_LATENCY_TRACER_H_
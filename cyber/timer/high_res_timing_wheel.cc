@@ -0,0 +1,186 @@
+/******************************************************************************
+ * Copyright 2024 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/timer/high_res_timing_wheel.h"
+
+#include <sys/prctl.h>
+#include <time.h>
+
+#include <cerrno>
+#include <utility>
+#include <vector>
+
+#include "cyber/common/log.h"
+#include "cyber/scheduler/scheduler_factory.h"
+
+namespace apollo {
+namespace cyber {
+
+namespace {
+constexpr uint64_t kResolutionNs = HR_TIMER_RESOLUTION_US * 1000;
+}  // namespace
+
+HighResTimingWheel::HighResTimingWheel() {}
+
+HighResTimingWheel::~HighResTimingWheel() { Shutdown(); }
+
+uint64_t HighResTimingWheel::NowNs() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return static_cast<uint64_t>(ts.tv_sec) * 1000000000ULL + ts.tv_nsec;
+}
+
+void HighResTimingWheel::Start() {
+  std::lock_guard<std::mutex> lock(running_mutex_);
+  if (!running_) {
+    ADEBUG << "HighResTimingWheel start ok";
+    {
+      std::lock_guard<std::mutex> wheel_lock(mutex_);
+      processed_tick_ = NowNs() / kResolutionNs;
+    }
+    running_ = true;
+    tick_thread_ = std::thread([this]() { this->TickFunc(); });
+    scheduler::Instance()->SetInnerThreadAttr("hr_timer", &tick_thread_);
+  }
+}
+
+void HighResTimingWheel::Shutdown() {
+  std::lock_guard<std::mutex> lock(running_mutex_);
+  if (running_) {
+    {
+      std::lock_guard<std::mutex> wheel_lock(mutex_);
+      running_ = false;
+    }
+    cv_.notify_all();
+    if (tick_thread_.joinable()) {
+      tick_thread_.join();
+    }
+  }
+}
+
+void HighResTimingWheel::AddTask(const std::shared_ptr<HighResTimerTask>& task) {
+  if (!running_) {
+    Start();
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (task_num_ == 0) {
+      // the tick thread was idle, do not make it catch up with the idle ticks
+      processed_tick_ = NowNs() / kResolutionNs;
+    }
+    Insert(task);
+    ++task_num_;
+  }
+  cv_.notify_one();
+}
+
+void HighResTimingWheel::RemoveTask(
+    const std::shared_ptr<HighResTimerTask>& task) {
+  // dropped by the tick thread the next time its slot is visited
+  task->cancelled = true;
+}
+
+void HighResTimingWheel::Insert(const std::shared_ptr<HighResTimerTask>& task) {
+  uint64_t tick = ToTick(task->deadline_ns);
+  if (tick <= processed_tick_) {
+    tick = processed_tick_ + 1;
+  }
+  task->rounds = (tick - processed_tick_ - 1) / HR_WORK_WHEEL_SIZE;
+  wheel_[tick % HR_WORK_WHEEL_SIZE].push_back(task);
+}
+
+void HighResTimingWheel::TickFunc() {
+  // the default 50us slack of normal threads is half a tick
+  prctl(PR_SET_TIMERSLACK, 1UL);
+  std::vector<std::pair<std::shared_ptr<HighResTimerTask>, uint64_t>> expired;
+  while (running_) {
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      if (task_num_ == 0) {
+        cv_.wait(lock, [this] { return task_num_ > 0 || !running_; });
+        if (!running_) {
+          break;
+        }
+      }
+    }
+
+    uint64_t next_ns = 0;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      next_ns = (processed_tick_ + 1) * kResolutionNs;
+    }
+    struct timespec ts;
+    ts.tv_sec = static_cast<time_t>(next_ns / 1000000000ULL);
+    ts.tv_nsec = static_cast<long>(next_ns % 1000000000ULL);  // NOLINT
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) ==
+           EINTR) {
+    }
+
+    uint64_t now_ns = NowNs();
+    uint64_t now_tick = now_ns / kResolutionNs;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      for (uint64_t tick = processed_tick_ + 1; tick <= now_tick; ++tick) {
+        auto& bucket = wheel_[tick % HR_WORK_WHEEL_SIZE];
+        for (auto it = bucket.begin(); it != bucket.end();) {
+          auto& task = *it;
+          if (task->cancelled) {
+            --task_num_;
+            it = bucket.erase(it);
+            continue;
+          }
+          if (task->rounds > 0) {
+            --task->rounds;
+            ++it;
+            continue;
+          }
+          expired.emplace_back(task, task->deadline_ns);
+          it = bucket.erase(it);
+        }
+      }
+      if (now_tick > processed_tick_) {
+        processed_tick_ = now_tick;
+      }
+      for (auto& item : expired) {
+        auto& task = item.first;
+        if (task->period_ns == 0) {
+          --task_num_;
+          continue;
+        }
+        task->deadline_ns += task->period_ns;
+        if (task->deadline_ns <= now_ns) {
+          uint64_t missed =
+              (now_ns - task->deadline_ns) / task->period_ns + 1;
+          task->deadline_ns += missed * task->period_ns;
+          if (task->statistics != nullptr) {
+            task->statistics->overruns += missed;
+          }
+        }
+        Insert(task);
+      }
+    }
+
+    for (auto& item : expired) {
+      if (!item.first->cancelled) {
+        item.first->callback(item.second);
+      }
+    }
+    expired.clear();
+  }
+}
+
+}  // namespace cyber
+}  // namespace apollo
@@ -0,0 +1,96 @@
+/******************************************************************************
+ * Copyright 2024 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_TIMER_HIGH_RES_TIMING_WHEEL_H_
+#define CYBER_TIMER_HIGH_RES_TIMING_WHEEL_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "cyber/common/macros.h"
+#include "cyber/timer/timer_statistics.h"
+
+namespace apollo {
+namespace cyber {
+
+static const uint64_t HR_TIMER_RESOLUTION_US = 100;
+static const uint64_t HR_WORK_WHEEL_SIZE = 1024;
+
+struct HighResTimerTask {
+  uint64_t timer_id = 0;
+  // zero for oneshot timers
+  uint64_t period_ns = 0;
+  // absolute CLOCK_MONOTONIC time of the next expiration
+  uint64_t deadline_ns = 0;
+  // full turns of the wheel left before the deadline
+  uint64_t rounds = 0;
+  std::atomic<bool> cancelled = {false};
+  // called on the wheel thread with the deadline that expired, must be short
+  std::function<void(uint64_t deadline_ns)> callback;
+  std::shared_ptr<TimerStatistics> statistics;
+};
+
+/**
+ * @brief Timing wheel of 100us ticks driven by clock_nanosleep on absolute
+ * deadlines, so that periodic timers do not drift. Periodic tasks are
+ * rearmed from their previous deadline, missed periods are skipped and
+ * counted as overruns. The tick thread sleeps while no task is added.
+ */
+class HighResTimingWheel {
+ public:
+  ~HighResTimingWheel();
+
+  void Start();
+
+  void Shutdown();
+
+  void AddTask(const std::shared_ptr<HighResTimerTask>& task);
+
+  void RemoveTask(const std::shared_ptr<HighResTimerTask>& task);
+
+  static uint64_t NowNs();
+
+ private:
+  void TickFunc();
+  void Insert(const std::shared_ptr<HighResTimerTask>& task);
+
+  static uint64_t ToTick(uint64_t time_ns) {
+    const uint64_t resolution_ns = HR_TIMER_RESOLUTION_US * 1000;
+    return (time_ns + resolution_ns - 1) / resolution_ns;
+  }
+
+  std::atomic<bool> running_ = {false};
+  std::mutex running_mutex_;
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::list<std::shared_ptr<HighResTimerTask>> wheel_[HR_WORK_WHEEL_SIZE];
+  uint64_t task_num_ = 0;
+  uint64_t processed_tick_ = 0;
+  std::thread tick_thread_;
+
+  DECLARE_SINGLETON(HighResTimingWheel)
+};
+
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_TIMER_HIGH_RES_TIMING_WHEEL_H_
@@ -17,8 +17,13 @@
 #include "cyber/timer/timer.h"
 
 #include <cmath>
+#include <cstdlib>
+#include <string>
 
 #include "cyber/common/global_data.h"
+#include "cyber/croutine/croutine.h"
+#include "cyber/scheduler/scheduler_factory.h"
+#include "cyber/task/task.h"
 
 namespace apollo {
 namespace cyber {
@@ -28,6 +33,39 @@ std::atomic<uint64_t> global_timer_id = {0};
 uint64_t GenerateTimerId() { return global_timer_id.fetch_add(1); }
 }  // namespace
 
+using croutine::CRoutine;
+using croutine::RoutineState;
+
+struct Timer::HighResContext {
+  std::mutex mutex;
+  bool stopped = false;
+  std::function<void()> callback;
+  std::shared_ptr<TimerStatistics> statistics;
+  uint64_t period_ns = 0;
+  uint64_t last_start_ns = 0;
+  // expirations not yet run by the croutine of TimerDispatch::CROUTINE
+  std::atomic<uint64_t> pending = {0};
+  std::atomic<uint64_t> pending_deadline_ns = {0};
+  uint64_t croutine_id = 0;
+  std::string croutine_name;
+
+  void Run(uint64_t deadline_ns) {
+    std::lock_guard<std::mutex> lg(mutex);
+    if (stopped) {
+      return;
+    }
+    uint64_t start = HighResTimingWheel::NowNs();
+    statistics->lateness.Add(start > deadline_ns ? start - deadline_ns : 0);
+    if (period_ns > 0 && last_start_ns > 0) {
+      uint64_t interval = start - last_start_ns;
+      statistics->jitter.Add(interval > period_ns ? interval - period_ns
+                                                  : period_ns - interval);
+    }
+    last_start_ns = start;
+    callback();
+  }
+};
+
 Timer::Timer() {
   timing_wheel_ = TimingWheel::Instance();
   timer_id_ = GenerateTimerId();
@@ -73,13 +111,21 @@ bool Timer::InitTimerTask() {
     };
   } else {
     std::weak_ptr<TimerTask> task_weak_ptr = task_;
-    task_->callback = [callback = this->timer_opt_.callback, task_weak_ptr]() {
+    task_->callback = [callback = this->timer_opt_.callback, task_weak_ptr,
+                       statistics = statistics_]() {
       auto task = task_weak_ptr.lock();
       if (!task) {
         return;
       }
       std::lock_guard<std::mutex> lg(task->mutex);
       auto start = Time::MonoTime().ToNanosecond();
+      if (task->last_execute_time_ns != 0) {
+        int64_t error_ns = static_cast<int64_t>(start -
+                                                task->last_execute_time_ns) -
+                           static_cast<int64_t>(task->interval_ms * 1000000);
+        statistics->lateness.Add(error_ns > 0 ? error_ns : 0);
+        statistics->jitter.Add(std::abs(error_ns));
+      }
       callback();
       auto end = Time::MonoTime().ToNanosecond();
       uint64_t execute_time_ns = end - start;
@@ -126,12 +172,108 @@ bool Timer::InitTimerTask() {
   return true;
 }
 
+bool Timer::InitHighResTimerTask() {
+  if (timer_opt_.period_us < HR_TIMER_RESOLUTION_US) {
+    AERROR << "High resolution period must not be less than "
+           << HR_TIMER_RESOLUTION_US << "us";
+    return false;
+  }
+
+  auto context = std::make_shared<HighResContext>();
+  context->callback = timer_opt_.callback;
+  context->statistics = statistics_;
+  context->period_ns = timer_opt_.oneshot ? 0 : timer_opt_.period_us * 1000;
+
+  auto task = std::make_shared<HighResTimerTask>();
+  task->timer_id = timer_id_;
+  task->period_ns = context->period_ns;
+  task->deadline_ns = HighResTimingWheel::NowNs() + timer_opt_.period_us * 1000;
+  task->statistics = statistics_;
+
+  std::weak_ptr<HighResContext> weak_context = context;
+  switch (timer_opt_.dispatch) {
+    case TimerDispatch::INLINE:
+      task->callback = [weak_context](uint64_t deadline_ns) {
+        auto context = weak_context.lock();
+        if (context) {
+          context->Run(deadline_ns);
+        }
+      };
+      break;
+    case TimerDispatch::CROUTINE: {
+      context->croutine_name = timer_opt_.croutine_name.empty()
+                                   ? "timer_" + std::to_string(timer_id_)
+                                   : timer_opt_.croutine_name;
+      context->croutine_id =
+          common::GlobalData::RegisterTaskName(context->croutine_name);
+      auto routine = [weak_context]() {
+        for (;;) {
+          CRoutine::GetCurrentRoutine()->set_state(RoutineState::DATA_WAIT);
+          uint64_t pending = 0;
+          {
+            auto context = weak_context.lock();
+            if (context) {
+              pending = context->pending.exchange(0);
+            }
+            if (pending > 0) {
+              // expirations that piled up run once, like a late period
+              context->statistics->overruns += pending - 1;
+              context->Run(context->pending_deadline_ns.load());
+            }
+          }
+          if (pending > 0) {
+            CRoutine::Yield(RoutineState::READY);
+          } else {
+            CRoutine::Yield();
+          }
+        }
+      };
+      if (!scheduler::Instance()->CreateTask(routine,
+                                             context->croutine_name)) {
+        AERROR << "Create croutine " << context->croutine_name
+               << " for timer [" << timer_id_ << "] failed";
+        return false;
+      }
+      task->callback = [weak_context](uint64_t deadline_ns) {
+        auto context = weak_context.lock();
+        if (context) {
+          context->pending_deadline_ns = deadline_ns;
+          context->pending.fetch_add(1);
+          scheduler::Instance()->NotifyTask(context->croutine_id);
+        }
+      };
+      break;
+    }
+    case TimerDispatch::ASYNC:
+    default:
+      task->callback = [weak_context](uint64_t deadline_ns) {
+        cyber::Async([weak_context, deadline_ns]() {
+          auto context = weak_context.lock();
+          if (context) {
+            context->Run(deadline_ns);
+          }
+        });
+      };
+      break;
+  }
+  high_res_context_ = context;
+  high_res_task_ = task;
+  return true;
+}
+
 void Timer::Start() {
   if (!common::GlobalData::Instance()->IsRealityMode()) {
     return;
   }
 
   if (!started_.exchange(true)) {
+    if (timer_opt_.period_us > 0) {
+      if (InitHighResTimerTask()) {
+        HighResTimingWheel::Instance()->AddTask(high_res_task_);
+        AINFO << "start high resolution timer [" << timer_id_ << "]";
+      }
+      return;
+    }
     if (InitTimerTask()) {
       timing_wheel_->AddTask(task_);
       AINFO << "start timer [" << task_->timer_id_ << "]";
@@ -140,7 +282,23 @@ void Timer::Start() {
 }
 
 void Timer::Stop() {
-  if (started_.exchange(false) && task_) {
+  if (!started_.exchange(false)) {
+    return;
+  }
+  if (high_res_task_) {
+    AINFO << "stop high resolution timer, the timer_id: " << timer_id_;
+    HighResTimingWheel::Instance()->RemoveTask(high_res_task_);
+    {
+      std::lock_guard<std::mutex> lg(high_res_context_->mutex);
+      high_res_context_->stopped = true;
+    }
+    if (!high_res_context_->croutine_name.empty()) {
+      scheduler::Instance()->RemoveTask(high_res_context_->croutine_name);
+    }
+    high_res_task_.reset();
+    high_res_context_.reset();
+  }
+  if (task_) {
     AINFO << "stop timer, the timer_id: " << timer_id_;
     // using a shared pointer to hold task_->mutex before task_ reset
     auto tmp_task = task_;
@@ -152,7 +310,7 @@ void Timer::Stop() {
 }
 
 Timer::~Timer() {
-  if (task_) {
+  if (task_ || high_res_task_) {
     Stop();
   }
 }
@@ -19,12 +19,27 @@
 
 #include <atomic>
 #include <memory>
+#include <string>
 
+#include "cyber/timer/high_res_timing_wheel.h"
+#include "cyber/timer/timer_statistics.h"
 #include "cyber/timer/timing_wheel.h"
 
 namespace apollo {
 namespace cyber {
 
+/**
+ * @brief Where the callbacks of high resolution timers run
+ */
+enum class TimerDispatch {
+  /** On the TaskManager, like the timing wheel timers */
+  ASYNC,
+  /** Directly on the high resolution timer thread, for very short callbacks */
+  INLINE,
+  /** On a croutine of its own, which the scheduler conf can place */
+  CROUTINE,
+};
+
 /**
  * @brief The options of timer
  *
@@ -61,6 +76,23 @@ struct TimerOption {
    * False: perform the callback every timed period
    */
   bool oneshot;
+
+  /**
+   * @brief The period of the timer on the high resolution backend, unit is
+   * us. When not zero, period is ignored and the timer fires from a thread
+   * with 100us ticks instead of the 2ms timing wheel.
+   * min: 100
+   */
+  uint64_t period_us = 0;
+
+  /** Where the callbacks of a high resolution timer run */
+  TimerDispatch dispatch = TimerDispatch::ASYNC;
+
+  /**
+   * The croutine name for TimerDispatch::CROUTINE, which the scheduler conf
+   * refers to. Defaults to "timer_<id>".
+   */
+  std::string croutine_name;
 };
 
 /**
@@ -109,12 +141,28 @@ class Timer {
    */
   void Stop();
 
+  /**
+   * @brief Get the lateness and jitter histograms of this timer
+   *
+   * @return The statistics, updated while the timer runs
+   */
+  std::shared_ptr<const TimerStatistics> GetStatistics() const {
+    return statistics_;
+  }
+
  private:
+  struct HighResContext;
+
   bool InitTimerTask();
+  bool InitHighResTimerTask();
   uint64_t timer_id_;
   TimerOption timer_opt_;
   TimingWheel* timing_wheel_ = nullptr;
   std::shared_ptr<TimerTask> task_;
+  std::shared_ptr<HighResTimerTask> high_res_task_;
+  std::shared_ptr<HighResContext> high_res_context_;
+  std::shared_ptr<TimerStatistics> statistics_ =
+      std::make_shared<TimerStatistics>();
   std::atomic<bool> started_ = {false};
 };
 
@@ -0,0 +1,106 @@
+/******************************************************************************
+ * Copyright 2024 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_TIMER_TIMER_STATISTICS_H_
+#define CYBER_TIMER_TIMER_STATISTICS_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+namespace apollo {
+namespace cyber {
+
+/**
+ * @brief Lock free histogram of durations in nanoseconds, with buckets from
+ * 10us up to 20ms. Add may be called while another thread reads it.
+ */
+class TimerHistogram {
+ public:
+  static constexpr size_t kBucketNum = 12;
+
+  static uint64_t BucketUpperBound(size_t index) {
+    static const uint64_t kBounds[kBucketNum] = {
+        10000ULL,   20000ULL,   50000ULL,    100000ULL,
+        200000ULL,  500000ULL,  1000000ULL,  2000000ULL,
+        5000000ULL, 10000000ULL, 20000000ULL,
+        std::numeric_limits<uint64_t>::max()};
+    return kBounds[index];
+  }
+
+  void Add(uint64_t value_ns) {
+    size_t index = 0;
+    while (value_ns >= BucketUpperBound(index)) {
+      ++index;
+    }
+    buckets_[index].fetch_add(1, std::memory_order_relaxed);
+    count_.fetch_add(1, std::memory_order_relaxed);
+    uint64_t max = max_.load(std::memory_order_relaxed);
+    while (value_ns > max &&
+           !max_.compare_exchange_weak(max, value_ns,
+                                       std::memory_order_relaxed)) {
+    }
+  }
+
+  uint64_t bucket(size_t index) const {
+    return buckets_[index].load(std::memory_order_relaxed);
+  }
+  uint64_t count() const { return count_.load(std::memory_order_relaxed); }
+  uint64_t max() const { return max_.load(std::memory_order_relaxed); }
+
+  /**
+   * @brief Upper bound of the bucket holding the given ratio of samples, e.g.
+   * 0.99 for the p99. Returns max() for the last bucket and 0 when empty.
+   */
+  uint64_t Percentile(double ratio) const {
+    uint64_t total = count();
+    if (total == 0) {
+      return 0;
+    }
+    uint64_t target = static_cast<uint64_t>(ratio * static_cast<double>(total));
+    uint64_t seen = 0;
+    for (size_t i = 0; i + 1 < kBucketNum; ++i) {
+      seen += bucket(i);
+      if (seen >= target) {
+        return BucketUpperBound(i);
+      }
+    }
+    return max();
+  }
+
+ private:
+  std::atomic<uint64_t> buckets_[kBucketNum] = {};
+  std::atomic<uint64_t> count_ = {0};
+  std::atomic<uint64_t> max_ = {0};
+};
+
+/**
+ * @brief Per timer statistics. Lateness is the delay of a callback start
+ * behind its deadline, jitter the deviation of the time between two callback
+ * starts from the period.
+ */
+struct TimerStatistics {
+  TimerHistogram lateness;
+  TimerHistogram jitter;
+  // expirations skipped or coalesced because the callback ran too long
+  std::atomic<uint64_t> overruns = {0};
+};
+
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_TIMER_TIMER_STATISTICS_H_
@@ -18,6 +18,7 @@
 
 #include "cyber/timer/timer.h"
 
+#include <atomic>
 #include <memory>
 #include <utility>
 
@@ -97,6 +98,59 @@ TEST(TimerTest, sim_mode) {
   }
 }
 
+TEST(TimerTest, high_resolution) {
+  std::atomic<int> count = {0};
+  TimerOption opt(0, [&count] { ++count; }, false);
+  opt.period_us = 500;
+  opt.dispatch = TimerDispatch::INLINE;
+  Timer timer(opt);
+  timer.Start();
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+  timer.Stop();
+  int fired = count;
+  // 400 periods, leave room for a loaded machine
+  EXPECT_LT(200, fired);
+  EXPECT_GE(401, fired);
+  auto statistics = timer.GetStatistics();
+  EXPECT_EQ(static_cast<uint64_t>(fired), statistics->lateness.count());
+  EXPECT_EQ(static_cast<uint64_t>(fired - 1), statistics->jitter.count());
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  EXPECT_EQ(fired, count);
+}
+
+TEST(TimerTest, high_resolution_croutine) {
+  std::atomic<int> count = {0};
+  TimerOption opt(0, [&count] { ++count; }, false);
+  opt.period_us = 1000;
+  opt.dispatch = TimerDispatch::CROUTINE;
+  opt.croutine_name = "high_resolution_croutine_test";
+  Timer timer(opt);
+  timer.Start();
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+  timer.Stop();
+  EXPECT_LT(0, count);
+  EXPECT_LT(0, timer.GetStatistics()->lateness.count());
+}
+
+TEST(TimerTest, high_resolution_oneshot) {
+  std::atomic<int> count = {0};
+  TimerOption opt(0, [&count] { ++count; }, true);
+  opt.period_us = 50;
+  Timer timer(opt);
+  timer.Start();
+  // below the resolution, refused
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  EXPECT_EQ(0, count);
+  timer.Stop();
+
+  opt.period_us = 2000;
+  timer.SetTimerOption(opt);
+  timer.Start();
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  EXPECT_EQ(1, count);
+  timer.Stop();
+}
+
 }  // namespace timer
 }  // namespace cyber
 }  // namespace apollo
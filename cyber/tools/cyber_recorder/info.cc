@@ -16,6 +16,14 @@
 
 #include "cyber/tools/cyber_recorder/info.h"
 
+#include <algorithm>
+#include <future>
+#include <limits>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+
+#include "cyber/base/thread_pool.h"
 #include "cyber/record/record_message.h"
 
 namespace apollo {
@@ -27,50 +35,132 @@ using apollo::cyber::record::kGB;
 using apollo::cyber::record::kKB;
 using apollo::cyber::record::kMB;
 
+namespace {
+
+constexpr int kWidth = 16;
+
+void PrintTime(uint64_t begin_time, uint64_t end_time) {
+  auto begin_time_s = static_cast<double>(begin_time) / 1e9;
+  auto end_time_s = static_cast<double>(end_time) / 1e9;
+  auto duration_s = end_time_s - begin_time_s;
+  auto begin_time_str = UnixSecondsToString(static_cast<int>(begin_time_s));
+  auto end_time_str = UnixSecondsToString(static_cast<int>(end_time_s));
+  std::cout << std::setw(kWidth) << "duration: " << duration_s << " Seconds"
+            << std::endl;
+  std::cout << std::setw(kWidth) << "begin_time: " << begin_time_str
+            << std::endl;
+  std::cout << std::setw(kWidth) << "end_time: " << end_time_str << std::endl;
+}
+
+void PrintSize(uint64_t size) {
+  std::cout << std::setw(kWidth) << "size: " << size << " Bytes";
+  if (size >= kGB) {
+    std::cout << " (" << static_cast<float>(size) / kGB << " GB)";
+  } else if (size >= kMB) {
+    std::cout << " (" << static_cast<float>(size) / kMB << " MB)";
+  } else if (size >= kKB) {
+    std::cout << " (" << static_cast<float>(size) / kKB << " KB)";
+  }
+  std::cout << std::endl;
+}
+
+void PrintChannel(const std::string& name, uint64_t message_number,
+                  const std::string& message_type) {
+  std::cout << std::setw(kWidth) << "";
+  std::cout << resetiosflags(std::ios::right);
+  std::cout << std::setw(50) << name;
+  std::cout << setiosflags(std::ios::right);
+  std::cout << std::setw(8) << message_number;
+  std::cout << std::setw(0) << " messages: ";
+  std::cout << message_type;
+  std::cout << std::endl;
+}
+
+}  // namespace
+
 Info::Info() {}
 
 Info::~Info() {}
 
 bool Info::Display(const std::string& file) {
+  RecordInfo info;
+  Load(file, &info);
+  return Print(info);
+}
+
+bool Info::Display(const std::vector<std::string>& files,
+                   uint32_t thread_num) {
+  if (thread_num == 0) {
+    thread_num = std::max(1U, std::thread::hardware_concurrency());
+  }
+  std::vector<RecordInfo> infos(files.size());
+  {
+    base::ThreadPool pool(std::min<size_t>(thread_num, files.size()),
+                          files.size() + 1);
+    std::vector<std::future<void>> loaded;
+    for (size_t i = 0; i < files.size(); ++i) {
+      loaded.emplace_back(pool.Enqueue(&Info::Load, files[i], &infos[i]));
+    }
+    for (auto& result : loaded) {
+      if (result.valid()) {
+        result.wait();
+      }
+    }
+  }
+
+  bool result = true;
+  for (size_t i = 0; i < infos.size(); ++i) {
+    if (i > 0) {
+      std::cout << std::endl;
+    }
+    result = Print(infos[i]) && result;
+  }
+  if (infos.size() > 1) {
+    std::cout << std::endl;
+    PrintTotal(infos);
+  }
+  return result;
+}
+
+void Info::Load(const std::string& file, RecordInfo* info) {
+  info->file = file;
   RecordFileReader file_reader;
   if (!file_reader.Open(file)) {
-    AERROR << "open record file error. file: " << file;
+    return;
+  }
+  info->opened = true;
+  info->header = file_reader.GetHeader();
+  if (file_reader.ReadIndex()) {
+    info->has_index = true;
+    info->index = file_reader.GetIndex();
+  }
+  file_reader.Close();
+}
+
+bool Info::Print(const RecordInfo& info) {
+  if (!info.opened) {
+    AERROR << "open record file error. file: " << info.file;
     return false;
   }
-  proto::Header hdr = file_reader.GetHeader();
+  const proto::Header& hdr = info.header;
 
+  std::cout << resetiosflags(std::ios::right);
   std::cout << setiosflags(std::ios::left);
   std::cout << setiosflags(std::ios::fixed);
 
-  int w = 16;
+  int w = kWidth;
   // file name
-  std::cout << std::setw(w) << "record_file: " << file << std::endl;
+  std::cout << std::setw(w) << "record_file: " << info.file << std::endl;
 
   // version
   std::cout << std::setw(w) << "version: " << hdr.major_version() << "."
             << hdr.minor_version() << std::endl;
 
   // time and duration
-  auto begin_time_s = static_cast<double>(hdr.begin_time()) / 1e9;
-  auto end_time_s = static_cast<double>(hdr.end_time()) / 1e9;
-  auto duration_s = end_time_s - begin_time_s;
-  auto begin_time_str = UnixSecondsToString(static_cast<int>(begin_time_s));
-  auto end_time_str = UnixSecondsToString(static_cast<int>(end_time_s));
-  std::cout << std::setw(w) << "duration: " << duration_s << " Seconds"
-            << std::endl;
-  std::cout << std::setw(w) << "begin_time: " << begin_time_str << std::endl;
-  std::cout << std::setw(w) << "end_time: " << end_time_str << std::endl;
+  PrintTime(hdr.begin_time(), hdr.end_time());
 
   // size
-  std::cout << std::setw(w) << "size: " << hdr.size() << " Bytes";
-  if (hdr.size() >= kGB) {
-    std::cout << " (" << static_cast<float>(hdr.size()) / kGB << " GB)";
-  } else if (hdr.size() >= kMB) {
-    std::cout << " (" << static_cast<float>(hdr.size()) / kMB << " MB)";
-  } else if (hdr.size() >= kKB) {
-    std::cout << " (" << static_cast<float>(hdr.size()) / kKB << " KB)";
-  }
-  std::cout << std::endl;
+  PrintSize(hdr.size());
 
   // is_complete
   std::cout << std::setw(w) << "is_complete:";
@@ -89,32 +179,75 @@ bool Info::Display(const std::string& file) {
   std::cout << std::setw(w) << "channel_number: " << hdr.channel_number()
             << std::endl;
 
-  // read index section
-  if (!file_reader.ReadIndex()) {
-    AERROR << "read index section of the file fail. file: " << file;
+  // index section
+  if (!info.has_index) {
+    AERROR << "read index section of the file fail. file: " << info.file;
     return false;
   }
 
   // channel info
   std::cout << std::setw(w) << "channel_info: " << std::endl;
-  proto::Index idx = file_reader.GetIndex();
-  for (int i = 0; i < idx.indexes_size(); ++i) {
-    ChannelCache* cache = idx.mutable_indexes(i)->mutable_channel_cache();
-    if (idx.mutable_indexes(i)->type() == proto::SectionType::SECTION_CHANNEL) {
-      std::cout << std::setw(w) << "";
-      std::cout << resetiosflags(std::ios::right);
-      std::cout << std::setw(50) << cache->name();
-      std::cout << setiosflags(std::ios::right);
-      std::cout << std::setw(8) << cache->message_number();
-      std::cout << std::setw(0) << " messages: ";
-      std::cout << cache->message_type();
-      std::cout << std::endl;
+  for (const auto& single_idx : info.index.indexes()) {
+    if (single_idx.type() == proto::SectionType::SECTION_CHANNEL) {
+      const ChannelCache& cache = single_idx.channel_cache();
+      PrintChannel(cache.name(), cache.message_number(), cache.message_type());
     }
   }
-  file_reader.Close();
   return true;
 }
 
+void Info::PrintTotal(const std::vector<RecordInfo>& infos) {
+  uint64_t record_number = 0;
+  uint64_t begin_time = std::numeric_limits<uint64_t>::max();
+  uint64_t end_time = 0;
+  uint64_t size = 0;
+  uint64_t message_number = 0;
+  // message number and type of each channel, in order of appearance
+  std::vector<std::string> channel_names;
+  std::unordered_map<std::string, std::pair<uint64_t, std::string>> channels;
+  for (const auto& info : infos) {
+    if (!info.opened) {
+      continue;
+    }
+    ++record_number;
+    begin_time = std::min(begin_time, info.header.begin_time());
+    end_time = std::max(end_time, info.header.end_time());
+    size += info.header.size();
+    message_number += info.header.message_number();
+    for (const auto& single_idx : info.index.indexes()) {
+      if (single_idx.type() != proto::SectionType::SECTION_CHANNEL) {
+        continue;
+      }
+      const ChannelCache& cache = single_idx.channel_cache();
+      auto inserted = channels.emplace(
+          cache.name(), std::make_pair(0, cache.message_type()));
+      if (inserted.second) {
+        channel_names.push_back(cache.name());
+      }
+      inserted.first->second.first += cache.message_number();
+    }
+  }
+  if (record_number == 0) {
+    return;
+  }
+
+  std::cout << resetiosflags(std::ios::right);
+  int w = kWidth;
+  std::cout << std::setw(w) << "total: " << record_number << " of "
+            << infos.size() << " record files" << std::endl;
+  PrintTime(begin_time, end_time);
+  PrintSize(size);
+  std::cout << std::setw(w) << "message_number: " << message_number
+            << std::endl;
+  std::cout << std::setw(w) << "channel_number: " << channels.size()
+            << std::endl;
+  std::cout << std::setw(w) << "channel_info: " << std::endl;
+  for (const auto& name : channel_names) {
+    const auto& channel = channels[name];
+    PrintChannel(name, channel.first, channel.second);
+  }
+}
+
 }  // namespace record
 }  // namespace cyber
 }  // namespace apollo
@@ -20,6 +20,7 @@
 #include <chrono>
 #include <iomanip>
 #include <string>
+#include <vector>
 
 #include "cyber/common/time_conversion.h"
 #include "cyber/proto/record.pb.h"
@@ -36,6 +37,25 @@ class Info {
   Info();
   ~Info();
   bool Display(const std::string& file);
+  /**
+   * @brief Display the records, followed by their totals when there are
+   * several. Only the header and index sections are read, by thread_num
+   * threads, 0 for one per core.
+   */
+  bool Display(const std::vector<std::string>& files, uint32_t thread_num);
+
+ private:
+  struct RecordInfo {
+    std::string file;
+    bool opened = false;
+    bool has_index = false;
+    proto::Header header;
+    proto::Index index;
+  };
+
+  static void Load(const std::string& file, RecordInfo* info);
+  bool Print(const RecordInfo& info);
+  void PrintTotal(const std::vector<RecordInfo>& infos);
 };
 
 }  // namespace record
@@ -49,10 +49,10 @@ using apollo::cyber::record::Recorder;
 using apollo::cyber::record::Recoverer;
 using apollo::cyber::record::Spliter;
 
-const char INFO_OPTIONS[] = "h";
-const char RECORD_OPTIONS[] = "o:ac:k:i:m:hCH";
+const char INFO_OPTIONS[] = "jh";
+const char RECORD_OPTIONS[] = "o:ac:k:i:m:zhCH";
 const char PLAY_OPTIONS[] = "f:ac:k:lr:b:e:s:d:p:h";
-const char SPLIT_OPTIONS[] = "f:o:c:k:b:e:h";
+const char SPLIT_OPTIONS[] = "f:o:c:k:b:e:j:h";
 const char RECOVER_OPTIONS[] = "f:o:h";
 
 void DisplayUsage(const std::string& binary);
@@ -73,7 +73,7 @@ void DisplayUsage(const std::string& binary) {
 
 void DisplayUsage(const std::string& binary, const std::string& command) {
   if (command == "info") {
-    std::cout << "usage: cyber_recorder info file" << std::endl;
+    std::cout << "usage: cyber_recorder info file [file...]" << std::endl;
     std::cout << "usage: " << binary << " " << command << " [options]"
               << std::endl;
     DisplayUsage(binary, command, INFO_OPTIONS);
@@ -153,6 +153,14 @@ void DisplayUsage(const std::string& binary, const std::string& command,
         std::cout << "\t-m, --segment-size <MB>\t\t\t" << command
                   << " segmented every n megabyte(s)" << std::endl;
         break;
+      case 'z':
+        std::cout << "\t-z, --compress\t\t\t\tzlib compress the chunks"
+                  << std::endl;
+        break;
+      case 'j':
+        std::cout << "\t-j, --jobs <n>\t\t\t\t" << command
+                  << " with n threads, one per core by default" << std::endl;
+        break;
       case 'h':
         std::cout << "\t-h, --help\t\t\t\tshow help message" << std::endl;
         break;
@@ -179,13 +187,9 @@ int main(int argc, char** argv) {
     return -1;
   }
   const std::string command(argv[1]);
-  std::string file_path;
-  if (argc >= 3) {
-    file_path = std::string(argv[2]);
-  }
 
   int long_index = 0;
-  const std::string short_opts = "f:c:k:o:alr:b:e:s:d:p:i:m:hCH";
+  const std::string short_opts = "f:c:k:o:alr:b:e:s:d:p:i:m:zj:hCH";
   static const struct option long_opts[] = {
       {"files", required_argument, nullptr, 'f'},
       {"white-channel", required_argument, nullptr, 'c'},
@@ -201,6 +205,8 @@ int main(int argc, char** argv) {
       {"preload", required_argument, nullptr, 'p'},
       {"segment-interval", required_argument, nullptr, 'i'},
       {"segment-size", required_argument, nullptr, 'm'},
+      {"compress", no_argument, nullptr, 'z'},
+      {"jobs", required_argument, nullptr, 'j'},
       {"help", no_argument, nullptr, 'h'},
       {"cpu-profile", no_argument, nullptr, 'C'},
       {"heap-profule", no_argument, nullptr, 'H'}};
@@ -219,6 +225,7 @@ int main(int argc, char** argv) {
   double opt_start = 0;
   uint64_t opt_delay = 0;
   uint32_t opt_preload = 3;
+  uint32_t opt_jobs = 0;
   auto opt_header = HeaderBuilder::GetHeader();
 
   do {
@@ -296,6 +303,10 @@ int main(int argc, char** argv) {
       case 'a':
         opt_all = true;
         break;
+      case 'z':
+        opt_header.set_compress(
+            apollo::cyber::proto::CompressType::COMPRESS_ZLIB);
+        break;
       case 'l':
         opt_loop = true;
         break;
@@ -397,6 +408,25 @@ int main(int argc, char** argv) {
           return -1;
         }
         break;
+      case 'j':
+        try {
+          int jobs = std::stoi(optarg);
+          if (jobs < 0) {
+            std::cout << "Argument is less than zero: -j/--jobs "
+                      << std::string(optarg) << std::endl;
+            return -1;
+          }
+          opt_jobs = jobs;
+        } catch (std::invalid_argument& ia) {
+          std::cout << "Invalid argument: -j/--jobs " << std::string(optarg)
+                    << std::endl;
+          return -1;
+        } catch (const std::out_of_range& e) {
+          std::cout << "Argument is out of range: -j/--jobs "
+                    << std::string(optarg) << std::endl;
+          return -1;
+        }
+        break;
       case 'h':
         DisplayUsage(binary, command);
         return 0;
@@ -407,20 +437,27 @@ int main(int argc, char** argv) {
 
   // cyber_recorder info
   if (command == "info") {
-    if (file_path.empty()) {
-      std::cout << "usage: cyber_recorder info file" << std::endl;
-      return -1;
-    }
-    if (!apollo::cyber::common::PathIsAbsolute(file_path)) {
-      auto file_path_abs =
-          apollo::cyber::common::GetEnv("PWD") + "/" + std::string(file_path);
-      if (std::filesystem::exists(file_path_abs)) {
-        file_path = file_path_abs;
+    // getopt moves the command and the files behind the options
+    std::vector<std::string> info_files;
+    for (int i = optind + 1; i < argc; ++i) {
+      std::string path(argv[i]);
+      if (!apollo::cyber::common::PathIsAbsolute(path)) {
+        auto file_path_abs = apollo::cyber::common::GetEnv("PWD") + "/" + path;
+        if (std::filesystem::exists(file_path_abs)) {
+          path = file_path_abs;
+        }
       }
+      info_files.push_back(path);
+    }
+    if (info_files.empty()) {
+      std::cout << "usage: cyber_recorder info file [file...]" << std::endl;
+      return -1;
     }
     ::apollo::cyber::Init(argv[0]);
     Info info;
-    bool info_result = info.Display(file_path);
+    bool info_result = info_files.size() == 1
+                           ? info.Display(info_files[0])
+                           : info.Display(info_files, opt_jobs);
     return info_result ? 0 : -1;
   } else if (command == "recover") {
     if (opt_file_vec.empty()) {
@@ -527,8 +564,8 @@ int main(int argc, char** argv) {
       std::cout << "Must specify file option (-f)." << std::endl;
       return -1;
     }
-    if (opt_file_vec.size() > 1 || opt_output_vec.size() > 1) {
-      std::cout << "Too many input/output file option (-f/-o)." << std::endl;
+    if (opt_output_vec.size() > 1) {
+      std::cout << "Too many output file option (-o)." << std::endl;
       return -1;
     }
     if (opt_output_vec.empty()) {
@@ -536,8 +573,9 @@ int main(int argc, char** argv) {
       opt_output_vec.push_back(default_output_file);
     }
     ::apollo::cyber::Init(argv[0]);
-    Spliter spliter(opt_file_vec[0], opt_output_vec[0], opt_white_channels,
-                    opt_black_channels, opt_begin, opt_end);
+    // several input files are merged in time order
+    Spliter spliter(opt_file_vec, opt_output_vec[0], opt_white_channels,
+                    opt_black_channels, opt_begin, opt_end, opt_jobs);
     bool split_result = spliter.Proc();
     return split_result ? 0 : -1;
   }
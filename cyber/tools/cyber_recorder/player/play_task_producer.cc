@@ -18,6 +18,7 @@
 
 #include <iostream>
 #include <limits>
+#include <utility>
 
 #include "cyber/common/log.h"
 #include "cyber/common/time_conversion.h"
@@ -112,7 +113,8 @@ bool PlayTaskProducer::ReadRecordInfo() {
 
   // loop each file
   for (auto& file : play_param_.files_to_play) {
-    auto record_reader = std::make_shared<RecordReader>(file);
+    // contents are copied once into the RawMessage straight from the mapping
+    auto record_reader = std::make_shared<RecordReader>(file, true);
     if (!record_reader->IsValid()) {
       continue;
     }
@@ -216,7 +218,7 @@ void PlayTaskProducer::WriteRecordProgress(const double& curr_time_s,
   record_info.set_record_name(play_param_.record_id);
   std::string content;
   record_info.SerializeToString(&content);
-  auto raw_msg = std::make_shared<message::RawMessage>(content);
+  auto raw_msg = std::make_shared<message::RawMessage>(std::move(content));
   writers_[record_info_channel]->Write(raw_msg);
 }
 
@@ -299,7 +301,8 @@ void PlayTaskProducer::FillPlayTaskBuffer() {
       continue;
     }
 
-    auto raw_msg = std::make_shared<message::RawMessage>(itr->content);
+    auto raw_msg = std::make_shared<message::RawMessage>(
+        std::string(itr->GetContent()));
     auto task = std::make_shared<PlayTask>(raw_msg, search->second, itr->time,
                                            itr->time);
     task_buffer_->Push(task);
@@ -350,7 +353,8 @@ void PlayTaskProducer::ThreadFuncUnderPreloadMode() {
           continue;
         }
 
-        auto raw_msg = std::make_shared<message::RawMessage>(itr->content);
+        auto raw_msg = std::make_shared<message::RawMessage>(
+            std::string(itr->GetContent()));
         auto task = std::make_shared<PlayTask>(raw_msg, search->second,
                                                itr->time, itr->time);
         task_buffer_->Push(task);
@@ -404,7 +408,8 @@ void PlayTaskProducer::ThreadFunc() {
           continue;
         }
 
-        auto raw_msg = std::make_shared<message::RawMessage>(itr->content);
+        auto raw_msg = std::make_shared<message::RawMessage>(
+            std::string(itr->GetContent()));
         auto task = std::make_shared<PlayTask>(
             raw_msg, search->second, itr->time, itr->time + plus_time_ns);
         task_buffer_->Push(task);
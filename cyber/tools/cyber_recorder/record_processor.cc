@@ -0,0 +1,365 @@
+/******************************************************************************
+ * Copyright 2024 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/tools/cyber_recorder/record_processor.h"
+
+#include <sys/stat.h>
+
+#include <algorithm>
+#include <deque>
+#include <future>
+#include <queue>
+#include <thread>
+#include <unordered_set>
+
+#include "cyber/common/log.h"
+
+namespace apollo {
+namespace cyber {
+namespace record {
+
+using apollo::cyber::proto::Channel;
+using apollo::cyber::proto::ChunkBody;
+using apollo::cyber::proto::ChunkHeader;
+using apollo::cyber::proto::SectionType;
+using apollo::cyber::proto::SingleMessage;
+
+namespace {
+
+// chunks loaded ahead of the one being merged, per thread
+constexpr size_t kChunksPerThread = 2;
+
+struct MergeEntry {
+  uint64_t time = 0;
+  uint64_t chunk_seq = 0;
+  std::shared_ptr<ChunkBody> chunk;
+  int next = 0;
+};
+
+struct LaterEntry {
+  bool operator()(const MergeEntry& a, const MergeEntry& b) const {
+    return a.time != b.time ? a.time > b.time : a.chunk_seq > b.chunk_seq;
+  }
+};
+
+}  // namespace
+
+bool RecordFilter::HasChannel(const std::string& channel_name) const {
+  if (!white_channels.empty() &&
+      std::find(white_channels.begin(), white_channels.end(), channel_name) ==
+          white_channels.end()) {
+    return false;
+  }
+  return std::find(black_channels.begin(), black_channels.end(),
+                   channel_name) == black_channels.end();
+}
+
+RecordProcessor::RecordProcessor(const std::vector<std::string>& files,
+                                 const RecordFilter& filter,
+                                 uint32_t thread_num)
+    : filter_(filter),
+      thread_num_(thread_num > 0
+                      ? thread_num
+                      : std::max(1U, std::thread::hardware_concurrency())) {
+  files_.resize(files.size());
+  for (size_t i = 0; i < files.size(); ++i) {
+    files_[i].path = files[i];
+  }
+}
+
+RecordProcessor::~RecordProcessor() {
+  // the loading tasks use the readers, wait for them before closing those
+  pool_ = nullptr;
+}
+
+bool RecordProcessor::Open() {
+  // every record is opened by a task of its own, the queue must hold them all
+  pool_.reset(new base::ThreadPool(
+      thread_num_, files_.size() + thread_num_ * kChunksPerThread + 1));
+  std::vector<std::future<bool>> opened;
+  opened.reserve(files_.size());
+  for (size_t i = 0; i < files_.size(); ++i) {
+    opened.emplace_back(pool_->Enqueue([this, i]() { return OpenFile(i); }));
+  }
+  bool ok = true;
+  for (auto& result : opened) {
+    if (!result.valid() || !result.get()) {
+      ok = false;
+    }
+  }
+  if (!ok) {
+    return false;
+  }
+
+  std::unordered_set<std::string> channel_names;
+  for (auto& file : files_) {
+    for (auto& channel : file.channels) {
+      if (channel_names.insert(channel.name()).second) {
+        channels_.emplace_back(std::move(channel));
+      }
+    }
+    file.channels.clear();
+    chunks_.insert(chunks_.end(), file.chunks.begin(), file.chunks.end());
+    file.chunks.clear();
+    skipped_chunk_num_ += file.skipped_chunk_num;
+  }
+  // the merge needs the chunks in order of their first message
+  std::stable_sort(chunks_.begin(), chunks_.end(),
+                   [](const ChunkTask& a, const ChunkTask& b) {
+                     return a.begin_time < b.begin_time;
+                   });
+  for (const auto& chunk : chunks_) {
+    begin_time_ = std::min(begin_time_, chunk.begin_time);
+    end_time_ = std::max(end_time_, chunk.end_time);
+  }
+  AINFO << "planned " << chunks_.size() << " chunks of " << files_.size()
+        << " record files, skipped " << skipped_chunk_num_ << " chunks.";
+  return true;
+}
+
+bool RecordProcessor::OpenFile(size_t file_index) {
+  RecordFile* file = &files_[file_index];
+  file->reader.reset(new RecordFileReader());
+  if (!file->reader->Open(file->path)) {
+    AERROR << "open record file failed, file: " << file->path;
+    return false;
+  }
+  if (file->reader->GetHeader().is_complete() && file->reader->ReadIndex()) {
+    return PlanFromIndex(file_index);
+  }
+  AWARN << "record file has no index, walk through its sections, file: "
+        << file->path;
+  return PlanFromSections(file_index);
+}
+
+bool RecordProcessor::PlanFromIndex(size_t file_index) {
+  RecordFile* file = &files_[file_index];
+  const proto::SingleIndex* chunk_header = nullptr;
+  for (const auto& single_index : file->reader->GetIndex().indexes()) {
+    switch (single_index.type()) {
+      case SectionType::SECTION_CHANNEL: {
+        const auto& cache = single_index.channel_cache();
+        if (filter_.HasChannel(cache.name())) {
+          Channel channel;
+          channel.set_name(cache.name());
+          channel.set_message_type(cache.message_type());
+          channel.set_proto_desc(cache.proto_desc());
+          file->channels.emplace_back(std::move(channel));
+        }
+        break;
+      }
+      case SectionType::SECTION_CHUNK_HEADER: {
+        chunk_header = &single_index;
+        break;
+      }
+      case SectionType::SECTION_CHUNK_BODY: {
+        if (chunk_header == nullptr) {
+          AERROR << "chunk body without chunk header in index, file: "
+                 << file->path << ", position: " << single_index.position();
+          return false;
+        }
+        const auto& cache = chunk_header->chunk_header_cache();
+        ChunkTask chunk;
+        chunk.file_index = file_index;
+        chunk.body_position = single_index.position();
+        chunk.begin_time = cache.begin_time();
+        chunk.end_time = cache.end_time();
+        AddChunk(chunk, cache.channel_names());
+        chunk_header = nullptr;
+        break;
+      }
+      default:
+        break;
+    }
+  }
+  return true;
+}
+
+bool RecordProcessor::PlanFromSections(size_t file_index) {
+  RecordFile* file = &files_[file_index];
+  RecordFileReader* reader = file->reader.get();
+  struct stat file_stat;
+  if (stat(file->path.c_str(), &file_stat) != 0) {
+    AERROR << "stat record file failed, file: " << file->path;
+    return false;
+  }
+  const google::protobuf::RepeatedPtrField<std::string> no_channel_names;
+  ChunkHeader chunk_header;
+  bool has_chunk_header = false;
+  reader->Reset();
+  while (!reader->EndOfFile()) {
+    Section section;
+    if (!reader->ReadSection(&section) ||
+        section.type == SectionType::SECTION_INDEX) {
+      break;
+    }
+    int64_t position = reader->CurrentPosition() - sizeof(section);
+    if (section.size < 0 ||
+        position + static_cast<int64_t>(sizeof(section)) + section.size >
+            file_stat.st_size) {
+      AWARN << "section cut off at the end of the record is skipped, file: "
+            << file->path << ", position: " << position;
+      break;
+    }
+    switch (section.type) {
+      case SectionType::SECTION_CHANNEL: {
+        Channel channel;
+        if (!reader->ReadSection<Channel>(section.size, &channel)) {
+          AERROR << "read channel section fail, file: " << file->path;
+          return false;
+        }
+        if (filter_.HasChannel(channel.name())) {
+          file->channels.emplace_back(std::move(channel));
+        }
+        break;
+      }
+      case SectionType::SECTION_CHUNK_HEADER: {
+        if (!reader->ReadSection<ChunkHeader>(section.size, &chunk_header)) {
+          AERROR << "read chunk header section fail, file: " << file->path;
+          return false;
+        }
+        has_chunk_header = true;
+        break;
+      }
+      case SectionType::SECTION_CHUNK_BODY: {
+        if (!has_chunk_header) {
+          AERROR << "chunk body without chunk header, file: " << file->path
+                 << ", position: " << position;
+          return false;
+        }
+        ChunkTask chunk;
+        chunk.file_index = file_index;
+        chunk.body_position = position;
+        chunk.begin_time = chunk_header.begin_time();
+        chunk.end_time = chunk_header.end_time();
+        AddChunk(chunk, no_channel_names);
+        has_chunk_header = false;
+        if (!reader->SkipSection(section.size)) {
+          return false;
+        }
+        break;
+      }
+      default: {
+        AERROR << "this section should not be here, section type: "
+               << section.type << ", file: " << file->path;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+void RecordProcessor::AddChunk(
+    const ChunkTask& chunk,
+    const google::protobuf::RepeatedPtrField<std::string>& channel_names) {
+  RecordFile* file = &files_[chunk.file_index];
+  bool wanted = filter_.Overlaps(chunk.begin_time, chunk.end_time);
+  if (wanted && !channel_names.empty()) {
+    wanted = std::any_of(channel_names.begin(), channel_names.end(),
+                         [this](const std::string& channel_name) {
+                           return filter_.HasChannel(channel_name);
+                         });
+  }
+  if (wanted) {
+    file->chunks.push_back(chunk);
+  } else {
+    ++file->skipped_chunk_num;
+  }
+}
+
+RecordProcessor::ChunkBodyPtr RecordProcessor::LoadChunk(
+    const ChunkTask& chunk) {
+  auto body = std::make_shared<ChunkBody>();
+  if (!files_[chunk.file_index].reader->ReadChunkBodyAt(chunk.body_position,
+                                                        body.get())) {
+    return nullptr;
+  }
+  auto messages = body->mutable_messages();
+  auto wanted_end = std::stable_partition(
+      messages->pointer_begin(), messages->pointer_end(),
+      [this](const SingleMessage* message) {
+        return filter_.HasTime(message->time()) &&
+               filter_.HasChannel(message->channel_name());
+      });
+  int wanted_num = static_cast<int>(wanted_end - messages->pointer_begin());
+  messages->DeleteSubrange(wanted_num, messages->size() - wanted_num);
+  // messages are appended to a chunk as they arrive, not strictly in order
+  std::stable_sort(messages->pointer_begin(), messages->pointer_end(),
+                   [](const SingleMessage* a, const SingleMessage* b) {
+                     return a->time() < b->time();
+                   });
+  return body;
+}
+
+bool RecordProcessor::Process(const MessageHandler& handler) {
+  if (pool_ == nullptr) {
+    AERROR << "record processor is not opened.";
+    return false;
+  }
+  const size_t window = thread_num_ * kChunksPerThread;
+  std::deque<std::future<ChunkBodyPtr>> loading;
+  size_t next_load = 0;
+  std::priority_queue<MergeEntry, std::vector<MergeEntry>, LaterEntry> merging;
+
+  // hand over the merged messages before time, all of them if drain is set
+  auto emit = [&handler, &merging](uint64_t time, bool drain) {
+    while (!merging.empty() && (drain || merging.top().time < time)) {
+      MergeEntry entry = merging.top();
+      merging.pop();
+      if (!handler(entry.chunk->messages(entry.next))) {
+        return false;
+      }
+      if (++entry.next < entry.chunk->messages_size()) {
+        entry.time = entry.chunk->messages(entry.next).time();
+        merging.push(std::move(entry));
+      }
+    }
+    return true;
+  };
+
+  for (size_t i = 0; i < chunks_.size(); ++i) {
+    while (next_load < chunks_.size() && loading.size() < window) {
+      ChunkTask chunk = chunks_[next_load++];
+      loading.emplace_back(
+          pool_->Enqueue([this, chunk]() { return LoadChunk(chunk); }));
+    }
+    // no message of this or a later chunk is before its begin time
+    if (!emit(chunks_[i].begin_time, false)) {
+      return false;
+    }
+    auto loaded = std::move(loading.front());
+    loading.pop_front();
+    ChunkBodyPtr chunk = loaded.valid() ? loaded.get() : nullptr;
+    if (chunk == nullptr) {
+      AERROR << "load chunk failed, file: "
+             << files_[chunks_[i].file_index].path
+             << ", position: " << chunks_[i].body_position;
+      return false;
+    }
+    if (chunk->messages_size() > 0) {
+      MergeEntry entry;
+      entry.time = chunk->messages(0).time();
+      entry.chunk_seq = i;
+      entry.chunk = std::move(chunk);
+      merging.push(std::move(entry));
+    }
+  }
+  return emit(0, true);
+}
+
+}  // namespace record
+}  // namespace cyber
+}  // namespace apollo
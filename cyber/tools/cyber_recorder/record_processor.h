@@ -0,0 +1,137 @@
+/******************************************************************************
+ * Copyright 2024 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_TOOLS_CYBER_RECORDER_RECORD_PROCESSOR_H_
+#define CYBER_TOOLS_CYBER_RECORDER_RECORD_PROCESSOR_H_
+
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "cyber/proto/record.pb.h"
+
+#include "cyber/base/thread_pool.h"
+#include "cyber/record/file/record_file_reader.h"
+
+namespace apollo {
+namespace cyber {
+namespace record {
+
+struct RecordFilter {
+  std::vector<std::string> white_channels;
+  std::vector<std::string> black_channels;
+  uint64_t begin_time = 0;
+  uint64_t end_time = std::numeric_limits<uint64_t>::max();
+
+  bool HasChannel(const std::string& channel_name) const;
+  bool HasTime(uint64_t time) const {
+    return time >= begin_time && time <= end_time;
+  }
+  bool Overlaps(uint64_t begin, uint64_t end) const {
+    return begin <= end_time && end >= begin_time;
+  }
+};
+
+/**
+ * @class RecordProcessor
+ * @brief Reads the messages of a set of records which pass a filter, merged
+ * in time order. The chunks to read are planned from the index sections, a
+ * chunk out of the time range or without any wanted channel is never read.
+ * The planned chunks are loaded, decompressed and filtered by a pool of
+ * threads while the handler consumes the ones before them.
+ */
+class RecordProcessor {
+ public:
+  using MessageHandler = std::function<bool(const proto::SingleMessage&)>;
+
+  /**
+   * @param thread_num threads loading chunks, 0 for one per core.
+   */
+  RecordProcessor(const std::vector<std::string>& files,
+                  const RecordFilter& filter, uint32_t thread_num = 0);
+  ~RecordProcessor();
+
+  /**
+   * @brief Open the records and plan the chunks to read. A record without an
+   * index, e.g. one which is still being written, is planned by walking its
+   * section headers.
+   */
+  bool Open();
+
+  /**
+   * @brief The wanted channels of all records, in order of appearance.
+   */
+  const std::vector<proto::Channel>& GetChannels() const { return channels_; }
+  uint64_t GetBeginTime() const { return begin_time_; }
+  uint64_t GetEndTime() const { return end_time_; }
+  uint64_t GetChunkNumber() const { return chunks_.size(); }
+  uint64_t GetSkippedChunkNumber() const { return skipped_chunk_num_; }
+
+  /**
+   * @brief Call handler with every wanted message in time order, messages of
+   * the same time keep the order of the records and chunks holding them.
+   * Stops and returns false when a chunk can not be read or the handler
+   * returns false.
+   */
+  bool Process(const MessageHandler& handler);
+
+ private:
+  struct ChunkTask {
+    size_t file_index = 0;
+    int64_t body_position = 0;
+    uint64_t begin_time = 0;
+    uint64_t end_time = 0;
+  };
+
+  struct RecordFile {
+    std::string path;
+    std::unique_ptr<RecordFileReader> reader;
+    std::vector<proto::Channel> channels;
+    std::vector<ChunkTask> chunks;
+    uint64_t skipped_chunk_num = 0;
+  };
+
+  using ChunkBodyPtr = std::shared_ptr<proto::ChunkBody>;
+
+  bool OpenFile(size_t file_index);
+  bool PlanFromIndex(size_t file_index);
+  bool PlanFromSections(size_t file_index);
+  // channel_names of the chunk are empty for records without them in index
+  void AddChunk(const ChunkTask& chunk,
+                const google::protobuf::RepeatedPtrField<std::string>&
+                    channel_names);
+  ChunkBodyPtr LoadChunk(const ChunkTask& chunk);
+
+  RecordFilter filter_;
+  uint32_t thread_num_;
+  std::vector<RecordFile> files_;
+  std::unique_ptr<base::ThreadPool> pool_ = nullptr;
+
+  std::vector<proto::Channel> channels_;
+  std::vector<ChunkTask> chunks_;
+  uint64_t skipped_chunk_num_ = 0;
+  uint64_t begin_time_ = std::numeric_limits<uint64_t>::max();
+  uint64_t end_time_ = 0;
+};
+
+}  // namespace record
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_TOOLS_CYBER_RECORDER_RECORD_PROCESSOR_H_
@@ -0,0 +1,330 @@
+/******************************************************************************
+ * Copyright 2024 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/tools/cyber_recorder/record_processor.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "cyber/record/file/record_file_reader.h"
+#include "cyber/record/file/record_file_writer.h"
+#include "cyber/record/header_builder.h"
+
+namespace apollo {
+namespace cyber {
+namespace record {
+
+using apollo::cyber::proto::Channel;
+using apollo::cyber::proto::ChunkBody;
+using apollo::cyber::proto::ChunkHeaderCache;
+using apollo::cyber::proto::Header;
+using apollo::cyber::proto::SectionType;
+using apollo::cyber::proto::SingleMessage;
+
+namespace {
+
+constexpr char kChanA[] = "/test/a";
+constexpr char kChanB[] = "/test/b";
+constexpr char kChanC[] = "/test/c";
+constexpr char kMsgType[] = "apollo.cyber.proto.Test";
+constexpr char kProtoDesc[] = "1234567890";
+// a chunk is flushed once it spans more than this, so a record usually holds
+// several of them, how many depends on the flush thread
+constexpr uint64_t kChunkInterval = 100;
+
+struct IndexedChunk {
+  ChunkHeaderCache header;
+  int64_t body_position = 0;
+};
+
+std::string ToString(const SingleMessage& message) {
+  return message.channel_name() + "|" + std::to_string(message.time()) + "|" +
+         message.content();
+}
+
+void WriteRecord(const std::string& path,
+                 const std::vector<std::string>& channel_names,
+                 const std::vector<SingleMessage>& messages) {
+  RecordFileWriter writer;
+  ASSERT_TRUE(writer.Open(path));
+  Header header = HeaderBuilder::GetHeaderWithChunkParams(kChunkInterval, 0);
+  header.set_segment_interval(0);
+  header.set_segment_raw_size(0);
+  ASSERT_TRUE(writer.WriteHeader(header));
+  for (const auto& channel_name : channel_names) {
+    Channel channel;
+    channel.set_name(channel_name);
+    channel.set_message_type(kMsgType);
+    channel.set_proto_desc(kProtoDesc);
+    ASSERT_TRUE(writer.WriteChannel(channel));
+  }
+  for (const auto& message : messages) {
+    ASSERT_TRUE(writer.WriteMessage(message));
+  }
+  writer.Close();
+}
+
+SingleMessage NewMessage(const std::string& channel_name, uint64_t time,
+                         const std::string& content) {
+  SingleMessage message;
+  message.set_channel_name(channel_name);
+  message.set_time(time);
+  message.set_content(content);
+  return message;
+}
+
+// reads all chunk bodies of a record one after another
+void ReadSerial(const std::string& path, std::vector<ChunkBody>* bodies) {
+  RecordFileReader reader;
+  ASSERT_TRUE(reader.Open(path));
+  while (!reader.EndOfFile()) {
+    Section section;
+    if (!reader.ReadSection(&section) ||
+        section.type == SectionType::SECTION_INDEX) {
+      break;
+    }
+    if (section.type == SectionType::SECTION_CHUNK_BODY) {
+      bodies->emplace_back();
+      ASSERT_TRUE(reader.ReadSection<ChunkBody>(section.size, &bodies->back()));
+    } else {
+      ASSERT_TRUE(reader.SkipSection(section.size));
+    }
+  }
+}
+
+void ReadIndexedChunks(const std::string& path,
+                       std::vector<IndexedChunk>* chunks) {
+  RecordFileReader reader;
+  ASSERT_TRUE(reader.Open(path));
+  ASSERT_TRUE(reader.ReadIndex());
+  for (const auto& single_index : reader.GetIndex().indexes()) {
+    if (single_index.type() == SectionType::SECTION_CHUNK_HEADER) {
+      chunks->emplace_back();
+      chunks->back().header = single_index.chunk_header_cache();
+    } else if (single_index.type() == SectionType::SECTION_CHUNK_BODY) {
+      ASSERT_FALSE(chunks->empty());
+      chunks->back().body_position = single_index.position();
+    }
+  }
+}
+
+}  // namespace
+
+class RecordProcessorTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    // the first two records interleave in time, the first one has messages
+    // of two channels at the same time
+    std::vector<SingleMessage> messages1;
+    std::vector<SingleMessage> messages2;
+    for (int i = 0; i < 50; ++i) {
+      uint64_t time = 1000 + 20 * i;
+      messages1.push_back(NewMessage(kChanA, time, "1a" + std::to_string(i)));
+      messages1.push_back(NewMessage(kChanB, time, "1b" + std::to_string(i)));
+      messages2.push_back(
+          NewMessage(kChanA, time + 10, "2a" + std::to_string(i)));
+    }
+    // the third one is later than both and only has a channel of its own
+    std::vector<SingleMessage> messages3;
+    for (int i = 0; i < 20; ++i) {
+      messages3.push_back(
+          NewMessage(kChanC, 5000 + 10 * i, "3c" + std::to_string(i)));
+    }
+    WriteRecord(files_[0], {kChanA, kChanB}, messages1);
+    WriteRecord(files_[1], {kChanA}, messages2);
+    WriteRecord(files_[2], {kChanC}, messages3);
+
+    for (const auto& file : files_) {
+      std::vector<ChunkBody> bodies;
+      ReadSerial(file, &bodies);
+      for (const auto& body : bodies) {
+        serial_.insert(serial_.end(), body.messages().begin(),
+                       body.messages().end());
+      }
+      ReadIndexedChunks(file, &chunks_);
+    }
+  }
+
+  void TearDown() override {
+    for (const auto& file : files_) {
+      remove(file.c_str());
+    }
+  }
+
+  // the messages of a serial read which pass filter, in time order
+  std::vector<std::string> Expected(const RecordFilter& filter) const {
+    std::vector<SingleMessage> messages;
+    for (const auto& message : serial_) {
+      if (filter.HasTime(message.time()) &&
+          filter.HasChannel(message.channel_name())) {
+        messages.push_back(message);
+      }
+    }
+    std::stable_sort(messages.begin(), messages.end(),
+                     [](const SingleMessage& a, const SingleMessage& b) {
+                       return a.time() < b.time();
+                     });
+    std::vector<std::string> result;
+    for (const auto& message : messages) {
+      result.push_back(ToString(message));
+    }
+    return result;
+  }
+
+  uint64_t ExpectedSkipped(const RecordFilter& filter) const {
+    uint64_t skipped = 0;
+    for (const auto& chunk : chunks_) {
+      const auto& names = chunk.header.channel_names();
+      if (!filter.Overlaps(chunk.header.begin_time(),
+                           chunk.header.end_time()) ||
+          std::none_of(names.begin(), names.end(),
+                       [&filter](const std::string& name) {
+                         return filter.HasChannel(name);
+                       })) {
+        ++skipped;
+      }
+    }
+    return skipped;
+  }
+
+  uint64_t CountChunks(const std::string& channel_name) const {
+    return std::count_if(
+        chunks_.begin(), chunks_.end(), [&channel_name](const IndexedChunk& c) {
+          const auto& names = c.header.channel_names();
+          return std::find(names.begin(), names.end(), channel_name) !=
+                 names.end();
+        });
+  }
+
+  static std::vector<std::string> Process(RecordProcessor* processor) {
+    std::vector<std::string> result;
+    EXPECT_TRUE(processor->Process([&result](const SingleMessage& message) {
+      result.push_back(ToString(message));
+      return true;
+    }));
+    return result;
+  }
+
+  const std::vector<std::string> files_ = {"record_processor_test_1.record",
+                                           "record_processor_test_2.record",
+                                           "record_processor_test_3.record"};
+  std::vector<SingleMessage> serial_;
+  std::vector<IndexedChunk> chunks_;
+};
+
+TEST_F(RecordProcessorTest, merge_in_time_order) {
+  ASSERT_EQ(170, serial_.size());
+
+  for (uint32_t thread_num : {1, 3}) {
+    RecordFilter filter;
+    RecordProcessor processor(files_, filter, thread_num);
+    ASSERT_TRUE(processor.Open());
+    EXPECT_EQ(chunks_.size(), processor.GetChunkNumber());
+    EXPECT_EQ(0, processor.GetSkippedChunkNumber());
+    EXPECT_EQ(1000, processor.GetBeginTime());
+    EXPECT_EQ(5190, processor.GetEndTime());
+    ASSERT_EQ(3, processor.GetChannels().size());
+    EXPECT_EQ(kChanA, processor.GetChannels()[0].name());
+    EXPECT_EQ(kChanB, processor.GetChannels()[1].name());
+    EXPECT_EQ(kChanC, processor.GetChannels()[2].name());
+    EXPECT_EQ(Expected(filter), Process(&processor));
+  }
+}
+
+TEST_F(RecordProcessorTest, filter_channels) {
+  RecordFilter filter;
+  filter.white_channels = {kChanA, kChanC};
+  filter.black_channels = {kChanC};
+  RecordProcessor processor(files_, filter, 2);
+  ASSERT_TRUE(processor.Open());
+
+  // the chunks of the third record never hold a wanted channel
+  EXPECT_EQ(ExpectedSkipped(filter), processor.GetSkippedChunkNumber());
+  EXPECT_GE(processor.GetSkippedChunkNumber(), CountChunks(kChanC));
+  EXPECT_EQ(chunks_.size(),
+            processor.GetChunkNumber() + processor.GetSkippedChunkNumber());
+  ASSERT_EQ(1, processor.GetChannels().size());
+  EXPECT_EQ(kChanA, processor.GetChannels()[0].name());
+
+  auto expected = Expected(filter);
+  EXPECT_EQ(100, expected.size());
+  EXPECT_EQ(expected, Process(&processor));
+}
+
+TEST_F(RecordProcessorTest, filter_time) {
+  RecordFilter filter;
+  filter.begin_time = 1300;
+  filter.end_time = 1600;
+  RecordProcessor processor(files_, filter, 2);
+  ASSERT_TRUE(processor.Open());
+
+  // every chunk of the third record is after the end time
+  EXPECT_EQ(ExpectedSkipped(filter), processor.GetSkippedChunkNumber());
+  EXPECT_GE(processor.GetSkippedChunkNumber(), CountChunks(kChanC));
+  EXPECT_EQ(chunks_.size(),
+            processor.GetChunkNumber() + processor.GetSkippedChunkNumber());
+
+  auto expected = Expected(filter);
+  EXPECT_EQ(47, expected.size());
+  EXPECT_EQ(expected, Process(&processor));
+
+  filter.black_channels = {kChanB};
+  RecordProcessor black_processor(files_, filter, 2);
+  ASSERT_TRUE(black_processor.Open());
+  expected = Expected(filter);
+  EXPECT_EQ(31, expected.size());
+  EXPECT_EQ(expected, Process(&black_processor));
+}
+
+TEST_F(RecordProcessorTest, handler_stops_process) {
+  RecordFilter filter;
+  RecordProcessor processor(files_, filter, 2);
+  ASSERT_TRUE(processor.Open());
+  int handled = 0;
+  EXPECT_FALSE(processor.Process([&handled](const SingleMessage&) {
+    return ++handled < 10;
+  }));
+  EXPECT_EQ(10, handled);
+}
+
+TEST_F(RecordProcessorTest, read_chunk_body_at) {
+  for (const auto& file : files_) {
+    std::vector<ChunkBody> bodies;
+    ReadSerial(file, &bodies);
+    std::vector<IndexedChunk> chunks;
+    ReadIndexedChunks(file, &chunks);
+    ASSERT_EQ(bodies.size(), chunks.size());
+
+    // the position of the file is left alone, the chunks can be read in any
+    // order
+    RecordFileReader reader;
+    ASSERT_TRUE(reader.Open(file));
+    for (size_t i = chunks.size(); i-- > 0;) {
+      ChunkBody body;
+      ASSERT_TRUE(reader.ReadChunkBodyAt(chunks[i].body_position, &body));
+      EXPECT_EQ(bodies[i].SerializeAsString(), body.SerializeAsString());
+      EXPECT_EQ(chunks[i].header.message_number(), body.messages_size());
+    }
+  }
+}
+
+}  // namespace record
+}  // namespace cyber
+}  // namespace apollo
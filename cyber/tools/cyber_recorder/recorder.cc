@@ -18,6 +18,7 @@
 
 #include <algorithm>
 
+#include "cyber/common/global_data.h"
 #include "cyber/record/header_builder.h"
 
 namespace apollo {
@@ -79,6 +80,10 @@ bool Recorder::Start() {
   get_patterns_func(black_channels_, &black_channel_patterns_);
 
   writer_.reset(new RecordWriter(header_));
+  const auto& global_conf = common::GlobalData::Instance()->Config();
+  if (global_conf.has_record_write_conf()) {
+    writer_->SetWriteConf(global_conf.record_write_conf());
+  }
   if (!writer_->Open(output_)) {
     AERROR << "Datafile open file error.";
     return false;
@@ -120,6 +125,7 @@ bool Recorder::Stop() {
     display_thread_->join();
     display_thread_ = nullptr;
   }
+  ShowWriteStats();
   is_started_ = false;
   is_stopping_ = false;
   return true;
@@ -264,7 +270,8 @@ void Recorder::ReaderCallback(const std::shared_ptr<RawMessage>& message,
 
   message_time_ = Time::Now().ToNanosecond();
   if (!writer_->WriteMessage(channel_name, message, message_time_)) {
-    AERROR << "write data fail, channel: " << channel_name;
+    // dropped ones are counted by the writer and shown in the progress
+    AERROR_EVERY(100) << "write data fail, channel: " << channel_name;
     return;
   }
 
@@ -272,17 +279,49 @@ void Recorder::ReaderCallback(const std::shared_ptr<RawMessage>& message,
 }
 
 void Recorder::ShowProgress() {
+  uint64_t last_bytes_written = 0;
+  auto last_time = std::chrono::steady_clock::now();
+  double write_mb_per_s = 0.0;
   while (is_started_ && !is_stopping_) {
+    auto stats = writer_->GetWriteStats();
+    auto now = std::chrono::steady_clock::now();
+    double elapsed_s = std::chrono::duration<double>(now - last_time).count();
+    if (elapsed_s >= 1.0) {
+      write_mb_per_s = static_cast<double>(stats.bytes_written -
+                                           last_bytes_written) /
+                       (1024.0 * 1024.0) / elapsed_s;
+      last_bytes_written = stats.bytes_written;
+      last_time = now;
+    }
     std::cout << "\r[RUNNING]  Record Time: " << std::setprecision(3)
               << message_time_ / 1000000000
               << "    Progress: " << channel_reader_map_.size() << " channels, "
-              << message_count_ << " messages";
+              << message_count_ << " messages"
+              << "    Write: " << std::fixed << std::setprecision(1)
+              << write_mb_per_s << " MB/s, buffered "
+              << (stats.budget.used_bytes >> 20) << " MB, dropped "
+              << stats.budget.dropped_num << std::defaultfloat;
     std::cout.flush();
     std::this_thread::sleep_for(std::chrono::milliseconds(100));
   }
   std::cout << std::endl;
 }
 
+void Recorder::ShowWriteStats() {
+  auto stats = writer_->GetWriteStats();
+  if (stats.budget.dropped_num > 0) {
+    std::cout << "dropped " << stats.budget.dropped_num
+              << " messages at the memory limit:" << std::endl;
+    for (const auto& item : stats.budget.dropped_by_channel) {
+      std::cout << "    " << item.first << ": " << item.second << std::endl;
+    }
+  }
+  if (stats.sync_num > 0) {
+    std::cout << "fdatasync " << stats.sync_num << " times, max "
+              << stats.max_sync_us / 1000 << " ms" << std::endl;
+  }
+}
+
 }  // namespace record
 }  // namespace cyber
 }  // namespace apollo
@@ -93,6 +93,8 @@ class Recorder : public std::enable_shared_from_this<Recorder> {
   void FindNewChannel(const RoleAttributes& role_attr);
 
   void ShowProgress();
+
+  void ShowWriteStats();
 };
 
 }  // namespace record
@@ -20,19 +20,25 @@ namespace apollo {
 namespace cyber {
 namespace record {
 
-using apollo::cyber::proto::Channel;
-using apollo::cyber::proto::SectionType;
-
 Spliter::Spliter(const std::string& input_file, const std::string& output_file,
                  const std::vector<std::string>& white_channels,
                  const std::vector<std::string>& black_channels,
                  uint64_t begin_time, uint64_t end_time)
-    : input_file_(input_file),
+    : Spliter(std::vector<std::string>{input_file}, output_file,
+              white_channels, black_channels, begin_time, end_time) {}
+
+Spliter::Spliter(const std::vector<std::string>& input_files,
+                 const std::string& output_file,
+                 const std::vector<std::string>& white_channels,
+                 const std::vector<std::string>& black_channels,
+                 uint64_t begin_time, uint64_t end_time, uint32_t thread_num)
+    : input_files_(input_files),
       output_file_(output_file),
       white_channels_(white_channels),
       black_channels_(black_channels),
       begin_time_(begin_time),
-      end_time_(end_time) {}
+      end_time_(end_time),
+      thread_num_(thread_num) {}
 
 Spliter::~Spliter() {}
 
@@ -54,15 +60,21 @@ bool Spliter::Proc() {
 
   AINFO << "split record file started.";
 
-  // open input file
-  if (!reader_.Open(input_file_)) {
-    AERROR << "open input file failed, file: " << input_file_;
+  // plan the chunks to read from the index of the input files
+  RecordFilter filter;
+  filter.white_channels = white_channels_;
+  filter.black_channels = black_channels_;
+  filter.begin_time = begin_time_;
+  filter.end_time = end_time_;
+  RecordProcessor processor(input_files_, filter, thread_num_);
+  if (!processor.Open()) {
+    AERROR << "open input files failed.";
     return false;
   }
-  Header header = reader_.GetHeader();
-  if (begin_time_ > header.end_time() || end_time_ < header.begin_time()) {
+  if (processor.GetChunkNumber() == 0) {
     AERROR << "time range " << begin_time_ << " to " << end_time_
-           << " is not include in this record file.";
+           << " is not include in the record files, or they have none of "
+              "the channels.";
     return false;
   }
 
@@ -76,89 +88,25 @@ bool Spliter::Proc() {
     AERROR << "write header to output file failed. file: " << output_file_;
     return false;
   }
+  for (const auto& channel : processor.GetChannels()) {
+    writer_.WriteChannel(channel);
+  }
 
-  // read through record file
-  bool skip_next_chunk_body(false);
-  reader_.Reset();
-  while (!reader_.EndOfFile()) {
-    Section section;
-    if (!reader_.ReadSection(&section)) {
-      AERROR << "read section failed.";
-      return false;
-    }
-    if (section.type == SectionType::SECTION_INDEX) {
-      break;
-    }
-    switch (section.type) {
-      case SectionType::SECTION_CHANNEL: {
-        Channel chan;
-        if (!reader_.ReadSection<Channel>(section.size, &chan)) {
-          AERROR << "read channel section fail.";
-          return false;
-        }
-        if (white_channels_.empty() ||
-            std::find(white_channels_.begin(), white_channels_.end(),
-                      chan.name()) != white_channels_.end()) {
-          if (std::find(black_channels_.begin(), black_channels_.end(),
-                        chan.name()) == black_channels_.end()) {
-            writer_.WriteChannel(chan);
-          }
-        }
-        break;
-      }
-      case SectionType::SECTION_CHUNK_HEADER: {
-        ChunkHeader chdr;
-        if (!reader_.ReadSection<ChunkHeader>(section.size, &chdr)) {
-          AERROR << "read chunk header section fail.";
+  // the messages arrive filtered and in time order
+  bool split_result =
+      processor.Process([this](const proto::SingleMessage& message) {
+        if (!writer_.WriteMessage(message)) {
+          AERROR << "add new message failed.";
           return false;
         }
-        if (begin_time_ > chdr.end_time() || end_time_ < chdr.begin_time()) {
-          skip_next_chunk_body = true;
-        }
-        break;
-      }
-      case SectionType::SECTION_CHUNK_BODY: {
-        if (skip_next_chunk_body) {
-          reader_.SkipSection(section.size);
-          skip_next_chunk_body = false;
-          break;
-        }
-        ChunkBody cbd;
-        if (!reader_.ReadSection<ChunkBody>(section.size, &cbd)) {
-          AERROR << "read chunk body section fail.";
-          return false;
-        }
-        for (int idx = 0; idx < cbd.messages_size(); ++idx) {
-          if (!white_channels_.empty() &&
-              std::find(white_channels_.begin(), white_channels_.end(),
-                        cbd.messages(idx).channel_name()) ==
-                  white_channels_.end()) {
-            continue;
-          }
-          if (std::find(black_channels_.begin(), black_channels_.end(),
-                        cbd.messages(idx).channel_name()) !=
-              black_channels_.end()) {
-            continue;
-          }
-          if (cbd.messages(idx).time() < begin_time_ ||
-              cbd.messages(idx).time() > end_time_) {
-            continue;
-          }
-          if (!writer_.WriteMessage(cbd.messages(idx))) {
-            AERROR << "add new message failed.";
-            return false;
-          }
-        }
-        break;
-      }
-      default: {
-        AERROR << "this section should not be here, section type: "
-               << section.type;
-        break;
-      }
-    }  // end for switch
-  }    // end for while
-  AINFO << "split record file done.";
+        return true;
+      });
+  if (!split_result) {
+    return false;
+  }
+  AINFO << "split record file done, read " << processor.GetChunkNumber()
+        << " chunks, skipped " << processor.GetSkippedChunkNumber()
+        << " chunks.";
   return true;
 }  // end for Proc()
 
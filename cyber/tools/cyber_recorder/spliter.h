@@ -28,6 +28,7 @@
 #include "cyber/record/file/record_file_reader.h"
 #include "cyber/record/file/record_file_writer.h"
 #include "cyber/record/header_builder.h"
+#include "cyber/tools/cyber_recorder/record_processor.h"
 
 using ::apollo::cyber::proto::ChannelCache;
 using ::apollo::cyber::proto::ChunkBody;
@@ -38,6 +39,12 @@ namespace apollo {
 namespace cyber {
 namespace record {
 
+/**
+ * @class Spliter
+ * @brief Writes the messages of one or more records which pass the channel
+ * and time filters into a new record, merged in time order. The input chunks
+ * are read by a RecordProcessor with thread_num threads.
+ */
 class Spliter {
  public:
   Spliter(const std::string& input_file, const std::string& output_file,
@@ -45,19 +52,24 @@ class Spliter {
           const std::vector<std::string>& black_channels,
           uint64_t begin_time = 0,
           uint64_t end_time = std::numeric_limits<uint64_t>::max());
+  Spliter(const std::vector<std::string>& input_files,
+          const std::string& output_file,
+          const std::vector<std::string>& white_channels,
+          const std::vector<std::string>& black_channels, uint64_t begin_time,
+          uint64_t end_time, uint32_t thread_num = 0);
   virtual ~Spliter();
   bool Proc();
 
  private:
-  RecordFileReader reader_;
   RecordFileWriter writer_;
-  std::string input_file_;
+  std::vector<std::string> input_files_;
   std::string output_file_;
   std::vector<std::string> white_channels_;
   std::vector<std::string> black_channels_;
   bool all_channels_;
   uint64_t begin_time_;
   uint64_t end_time_;
+  uint32_t thread_num_;
 };
 
 }  // namespace record
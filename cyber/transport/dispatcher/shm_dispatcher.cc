@@ -19,6 +19,7 @@
 #include "cyber/common/global_data.h"
 #include "cyber/common/util.h"
 #include "cyber/scheduler/scheduler_factory.h"
+#include "cyber/statistics/latency_tracer.h"
 #include "cyber/transport/shm/readable_info.h"
 
 namespace apollo {
@@ -52,6 +53,10 @@ void ShmDispatcher::AddSegment(const RoleAttributes& self_attr) {
   if (segments_.count(channel_id) > 0) {
     return;
   }
+  if (!notifier_->AddChannel(channel_id)) {
+    AERROR << "notifier fail to listen on channel: "
+           << GlobalData::GetChannelById(channel_id);
+  }
   auto segment = SegmentFactory::CreateSegment(channel_id);
   segments_[channel_id] = segment;
   previous_indexes_[channel_id] = UINT32_MAX;
@@ -76,6 +81,10 @@ void ShmDispatcher::ReadMessage(uint64_t channel_id, uint32_t block_index) {
       reinterpret_cast<char*>(rb->buf) + rb->block->msg_size();
 
   if (msg_info.DeserializeFrom(msg_info_addr, rb->block->msg_info_size())) {
+    if (msg_info.traced()) {
+      msg_info.set_trace_stamp(TRACE_RECEIVED,
+                               statistics::LatencyTracer::Now());
+    }
     OnMessage(channel_id, rb, msg_info);
   } else {
     AERROR << "error msg info of channel:"
@@ -102,6 +111,10 @@ void ShmDispatcher::ReadArenaMessage(uint64_t channel_id,
   const char* msg_info_addr =
       reinterpret_cast<char*>(rb->buf) + rb->block->msg_size();
   if (msg_info.DeserializeFrom(msg_info_addr, rb->block->msg_info_size())) {
+    if (msg_info.traced()) {
+      msg_info.set_trace_stamp(TRACE_RECEIVED,
+                               statistics::LatencyTracer::Now());
+    }
     OnArenaMessage(channel_id, rb, msg_info);
   } else {
     AERROR << "error msg info of channel:"
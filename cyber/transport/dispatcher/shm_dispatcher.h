@@ -163,7 +163,8 @@ void ShmDispatcher::AddListener(const RoleAttributes& self_attr,
           self_attr.channel_id()) &&
       self_attr.message_type() != message::MessageType<message::RawMessage>() &&
       self_attr.message_type() !=
-          message::MessageType<message::PyMessageWrap>()) {
+          message::MessageType<message::PyMessageWrap>() &&
+      !message::IsZeroCopyMessage<MessageT>::value) {
     auto listener_adapter = [listener, self_attr](
                                 const std::shared_ptr<ReadableBlock>& rb,
                                 const MessageInfo& msg_info) {
@@ -278,7 +279,8 @@ void ShmDispatcher::AddListener(const RoleAttributes& self_attr,
           self_attr.channel_id()) &&
       self_attr.message_type() != message::MessageType<message::RawMessage>() &&
       self_attr.message_type() !=
-          message::MessageType<message::PyMessageWrap>()) {
+          message::MessageType<message::PyMessageWrap>() &&
+      !message::IsZeroCopyMessage<MessageT>::value) {
     auto listener_adapter = [listener, self_attr](
                                 const std::shared_ptr<ReadableBlock>& rb,
                                 const MessageInfo& msg_info) {
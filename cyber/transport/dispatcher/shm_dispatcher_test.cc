@@ -17,6 +17,9 @@
 #include "cyber/transport/dispatcher/shm_dispatcher.h"
 
 #include <memory>
+#include <string>
+#include <vector>
+
 #include "gtest/gtest.h"
 
 #include "cyber/common/global_data.h"
@@ -24,9 +27,23 @@
 #include "cyber/init.h"
 #include "cyber/message/raw_message.h"
 #include "cyber/proto/unit_test.pb.h"
+#include "cyber/statistics/latency_tracer.h"
 #include "cyber/transport/common/identity.h"
+#include "cyber/transport/transmitter/shm_transmitter.h"
 #include "cyber/transport/transport.h"
 
+namespace {
+
+struct LoanedPose {
+  uint64_t timestamp;
+  double x;
+  double y;
+};
+
+}  // namespace
+
+CYBER_REGISTER_ZERO_COPY_MESSAGE(LoanedPose)
+
 namespace apollo {
 namespace cyber {
 namespace transport {
@@ -94,6 +111,115 @@ TEST(ShmDispatcherTest, on_message) {
   EXPECT_EQ(recv_msg->message, send_msg->message);
 }
 
+TEST(ShmDispatcherTest, trace_stamps) {
+  auto dispatcher = ShmDispatcher::Instance();
+
+  std::vector<std::string> channel_names = {"trace_stamps"};
+  // messages of the arena channel of cyber.pb.conf take the arena path
+  if (common::GlobalData::Instance()->IsChannelEnableArenaShm("/apollo/msg")) {
+    channel_names.push_back("/apollo/msg");
+  }
+  for (const auto& channel_name : channel_names) {
+    RoleAttributes oppo_attr;
+    oppo_attr.set_host_name(common::GlobalData::Instance()->HostName());
+    oppo_attr.set_host_ip(common::GlobalData::Instance()->HostIp());
+    oppo_attr.set_channel_name(channel_name);
+    oppo_attr.set_channel_id(common::Hash(channel_name));
+    oppo_attr.set_message_type(message::MessageType<proto::Chatter>());
+    Identity oppo_id;
+    oppo_attr.set_id(oppo_id.HashValue());
+
+    auto transmitter = Transport::Instance()->CreateTransmitter<proto::Chatter>(
+        oppo_attr, proto::OptionalMode::SHM);
+    ASSERT_NE(transmitter, nullptr);
+
+    RoleAttributes self_attr;
+    self_attr.set_channel_name(channel_name);
+    self_attr.set_channel_id(common::Hash(channel_name));
+    self_attr.set_message_type(message::MessageType<proto::Chatter>());
+    Identity self_id;
+    self_attr.set_id(self_id.HashValue());
+
+    MessageInfo recv_info;
+    dispatcher->AddListener<proto::Chatter>(
+        self_attr, [&recv_info](const std::shared_ptr<proto::Chatter>& msg,
+                                const MessageInfo& msg_info) {
+          (void)msg;
+          recv_info = msg_info;
+        });
+    transmitter->Enable(self_attr);
+
+    // a traced writer stamps TRACE_TRANSMIT, the transport adds the others
+    auto send_msg = std::make_shared<proto::Chatter>();
+    send_msg->set_content(channel_name);
+    MessageInfo msg_info(oppo_id, 1);
+    msg_info.set_trace_stamp(TRACE_TRANSMIT, statistics::LatencyTracer::Now());
+    EXPECT_TRUE(transmitter->Transmit(send_msg, msg_info));
+
+    sleep(1);
+    ASSERT_TRUE(recv_info.traced()) << channel_name;
+    const auto& stamps = recv_info.trace_stamps();
+    EXPECT_EQ(stamps[TRACE_TRANSMIT], msg_info.trace_stamps()[TRACE_TRANSMIT]);
+    EXPECT_GE(stamps[TRACE_ACQUIRED], stamps[TRACE_TRANSMIT]) << channel_name;
+    EXPECT_GE(stamps[TRACE_SERIALIZED], stamps[TRACE_ACQUIRED]) << channel_name;
+    EXPECT_GE(stamps[TRACE_RECEIVED], stamps[TRACE_SERIALIZED]) << channel_name;
+  }
+}
+
+TEST(ShmDispatcherTest, loan_and_publish) {
+  auto dispatcher = ShmDispatcher::Instance();
+
+  RoleAttributes oppo_attr;
+  oppo_attr.set_host_name(common::GlobalData::Instance()->HostName());
+  oppo_attr.set_host_ip(common::GlobalData::Instance()->HostIp());
+  oppo_attr.set_channel_name("loan_and_publish");
+  oppo_attr.set_channel_id(common::Hash("loan_and_publish"));
+  oppo_attr.set_message_type(message::MessageType<LoanedPose>());
+  Identity oppo_id;
+  oppo_attr.set_id(oppo_id.HashValue());
+  auto transmitter = std::make_shared<ShmTransmitter<LoanedPose>>(oppo_attr);
+
+  RoleAttributes self_attr;
+  self_attr.set_channel_name("loan_and_publish");
+  self_attr.set_channel_id(common::Hash("loan_and_publish"));
+  self_attr.set_message_type(message::MessageType<LoanedPose>());
+  Identity self_id;
+  self_attr.set_id(self_id.HashValue());
+
+  LoanedPose recv_pose = {0, 0.0, 0.0};
+  MessageInfo recv_info;
+  dispatcher->AddListener<LoanedPose>(
+      self_attr, [&recv_pose, &recv_info](
+                     const std::shared_ptr<LoanedPose>& msg,
+                     const MessageInfo& msg_info) {
+        recv_pose = *msg;
+        recv_info = msg_info;
+      });
+
+  // nothing to lend before a reader is enabled
+  LoanedMessage<LoanedPose> loaned;
+  EXPECT_FALSE(transmitter->Loan(&loaned));
+  transmitter->Enable(self_attr);
+  ASSERT_TRUE(transmitter->Loan(&loaned));
+  ASSERT_TRUE(loaned.InSharedMemory());
+  loaned->timestamp = 42;
+  loaned->x = 1.0;
+  loaned->y = 2.0;
+
+  // the message info is prepared as on the Transmit path, which records the
+  // TRANSMIT_BEGIN perf event along with the sequence number
+  EXPECT_TRUE(transmitter->Publish(&loaned));
+  EXPECT_FALSE(loaned.IsValid());
+  EXPECT_EQ(transmitter->seq_num(), 1);
+
+  sleep(1);
+  EXPECT_EQ(recv_pose.timestamp, 42);
+  EXPECT_EQ(recv_pose.x, 1.0);
+  EXPECT_EQ(recv_pose.y, 2.0);
+  EXPECT_EQ(recv_info.sender_id(), transmitter->id());
+  EXPECT_EQ(recv_info.seq_num(), 1);
+}
+
 TEST(ShmDispatcherTest, shutdown) {
   auto dispatcher = ShmDispatcher::Instance();
   dispatcher->Shutdown();
@@ -28,6 +28,9 @@ const std::size_t MessageInfo::kSize = 2 * ID_SIZE + sizeof(uint64_t) + \
                                         sizeof(uint64_t) + sizeof(int32_t) + \
                                         sizeof(uint64_t);
 
+const std::size_t MessageInfo::kTraceSize =
+    kWriterTraceStageNum * sizeof(uint64_t);
+
 MessageInfo::MessageInfo() : sender_id_(false), spare_id_(false) {}
 
 MessageInfo::MessageInfo(const Identity& sender_id, uint64_t seq_num)
@@ -41,7 +44,9 @@ MessageInfo::MessageInfo(const MessageInfo& another)
     : sender_id_(another.sender_id_),
       channel_id_(another.channel_id_),
       seq_num_(another.seq_num_),
-      spare_id_(another.spare_id_) {}
+      spare_id_(another.spare_id_),
+      send_time_(another.send_time_),
+      trace_stamps_(another.trace_stamps_) {}
 
 MessageInfo::~MessageInfo() {}
 
@@ -51,6 +56,8 @@ MessageInfo& MessageInfo::operator=(const MessageInfo& another) {
     channel_id_ = another.channel_id_;
     seq_num_ = another.seq_num_;
     spare_id_ = another.spare_id_;
+    send_time_ = another.send_time_;
+    trace_stamps_ = another.trace_stamps_;
   }
   return *this;
 }
@@ -76,6 +83,11 @@ bool MessageInfo::SerializeTo(std::string* dst) const {
   dst->append(spare_id_.data(), ID_SIZE);
   dst->append(reinterpret_cast<const char*>(
     &send_time_), sizeof(send_time_));
+  dst->resize(kSize, '\0');
+  if (traced()) {
+    dst->append(reinterpret_cast<const char*>(trace_stamps_.data()),
+                kTraceSize);
+  }
   return true;
 }
 
@@ -97,6 +109,10 @@ bool MessageInfo::SerializeTo(char* dst, std::size_t len) const {
   ptr += ID_SIZE;
   std::memcpy(ptr,
     reinterpret_cast<const char*>(&send_time_), sizeof(send_time_));
+  // the trace stamps are dropped if the caller did not reserve room for them
+  if (traced() && len >= kSize + kTraceSize) {
+    std::memcpy(dst + kSize, trace_stamps_.data(), kTraceSize);
+  }
   return true;
 }
 
@@ -106,7 +122,7 @@ bool MessageInfo::DeserializeFrom(const std::string& src) {
 
 bool MessageInfo::DeserializeFrom(const char* src, std::size_t len) {
   RETURN_VAL_IF_NULL(src, false);
-  if (len != kSize) {
+  if (len != kSize && len != kSize + kTraceSize) {
     AWARN << "src size mismatch, given[" << len << "] target[" << kSize << "]";
     return false;
   }
@@ -124,6 +140,10 @@ bool MessageInfo::DeserializeFrom(const char* src, std::size_t len) {
   ptr += ID_SIZE;
   std::memcpy(
     reinterpret_cast<char*>(&send_time_), ptr, sizeof(send_time_));
+  trace_stamps_.fill(0);
+  if (len == kSize + kTraceSize) {
+    std::memcpy(trace_stamps_.data(), src + kSize, kTraceSize);
+  }
   return true;
 }
 
@@ -22,6 +22,7 @@
 #include <string>
 
 #include "cyber/transport/common/identity.h"
+#include "cyber/transport/message/trace_stamps.h"
 
 namespace apollo {
 namespace cyber {
@@ -59,16 +60,30 @@ class MessageInfo {
   void set_spare_id(const Identity& spare_id) { spare_id_ = spare_id; }
 
   static const std::size_t kSize;
+  // appended after kSize when the message is traced
+  static const std::size_t kTraceSize;
 
   uint64_t send_time() const { return send_time_; }
   void set_send_time(uint64_t send_time) { send_time_ = send_time; }
 
+  // a message is traced once its writer stamped TRACE_TRANSMIT
+  bool traced() const {
+    return trace_stamps_[TRACE_TRANSMIT] != 0;
+  }
+  const TraceStamps& trace_stamps() const { return trace_stamps_; }
+  void set_trace_stamp(TraceStage stage, uint64_t stamp) {
+    trace_stamps_[stage] = stamp;
+  }
+
+  std::size_t ByteSize() const { return traced() ? kSize + kTraceSize : kSize; }
+
  private:
   Identity sender_id_;
   uint64_t channel_id_ = 0;
   uint64_t seq_num_ = 0;
   Identity spare_id_;
-  uint64_t send_time_;
+  uint64_t send_time_ = 0;
+  TraceStamps trace_stamps_ = {};
 };
 
 }  // namespace transport
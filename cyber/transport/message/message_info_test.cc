@@ -70,6 +70,39 @@ TEST(MessageInfoTest, test) {
   EXPECT_EQ(msgInfo3, msgInfo4);
 }
 
+TEST(MessageInfoTest, trace) {
+  Identity id;
+  MessageInfo info(id, 1);
+  EXPECT_FALSE(info.traced());
+  EXPECT_EQ(info.ByteSize(), MessageInfo::kSize);
+
+  info.set_trace_stamp(TRACE_TRANSMIT, 100);
+  info.set_trace_stamp(TRACE_ACQUIRED, 200);
+  info.set_trace_stamp(TRACE_SERIALIZED, 300);
+  // receiver side stamps never go on the wire
+  info.set_trace_stamp(TRACE_RECEIVED, 400);
+  EXPECT_TRUE(info.traced());
+  EXPECT_EQ(info.ByteSize(), MessageInfo::kSize + MessageInfo::kTraceSize);
+
+  MessageInfo copied(info);
+  EXPECT_EQ(copied.trace_stamps(), info.trace_stamps());
+
+  std::string buf(info.ByteSize(), '\0');
+  EXPECT_TRUE(info.SerializeTo(const_cast<char*>(buf.data()), buf.size()));
+  MessageInfo received;
+  EXPECT_TRUE(received.DeserializeFrom(buf));
+  EXPECT_EQ(received, info);
+  EXPECT_EQ(received.trace_stamps()[TRACE_TRANSMIT], 100);
+  EXPECT_EQ(received.trace_stamps()[TRACE_SERIALIZED], 300);
+  EXPECT_EQ(received.trace_stamps()[TRACE_RECEIVED], 0);
+
+  // without room for the stamps the message goes out untraced
+  EXPECT_TRUE(info.SerializeTo(const_cast<char*>(buf.data()),
+                               MessageInfo::kSize));
+  EXPECT_TRUE(received.DeserializeFrom(buf.data(), MessageInfo::kSize));
+  EXPECT_FALSE(received.traced());
+}
+
 }  // namespace transport
 }  // namespace cyber
 }  // namespace apollo
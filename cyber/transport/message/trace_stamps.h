@@ -0,0 +1,49 @@
+/******************************************************************************
+ * Copyright 2024 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_TRANSPORT_MESSAGE_TRACE_STAMPS_H_
+#define CYBER_TRANSPORT_MESSAGE_TRACE_STAMPS_H_
+
+#include <array>
+#include <cstdint>
+
+namespace apollo {
+namespace cyber {
+namespace transport {
+
+/**
+ * @brief Monotonic stamps taken along the transport pipeline. The writer side
+ * ones travel inside `MessageInfo`, the receiver side ones are added by the
+ * process the reader lives in. `statistics::LatencyTracer` turns them into
+ * latencies.
+ */
+enum TraceStage : uint32_t {
+  TRACE_TRANSMIT = 0,  // Transmitter::Transmit entered
+  TRACE_ACQUIRED,      // shm block acquired for write
+  TRACE_SERIALIZED,    // message serialized into the block
+  TRACE_RECEIVED,      // receiver picked the block up after notify
+  TRACE_DISPATCHED,    // message handed to the reader buffers
+  TRACE_STAGE_NUM,
+};
+constexpr uint32_t kWriterTraceStageNum = TRACE_SERIALIZED + 1;
+
+using TraceStamps = std::array<uint64_t, TRACE_STAGE_NUM>;
+
+}  // namespace transport
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_TRANSPORT_MESSAGE_TRACE_STAMPS_H_
@@ -453,6 +453,10 @@ void ArenaAddressAllocator::Deallocate(uint64_t key) {
   }
 }
 
+uint64_t ArenaAddressAllocator::AddressSegmentSize() const {
+  return meta_ ? meta_->struct_.address_segment_size_ : 0;
+}
+
 }  // namespace transport
 }  // namespace cyber
 }  // namespace apollo
@@ -101,6 +101,8 @@ class ArenaAddressAllocator {
                                         ArenaAddressNode** node_p);
   void* Allocate(uint64_t key);
   void Deallocate(uint64_t key);
+  // size of the address range handed out by Allocate
+  uint64_t AddressSegmentSize() const;
 
  private:
   uint64_t meta_shm_key_;
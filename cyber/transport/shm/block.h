@@ -39,6 +39,11 @@ class Block {
     msg_info_size_ = msg_info_size;
   }
 
+  // Only used by the ring layout: where the buffer of this block lives in the
+  // ring area of the segment. buf_size() is 0 if the buffer was reclaimed.
+  uint64_t buf_offset() const { return buf_offset_.load(); }
+  uint64_t buf_size() const { return buf_size_.load(); }
+
   static const int32_t kRWLockFree;
   static const int32_t kWriteExclusive;
   static const int32_t kMaxTryLockTimes;
@@ -53,6 +58,9 @@ class Block {
 
   uint64_t msg_size_;
   uint64_t msg_info_size_;
+
+  std::atomic<uint64_t> buf_offset_ = {0};
+  std::atomic<uint64_t> buf_size_ = {0};
 };
 
 }  // namespace transport
@@ -0,0 +1,337 @@
+/******************************************************************************
+ * Copyright 2024 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/transport/shm/channel_notifier.h"
+
+#include <linux/futex.h>
+#include <signal.h>
+#include <sys/ipc.h>
+#include <sys/shm.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <cstring>
+#include <ctime>
+#include <string>
+#include <thread>
+
+#include "cyber/common/log.h"
+#include "cyber/common/util.h"
+
+namespace apollo {
+namespace cyber {
+namespace transport {
+
+using base::ReadLockGuard;
+using base::WriteLockGuard;
+using common::Hash;
+
+namespace {
+
+void* AttachShm(key_t key, size_t size, bool* created) {
+  *created = false;
+  int shmid = shmget(key, size, 0644 | IPC_CREAT | IPC_EXCL);
+  if (shmid != -1) {
+    *created = true;
+  } else if (errno == EEXIST) {
+    shmid = shmget(key, 0, 0644);
+  }
+  if (shmid == -1) {
+    AERROR << "get shm failed, error: " << strerror(errno);
+    return nullptr;
+  }
+
+  struct shmid_ds shm_info;
+  if (shmctl(shmid, IPC_STAT, &shm_info) == -1 ||
+      shm_info.shm_segsz < size) {
+    AERROR << "shm of key " << key << " is missing or too small.";
+    return nullptr;
+  }
+
+  void* addr = shmat(shmid, nullptr, 0);
+  if (addr == reinterpret_cast<void*>(-1)) {
+    AERROR << "attach shm failed, error: " << strerror(errno);
+    if (*created) {
+      shmctl(shmid, IPC_RMID, 0);
+    }
+    return nullptr;
+  }
+  return addr;
+}
+
+void FutexWait(std::atomic<uint32_t>* word, uint32_t expected,
+               int64_t timeout_us) {
+  struct timespec ts;
+  ts.tv_sec = static_cast<time_t>(timeout_us / 1000000);
+  ts.tv_nsec = static_cast<long>((timeout_us % 1000000) * 1000);  // NOLINT
+  syscall(SYS_futex, reinterpret_cast<uint32_t*>(word), FUTEX_WAIT, expected,
+          &ts, nullptr, 0);
+}
+
+void FutexWake(std::atomic<uint32_t>* word) {
+  syscall(SYS_futex, reinterpret_cast<uint32_t*>(word), FUTEX_WAKE, INT_MAX,
+          nullptr, nullptr, 0);
+}
+
+}  // namespace
+
+ChannelNotifier::ChannelNotifier() {
+  if (!Init()) {
+    AERROR << "fail to init channel notifier.";
+    is_shutdown_.store(true);
+    return;
+  }
+  ADEBUG << "channel notifier slot: " << slot_;
+}
+
+ChannelNotifier::~ChannelNotifier() { Shutdown(); }
+
+void ChannelNotifier::Shutdown() {
+  if (is_shutdown_.exchange(true)) {
+    return;
+  }
+
+  ReleaseSlot();
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+  WriteLockGuard<base::AtomicRWLock> lock(rings_lock_);
+  for (auto& item : rings_) {
+    shmdt(item.second.managed_shm);
+  }
+  rings_.clear();
+  listen_channels_.clear();
+  if (registry_shm_ != nullptr) {
+    shmdt(registry_shm_);
+    registry_shm_ = nullptr;
+  }
+  registry_ = nullptr;
+}
+
+bool ChannelNotifier::Notify(const ReadableInfo& info) {
+  if (is_shutdown_.load()) {
+    ADEBUG << "notifier is shutdown.";
+    return false;
+  }
+
+  ChannelRing* ring = GetRing(info.channel_id());
+  if (ring == nullptr) {
+    return false;
+  }
+
+  auto indicator = ring->indicator;
+  uint64_t seq = indicator->next_seq.fetch_add(1);
+  uint64_t idx = seq % kChannelBufLength;
+  indicator->infos[idx] = info;
+  indicator->seqs[idx] = seq;
+
+  RingDoorbells(indicator);
+  return true;
+}
+
+bool ChannelNotifier::Listen(int timeout_ms, ReadableInfo* info) {
+  if (info == nullptr) {
+    AERROR << "info nullptr.";
+    return false;
+  }
+
+  if (is_shutdown_.load()) {
+    ADEBUG << "notifier is shutdown.";
+    return false;
+  }
+
+  auto& doorbell = registry_->doorbells[slot_];
+  auto deadline = std::chrono::steady_clock::now() +
+                  std::chrono::milliseconds(timeout_ms);
+  while (!is_shutdown_.load()) {
+    // load the doorbell before scanning, see FutexNotifier::Listen
+    uint32_t expected = doorbell.futex.load();
+    if (TryRead(info)) {
+      return true;
+    }
+
+    auto remain_us = std::chrono::duration_cast<std::chrono::microseconds>(
+                         deadline - std::chrono::steady_clock::now())
+                         .count();
+    if (remain_us <= 0) {
+      return false;
+    }
+    doorbell.waiters.fetch_add(1);
+    FutexWait(&doorbell.futex, expected, remain_us);
+    doorbell.waiters.fetch_sub(1);
+  }
+  return false;
+}
+
+bool ChannelNotifier::AddChannel(uint64_t channel_id) {
+  if (is_shutdown_.load()) {
+    ADEBUG << "notifier is shutdown.";
+    return false;
+  }
+
+  ChannelRing* ring = GetRing(channel_id);
+  if (ring == nullptr) {
+    return false;
+  }
+
+  WriteLockGuard<base::AtomicRWLock> lock(rings_lock_);
+  if (ring->listening) {
+    return true;
+  }
+  ring->next_seq = ring->indicator->next_seq.load();
+  ring->indicator->listeners[slot_ / 64].fetch_or(1ULL << (slot_ % 64));
+  ring->listening = true;
+  listen_channels_.emplace_back(channel_id);
+  return true;
+}
+
+bool ChannelNotifier::Init() {
+  bool created = false;
+  key_t key = static_cast<key_t>(
+      Hash("/apollo/cyber/transport/shm/channel_notifier"));
+  registry_shm_ = AttachShm(key, sizeof(Registry), &created);
+  if (registry_shm_ == nullptr) {
+    return false;
+  }
+  if (created) {
+    registry_ = new (registry_shm_) Registry();
+  } else {
+    registry_ = reinterpret_cast<Registry*>(registry_shm_);
+  }
+  return ClaimSlot();
+}
+
+bool ChannelNotifier::ClaimSlot() {
+  int32_t pid = static_cast<int32_t>(getpid());
+  for (uint32_t i = 0; i < kMaxListeners; ++i) {
+    auto& doorbell = registry_->doorbells[i];
+    int32_t owner = doorbell.pid.load();
+    // a slot left by a dead process is reused. Channels it listened on may
+    // still carry its bit, which only costs the new owner a spurious wakeup.
+    if (owner != 0 && owner != pid &&
+        !(kill(owner, 0) == -1 && errno == ESRCH)) {
+      continue;
+    }
+    if (doorbell.pid.compare_exchange_strong(owner, pid)) {
+      slot_ = static_cast<int32_t>(i);
+      return true;
+    }
+  }
+  AERROR << "no free listener slot, max listeners: " << kMaxListeners;
+  return false;
+}
+
+void ChannelNotifier::ReleaseSlot() {
+  if (registry_ == nullptr || slot_ == -1) {
+    return;
+  }
+
+  {
+    WriteLockGuard<base::AtomicRWLock> lock(rings_lock_);
+    for (auto channel_id : listen_channels_) {
+      auto indicator = rings_[channel_id].indicator;
+      indicator->listeners[slot_ / 64].fetch_and(~(1ULL << (slot_ % 64)));
+    }
+  }
+
+  auto& doorbell = registry_->doorbells[slot_];
+  doorbell.futex.fetch_add(1);
+  FutexWake(&doorbell.futex);
+  doorbell.pid.store(0);
+}
+
+ChannelNotifier::ChannelRing* ChannelNotifier::GetRing(uint64_t channel_id) {
+  {
+    ReadLockGuard<base::AtomicRWLock> lock(rings_lock_);
+    auto it = rings_.find(channel_id);
+    if (it != rings_.end()) {
+      return &it->second;
+    }
+  }
+
+  WriteLockGuard<base::AtomicRWLock> lock(rings_lock_);
+  auto it = rings_.find(channel_id);
+  if (it != rings_.end()) {
+    return &it->second;
+  }
+
+  bool created = false;
+  key_t key = static_cast<key_t>(
+      Hash("/apollo/cyber/transport/shm/channel_notifier/" +
+           std::to_string(channel_id)));
+  void* managed_shm = AttachShm(key, sizeof(ChannelIndicator), &created);
+  if (managed_shm == nullptr) {
+    AERROR << "fail to open notification ring of channel: " << channel_id;
+    return nullptr;
+  }
+
+  ChannelRing& ring = rings_[channel_id];
+  ring.managed_shm = managed_shm;
+  if (created) {
+    ring.indicator = new (managed_shm) ChannelIndicator();
+  } else {
+    ring.indicator = reinterpret_cast<ChannelIndicator*>(managed_shm);
+  }
+  return &ring;
+}
+
+bool ChannelNotifier::TryRead(ReadableInfo* info) {
+  ReadLockGuard<base::AtomicRWLock> lock(rings_lock_);
+  size_t channel_num = listen_channels_.size();
+  for (size_t i = 0; i < channel_num; ++i) {
+    // start from the channel after the last hit so a busy channel can not
+    // starve the others
+    size_t index = (next_listen_index_ + i) % channel_num;
+    ChannelRing& ring = rings_[listen_channels_[index]];
+    auto indicator = ring.indicator;
+    if (indicator->next_seq.load() == ring.next_seq) {
+      continue;
+    }
+
+    auto idx = ring.next_seq % kChannelBufLength;
+    auto actual_seq = indicator->seqs[idx];
+    if (actual_seq >= ring.next_seq) {
+      ring.next_seq = actual_seq;
+      *info = indicator->infos[idx];
+      ++ring.next_seq;
+      next_listen_index_ = index + 1;
+      return true;
+    }
+    ADEBUG << "seq[" << ring.next_seq << "] is writing, can not read now.";
+  }
+  return false;
+}
+
+void ChannelNotifier::RingDoorbells(const ChannelIndicator* indicator) {
+  for (uint32_t i = 0; i < kListenerMaskSize; ++i) {
+    uint64_t mask = indicator->listeners[i].load();
+    while (mask != 0) {
+      uint32_t bit = static_cast<uint32_t>(__builtin_ctzll(mask));
+      mask &= mask - 1;
+      auto& doorbell = registry_->doorbells[i * 64 + bit];
+      doorbell.futex.fetch_add(1);
+      if (doorbell.waiters.load() > 0) {
+        FutexWake(&doorbell.futex);
+      }
+    }
+  }
+}
+
+}  // namespace transport
+}  // namespace cyber
+}  // namespace apollo
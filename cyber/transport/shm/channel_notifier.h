@@ -0,0 +1,115 @@
+/******************************************************************************
+ * Copyright 2024 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_TRANSPORT_SHM_CHANNEL_NOTIFIER_H_
+#define CYBER_TRANSPORT_SHM_CHANNEL_NOTIFIER_H_
+
+#include <sys/types.h>
+
+#include <atomic>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "cyber/base/atomic_rw_lock.h"
+#include "cyber/common/macros.h"
+#include "cyber/transport/shm/notifier_base.h"
+
+namespace apollo {
+namespace cyber {
+namespace transport {
+
+/**
+ * @brief Notifier with one readable info ring per channel.
+ *
+ * Every listening process owns a doorbell slot in a host wide registry, and
+ * every channel ring records the slots of the processes that listen on it.
+ * Notify only rings the doorbells of those processes, and Listen only scans
+ * the rings of the channels added through AddChannel, so a dispatcher never
+ * sees the traffic of channels it does not subscribe.
+ */
+class ChannelNotifier : public NotifierBase {
+ public:
+  static const uint32_t kMaxListeners = 256;
+  static const uint32_t kChannelBufLength = 256;
+
+ private:
+  static const uint32_t kListenerMaskSize = kMaxListeners / 64;
+
+  struct Doorbell {
+    std::atomic<int32_t> pid = {0};
+    std::atomic<uint32_t> futex = {0};
+    std::atomic<uint32_t> waiters = {0};
+  };
+
+  struct Registry {
+    Doorbell doorbells[kMaxListeners];
+  };
+
+  struct ChannelIndicator {
+    std::atomic<uint64_t> next_seq = {0};
+    // bit i is set if the process owning doorbell i listens on this channel
+    std::atomic<uint64_t> listeners[kListenerMaskSize] = {};
+    ReadableInfo infos[kChannelBufLength];
+    uint64_t seqs[kChannelBufLength] = {0};
+  };
+
+  struct ChannelRing {
+    void* managed_shm = nullptr;
+    ChannelIndicator* indicator = nullptr;
+    uint64_t next_seq = 0;
+    bool listening = false;
+  };
+
+ public:
+  virtual ~ChannelNotifier();
+
+  void Shutdown() override;
+  bool Notify(const ReadableInfo& info) override;
+  bool Listen(int timeout_ms, ReadableInfo* info) override;
+  bool AddChannel(uint64_t channel_id) override;
+
+  static const char* Type() { return "channel"; }
+
+ private:
+  bool Init();
+  bool ClaimSlot();
+  void ReleaseSlot();
+
+  ChannelRing* GetRing(uint64_t channel_id);
+  bool TryRead(ReadableInfo* info);
+  void RingDoorbells(const ChannelIndicator* indicator);
+
+  void* registry_shm_ = nullptr;
+  Registry* registry_ = nullptr;
+  int32_t slot_ = -1;
+
+  // key: channel_id
+  std::unordered_map<uint64_t, ChannelRing> rings_;
+  std::vector<uint64_t> listen_channels_;
+  size_t next_listen_index_ = 0;
+  base::AtomicRWLock rings_lock_;
+
+  std::atomic<bool> is_shutdown_ = {false};
+
+  DECLARE_SINGLETON(ChannelNotifier)
+};
+
+}  // namespace transport
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_TRANSPORT_SHM_CHANNEL_NOTIFIER_H_
@@ -0,0 +1,91 @@
+/******************************************************************************
+ * Copyright 2024 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/transport/shm/channel_notifier.h"
+
+#include <chrono>
+#include <thread>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace cyber {
+namespace transport {
+
+TEST(ChannelNotifierTest, constructor) {
+  auto notifier = ChannelNotifier::Instance();
+  EXPECT_NE(notifier, nullptr);
+}
+
+TEST(ChannelNotifierTest, only_listened_channels) {
+  auto notifier = ChannelNotifier::Instance();
+  ReadableInfo readable_info;
+  EXPECT_TRUE(notifier->AddChannel(1));
+  while (notifier->Listen(10, &readable_info)) {
+  }
+
+  // channel 2 is not listened, its notification never reaches us
+  EXPECT_TRUE(notifier->Notify(ReadableInfo(0, 0, 2)));
+  EXPECT_FALSE(notifier->Listen(100, &readable_info));
+
+  EXPECT_TRUE(notifier->Notify(ReadableInfo(0, 5, 1)));
+  EXPECT_TRUE(notifier->Listen(100, &readable_info));
+  EXPECT_EQ(readable_info.channel_id(), 1);
+  EXPECT_EQ(readable_info.block_index(), 5);
+  EXPECT_FALSE(notifier->Listen(100, &readable_info));
+
+  EXPECT_TRUE(notifier->AddChannel(2));
+  EXPECT_TRUE(notifier->Notify(ReadableInfo(0, 1, 2)));
+  EXPECT_TRUE(notifier->Notify(ReadableInfo(0, 6, 1)));
+  EXPECT_TRUE(notifier->Listen(100, &readable_info));
+  EXPECT_TRUE(notifier->Listen(100, &readable_info));
+  EXPECT_FALSE(notifier->Listen(100, &readable_info));
+}
+
+TEST(ChannelNotifierTest, blocked_listener_wakeup) {
+  auto notifier = ChannelNotifier::Instance();
+  ReadableInfo readable_info;
+  EXPECT_TRUE(notifier->AddChannel(3));
+  while (notifier->Listen(10, &readable_info)) {
+  }
+
+  std::thread notify_thread([notifier]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    notifier->Notify(ReadableInfo(0, 7, 3));
+  });
+
+  auto start = std::chrono::steady_clock::now();
+  EXPECT_TRUE(notifier->Listen(1000, &readable_info));
+  auto cost = std::chrono::steady_clock::now() - start;
+  notify_thread.join();
+
+  EXPECT_LT(cost, std::chrono::milliseconds(500));
+  EXPECT_EQ(readable_info.channel_id(), 3);
+  EXPECT_EQ(readable_info.block_index(), 7);
+}
+
+TEST(ChannelNotifierTest, shutdown) {
+  auto notifier = ChannelNotifier::Instance();
+  notifier->Shutdown();
+  ReadableInfo readable_info;
+  EXPECT_FALSE(notifier->AddChannel(4));
+  EXPECT_FALSE(notifier->Notify(readable_info));
+  EXPECT_FALSE(notifier->Listen(100, &readable_info));
+}
+
+}  // namespace transport
+}  // namespace cyber
+}  // namespace apollo
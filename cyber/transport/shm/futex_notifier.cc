@@ -0,0 +1,267 @@
+/******************************************************************************
+ * Copyright 2024 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/transport/shm/futex_notifier.h"
+
+#include <linux/futex.h>
+#include <sys/ipc.h>
+#include <sys/shm.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <cstring>
+#include <ctime>
+#include <thread>
+
+#include "cyber/common/log.h"
+#include "cyber/common/util.h"
+
+namespace apollo {
+namespace cyber {
+namespace transport {
+
+using common::Hash;
+
+FutexNotifier::FutexNotifier() {
+  key_ = static_cast<key_t>(
+      Hash("/apollo/cyber/transport/shm/futex_notifier"));
+  ADEBUG << "futex notifier key: " << key_;
+  shm_size_ = sizeof(Indicator);
+
+  if (!Init()) {
+    AERROR << "fail to init futex notifier.";
+    is_shutdown_.store(true);
+    return;
+  }
+  next_seq_ = indicator_->next_seq.load();
+  ADEBUG << "next_seq: " << next_seq_;
+}
+
+FutexNotifier::~FutexNotifier() { Shutdown(); }
+
+void FutexNotifier::Shutdown() {
+  if (is_shutdown_.exchange(true)) {
+    return;
+  }
+
+  // kick listeners blocked in futex wait so they observe is_shutdown_
+  Wake();
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  Reset();
+}
+
+bool FutexNotifier::Notify(const ReadableInfo& info) {
+  if (is_shutdown_.load()) {
+    ADEBUG << "notifier is shutdown.";
+    return false;
+  }
+
+  uint64_t seq = indicator_->next_seq.fetch_add(1);
+  uint64_t idx = seq % kBufLength;
+  indicator_->infos[idx] = info;
+  indicator_->seqs[idx] = seq;
+
+  // publish the slot before bumping the futex word, a listener that saw the
+  // old futex value is then guaranteed to either read the slot or be woken.
+  indicator_->futex.fetch_add(1);
+  if (indicator_->waiters.load() > 0) {
+    Wake();
+  }
+
+  return true;
+}
+
+bool FutexNotifier::Listen(int timeout_ms, ReadableInfo* info) {
+  if (info == nullptr) {
+    AERROR << "info nullptr.";
+    return false;
+  }
+
+  if (is_shutdown_.load()) {
+    ADEBUG << "notifier is shutdown.";
+    return false;
+  }
+
+  auto deadline = std::chrono::steady_clock::now() +
+                  std::chrono::milliseconds(timeout_ms);
+  while (!is_shutdown_.load()) {
+    // load the futex word before checking the ring, any Notify issued after
+    // the check changes the word and makes the futex wait return at once.
+    uint32_t expected = indicator_->futex.load();
+    if (TryRead(info)) {
+      return true;
+    }
+
+    auto remain_us = std::chrono::duration_cast<std::chrono::microseconds>(
+                         deadline - std::chrono::steady_clock::now())
+                         .count();
+    if (remain_us <= 0) {
+      return false;
+    }
+    Wait(expected, remain_us);
+  }
+  return false;
+}
+
+bool FutexNotifier::TryRead(ReadableInfo* info) {
+  uint64_t seq = indicator_->next_seq.load();
+  if (seq == next_seq_) {
+    return false;
+  }
+
+  auto idx = next_seq_ % kBufLength;
+  auto actual_seq = indicator_->seqs[idx];
+  if (actual_seq >= next_seq_) {
+    next_seq_ = actual_seq;
+    *info = indicator_->infos[idx];
+    ++next_seq_;
+    return true;
+  }
+
+  ADEBUG << "seq[" << next_seq_ << "] is writing, can not read now.";
+  return false;
+}
+
+void FutexNotifier::Wait(uint32_t expected, int64_t timeout_us) {
+  struct timespec ts;
+  ts.tv_sec = static_cast<time_t>(timeout_us / 1000000);
+  ts.tv_nsec = static_cast<long>((timeout_us % 1000000) * 1000);  // NOLINT
+
+  indicator_->waiters.fetch_add(1);
+  // the indicator is shared between processes, so FUTEX_PRIVATE_FLAG must not
+  // be used here.
+  long ret = syscall(SYS_futex,  // NOLINT
+                     reinterpret_cast<uint32_t*>(&indicator_->futex),
+                     FUTEX_WAIT, expected, &ts, nullptr, 0);
+  indicator_->waiters.fetch_sub(1);
+  if (ret == -1 && errno != EAGAIN && errno != ETIMEDOUT && errno != EINTR) {
+    AERROR << "futex wait failed, error: " << strerror(errno);
+  }
+}
+
+void FutexNotifier::Wake() {
+  if (indicator_ == nullptr) {
+    return;
+  }
+  syscall(SYS_futex, reinterpret_cast<uint32_t*>(&indicator_->futex),
+          FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+}
+
+bool FutexNotifier::Init() { return OpenOrCreate(); }
+
+bool FutexNotifier::OpenOrCreate() {
+  // create managed_shm_
+  int retry = 0;
+  int shmid = 0;
+  while (retry < 2) {
+    shmid = shmget(key_, shm_size_, 0644 | IPC_CREAT | IPC_EXCL);
+    if (shmid != -1) {
+      break;
+    }
+
+    if (EINVAL == errno) {
+      AINFO << "need larger space, recreate.";
+      Reset();
+      Remove();
+      ++retry;
+    } else if (EEXIST == errno) {
+      ADEBUG << "shm already exist, open only.";
+      return OpenOnly();
+    } else {
+      break;
+    }
+  }
+
+  if (shmid == -1) {
+    AERROR << "create shm failed, error code: " << strerror(errno);
+    return false;
+  }
+
+  // attach managed_shm_
+  managed_shm_ = shmat(shmid, nullptr, 0);
+  if (managed_shm_ == reinterpret_cast<void*>(-1)) {
+    AERROR << "attach shm failed.";
+    shmctl(shmid, IPC_RMID, 0);
+    return false;
+  }
+
+  // create indicator_
+  indicator_ = new (managed_shm_) Indicator();
+  if (indicator_ == nullptr) {
+    AERROR << "create indicator failed.";
+    shmdt(managed_shm_);
+    managed_shm_ = nullptr;
+    shmctl(shmid, IPC_RMID, 0);
+    return false;
+  }
+
+  ADEBUG << "open or create true.";
+  return true;
+}
+
+bool FutexNotifier::OpenOnly() {
+  // get managed_shm_
+  int shmid = shmget(key_, 0, 0644);
+  if (shmid == -1) {
+    AERROR << "get shm failed, error: " << strerror(errno);
+    return false;
+  }
+
+  // attach managed_shm_
+  managed_shm_ = shmat(shmid, nullptr, 0);
+  if (managed_shm_ == reinterpret_cast<void*>(-1)) {
+    AERROR << "attach shm failed, error: " << strerror(errno);
+    return false;
+  }
+
+  // get indicator_
+  indicator_ = reinterpret_cast<Indicator*>(managed_shm_);
+  if (indicator_ == nullptr) {
+    AERROR << "get indicator failed.";
+    shmdt(managed_shm_);
+    managed_shm_ = nullptr;
+    return false;
+  }
+
+  ADEBUG << "open true.";
+  return true;
+}
+
+bool FutexNotifier::Remove() {
+  int shmid = shmget(key_, 0, 0644);
+  if (shmid == -1 || shmctl(shmid, IPC_RMID, 0) == -1) {
+    AERROR << "remove shm failed, error code: " << strerror(errno);
+    return false;
+  }
+  ADEBUG << "remove success.";
+
+  return true;
+}
+
+void FutexNotifier::Reset() {
+  indicator_ = nullptr;
+  if (managed_shm_ != nullptr) {
+    shmdt(managed_shm_);
+    managed_shm_ = nullptr;
+  }
+}
+
+}  // namespace transport
+}  // namespace cyber
+}  // namespace apollo
@@ -0,0 +1,153 @@
+/******************************************************************************
+ * Copyright 2024 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_TRANSPORT_SHM_LOANED_MESSAGE_H_
+#define CYBER_TRANSPORT_SHM_LOANED_MESSAGE_H_
+
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "cyber/message/zero_copy_message_traits.h"
+#include "cyber/transport/shm/segment.h"
+
+namespace apollo {
+namespace cyber {
+namespace transport {
+
+/**
+ * @class LoanedMessage
+ * @brief A zero copy message lent by a writer. The message either lives in a
+ * write locked block of the channel's shared memory segment, when there are
+ * readers in other processes, or on the heap otherwise. Returning the loan
+ * without publishing it releases the block untouched by readers.
+ */
+template <typename M>
+class LoanedMessage {
+ public:
+  LoanedMessage() = default;
+  ~LoanedMessage() { Reset(); }
+
+  LoanedMessage(const LoanedMessage&) = delete;
+  LoanedMessage& operator=(const LoanedMessage&) = delete;
+
+  LoanedMessage(LoanedMessage&& other) noexcept { *this = std::move(other); }
+  LoanedMessage& operator=(LoanedMessage&& other) noexcept {
+    if (this != &other) {
+      Reset();
+      segment_ = std::move(other.segment_);
+      block_ = other.block_;
+      heap_msg_ = std::move(other.heap_msg_);
+      msg_ = other.msg_;
+      other.segment_ = nullptr;
+      other.block_ = WritableBlock();
+      other.msg_ = nullptr;
+    }
+    return *this;
+  }
+
+  bool IsValid() const { return msg_ != nullptr; }
+  bool InSharedMemory() const { return segment_ != nullptr; }
+  const SegmentPtr& segment() const { return segment_; }
+
+  M* get() const { return msg_; }
+  M& operator*() const { return *msg_; }
+  M* operator->() const { return msg_; }
+
+  /**
+   * @brief Construct the message in a block acquired for write, the block
+   * stays write locked until the loan is published or reset.
+   */
+  bool Bind(const SegmentPtr& segment, const WritableBlock& block) {
+    if (reinterpret_cast<uintptr_t>(block.buf) % alignof(M) != 0) {
+      return false;
+    }
+    Reset();
+    segment_ = segment;
+    block_ = block;
+    msg_ = new (block_.buf) M();
+    return true;
+  }
+
+  void Allocate() {
+    Reset();
+    heap_msg_ = std::make_shared<M>();
+    msg_ = heap_msg_.get();
+  }
+
+  /**
+   * @brief Hand the block over to the transmitter which publishes it, the
+   * loan is empty afterwards.
+   */
+  WritableBlock Detach() {
+    WritableBlock block = block_;
+    segment_ = nullptr;
+    block_ = WritableBlock();
+    msg_ = nullptr;
+    return block;
+  }
+
+  /**
+   * @brief The message as a shared pointer for the transports that do not
+   * take loans, a message in shared memory is copied out.
+   */
+  std::shared_ptr<M> Share() const {
+    if (heap_msg_ != nullptr) {
+      return heap_msg_;
+    }
+    return CopyOut<M>(msg_);
+  }
+
+  void Reset() {
+    if (segment_ != nullptr) {
+      segment_->ReleaseWrittenBlock(block_);
+    }
+    segment_ = nullptr;
+    block_ = WritableBlock();
+    heap_msg_ = nullptr;
+    msg_ = nullptr;
+  }
+
+ private:
+  // only zero copy messages are ever bound to a block
+  template <typename T>
+  static typename std::enable_if<message::IsZeroCopyMessage<T>::value,
+                                 std::shared_ptr<T>>::type
+  CopyOut(const T* msg) {
+    return msg == nullptr ? nullptr : std::make_shared<T>(*msg);
+  }
+
+  template <typename T>
+  static typename std::enable_if<!message::IsZeroCopyMessage<T>::value,
+                                 std::shared_ptr<T>>::type
+  CopyOut(const T* msg) {
+    (void)msg;
+    return nullptr;
+  }
+
+  SegmentPtr segment_ = nullptr;
+  WritableBlock block_;
+  std::shared_ptr<M> heap_msg_ = nullptr;
+  M* msg_ = nullptr;
+};
+
+}  // namespace transport
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_TRANSPORT_SHM_LOANED_MESSAGE_H_
@@ -0,0 +1,125 @@
+/******************************************************************************
+ * Copyright 2024 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/transport/shm/loaned_message.h"
+
+#include <utility>
+
+#include "gtest/gtest.h"
+
+#include "cyber/common/global_data.h"
+#include "cyber/message/message_traits.h"
+#include "cyber/transport/shm/segment_factory.h"
+
+namespace {
+
+struct LoanedPose {
+  uint64_t timestamp;
+  double x;
+  double y;
+};
+
+}  // namespace
+
+CYBER_REGISTER_ZERO_COPY_MESSAGE(LoanedPose)
+
+namespace apollo {
+namespace cyber {
+namespace transport {
+
+class LoanedMessageTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    channel_id_ = common::GlobalData::RegisterChannel("loaned_message_test");
+    segment_ = SegmentFactory::CreateSegment(channel_id_);
+    ASSERT_NE(segment_, nullptr);
+    ASSERT_TRUE(segment_->AcquireBlockToWrite(sizeof(LoanedPose), &block_));
+  }
+
+  void TearDown() override { segment_ = nullptr; }
+
+  uint64_t channel_id_ = 0;
+  SegmentPtr segment_;
+  WritableBlock block_;
+};
+
+TEST_F(LoanedMessageTest, bind_and_reset) {
+  LoanedMessage<LoanedPose> loaned;
+  EXPECT_FALSE(loaned.IsValid());
+  ASSERT_TRUE(loaned.Bind(segment_, block_));
+  EXPECT_TRUE(loaned.IsValid());
+  EXPECT_TRUE(loaned.InSharedMemory());
+  EXPECT_EQ(reinterpret_cast<uint8_t*>(loaned.get()), block_.buf);
+  EXPECT_EQ(loaned->timestamp, 0);
+
+  // the block is write locked as long as it is loaned
+  EXPECT_FALSE(segment_->LockBlockForReadByIndex(block_.index));
+
+  LoanedMessage<LoanedPose> moved(std::move(loaned));
+  EXPECT_FALSE(loaned.IsValid());
+  EXPECT_TRUE(moved.IsValid());
+
+  moved.Reset();
+  EXPECT_FALSE(moved.IsValid());
+  EXPECT_TRUE(segment_->LockBlockForReadByIndex(block_.index));
+  segment_->ReleaseBlockForReadByIndex(block_.index);
+}
+
+TEST_F(LoanedMessageTest, detach_and_read) {
+  LoanedMessage<LoanedPose> loaned;
+  ASSERT_TRUE(loaned.Bind(segment_, block_));
+  loaned->timestamp = 42;
+  loaned->x = 1.0;
+  loaned->y = 2.0;
+
+  auto copy = loaned.Share();
+  ASSERT_NE(copy, nullptr);
+  EXPECT_NE(copy.get(), loaned.get());
+  EXPECT_EQ(copy->timestamp, 42);
+
+  WritableBlock wb = loaned.Detach();
+  EXPECT_FALSE(loaned.IsValid());
+  EXPECT_EQ(wb.index, block_.index);
+  wb.block->set_msg_size(sizeof(LoanedPose));
+  segment_->ReleaseWrittenBlock(wb);
+
+  ReadableBlock rb;
+  rb.index = wb.index;
+  ASSERT_TRUE(segment_->AcquireBlockToRead(&rb));
+  LoanedPose pose;
+  EXPECT_TRUE(message::ParseFromArray(
+      rb.buf, static_cast<int>(rb.block->msg_size()), &pose));
+  segment_->ReleaseReadBlock(rb);
+  EXPECT_EQ(pose.timestamp, 42);
+  EXPECT_EQ(pose.y, 2.0);
+}
+
+TEST_F(LoanedMessageTest, heap) {
+  segment_->ReleaseWrittenBlock(block_);
+  LoanedMessage<LoanedPose> loaned;
+  loaned.Allocate();
+  EXPECT_TRUE(loaned.IsValid());
+  EXPECT_FALSE(loaned.InSharedMemory());
+  loaned->timestamp = 7;
+  auto shared = loaned.Share();
+  EXPECT_EQ(shared.get(), loaned.get());
+  loaned.Reset();
+  EXPECT_EQ(shared->timestamp, 7);
+}
+
+}  // namespace transport
+}  // namespace cyber
+}  // namespace apollo
@@ -17,6 +17,7 @@
 #ifndef CYBER_TRANSPORT_SHM_NOTIFIER_BASE_H_
 #define CYBER_TRANSPORT_SHM_NOTIFIER_BASE_H_
 
+#include <cstdint>
 #include <memory>
 
 #include "cyber/transport/shm/readable_info.h"
@@ -35,6 +36,13 @@ class NotifierBase {
   virtual void Shutdown() = 0;
   virtual bool Notify(const ReadableInfo& info) = 0;
   virtual bool Listen(int timeout_ms, ReadableInfo* info) = 0;
+
+  // Declares that this process listens on channel_id. Notifiers that keep a
+  // single host wide stream deliver every channel and ignore it.
+  virtual bool AddChannel(uint64_t channel_id) {
+    (void)channel_id;
+    return true;
+  }
 };
 
 }  // namespace transport
@@ -31,6 +31,8 @@ class NotifierFactory {
 
  private:
   static NotifierPtr CreateConditionNotifier();
+  static NotifierPtr CreateFutexNotifier();
+  static NotifierPtr CreateChannelNotifier();
   static NotifierPtr CreateMulticastNotifier();
 };
 
@@ -60,8 +60,13 @@ bool PosixSegment::OpenOrCreate() {
   }
 
   // attach managed_shm_
+  int flags = MAP_SHARED;
+  if (conf_.ring_layout()) {
+    // pages of the ring are only committed when they are touched
+    flags |= MAP_NORESERVE;
+  }
   managed_shm_ = mmap(nullptr, conf_.managed_shm_size(), PROT_READ | PROT_WRITE,
-                      MAP_SHARED, fd, 0);
+                      flags, fd, 0);
   if (managed_shm_ == MAP_FAILED) {
     AERROR << "attach shm failed:" << strerror(errno);
     close(fd);
@@ -190,8 +195,12 @@ bool PosixSegment::OpenOnly() {
   }
 
   // attach managed_shm_
+  int flags = MAP_SHARED;
+  if (conf_.ring_layout()) {
+    flags |= MAP_NORESERVE;
+  }
   managed_shm_ = mmap(nullptr, file_attr.st_size, PROT_READ | PROT_WRITE,
-                      MAP_SHARED, fd, 0);
+                      flags, fd, 0);
   if (managed_shm_ == MAP_FAILED) {
     AERROR << "attach shm failed: " << strerror(errno);
     close(fd);
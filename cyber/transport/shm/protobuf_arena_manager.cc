@@ -18,7 +18,10 @@
 #include <sys/ipc.h>
 #include <sys/shm.h>
 
+#include <algorithm>
+#include <chrono>
 #include <cstring>
+#include <sstream>
 #include <string>
 
 #include <google/protobuf/arena.h>
@@ -30,10 +33,44 @@ namespace apollo {
 namespace cyber {
 namespace transport {
 
+namespace {
+
+uint64_t NowNs() {
+  // steady clock is system wide, so it can be compared across processes
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+uint64_t RoundUp(uint64_t size, uint64_t align) {
+  return (size + align - 1) / align * align;
+}
+
+// extents are sized by power of two so that an idle one is likely to fit the
+// next large message
+uint64_t ExtentSize(uint64_t size) {
+  uint64_t extent_size = static_cast<uint64_t>(SHMLBA);
+  while (extent_size < size) {
+    extent_size <<= 1;
+  }
+  return extent_size;
+}
+
+}  // namespace
+
 const int32_t ArenaSegmentBlock::kRWLockFree = 0;
 const int32_t ArenaSegmentBlock::kWriteExclusive = -1;
 const int32_t ArenaSegmentBlock::kMaxTryLockTimes = 5;
 
+const uint32_t ArenaSegmentExtent::kFree = 0;
+const uint32_t ArenaSegmentExtent::kCreating = 1;
+const uint32_t ArenaSegmentExtent::kBound = 2;
+const uint32_t ArenaSegmentExtent::kIdle = 3;
+const uint32_t ArenaSegmentExtent::kReclaiming = 4;
+const uint32_t ArenaSegmentExtent::kReclaimed = 5;
+
+const uint32_t ArenaSegment::kMaxExtentNum = 64;
+
 ArenaSegment::ArenaSegment()
     : channel_id_(0), key_id_(0), base_address_(nullptr) {}
 
@@ -49,15 +86,26 @@ ArenaSegment::ArenaSegment(uint64_t channel_id, void* base_address)
       base_address_(base_address) {}
 
 ArenaSegment::ArenaSegment(uint64_t channel_id, uint64_t message_size,
-                           uint64_t block_num, void* base_address)
+                           uint64_t block_num, void* base_address,
+                           uint64_t address_space_size)
     : channel_id_(channel_id),
       key_id_(std::hash<std::string>{}("/apollo/__arena__/" +
                                        std::to_string(channel_id))),
-      base_address_(base_address) {
+      base_address_(base_address),
+      address_space_size_(base_address ? address_space_size : 0) {
   Init(message_size, block_num);
 }
 
-ArenaSegment::~ArenaSegment() {}
+ArenaSegment::~ArenaSegment() {
+  std::lock_guard<std::mutex> lock(extent_mutex_);
+  for (uint32_t i = 0; i < extent_addresses_.size(); ++i) {
+    DetachExtent(i);
+  }
+  if (state_) {
+    state_->struct_.ref_count_.fetch_sub(1);
+    shmdt(shm_address_);
+  }
+}
 
 bool ArenaSegment::Init(uint64_t message_size, uint64_t block_num) {
   uint64_t key_id = std::hash<std::string>{}("/apollo/__arena__/" +
@@ -71,12 +119,50 @@ bool ArenaSegment::Init(uint64_t message_size, uint64_t block_num) {
   return true;
 }
 
+void ArenaSegment::InitLayout(uint64_t message_size, uint64_t block_num,
+                              uint64_t shared_buffer_size) {
+  // [state][extents][blocks][block buffers][shared buffer]
+  message_capacity_ = message_size;
+  state_ = reinterpret_cast<ArenaSegmentState*>(shm_address_);
+  extents_ = reinterpret_cast<ArenaSegmentExtent*>(
+      reinterpret_cast<uint64_t>(shm_address_) + sizeof(ArenaSegmentState));
+  blocks_ = reinterpret_cast<ArenaSegmentBlock*>(
+      reinterpret_cast<uint64_t>(extents_) +
+      kMaxExtentNum * sizeof(ArenaSegmentExtent));
+  uint64_t buffer_address = reinterpret_cast<uint64_t>(blocks_) +
+                            block_num * sizeof(ArenaSegmentBlock);
+
+  arenas_.resize(block_num, nullptr);
+  if (shared_buffer_size == 0) {
+    shared_buffer_arena_ = nullptr;
+  } else {
+    google::protobuf::ArenaOptions options;
+    options.start_block_size = shared_buffer_size;
+    options.max_block_size = shared_buffer_size;
+    options.initial_block =
+        reinterpret_cast<char*>(buffer_address + block_num * message_size);
+    options.initial_block_size = shared_buffer_size;
+    shared_buffer_arena_ = std::make_shared<google::protobuf::Arena>(options);
+  }
+  for (size_t i = 0; i < block_num; i++) {
+    arena_block_address_.push_back(buffer_address + i * message_size);
+  }
+
+  auto arena_conf =
+      cyber::common::GlobalData::Instance()->GetChannelArenaConf(channel_id_);
+  max_extent_num_ = std::min(arena_conf.max_extent_num(), kMaxExtentNum);
+  extent_idle_timeout_ns_ = arena_conf.extent_idle_timeout_ms() * 1000000;
+  extent_addresses_.assign(kMaxExtentNum, nullptr);
+  extent_generations_.assign(kMaxExtentNum, 0);
+}
+
 bool ArenaSegment::OpenOrCreate(uint64_t message_size, uint64_t block_num) {
   auto arena_conf =
       cyber::common::GlobalData::Instance()->GetChannelArenaConf(channel_id_);
   auto shared_buffer_size = arena_conf.shared_buffer_size();
   auto size = sizeof(ArenaSegmentState) +
-              sizeof(ArenaSegmentBlockDescriptor) * block_num +
+              sizeof(ArenaSegmentExtent) * kMaxExtentNum +
+              sizeof(ArenaSegmentBlock) * block_num +
               message_size * block_num + shared_buffer_size;
   auto shmid =
       shmget(static_cast<key_t>(key_id_), size, 0644 | IPC_CREAT | IPC_EXCL);
@@ -91,45 +177,36 @@ bool ArenaSegment::OpenOrCreate(uint64_t message_size, uint64_t block_num) {
       return false;
     }
   }
-  message_capacity_ = message_size;
   shm_address_ = shmat(shmid, base_address_, 0);
   if (shm_address_ == reinterpret_cast<void*>(-1)) {
     // shmat failed
+    shm_address_ = nullptr;
     return false;
   }
+  InitLayout(message_size, block_num, shared_buffer_size);
 
-  arenas_.resize(block_num, nullptr);
-  if (shared_buffer_size == 0) {
-    shared_buffer_arena_ = nullptr;
-  } else {
-    google::protobuf::ArenaOptions options;
-    options.start_block_size = shared_buffer_size;
-    options.max_block_size = shared_buffer_size;
-    options.initial_block = reinterpret_cast<char*>(
-        reinterpret_cast<uint64_t>(shm_address_) + sizeof(ArenaSegmentState) +
-        block_num * sizeof(ArenaSegmentBlock) + block_num * message_size);
-    options.initial_block_size = shared_buffer_size;
-    shared_buffer_arena_ = std::make_shared<google::protobuf::Arena>(options);
-  }
-  for (size_t i = 0; i < block_num; i++) {
-    arena_block_address_.push_back(
-        reinterpret_cast<uint64_t>(shm_address_) + sizeof(ArenaSegmentState) +
-        block_num * sizeof(ArenaSegmentBlock) + i * message_size);
-  }
-
-  state_ = reinterpret_cast<ArenaSegmentState*>(shm_address_);
   state_->struct_.ref_count_.store(1);
-  state_->struct_.auto_extended_.store(false);
+  state_->struct_.auto_extended_.store(max_extent_num_ > 0 &&
+                                       address_space_size_ > 0);
   state_->struct_.message_size_.store(message_size);
   state_->struct_.block_num_.store(block_num);
   state_->struct_.message_seq_.store(0);
-  blocks_ = reinterpret_cast<ArenaSegmentBlock*>(
-      reinterpret_cast<uint64_t>(shm_address_) + sizeof(ArenaSegmentState));
+  state_->struct_.extent_end_.store(RoundUp(size, SHMLBA));
+  state_->struct_.extent_generation_.store(0);
+  for (uint32_t i = 0; i < kMaxExtentNum; ++i) {
+    extents_[i].state_.store(ArenaSegmentExtent::kFree);
+    extents_[i].generation_.store(0);
+    extents_[i].idle_since_ns_.store(0);
+    extents_[i].offset_ = 0;
+    extents_[i].size_ = 0;
+  }
   for (uint64_t i = 0; i < block_num; ++i) {
     blocks_[i].size_ = message_size;
     // blocks_[i].writing_ref_count_.store(0);
     // blocks_[i].reading_ref_count_.store(0);
     blocks_[i].lock_num_.store(0);
+    blocks_[i].extent_index_.store(-1);
+    blocks_[i].used_size_.store(0);
   }
   return true;
 }
@@ -146,32 +223,12 @@ bool ArenaSegment::Open(uint64_t message_size, uint64_t block_num) {
   shm_address_ = shmat(shmid, base_address_, 0);
   if (shm_address_ == reinterpret_cast<void*>(-1)) {
     // shmat failed
+    shm_address_ = nullptr;
     return false;
   }
-  message_capacity_ = message_size;
-  state_ = reinterpret_cast<ArenaSegmentState*>(shm_address_);
+  InitLayout(message_size, block_num, shared_buffer_size);
   state_->struct_.ref_count_.fetch_add(1);
-  blocks_ = reinterpret_cast<ArenaSegmentBlock*>(
-      reinterpret_cast<uint64_t>(shm_address_) + sizeof(ArenaSegmentState));
-
-  arenas_.resize(block_num, nullptr);
-  if (shared_buffer_size == 0) {
-    shared_buffer_arena_ = nullptr;
-  } else {
-    google::protobuf::ArenaOptions options;
-    options.start_block_size = shared_buffer_size;
-    options.max_block_size = shared_buffer_size;
-    options.initial_block = reinterpret_cast<char*>(
-        reinterpret_cast<uint64_t>(shm_address_) + sizeof(ArenaSegmentState) +
-        block_num * sizeof(ArenaSegmentBlock) + block_num * message_size);
-    options.initial_block_size = shared_buffer_size;
-    shared_buffer_arena_ = std::make_shared<google::protobuf::Arena>(options);
-  }
-  for (size_t i = 0; i < block_num; i++) {
-    arena_block_address_.push_back(
-        reinterpret_cast<uint64_t>(shm_address_) + sizeof(ArenaSegmentState) +
-        block_num * sizeof(ArenaSegmentBlock) + i * message_size);
-  }
+  SyncExtents();
   return true;
 }
 
@@ -263,16 +320,28 @@ bool ArenaSegment::AcquireBlockToWrite(uint64_t size,
     return false;
   }
 
-  // TODO(all): support dynamic block size
-
-  uint64_t block_num = state_->struct_.block_num_.load();
-  uint64_t block_size = state_->struct_.message_size_.load();
   uint64_t block_index = GetNextWritableBlockIndex();
+  if (size > state_->struct_.message_size_.load()) {
+    if (!BindExtent(block_index, size)) {
+      RemoveBlockWriteLock(block_index);
+      return false;
+    }
+  } else {
+    UnbindExtent(block_index);
+  }
   block_info->block_index_ = block_index;
   block_info->block_ = &blocks_[block_index];
-  block_info->block_buffer_address_ = reinterpret_cast<void*>(
-      reinterpret_cast<uint64_t>(shm_address_) + sizeof(ArenaSegmentState) +
-      block_num * sizeof(ArenaSegmentBlock) + block_index * block_size);
+  block_info->block_buffer_address_ = GetBlockBufferAddress(block_index);
+  block_info->block_buffer_size_ = GetBlockBufferSize(block_index);
+
+  // the writer claiming the reclaim slot reclaims, the others go on
+  uint64_t now = NowNs();
+  uint64_t next_reclaim_ns = next_reclaim_ns_.load();
+  if (now >= next_reclaim_ns &&
+      next_reclaim_ns_.compare_exchange_strong(
+          next_reclaim_ns, now + extent_idle_timeout_ns_ / 2)) {
+    ReclaimIdleExtents();
+  }
   return true;
 }
 
@@ -299,19 +368,16 @@ bool ArenaSegment::AcquireBlockToRead(ArenaSegmentBlockInfo* block_info) {
     return false;
   }
 
-  // TODO(all): support dynamic block size
-
   if (!AddBlockReadLock(block_info->block_index_)) {
     return false;
   }
-  uint64_t block_num = state_->struct_.block_num_.load();
-  uint64_t block_size = state_->struct_.message_size_.load();
+  SyncExtents();
 
   block_info->block_ = &blocks_[block_info->block_index_];
-  block_info->block_buffer_address_ = reinterpret_cast<void*>(
-      reinterpret_cast<uint64_t>(shm_address_) + sizeof(ArenaSegmentState) +
-      block_num * sizeof(ArenaSegmentBlock) +
-      block_info->block_index_ * block_size);
+  block_info->block_buffer_address_ =
+      GetBlockBufferAddress(block_info->block_index_);
+  block_info->block_buffer_size_ =
+      GetBlockBufferSize(block_info->block_index_);
   return true;
 }
 
@@ -325,6 +391,324 @@ void ArenaSegment::ReleaseReadBlock(const ArenaSegmentBlockInfo& block_info) {
   RemoveBlockReadLock(block_info.block_index_);
 }
 
+void* ArenaSegment::GetBlockBufferAddress(uint64_t block_index) {
+  int32_t extent_index = blocks_[block_index].extent_index_.load();
+  if (extent_index < 0) {
+    return reinterpret_cast<void*>(arena_block_address_[block_index]);
+  }
+  return reinterpret_cast<void*>(reinterpret_cast<uint64_t>(shm_address_) +
+                                 extents_[extent_index].offset_);
+}
+
+uint64_t ArenaSegment::GetBlockBufferSize(uint64_t block_index) {
+  int32_t extent_index = blocks_[block_index].extent_index_.load();
+  if (extent_index < 0) {
+    return state_->struct_.message_size_.load();
+  }
+  return extents_[extent_index].size_;
+}
+
+void ArenaSegment::SetBlockUsedSize(uint64_t block_index, uint64_t size) {
+  blocks_[block_index].used_size_.store(size);
+}
+
+uint64_t ArenaSegment::ExtentKey(uint32_t extent_index) const {
+  return std::hash<std::string>{}("/apollo/__arena__/" +
+                                  std::to_string(channel_id_) + "/extent/" +
+                                  std::to_string(extent_index));
+}
+
+bool ArenaSegment::BindExtent(uint64_t block_index, uint64_t size) {
+  // the write lock of the block is held, so nobody reads its extent
+  std::lock_guard<std::mutex> lock(extent_mutex_);
+  auto& block = blocks_[block_index];
+  int32_t current = block.extent_index_.load();
+  if (current >= 0 && extents_[current].size_ >= size &&
+      AttachExtent(static_cast<uint32_t>(current))) {
+    block.size_ = extents_[current].size_;
+    return true;
+  }
+  UnbindExtent(block_index);
+  if (max_extent_num_ == 0 || address_space_size_ == 0) {
+    AWARN << "message of " << size << " bytes exceeds the arena block size "
+          << state_->struct_.message_size_.load() << " of channel "
+          << channel_id_ << ", and the segment can not grow.";
+    return false;
+  }
+
+  uint64_t extent_size = ExtentSize(size);
+  int64_t idle = -1;
+  int64_t reclaimed = -1;
+  int64_t unused = -1;
+  uint32_t used_num = 0;
+  for (uint32_t i = 0; i < max_extent_num_; ++i) {
+    auto state = extents_[i].state_.load();
+    if (state == ArenaSegmentExtent::kIdle &&
+        extents_[i].size_ >= extent_size &&
+        (idle < 0 || extents_[i].size_ < extents_[idle].size_)) {
+      idle = i;
+    } else if (state == ArenaSegmentExtent::kReclaimed &&
+               extents_[i].size_ >= extent_size &&
+               (reclaimed < 0 ||
+                extents_[i].size_ < extents_[reclaimed].size_)) {
+      reclaimed = i;
+    } else if (state == ArenaSegmentExtent::kFree && unused < 0) {
+      unused = i;
+    }
+    if (state != ArenaSegmentExtent::kFree &&
+        state != ArenaSegmentExtent::kReclaimed) {
+      ++used_num;
+    }
+  }
+
+  uint32_t expected = ArenaSegmentExtent::kIdle;
+  if (idle >= 0 && extents_[idle].state_.compare_exchange_strong(
+                       expected, ArenaSegmentExtent::kBound)) {
+    if (!AttachExtent(static_cast<uint32_t>(idle))) {
+      extents_[idle].idle_since_ns_.store(NowNs());
+      extents_[idle].state_.store(ArenaSegmentExtent::kIdle);
+      return false;
+    }
+    block.size_ = extents_[idle].size_;
+    block.extent_index_.store(static_cast<int32_t>(idle));
+    return true;
+  }
+
+  int64_t target = -1;
+  expected = ArenaSegmentExtent::kReclaimed;
+  if (reclaimed >= 0 && extents_[reclaimed].state_.compare_exchange_strong(
+                            expected, ArenaSegmentExtent::kCreating)) {
+    // reuse the address range of a removed extent
+    target = reclaimed;
+  } else if (unused >= 0 && used_num < max_extent_num_) {
+    expected = ArenaSegmentExtent::kFree;
+    if (extents_[unused].state_.compare_exchange_strong(
+            expected, ArenaSegmentExtent::kCreating)) {
+      uint64_t end = state_->struct_.extent_end_.load();
+      do {
+        if (end + extent_size > address_space_size_) {
+          extents_[unused].state_.store(ArenaSegmentExtent::kFree);
+          AWARN << "address range of arena channel " << channel_id_
+                << " is used up, " << end << " of " << address_space_size_
+                << " bytes taken by the segment and its extents.";
+          return false;
+        }
+      } while (!state_->struct_.extent_end_.compare_exchange_weak(
+          end, end + extent_size));
+      extents_[unused].offset_ = end;
+      extents_[unused].size_ = extent_size;
+      target = unused;
+    }
+  }
+  if (target < 0) {
+    AWARN << "no arena extent left for a message of " << size
+          << " bytes in channel " << channel_id_ << ", "
+          << used_num << " extents in use.";
+    return false;
+  }
+  if (!CreateExtent(static_cast<uint32_t>(target))) {
+    extents_[target].state_.store(ArenaSegmentExtent::kReclaimed);
+    return false;
+  }
+  block.size_ = extents_[target].size_;
+  block.extent_index_.store(static_cast<int32_t>(target));
+  return true;
+}
+
+void ArenaSegment::UnbindExtent(uint64_t block_index) {
+  auto& block = blocks_[block_index];
+  int32_t extent_index = block.extent_index_.exchange(-1);
+  block.size_ = state_->struct_.message_size_.load();
+  if (extent_index < 0) {
+    return;
+  }
+  extents_[extent_index].idle_since_ns_.store(NowNs());
+  extents_[extent_index].state_.store(ArenaSegmentExtent::kIdle);
+}
+
+bool ArenaSegment::CreateExtent(uint32_t extent_index) {
+  auto& extent = extents_[extent_index];
+  auto key = static_cast<key_t>(ExtentKey(extent_index));
+  auto shmid = shmget(key, extent.size_, 0644 | IPC_CREAT | IPC_EXCL);
+  if (shmid == -1 && errno == EEXIST) {
+    // left behind by a crashed process, the slot says nobody uses it
+    shmctl(shmget(key, 0, 0644), IPC_RMID, nullptr);
+    shmid = shmget(key, extent.size_, 0644 | IPC_CREAT | IPC_EXCL);
+  }
+  if (shmid == -1) {
+    AERROR << "create arena extent of " << extent.size_
+           << " bytes failed, channel: " << channel_id_
+           << ", error: " << strerror(errno);
+    return false;
+  }
+
+  DetachExtent(extent_index);
+  void* expected_address = reinterpret_cast<void*>(
+      reinterpret_cast<uint64_t>(shm_address_) + extent.offset_);
+  void* address = shmat(shmid, expected_address, 0);
+  if (address != expected_address) {
+    AERROR << "attach arena extent at " << expected_address
+           << " failed, channel: " << channel_id_;
+    if (address != reinterpret_cast<void*>(-1)) {
+      shmdt(address);
+    }
+    shmctl(shmid, IPC_RMID, nullptr);
+    return false;
+  }
+  extent_addresses_[extent_index] = address;
+  extent_generations_[extent_index] = extent.generation_.fetch_add(1) + 1;
+  extent.state_.store(ArenaSegmentExtent::kBound);
+  state_->struct_.extent_generation_.fetch_add(1);
+  ADEBUG << "arena extent " << extent_index << " of " << extent.size_
+         << " bytes created, channel: " << channel_id_;
+  return true;
+}
+
+bool ArenaSegment::AttachExtent(uint32_t extent_index) {
+  auto& extent = extents_[extent_index];
+  uint64_t generation = extent.generation_.load();
+  if (extent_addresses_[extent_index] != nullptr &&
+      extent_generations_[extent_index] == generation) {
+    return true;
+  }
+  DetachExtent(extent_index);
+  auto shmid = shmget(static_cast<key_t>(ExtentKey(extent_index)), 0, 0644);
+  if (shmid == -1) {
+    AERROR << "open arena extent " << extent_index
+           << " failed, channel: " << channel_id_;
+    return false;
+  }
+  void* expected_address = reinterpret_cast<void*>(
+      reinterpret_cast<uint64_t>(shm_address_) + extent.offset_);
+  void* address = shmat(shmid, expected_address, 0);
+  if (address != expected_address) {
+    AERROR << "attach arena extent at " << expected_address
+           << " failed, channel: " << channel_id_;
+    if (address != reinterpret_cast<void*>(-1)) {
+      shmdt(address);
+    }
+    return false;
+  }
+  extent_addresses_[extent_index] = address;
+  extent_generations_[extent_index] = generation;
+  return true;
+}
+
+void ArenaSegment::DetachExtent(uint32_t extent_index) {
+  if (extent_addresses_[extent_index] != nullptr) {
+    shmdt(extent_addresses_[extent_index]);
+    extent_addresses_[extent_index] = nullptr;
+  }
+}
+
+void ArenaSegment::SyncExtents() {
+  if (!state_ || !extents_) {
+    return;
+  }
+  uint64_t generation = state_->struct_.extent_generation_.load();
+  if (generation == synced_extent_generation_) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(extent_mutex_);
+  bool settled = true;
+  for (uint32_t i = 0; i < kMaxExtentNum; ++i) {
+    auto state = extents_[i].state_.load();
+    if (state == ArenaSegmentExtent::kBound ||
+        state == ArenaSegmentExtent::kIdle) {
+      settled = AttachExtent(i) && settled;
+    } else if (state == ArenaSegmentExtent::kFree ||
+               state == ArenaSegmentExtent::kReclaimed) {
+      DetachExtent(i);
+      extent_generations_[i] = extents_[i].generation_.load();
+    } else {
+      // being created or removed, check again next time
+      settled = false;
+    }
+  }
+  if (settled) {
+    synced_extent_generation_ = generation;
+  }
+}
+
+uint64_t ArenaSegment::ReclaimIdleExtents(bool force) {
+  if (!state_ || !extents_) {
+    return 0;
+  }
+  std::lock_guard<std::mutex> lock(extent_mutex_);
+  uint64_t now = NowNs();
+  uint64_t reclaimed_num = 0;
+  for (uint32_t i = 0; i < kMaxExtentNum; ++i) {
+    auto& extent = extents_[i];
+    uint32_t expected = ArenaSegmentExtent::kIdle;
+    if (extent.state_.load() != expected) {
+      continue;
+    }
+    uint64_t idle_since = extent.idle_since_ns_.load();
+    if (!force &&
+        (now < idle_since || now - idle_since < extent_idle_timeout_ns_)) {
+      continue;
+    }
+    if (!extent.state_.compare_exchange_strong(
+            expected, ArenaSegmentExtent::kReclaiming)) {
+      continue;
+    }
+    // the memory is released once the last process detaches it
+    auto shmid = shmget(static_cast<key_t>(ExtentKey(i)), 0, 0644);
+    if (shmid != -1) {
+      shmctl(shmid, IPC_RMID, nullptr);
+    }
+    DetachExtent(i);
+    extent_generations_[i] = extent.generation_.fetch_add(1) + 1;
+    extent.state_.store(ArenaSegmentExtent::kReclaimed);
+    state_->struct_.extent_generation_.fetch_add(1);
+    ++reclaimed_num;
+  }
+  if (reclaimed_num > 0) {
+    ADEBUG << reclaimed_num << " idle arena extents removed, channel: "
+           << channel_id_;
+  }
+  return reclaimed_num;
+}
+
+ArenaSegmentUsage ArenaSegment::GetUsage() {
+  ArenaSegmentUsage usage;
+  usage.channel_id = channel_id_;
+  if (!state_ || !blocks_) {
+    return usage;
+  }
+  usage.block_num = state_->struct_.block_num_.load();
+  usage.block_size = state_->struct_.message_size_.load();
+  for (uint64_t i = 0; i < usage.block_num; ++i) {
+    if (blocks_[i].lock_num_.load() != ArenaSegmentBlock::kRWLockFree) {
+      ++usage.locked_block_num;
+    }
+    usage.used_bytes += blocks_[i].used_size_.load();
+  }
+  for (uint32_t i = 0; i < kMaxExtentNum; ++i) {
+    auto state = extents_[i].state_.load();
+    if (state == ArenaSegmentExtent::kBound) {
+      ++usage.bound_extent_num;
+      usage.extent_bytes += extents_[i].size_;
+    } else if (state == ArenaSegmentExtent::kIdle) {
+      ++usage.idle_extent_num;
+      usage.extent_bytes += extents_[i].size_;
+    } else if (state == ArenaSegmentExtent::kReclaimed) {
+      ++usage.reclaimed_extent_num;
+    }
+  }
+  usage.reserved_bytes =
+      usage.block_num * usage.block_size + usage.extent_bytes;
+  usage.address_space_used = state_->struct_.extent_end_.load();
+  usage.address_space_size = address_space_size_;
+  if (usage.reserved_bytes > 0) {
+    usage.fragmentation =
+        1.0 - static_cast<double>(std::min(usage.used_bytes,
+                                           usage.reserved_bytes)) /
+                  static_cast<double>(usage.reserved_bytes);
+  }
+  return usage;
+}
+
 ProtobufArenaManager::ProtobufArenaManager() {
   address_allocator_ = std::make_shared<ArenaAddressAllocator>();
 }
@@ -345,68 +729,90 @@ std::shared_ptr<ArenaSegment> ProtobufArenaManager::GetSegment(
   return segments_[channel_id];
 }
 
+void* ProtobufArenaManager::CopyMessage(
+    const std::shared_ptr<ArenaSegment>& segment,
+    message::ArenaMessageWrapper* wrapper,
+    const google::protobuf::Message* input_msg) {
+  auto arena_conf = cyber::common::GlobalData::Instance()->GetChannelArenaConf(
+      segment->channel_id_);
+  google::protobuf::ArenaOptions options;
+  options.start_block_size = arena_conf.max_msg_size();
+  options.max_block_size = arena_conf.max_msg_size();
+
+  // the wire size is the first guess, an arena outgrowing its block has
+  // spilled to the heap where readers can not see it, so the copy is done
+  // again in a block large enough for the space it took
+  uint64_t size = input_msg->ByteSizeLong();
+  for (int i = 0; i < 3; ++i) {
+    ArenaSegmentBlockInfo wb;
+    if (!segment->AcquireBlockToWrite(size, &wb)) {
+      return nullptr;
+    }
+    options.initial_block = reinterpret_cast<char*>(wb.block_buffer_address_);
+    options.initial_block_size = wb.block_buffer_size_;
+    if (segment->arenas_[wb.block_index_] != nullptr) {
+      segment->arenas_[wb.block_index_] = nullptr;
+    }
+    auto arena = std::make_shared<google::protobuf::Arena>(options);
+    auto msg = input_msg->New(arena.get());
+    msg->CopyFrom(*input_msg);
+    uint64_t space = arena->SpaceAllocated();
+    if (space > wb.block_buffer_size_) {
+      ADEBUG << "message of " << space << " bytes spilled out of arena block "
+             << wb.block_index_ << " of " << wb.block_buffer_size_ << " bytes";
+      arena = nullptr;
+      segment->ReleaseWrittenBlock(wb);
+      size = std::max(space, wb.block_buffer_size_ * 2);
+      continue;
+    }
+    segment->arenas_[wb.block_index_] = arena;
+    segment->SetBlockUsedSize(wb.block_index_, arena->SpaceUsed());
+    ResetMessageRelatedBlocks(wrapper);
+    this->AddMessageRelatedBlock(wrapper, wb.block_index_);
+    SetMessageAddressOffset(
+        wrapper, reinterpret_cast<uint64_t>(msg) -
+                     reinterpret_cast<uint64_t>(segment->GetShmAddress()));
+    segment->ReleaseWrittenBlock(wb);
+    return reinterpret_cast<void*>(msg);
+  }
+  AERROR << "message of " << input_msg->ByteSizeLong()
+         << " bytes does not fit the arena of channel " << segment->channel_id_;
+  return nullptr;
+}
+
 void* ProtobufArenaManager::SetMessage(message::ArenaMessageWrapper* wrapper,
                                        const void* message) {
   auto input_msg = reinterpret_cast<const google::protobuf::Message*>(message);
   auto channel_id = GetMessageChannelId(wrapper);
   auto segment = GetSegment(channel_id);
   auto arena_ptr = input_msg->GetArena();
-  google::protobuf::ArenaOptions options;
 
   if (!segment) {
     return nullptr;
   }
 
-  void* msg_output = nullptr;
   if (arena_ptr == nullptr) {
-    auto arena_conf =
-        cyber::common::GlobalData::Instance()->GetChannelArenaConf(channel_id);
-    google::protobuf::ArenaOptions options;
-    options.start_block_size = arena_conf.max_msg_size();
-    options.max_block_size = arena_conf.max_msg_size();
-
-    if (!segment) {
-      return nullptr;
-    }
-
-    ResetMessageRelatedBlocks(wrapper);
+    return CopyMessage(segment, wrapper, input_msg);
+  }
 
-    ArenaSegmentBlockInfo wb;
-    // TODO(all): AcquireBlockToWrite for dynamic adjust block
-    // auto size = input_msg->ByteSizeLong();
-    uint64_t size = 0;
-    if (!segment->AcquireBlockToWrite(size, &wb)) {
-      return nullptr;
-    }
-    this->AddMessageRelatedBlock(wrapper, wb.block_index_);
-    options.initial_block =
-        reinterpret_cast<char*>(segment->arena_block_address_[wb.block_index_]);
-    options.initial_block_size = segment->message_capacity_;
-    if (segment->arenas_[wb.block_index_] != nullptr) {
-      segment->arenas_[wb.block_index_] = nullptr;
+  ArenaSegmentBlockInfo wb;
+  int block_index = -1;
+  for (size_t i = 0; i < segment->arenas_.size(); i++) {
+    if (segment->arenas_[i].get() == arena_ptr) {
+      block_index = i;
+      break;
     }
-    segment->arenas_[wb.block_index_] =
-        std::make_shared<google::protobuf::Arena>(options);
-    auto msg = input_msg->New(segment->arenas_[wb.block_index_].get());
-    msg->CopyFrom(*input_msg);
-    SetMessageAddressOffset(
-        wrapper, reinterpret_cast<uint64_t>(msg) -
-                     reinterpret_cast<uint64_t>(segment->GetShmAddress()));
-    msg_output = reinterpret_cast<void*>(msg);
-    segment->ReleaseWrittenBlock(wb);
+  }
+  if (block_index == -1) {
+    return nullptr;
+  }
+  wb.block_index_ = block_index;
+  void* msg_output = nullptr;
+  if (arena_ptr->SpaceAllocated() > segment->GetBlockBufferSize(block_index)) {
+    // built in place but outgrew the block
+    msg_output = CopyMessage(segment, wrapper, input_msg);
   } else {
-    ArenaSegmentBlockInfo wb;
-    int block_index = -1;
-    for (size_t i = 0; i < segment->message_capacity_; i++) {
-      if (segment->arenas_[i].get() == arena_ptr) {
-        block_index = i;
-        break;
-      }
-    }
-    if (block_index == -1) {
-      return nullptr;
-    }
-    wb.block_index_ = block_index;
+    segment->SetBlockUsedSize(block_index, arena_ptr->SpaceUsed());
     ResetMessageRelatedBlocks(wrapper);
     this->AddMessageRelatedBlock(wrapper, block_index);
     SetMessageAddressOffset(
@@ -414,8 +820,8 @@ void* ProtobufArenaManager::SetMessage(message::ArenaMessageWrapper* wrapper,
                      reinterpret_cast<uint64_t>(segment->GetShmAddress()));
     msg_output = reinterpret_cast<void*>(
         const_cast<google::protobuf::Message*>(input_msg));
-    segment->ReleaseWrittenBlock(wb);
   }
+  segment->ReleaseWrittenBlock(wb);
 
   return msg_output;
 }
@@ -426,6 +832,8 @@ void* ProtobufArenaManager::GetMessage(message::ArenaMessageWrapper* wrapper) {
     return nullptr;
   }
 
+  // the message may live in an extent mapped by the writer since
+  segment->SyncExtents();
   auto address = reinterpret_cast<uint64_t>(segment->GetShmAddress()) +
                  GetMessageAddressOffset(wrapper);
 
@@ -474,7 +882,8 @@ bool ProtobufArenaManager::EnableSegment(uint64_t channel_id) {
   auto segment_shm_address = address_allocator_->Allocate(channel_id);
   auto segment = std::make_shared<ArenaSegment>(
       channel_id, arena_conf.max_msg_size(), arena_conf.max_pool_size(),
-      reinterpret_cast<void*>(segment_shm_address));
+      reinterpret_cast<void*>(segment_shm_address),
+      address_allocator_->AddressSegmentSize());
   segments_[channel_id] = segment;
   if (arena_buffer_callbacks_.find(channel_id) !=
       arena_buffer_callbacks_.end()) {
@@ -500,6 +909,38 @@ bool ProtobufArenaManager::Destroy() {
   return true;
 }
 
+std::vector<ArenaSegmentUsage> ProtobufArenaManager::GetUsage() {
+  std::vector<std::shared_ptr<ArenaSegment>> segments;
+  {
+    std::lock_guard<std::mutex> lock(segments_mutex_);
+    for (auto& segment : segments_) {
+      segments.emplace_back(segment.second);
+    }
+  }
+  std::vector<ArenaSegmentUsage> usages;
+  for (auto& segment : segments) {
+    usages.emplace_back(segment->GetUsage());
+  }
+  return usages;
+}
+
+std::string ProtobufArenaManager::GetUsageReport() {
+  std::ostringstream report;
+  for (auto& usage : GetUsage()) {
+    report << common::GlobalData::GetChannelById(usage.channel_id)
+           << ": blocks " << usage.locked_block_num << "/" << usage.block_num
+           << " locked of " << usage.block_size << " bytes, extents "
+           << usage.bound_extent_num << " bound " << usage.idle_extent_num
+           << " idle " << usage.reclaimed_extent_num << " reclaimed of "
+           << usage.extent_bytes << " bytes, used " << usage.used_bytes
+           << " of " << usage.reserved_bytes << " bytes, fragmentation "
+           << usage.fragmentation << ", address space "
+           << usage.address_space_used << "/" << usage.address_space_size
+           << "\n";
+  }
+  return report.str();
+}
+
 void ProtobufArenaManager::SetMessageChannelId(
     message::ArenaMessageWrapper* wrapper, uint64_t channel_id) {
   wrapper->GetExtended<ExtendedStruct>()->meta_.channel_id_ = channel_id;
@@ -16,12 +16,15 @@
 #ifndef CYBER_TRANSPORT_SHM_PROTOBUF_ARENA_MANAGER_H_
 #define CYBER_TRANSPORT_SHM_PROTOBUF_ARENA_MANAGER_H_
 
+#include <atomic>
 #include <functional>
 #include <memory>
+#include <string>
 #include <unordered_map>
 #include <vector>
 
 #include <google/protobuf/arena.h>
+#include <google/protobuf/message.h>
 
 #include "cyber/base/arena_queue.h"
 #include "cyber/base/pthread_rw_lock.h"
@@ -44,6 +47,10 @@ union ArenaSegmentState {
     std::atomic<uint64_t> block_num_;
     std::atomic<uint64_t> message_seq_;
     std::mutex mutex_;
+    // offset of the first address not yet used by an extent
+    std::atomic<uint64_t> extent_end_;
+    // bumped whenever an extent is mapped or removed
+    std::atomic<uint64_t> extent_generation_;
   } struct_;
   uint8_t bytes_[128];
 };
@@ -67,12 +74,58 @@ struct ArenaSegmentBlock {
   static const int32_t kWriteExclusive;
   static const int32_t kMaxTryLockTimes;
   std::atomic<int32_t> lock_num_ = {0};
+  // extent holding the message of this block instead of its own buffer
+  std::atomic<int32_t> extent_index_ = {-1};
+  // arena space taken by the last message written
+  std::atomic<uint64_t> used_size_ = {0};
+};
+
+// Shared memory mapped on demand right behind the segment, at the same
+// address in every process, for a message larger than the block size. An
+// extent is bound to the block whose message it holds, so the block locks
+// cover it as well, and becomes idle once the block is written again.
+struct ArenaSegmentExtent {
+  static const uint32_t kFree;
+  static const uint32_t kCreating;
+  static const uint32_t kBound;
+  static const uint32_t kIdle;
+  static const uint32_t kReclaiming;
+  // removed, the address range is kept for a later extent
+  static const uint32_t kReclaimed;
+  std::atomic<uint32_t> state_ = {0};
+  std::atomic<uint64_t> generation_ = {0};
+  std::atomic<uint64_t> idle_since_ns_ = {0};
+  // from the segment address
+  uint64_t offset_;
+  uint64_t size_;
 };
 
 struct ArenaSegmentBlockInfo {
   uint64_t block_index_;
   ArenaSegmentBlock* block_;
   void* block_buffer_address_;
+  uint64_t block_buffer_size_ = 0;
+};
+
+struct ArenaSegmentUsage {
+  uint64_t channel_id = 0;
+  uint64_t block_num = 0;
+  uint64_t block_size = 0;
+  // blocks being written or read
+  uint64_t locked_block_num = 0;
+  uint64_t bound_extent_num = 0;
+  uint64_t idle_extent_num = 0;
+  // holes left by removed extents in the address range
+  uint64_t reclaimed_extent_num = 0;
+  uint64_t extent_bytes = 0;
+  // block buffers plus mapped extents
+  uint64_t reserved_bytes = 0;
+  // arena space taken by the last message of every block
+  uint64_t used_bytes = 0;
+  uint64_t address_space_used = 0;
+  uint64_t address_space_size = 0;
+  // share of the reserved bytes not holding message data
+  double fragmentation = 0.0;
 };
 
 class ArenaSegment {
@@ -80,10 +133,14 @@ class ArenaSegment {
   ArenaSegment();
   explicit ArenaSegment(uint64_t channel_id);
   ArenaSegment(uint64_t channel_id, void* base_address);
+  // extents are only mapped when `address_space_size`, the size of the
+  // address range reserved from `base_address`, leaves room behind the segment
   ArenaSegment(uint64_t channel_id, uint64_t message_size, uint64_t block_num,
-               void* base_address);
+               void* base_address, uint64_t address_space_size = 0);
   ~ArenaSegment();
 
+  static const uint32_t kMaxExtentNum;
+
   bool Init(uint64_t message_size, uint64_t block_num);
   // bool Create(uint64_t message_size, uint64_t block_num);
   bool Open(uint64_t message_size, uint64_t block_num);
@@ -103,21 +160,57 @@ class ArenaSegment {
   bool AcquireBlockToRead(ArenaSegmentBlockInfo* block_info);
   void ReleaseReadBlock(const ArenaSegmentBlockInfo& block_info);
 
+  void* GetBlockBufferAddress(uint64_t block_index);
+  uint64_t GetBlockBufferSize(uint64_t block_index);
+  void SetBlockUsedSize(uint64_t block_index, uint64_t size);
+
+  // map the extents created by other processes and drop the removed ones,
+  // needed before reading a message which may live in an extent
+  void SyncExtents();
+  // remove the extents idle for longer than extent_idle_timeout_ms, or all
+  // the idle ones if `force`, returns the number of extents removed
+  uint64_t ReclaimIdleExtents(bool force = false);
+
+  ArenaSegmentUsage GetUsage();
+
   // uint64_t GetCapicity();
 
+ private:
+  void InitLayout(uint64_t message_size, uint64_t block_num,
+                  uint64_t shared_buffer_size);
+  bool BindExtent(uint64_t block_index, uint64_t size);
+  void UnbindExtent(uint64_t block_index);
+  bool CreateExtent(uint32_t extent_index);
+  bool AttachExtent(uint32_t extent_index);
+  void DetachExtent(uint32_t extent_index);
+  uint64_t ExtentKey(uint32_t extent_index) const;
+
  public:
-  ArenaSegmentState* state_;
-  ArenaSegmentBlock* blocks_;
+  ArenaSegmentState* state_ = nullptr;
+  ArenaSegmentExtent* extents_ = nullptr;
+  ArenaSegmentBlock* blocks_ = nullptr;
   std::vector<std::shared_ptr<google::protobuf::Arena>> arenas_;
   std::vector<uint64_t> arena_block_address_;
   uint64_t channel_id_;
   uint64_t key_id_;
   void* base_address_;
-  void* shm_address_;
+  void* shm_address_ = nullptr;
   std::shared_ptr<google::protobuf::Arena> shared_buffer_arena_;
   void* arena_buffer_address_ = nullptr;
 
   uint64_t message_capacity_;
+
+ private:
+  uint64_t address_space_size_ = 0;
+  uint32_t max_extent_num_ = 0;
+  uint64_t extent_idle_timeout_ns_ = 0;
+  std::atomic<uint64_t> next_reclaim_ns_ = {0};
+
+  // mappings of the extents in this process
+  std::mutex extent_mutex_;
+  std::vector<void*> extent_addresses_;
+  std::vector<uint64_t> extent_generations_;
+  uint64_t synced_extent_generation_ = 0;
 };
 
 union ExtendedStruct {
@@ -174,6 +267,10 @@ class ProtobufArenaManager : public message::ArenaManagerBase {
 
   std::shared_ptr<ArenaSegment> GetSegment(uint64_t channel_id);
 
+  std::vector<ArenaSegmentUsage> GetUsage();
+  // one line per enabled channel with its block and extent usage
+  std::string GetUsageReport();
+
   void* SetMessage(message::ArenaMessageWrapper* wrapper,
                    const void* message) override;
   void* GetMessage(message::ArenaMessageWrapper* wrapper) override;
@@ -233,7 +330,8 @@ class ProtobufArenaManager : public message::ArenaManagerBase {
             typename std::enable_if<
                 google::protobuf::Arena::is_arena_constructable<M>::value,
                 M>::type* = nullptr>
-  void AcquireArenaMessage(uint64_t channel_id, std::shared_ptr<M>& ret_msg) {
+  void AcquireArenaMessage(uint64_t channel_id, std::shared_ptr<M>& ret_msg,
+                           uint64_t size_hint = 0) {
     auto arena_conf =
         cyber::common::GlobalData::Instance()->GetChannelArenaConf(channel_id);
     google::protobuf::ArenaOptions options;
@@ -245,17 +343,14 @@ class ProtobufArenaManager : public message::ArenaManagerBase {
       return;
     }
 
+    // a message outgrowing its block is copied to a larger one when sent,
+    // `size_hint` reserves an extent large enough upfront
     ArenaSegmentBlockInfo wb;
-    // TODO(All): size should be send to
-    // AcquireBlockToWrite for dynamic adjust block size
-    // auto size = input_msg->ByteSizeLong();
-    uint64_t size = 0;
-    if (!segment->AcquireBlockToWrite(size, &wb)) {
+    if (!segment->AcquireBlockToWrite(size_hint, &wb)) {
       return;
     }
-    options.initial_block =
-        reinterpret_cast<char*>(segment->arena_block_address_[wb.block_index_]);
-    options.initial_block_size = segment->message_capacity_;
+    options.initial_block = reinterpret_cast<char*>(wb.block_buffer_address_);
+    options.initial_block_size = wb.block_buffer_size_;
     if (segment->arenas_[wb.block_index_] != nullptr) {
       segment->arenas_[wb.block_index_] = nullptr;
     }
@@ -280,7 +375,8 @@ class ProtobufArenaManager : public message::ArenaManagerBase {
             typename std::enable_if<
                 !google::protobuf::Arena::is_arena_constructable<M>::value,
                 M>::type* = nullptr>
-  void AcquireArenaMessage(uint64_t channel_id, std::shared_ptr<M>& ret_msg) {
+  void AcquireArenaMessage(uint64_t channel_id, std::shared_ptr<M>& ret_msg,
+                           uint64_t size_hint = 0) {
     return;
   }
 
@@ -291,6 +387,10 @@ class ProtobufArenaManager : public message::ArenaManagerBase {
   std::unordered_map<uint64_t, std::function<void()>> arena_buffer_callbacks_;
   std::mutex segments_mutex_;
 
+  void* CopyMessage(const std::shared_ptr<ArenaSegment>& segment,
+                    message::ArenaMessageWrapper* wrapper,
+                    const google::protobuf::Message* input_msg);
+
   std::shared_ptr<ArenaAddressAllocator> address_allocator_;
 
   static ArenaAllocCallback arena_alloc_cb_;
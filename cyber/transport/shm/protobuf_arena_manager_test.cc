@@ -0,0 +1,164 @@
+/******************************************************************************
+ * Copyright 2024 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/transport/shm/protobuf_arena_manager.h"
+
+#include <sys/ipc.h>
+#include <sys/shm.h>
+
+#include <cstring>
+#include <memory>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace cyber {
+namespace transport {
+
+class ArenaSegmentTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    address_ = allocator_.Allocate(kChannelId);
+    ASSERT_NE(address_, nullptr);
+    segment_ = std::make_shared<ArenaSegment>(
+        kChannelId, kMessageSize, kBlockNum, address_,
+        allocator_.AddressSegmentSize());
+    ASSERT_NE(segment_->state_, nullptr);
+  }
+
+  void TearDown() override {
+    // unbind every block so that all the extents can be removed
+    for (uint64_t i = 0; i < kBlockNum; ++i) {
+      ArenaSegmentBlockInfo wb;
+      ASSERT_TRUE(segment_->AcquireBlockToWrite(0, &wb));
+      segment_->ReleaseWrittenBlock(wb);
+    }
+    segment_->ReclaimIdleExtents(true);
+    auto key_id = segment_->key_id_;
+    segment_ = nullptr;
+    shmctl(shmget(static_cast<key_t>(key_id), 0, 0644), IPC_RMID, nullptr);
+    allocator_.Deallocate(kChannelId);
+  }
+
+  static const uint64_t kChannelId;
+  static const uint64_t kMessageSize;
+  static const uint64_t kBlockNum;
+
+  ArenaAddressAllocator allocator_;
+  void* address_ = nullptr;
+  std::shared_ptr<ArenaSegment> segment_;
+};
+
+const uint64_t ArenaSegmentTest::kChannelId = 0x5a5a5a5a;
+const uint64_t ArenaSegmentTest::kMessageSize = 4096;
+const uint64_t ArenaSegmentTest::kBlockNum = 2;
+
+TEST_F(ArenaSegmentTest, small_message_uses_block) {
+  ArenaSegmentBlockInfo wb;
+  EXPECT_TRUE(segment_->AcquireBlockToWrite(100, &wb));
+  EXPECT_EQ(wb.block_buffer_size_, kMessageSize);
+  EXPECT_EQ(reinterpret_cast<uint64_t>(wb.block_buffer_address_),
+            segment_->arena_block_address_[wb.block_index_]);
+  segment_->SetBlockUsedSize(wb.block_index_, 100);
+  segment_->ReleaseWrittenBlock(wb);
+
+  auto usage = segment_->GetUsage();
+  EXPECT_EQ(usage.block_num, kBlockNum);
+  EXPECT_EQ(usage.bound_extent_num, 0);
+  EXPECT_EQ(usage.reserved_bytes, kBlockNum * kMessageSize);
+  EXPECT_EQ(usage.used_bytes, 100);
+  EXPECT_GT(usage.fragmentation, 0.9);
+}
+
+TEST_F(ArenaSegmentTest, grow_and_reuse_extent) {
+  const uint64_t size = 100 * 1024;
+  ArenaSegmentBlockInfo wb;
+  ASSERT_TRUE(segment_->AcquireBlockToWrite(size, &wb));
+  EXPECT_GE(wb.block_buffer_size_, size);
+  auto extent_address = wb.block_buffer_address_;
+  // the extent is mapped right behind the segment
+  EXPECT_GT(reinterpret_cast<uint64_t>(extent_address),
+            segment_->arena_block_address_[kBlockNum - 1]);
+  std::memset(wb.block_buffer_address_, 0x5a, size);
+  EXPECT_EQ(segment_->GetBlockBufferAddress(wb.block_index_), extent_address);
+  segment_->ReleaseWrittenBlock(wb);
+
+  auto usage = segment_->GetUsage();
+  EXPECT_EQ(usage.bound_extent_num, 1);
+  EXPECT_EQ(usage.idle_extent_num, 0);
+  EXPECT_GE(usage.extent_bytes, size);
+
+  // writing small messages to every block leaves the extent idle
+  for (uint64_t i = 0; i < kBlockNum; ++i) {
+    ASSERT_TRUE(segment_->AcquireBlockToWrite(0, &wb));
+    segment_->ReleaseWrittenBlock(wb);
+  }
+  usage = segment_->GetUsage();
+  EXPECT_EQ(usage.bound_extent_num, 0);
+  EXPECT_EQ(usage.idle_extent_num, 1);
+
+  // and the idle extent is taken by the next large message
+  ASSERT_TRUE(segment_->AcquireBlockToWrite(size / 2, &wb));
+  EXPECT_EQ(wb.block_buffer_address_, extent_address);
+  segment_->ReleaseWrittenBlock(wb);
+  usage = segment_->GetUsage();
+  EXPECT_EQ(usage.bound_extent_num, 1);
+  EXPECT_EQ(usage.idle_extent_num, 0);
+}
+
+TEST_F(ArenaSegmentTest, reclaim_idle_extent) {
+  const uint64_t size = 64 * 1024;
+  ArenaSegmentBlockInfo wb;
+  ASSERT_TRUE(segment_->AcquireBlockToWrite(size, &wb));
+  auto extent_address = wb.block_buffer_address_;
+  segment_->ReleaseWrittenBlock(wb);
+  auto address_space_used = segment_->GetUsage().address_space_used;
+
+  // bound extents are never removed
+  EXPECT_EQ(segment_->ReclaimIdleExtents(true), 0);
+  for (uint64_t i = 0; i < kBlockNum; ++i) {
+    ASSERT_TRUE(segment_->AcquireBlockToWrite(0, &wb));
+    segment_->ReleaseWrittenBlock(wb);
+  }
+  // not idle for long enough yet
+  EXPECT_EQ(segment_->ReclaimIdleExtents(), 0);
+  EXPECT_EQ(segment_->ReclaimIdleExtents(true), 1);
+  auto usage = segment_->GetUsage();
+  EXPECT_EQ(usage.idle_extent_num, 0);
+  EXPECT_EQ(usage.reclaimed_extent_num, 1);
+  EXPECT_EQ(usage.extent_bytes, 0);
+
+  // a new extent reuses the address range of the removed one
+  ASSERT_TRUE(segment_->AcquireBlockToWrite(size, &wb));
+  EXPECT_EQ(wb.block_buffer_address_, extent_address);
+  std::memset(wb.block_buffer_address_, 0x5a, size);
+  segment_->ReleaseWrittenBlock(wb);
+  usage = segment_->GetUsage();
+  EXPECT_EQ(usage.bound_extent_num, 1);
+  EXPECT_EQ(usage.reclaimed_extent_num, 0);
+  EXPECT_EQ(usage.address_space_used, address_space_used);
+}
+
+TEST_F(ArenaSegmentTest, address_space_limit) {
+  ArenaSegmentBlockInfo wb;
+  EXPECT_FALSE(
+      segment_->AcquireBlockToWrite(allocator_.AddressSegmentSize(), &wb));
+  EXPECT_EQ(segment_->GetUsage().locked_block_num, 0);
+}
+
+}  // namespace transport
+}  // namespace cyber
+}  // namespace apollo
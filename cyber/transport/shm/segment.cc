@@ -16,6 +16,7 @@
 
 #include "cyber/transport/shm/segment.h"
 
+#include "cyber/common/global_data.h"
 #include "cyber/common/log.h"
 #include "cyber/common/util.h"
 #include "cyber/transport/shm/shm_conf.h"
@@ -35,7 +36,13 @@ Segment::Segment(uint64_t channel_id)
       block_buf_lock_(),
       arena_block_buf_lock_(),
       block_buf_addrs_(),
-      arena_block_buf_addrs_() {}
+      arena_block_buf_addrs_() {
+  auto& g_conf = common::GlobalData::Instance()->Config();
+  if (g_conf.has_transport_conf() && g_conf.transport_conf().has_shm_conf() &&
+      g_conf.transport_conf().shm_conf().block_layout() == "ring") {
+    conf_.set_ring_layout(true);
+  }
+}
 
 bool Segment::AcquireBlockToWrite(std::size_t msg_size,
                                   WritableBlock* writable_block) {
@@ -50,6 +57,10 @@ bool Segment::AcquireBlockToWrite(std::size_t msg_size,
     result = Remap();
   }
 
+  if (result && conf_.ring_layout()) {
+    return AcquireRingBlockToWrite(msg_size, writable_block);
+  }
+
   if (msg_size > conf_.ceiling_msg_size()) {
     AINFO << "msg_size: " << msg_size
           << " larger than current shm_buffer_size: "
@@ -127,6 +138,10 @@ bool Segment::AcquireBlockToRead(ReadableBlock* readable_block) {
     return false;
   }
 
+  if (conf_.ring_layout()) {
+    return AcquireRingBlockToRead(readable_block);
+  }
+
   if (!blocks_[index].TryLockForRead()) {
     return false;
   }
@@ -303,6 +318,86 @@ uint32_t Segment::GetNextWritableBlockIndex() {
   return 0;
 }
 
+bool Segment::AcquireRingBlockToWrite(std::size_t msg_size,
+                                      WritableBlock* writable_block) {
+  if (msg_size > conf_.ceiling_msg_size()) {
+    AERROR << "msg_size: " << msg_size << " larger than ring reserve size: "
+           << ShmConf::RING_RESERVE_SIZE;
+    return false;
+  }
+
+  uint64_t buf_size = conf_.GetRingBufSize(msg_size);
+  state_->GrowRing(conf_.GetRingCapacity(buf_size));
+
+  uint32_t index = GetNextWritableBlockIndex();
+  Block& block = blocks_[index];
+  block.buf_size_.store(0);
+  // every try moves the ring head forward, so within block_num tries we get
+  // a range that no reader is holding
+  for (uint32_t i = 0; i <= conf_.block_num(); ++i) {
+    uint64_t offset = state_->ReserveRing(buf_size);
+    if (!ReclaimRingRange(index, offset, buf_size)) {
+      continue;
+    }
+    block.buf_offset_.store(offset);
+    block.buf_size_.store(buf_size);
+    writable_block->index = index;
+    writable_block->block = &block;
+    writable_block->buf = GetRingBuf() + offset;
+    return true;
+  }
+
+  AWARN << "no free ring range for msg_size: " << msg_size;
+  block.ReleaseWriteLock();
+  return false;
+}
+
+bool Segment::AcquireRingBlockToRead(ReadableBlock* readable_block) {
+  auto index = readable_block->index;
+  Block& block = blocks_[index];
+  if (!block.TryLockForRead()) {
+    return false;
+  }
+
+  uint64_t buf_size = block.buf_size();
+  if (buf_size == 0 ||
+      block.buf_offset() + buf_size > ShmConf::RING_RESERVE_SIZE) {
+    ADEBUG << "block " << index << " has been reclaimed.";
+    block.ReleaseReadLock();
+    return false;
+  }
+  readable_block->block = &block;
+  readable_block->buf = GetRingBuf() + block.buf_offset();
+  return true;
+}
+
+bool Segment::ReclaimRingRange(uint32_t index, uint64_t offset,
+                               uint64_t size) {
+  for (uint32_t i = 0; i < conf_.block_num(); ++i) {
+    if (i == index) {
+      continue;
+    }
+    Block& block = blocks_[i];
+    uint64_t block_size = block.buf_size();
+    uint64_t block_offset = block.buf_offset();
+    if (block_size == 0 || block_offset >= offset + size ||
+        offset >= block_offset + block_size) {
+      continue;
+    }
+    // the overlapped block is being read or written, skip this range
+    if (!block.TryLockForWrite()) {
+      return false;
+    }
+    block.buf_size_.store(0);
+    block.ReleaseWriteLock();
+  }
+  return true;
+}
+
+uint8_t* Segment::GetRingBuf() {
+  return static_cast<uint8_t*>(managed_shm_) + conf_.ring_offset();
+}
+
 uint32_t Segment::GetNextArenaWritableBlockIndex() {
   const auto block_num = ShmConf::ARENA_BLOCK_NUM;
   while (1) {
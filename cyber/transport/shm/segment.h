@@ -94,6 +94,11 @@ class Segment {
   bool Remap();
   bool Recreate(const uint64_t& msg_size);
   uint32_t GetNextWritableBlockIndex();
+  bool AcquireRingBlockToWrite(std::size_t msg_size,
+                               WritableBlock* writable_block);
+  bool AcquireRingBlockToRead(ReadableBlock* readable_block);
+  bool ReclaimRingRange(uint32_t index, uint64_t offset, uint64_t size);
+  uint8_t* GetRingBuf();
   uint32_t GetNextArenaWritableBlockIndex();
 };
 
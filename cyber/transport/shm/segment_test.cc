@@ -0,0 +1,133 @@
+/******************************************************************************
+ * Copyright 2024 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/transport/shm/segment.h"
+
+#include <cstring>
+
+#include "gtest/gtest.h"
+
+#include "cyber/common/util.h"
+#include "cyber/transport/shm/posix_segment.h"
+#include "cyber/transport/shm/state.h"
+
+namespace apollo {
+namespace cyber {
+namespace transport {
+
+namespace {
+
+// the ring layout regardless of the block_layout of cyber.pb.conf
+class RingSegment : public PosixSegment {
+ public:
+  explicit RingSegment(uint64_t channel_id) : PosixSegment(channel_id) {
+    conf_.set_ring_layout(true);
+  }
+};
+
+// fills the message of a block with its mark
+bool Write(Segment* segment, std::size_t msg_size, uint8_t mark,
+           WritableBlock* wb) {
+  if (!segment->AcquireBlockToWrite(msg_size, wb)) {
+    return false;
+  }
+  std::memset(wb->buf, mark, msg_size);
+  wb->block->set_msg_size(msg_size);
+  segment->ReleaseWrittenBlock(*wb);
+  return true;
+}
+
+// whether the block can still be read and holds its mark
+bool ReadMark(Segment* segment, uint32_t index, uint8_t mark) {
+  ReadableBlock rb;
+  rb.index = index;
+  if (!segment->AcquireBlockToRead(&rb)) {
+    return false;
+  }
+  bool intact = true;
+  for (uint64_t i = 0; i < rb.block->msg_size(); ++i) {
+    intact = intact && rb.buf[i] == mark;
+  }
+  segment->ReleaseReadBlock(rb);
+  return intact;
+}
+
+}  // namespace
+
+TEST(SegmentTest, ring_reserve) {
+  State state(0);
+  state.GrowRing(1024);
+
+  // an empty ring takes a buffer of its whole capacity
+  EXPECT_EQ(state.ReserveRing(1024), 0);
+  // a full one wraps to the beginning
+  EXPECT_EQ(state.ReserveRing(512), 0);
+  // a buffer that exactly fits the tail does not wrap
+  EXPECT_EQ(state.ReserveRing(512), 512);
+  EXPECT_EQ(state.ReserveRing(1), 0);
+
+  // the ring grows in place and never shrinks
+  state.GrowRing(2048);
+  state.GrowRing(512);
+  EXPECT_EQ(state.ring_capacity(), 2048);
+  EXPECT_EQ(state.ReserveRing(1024), 1);
+  EXPECT_EQ(state.ReserveRing(1024), 0);
+}
+
+TEST(SegmentTest, ring_wraparound) {
+  RingSegment segment(common::Hash("segment_test_ring_wraparound"));
+
+  // with the 1K message info, 128 buffers of 32K fill the 4M ring of the
+  // class exactly
+  const std::size_t msg_size = 31 * 1024;
+  const uint64_t buf_size = 32 * 1024;
+  const uint32_t buf_num = 128;
+  WritableBlock wb;
+  for (uint32_t i = 0; i < buf_num; ++i) {
+    ASSERT_TRUE(Write(&segment, msg_size, static_cast<uint8_t>(i), &wb));
+    EXPECT_EQ(wb.index, i);
+    EXPECT_EQ(wb.block->buf_offset(), i * buf_size);
+    EXPECT_EQ(wb.block->buf_size(), buf_size);
+  }
+  for (uint32_t i = 0; i < buf_num; ++i) {
+    EXPECT_TRUE(ReadMark(&segment, i, static_cast<uint8_t>(i)));
+  }
+
+  // the ring is full, the next buffer wraps and the block whose range it
+  // overwrites can no longer be read
+  ASSERT_TRUE(Write(&segment, msg_size, 0xff, &wb));
+  EXPECT_EQ(wb.index, buf_num);
+  EXPECT_EQ(wb.block->buf_offset(), 0);
+  EXPECT_TRUE(ReadMark(&segment, buf_num, 0xff));
+  EXPECT_FALSE(ReadMark(&segment, 0, 0));
+  EXPECT_TRUE(ReadMark(&segment, 1, 1));
+
+  // a range still being read is skipped rather than overwritten
+  ReadableBlock held;
+  held.index = 1;
+  ASSERT_TRUE(segment.AcquireBlockToRead(&held));
+  ASSERT_TRUE(Write(&segment, msg_size, 0xfe, &wb));
+  EXPECT_EQ(wb.index, buf_num + 1);
+  EXPECT_EQ(wb.block->buf_offset(), 2 * buf_size);
+  segment.ReleaseReadBlock(held);
+  EXPECT_TRUE(ReadMark(&segment, 1, 1));
+  EXPECT_FALSE(ReadMark(&segment, 2, 2));
+  EXPECT_TRUE(ReadMark(&segment, buf_num + 1, 0xfe));
+}
+
+}  // namespace transport
+}  // namespace cyber
+}  // namespace apollo
@@ -28,6 +28,16 @@ ShmConf::ShmConf(const uint64_t& real_msg_size) { Update(real_msg_size); }
 ShmConf::~ShmConf() {}
 
 void ShmConf::Update(const uint64_t& real_msg_size) {
+  if (ring_layout_) {
+    // the size of the segment no longer depends on the message size
+    ceiling_msg_size_ = RING_RESERVE_SIZE - MESSAGE_INFO_SIZE;
+    block_buf_size_ = 0;
+    block_num_ = RING_BLOCK_NUM;
+    managed_shm_size_ = EXTRA_SIZE + STATE_SIZE + BLOCK_SIZE * block_num_ + \
+                        (BLOCK_SIZE + ARENA_MESSAGE_SIZE) * ARENA_BLOCK_NUM + \
+                        RING_RESERVE_SIZE;
+    return;
+  }
   ceiling_msg_size_ = GetCeilingMessageSize(real_msg_size);
   block_buf_size_ = GetBlockBufSize(ceiling_msg_size_);
   block_num_ = GetBlockNum(ceiling_msg_size_);
@@ -62,6 +72,38 @@ const uint64_t ShmConf::MESSAGE_SIZE_16M = 1024 * 1024 * 16;
 const uint32_t ShmConf::BLOCK_NUM_MORE = 8;
 const uint64_t ShmConf::MESSAGE_SIZE_MORE = 1024 * 1024 * 32;
 
+const uint32_t ShmConf::RING_BLOCK_NUM = 512;
+const uint64_t ShmConf::RING_ALIGN_SIZE = 64;
+const uint64_t ShmConf::RING_GROW_SIZE = 1024 * 1024;
+const uint64_t ShmConf::RING_RESERVE_SIZE = 1024ULL * 1024 * 1024;
+
+void ShmConf::set_ring_layout(bool ring_layout) {
+  ring_layout_ = ring_layout;
+  Update(MESSAGE_SIZE_16K);
+}
+
+uint64_t ShmConf::ring_offset() const {
+  // the ring follows State, blocks, arena blocks and arena block bufs, each
+  // of them counted with its reserved size
+  uint64_t offset = STATE_SIZE + BLOCK_SIZE * block_num_ +
+                    (BLOCK_SIZE + ARENA_MESSAGE_SIZE) * ARENA_BLOCK_NUM;
+  return (offset + RING_ALIGN_SIZE - 1) / RING_ALIGN_SIZE * RING_ALIGN_SIZE;
+}
+
+uint64_t ShmConf::GetRingBufSize(const uint64_t& real_msg_size) {
+  uint64_t size = real_msg_size + MESSAGE_INFO_SIZE;
+  return (size + RING_ALIGN_SIZE - 1) / RING_ALIGN_SIZE * RING_ALIGN_SIZE;
+}
+
+uint64_t ShmConf::GetRingCapacity(const uint64_t& ring_buf_size) {
+  // keep the queue depth of the fixed classes, but sized with the actual
+  // message size instead of the ceiling of its class
+  uint64_t capacity =
+      ring_buf_size * GetBlockNum(GetCeilingMessageSize(ring_buf_size));
+  capacity = (capacity + RING_GROW_SIZE - 1) / RING_GROW_SIZE * RING_GROW_SIZE;
+  return capacity < RING_RESERVE_SIZE ? capacity : RING_RESERVE_SIZE;
+}
+
 uint64_t ShmConf::GetCeilingMessageSize(const uint64_t& real_msg_size) {
   uint64_t ceiling_msg_size = MESSAGE_SIZE_16K;
   if (real_msg_size <= MESSAGE_SIZE_16K) {
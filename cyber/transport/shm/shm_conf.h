@@ -37,6 +37,17 @@ class ShmConf {
   const uint32_t& block_num() { return block_num_; }
   const uint64_t& managed_shm_size() { return managed_shm_size_; }
 
+  // Ring layout: message buffers are carved out of one ring area reserved
+  // at creation, so bigger messages never recreate the segment.
+  bool ring_layout() const { return ring_layout_; }
+  void set_ring_layout(bool ring_layout);
+
+  uint64_t ring_offset() const;
+  uint64_t GetRingBufSize(const uint64_t& real_msg_size);
+  uint64_t GetRingCapacity(const uint64_t& ring_buf_size);
+
+  static const uint64_t RING_RESERVE_SIZE;
+
   // For arena msg
   static const uint32_t ARENA_BLOCK_NUM;
   static const uint64_t ARENA_MESSAGE_SIZE;
@@ -50,6 +61,7 @@ class ShmConf {
   uint64_t block_buf_size_;
   uint32_t block_num_;
   uint64_t managed_shm_size_;
+  bool ring_layout_ = false;
 
   // Extra size, Byte
   static const uint64_t EXTRA_SIZE;
@@ -77,6 +89,10 @@ class ShmConf {
   // For message 10M+
   static const uint32_t BLOCK_NUM_MORE;
   static const uint64_t MESSAGE_SIZE_MORE;
+  // For ring layout
+  static const uint32_t RING_BLOCK_NUM;
+  static const uint64_t RING_ALIGN_SIZE;
+  static const uint64_t RING_GROW_SIZE;
 };
 
 }  // namespace transport
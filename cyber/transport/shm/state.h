@@ -57,12 +57,36 @@ class State {
   uint64_t ceiling_msg_size() { return ceiling_msg_size_.load(); }
   uint32_t reference_counts() { return reference_count_.load(); }
 
+  // For ring layout, reserves size bytes in [0, ring_capacity) and wraps to
+  // the beginning when the tail of the ring is too small.
+  uint64_t ReserveRing(uint64_t size) {
+    uint64_t head = ring_head_.load();
+    uint64_t offset = 0;
+    do {
+      offset = head;
+      if (offset + size > ring_capacity_.load()) {
+        offset = 0;
+      }
+    } while (!ring_head_.compare_exchange_weak(head, offset + size));
+    return offset;
+  }
+
+  void GrowRing(uint64_t capacity) {
+    uint64_t current = ring_capacity_.load();
+    while (current < capacity &&
+           !ring_capacity_.compare_exchange_weak(current, capacity)) {
+    }
+  }
+  uint64_t ring_capacity() { return ring_capacity_.load(); }
+
  private:
   std::atomic<bool> need_remap_ = {false};
   std::atomic<uint32_t> seq_ = {0};
   std::atomic<uint32_t> arena_seq_ = {0};
   std::atomic<uint32_t> reference_count_ = {0};
   std::atomic<uint64_t> ceiling_msg_size_;
+  std::atomic<uint64_t> ring_head_ = {0};
+  std::atomic<uint64_t> ring_capacity_ = {0};
 };
 
 }  // namespace transport
@@ -44,7 +44,12 @@ bool XsiSegment::OpenOrCreate() {
   int retry = 0;
   int shmid = 0;
   while (retry < 2) {
-    shmid = shmget(key_, conf_.managed_shm_size(), 0644 | IPC_CREAT | IPC_EXCL);
+    int shmflg = 0644 | IPC_CREAT | IPC_EXCL;
+    if (conf_.ring_layout()) {
+      // pages of the ring are only committed when they are touched
+      shmflg |= SHM_NORESERVE;
+    }
+    shmid = shmget(key_, conf_.managed_shm_size(), shmflg);
     if (shmid != -1) {
       break;
     }
@@ -72,6 +72,10 @@ class HybridTransmitter : public Transmitter<M> {
 
   bool Transmit(const MessagePtr& msg, const MessageInfo& msg_info) override;
 
+  bool Loan(LoanedMessage<M>* loaned) override;
+  using Transmitter<M>::Publish;
+  bool Publish(LoanedMessage<M>* loaned, const MessageInfo& msg_info) override;
+
   bool AcquireMessage(std::shared_ptr<M>& msg);
 
  private:
@@ -173,6 +177,50 @@ bool HybridTransmitter<M>::Transmit(const MessagePtr& msg,
   return true;
 }
 
+template <typename M>
+bool HybridTransmitter<M>::Loan(LoanedMessage<M>* loaned) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = transmitters_.find(OptionalMode::SHM);
+  // a loan is only worth it when some reader is in another process
+  if (it == transmitters_.end() || receivers_[OptionalMode::SHM].empty()) {
+    return false;
+  }
+  return it->second->Loan(loaned);
+}
+
+template <typename M>
+bool HybridTransmitter<M>::Publish(LoanedMessage<M>* loaned,
+                                   const MessageInfo& msg_info) {
+  if (!loaned->InSharedMemory()) {
+    auto msg = loaned->Share();
+    loaned->Reset();
+    RETURN_VAL_IF_NULL(msg, false);
+    return Transmit(msg, msg_info);
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  // the other transports and the history take a copy, which must be done
+  // before the block is handed over to the readers
+  MessagePtr msg = nullptr;
+  for (auto& item : transmitters_) {
+    if (item.first == OptionalMode::SHM || receivers_[item.first].empty()) {
+      continue;
+    }
+    if (msg == nullptr) {
+      msg = loaned->Share();
+    }
+    item.second->Transmit(msg, msg_info);
+  }
+  if (this->attr_.qos_profile().durability() ==
+      QosDurabilityPolicy::DURABILITY_TRANSIENT_LOCAL) {
+    if (msg == nullptr) {
+      msg = loaned->Share();
+    }
+    history_->Add(msg, msg_info);
+  }
+  return transmitters_[OptionalMode::SHM]->Publish(loaned, msg_info);
+}
+
 template <typename M>
 bool HybridTransmitter<M>::AcquireMessage(std::shared_ptr<M>& msg) {
   bool result = false;
@@ -58,6 +58,10 @@ class ShmTransmitter : public Transmitter<M> {
 
   bool Transmit(const MessagePtr& msg, const MessageInfo& msg_info) override;
 
+  bool Loan(LoanedMessage<M>* loaned) override;
+  using Transmitter<M>::Publish;
+  bool Publish(LoanedMessage<M>* loaned, const MessageInfo& msg_info) override;
+
   bool AcquireMessage(std::shared_ptr<M>& msg);
 
  private:
@@ -104,7 +108,8 @@ ShmTransmitter<M>::ShmTransmitter(const RoleAttributes& attr)
   arena_transmit_ = common::GlobalData::Instance()->IsChannelEnableArenaShm(
                         this->attr_.channel_id()) &&
                     !type_check<M, message::RawMessage>::value &&
-                    !type_check<M, message::PyMessageWrap>::value;
+                    !type_check<M, message::PyMessageWrap>::value &&
+                    !message::IsZeroCopyMessage<M>::value;
 }
 
 template <typename M>
@@ -197,6 +202,66 @@ bool ShmTransmitter<M>::Transmit(const MessagePtr& msg,
   return Transmit(*msg, msg_info);
 }
 
+template <typename M>
+bool ShmTransmitter<M>::Loan(LoanedMessage<M>* loaned) {
+  if (!message::IsZeroCopyMessage<M>::value || !this->enabled_) {
+    return false;
+  }
+
+  WritableBlock wb;
+  if (!segment_->AcquireBlockToWrite(sizeof(M), &wb)) {
+    AERROR << "acquire block failed.";
+    return false;
+  }
+  if (!loaned->Bind(segment_, wb)) {
+    AERROR << "block " << wb.index << " of channel "
+           << this->attr_.channel_name() << " is not aligned to the message.";
+    segment_->ReleaseWrittenBlock(wb);
+    return false;
+  }
+  ADEBUG << "loaned block index: " << wb.index;
+  return true;
+}
+
+template <typename M>
+bool ShmTransmitter<M>::Publish(LoanedMessage<M>* loaned,
+                                const MessageInfo& msg_info) {
+  // the segment is renewed if the transmitter was disabled in between
+  if (!this->enabled_ || !loaned->InSharedMemory() ||
+      loaned->segment() != segment_) {
+    return Transmitter<M>::Publish(loaned, msg_info);
+  }
+
+  MessageInfo block_msg_info(msg_info);
+  if (block_msg_info.traced()) {
+    // the message is already in place, there is nothing to serialize
+    auto now = statistics::LatencyTracer::Now();
+    block_msg_info.set_trace_stamp(TRACE_ACQUIRED, now);
+    block_msg_info.set_trace_stamp(TRACE_SERIALIZED, now);
+  }
+
+  WritableBlock wb = loaned->Detach();
+  wb.block->set_msg_size(sizeof(M));
+  char* msg_info_addr = reinterpret_cast<char*>(wb.buf) + sizeof(M);
+  if (!block_msg_info.SerializeTo(msg_info_addr, block_msg_info.ByteSize())) {
+    AERROR << "serialize message info failed.";
+    segment_->ReleaseWrittenBlock(wb);
+    return false;
+  }
+  wb.block->set_msg_info_size(block_msg_info.ByteSize());
+  segment_->ReleaseWrittenBlock(wb);
+
+  ReadableInfo readable_info;
+  readable_info.set_host_id(host_id_);
+  readable_info.set_channel_id(channel_id_);
+  readable_info.set_arena_block_index(-1);
+  readable_info.set_block_index(wb.index);
+  ADEBUG << "Publishing loaned sharedmem message: "
+         << common::GlobalData::GetChannelById(channel_id_)
+         << " to normal block: " << readable_info.block_index();
+  return notifier_->Notify(readable_info);
+}
+
 template <typename M>
 bool ShmTransmitter<M>::Transmit(const M& msg, const MessageInfo& msg_info) {
   if (!this->enabled_) {
@@ -221,6 +286,12 @@ bool ShmTransmitter<M>::Transmit(const M& msg, const MessageInfo& msg_info) {
       return false;
     }
 
+    MessageInfo block_msg_info(msg_info);
+    if (block_msg_info.traced()) {
+      block_msg_info.set_trace_stamp(TRACE_ACQUIRED,
+                                     statistics::LatencyTracer::Now());
+    }
+
     ADEBUG << "arena block index: " << arena_wb.index;
     auto arena_manager = ProtobufArenaManager::Instance();
     auto msg_wrapper = arena_manager->CreateMessageWrapper();
@@ -250,14 +321,18 @@ bool ShmTransmitter<M>::Transmit(const M& msg, const MessageInfo& msg_info) {
     // }
     memcpy(arena_wb.buf, msg_wrapper->GetData(), msg_size);
     arena_wb.block->set_msg_size(msg_size);
+    if (block_msg_info.traced()) {
+      block_msg_info.set_trace_stamp(TRACE_SERIALIZED,
+                                     statistics::LatencyTracer::Now());
+    }
 
     char* msg_info_addr = reinterpret_cast<char*>(arena_wb.buf) + msg_size;
-    if (!msg_info.SerializeTo(msg_info_addr, MessageInfo::kSize)) {
+    if (!block_msg_info.SerializeTo(msg_info_addr, block_msg_info.ByteSize())) {
       AERROR << "serialize message info failed.";
       segment_->ReleaseArenaWrittenBlock(arena_wb);
       return false;
     }
-    arena_wb.block->set_msg_info_size(MessageInfo::kSize);
+    arena_wb.block->set_msg_info_size(block_msg_info.ByteSize());
     readable_info.set_arena_block_index(arena_wb.index);
     if (serialized_receiver_count_.load() > 0) {
       std::size_t msg_size = message::ByteSize(msg);
@@ -275,12 +350,13 @@ bool ShmTransmitter<M>::Transmit(const M& msg, const MessageInfo& msg_info) {
       wb.block->set_msg_size(msg_size);
 
       char* msg_info_addr = reinterpret_cast<char*>(wb.buf) + msg_size;
-      if (!msg_info.SerializeTo(msg_info_addr, MessageInfo::kSize)) {
+      if (!block_msg_info.SerializeTo(msg_info_addr,
+                                      block_msg_info.ByteSize())) {
         AERROR << "serialize message info failed.";
         segment_->ReleaseWrittenBlock(wb);
         return false;
       }
-      wb.block->set_msg_info_size(MessageInfo::kSize);
+      wb.block->set_msg_info_size(block_msg_info.ByteSize());
       segment_->ReleaseWrittenBlock(wb);
       segment_->ReleaseArenaWrittenBlock(arena_wb);
       readable_info.set_block_index(wb.index);
@@ -293,6 +369,11 @@ bool ShmTransmitter<M>::Transmit(const M& msg, const MessageInfo& msg_info) {
       AERROR << "acquire block failed.";
       return false;
     }
+    MessageInfo block_msg_info(msg_info);
+    if (block_msg_info.traced()) {
+      block_msg_info.set_trace_stamp(TRACE_ACQUIRED,
+                                     statistics::LatencyTracer::Now());
+    }
 
     ADEBUG << "block index: " << wb.index;
     if (!message::SerializeToArray(msg, wb.buf, static_cast<int>(msg_size))) {
@@ -301,14 +382,18 @@ bool ShmTransmitter<M>::Transmit(const M& msg, const MessageInfo& msg_info) {
       return false;
     }
     wb.block->set_msg_size(msg_size);
+    if (block_msg_info.traced()) {
+      block_msg_info.set_trace_stamp(TRACE_SERIALIZED,
+                                     statistics::LatencyTracer::Now());
+    }
 
     char* msg_info_addr = reinterpret_cast<char*>(wb.buf) + msg_size;
-    if (!msg_info.SerializeTo(msg_info_addr, MessageInfo::kSize)) {
+    if (!block_msg_info.SerializeTo(msg_info_addr, block_msg_info.ByteSize())) {
       AERROR << "serialize message info failed.";
       segment_->ReleaseWrittenBlock(wb);
       return false;
     }
-    wb.block->set_msg_info_size(MessageInfo::kSize);
+    wb.block->set_msg_info_size(block_msg_info.ByteSize());
     segment_->ReleaseWrittenBlock(wb);
     readable_info.set_block_index(wb.index);
   }
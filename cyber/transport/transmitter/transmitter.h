@@ -22,9 +22,11 @@
 #include <string>
 
 #include "cyber/event/perf_event_cache.h"
+#include "cyber/statistics/latency_tracer.h"
 #include "cyber/statistics/statistics.h"
 #include "cyber/transport/common/endpoint.h"
 #include "cyber/transport/message/message_info.h"
+#include "cyber/transport/shm/loaned_message.h"
 
 namespace apollo {
 namespace cyber {
@@ -52,6 +54,15 @@ class Transmitter : public Endpoint {
   virtual bool Transmit(const MessagePtr& msg);
   virtual bool Transmit(const MessagePtr& msg, const MessageInfo& msg_info) = 0;
 
+  /**
+   * @brief Lend a zero copy message constructed in place by the transport,
+   * transports that can not lend return false and the caller allocates it.
+   */
+  virtual bool Loan(LoanedMessage<M>* loaned);
+
+  bool Publish(LoanedMessage<M>* loaned);
+  virtual bool Publish(LoanedMessage<M>* loaned, const MessageInfo& msg_info);
+
   uint64_t NextSeqNum() {
     (*seq_num_) << 1;
     return seq_num_->get_value();
@@ -60,6 +71,8 @@ class Transmitter : public Endpoint {
   uint64_t seq_num() const { return seq_num_->get_value(); }
 
  protected:
+  void PrepareMessageInfo();
+
   MessageInfo msg_info_;
   std::shared_ptr<::bvar::Adder<int>> seq_num_;
 };
@@ -77,11 +90,42 @@ Transmitter<M>::~Transmitter() {}
 
 template <typename M>
 bool Transmitter<M>::Transmit(const MessagePtr& msg) {
+  PrepareMessageInfo();
+  return Transmit(msg, msg_info_);
+}
+
+template <typename M>
+bool Transmitter<M>::Loan(LoanedMessage<M>* loaned) {
+  (void)loaned;
+  return false;
+}
+
+template <typename M>
+bool Transmitter<M>::Publish(LoanedMessage<M>* loaned) {
+  PrepareMessageInfo();
+  return Publish(loaned, msg_info_);
+}
+
+template <typename M>
+bool Transmitter<M>::Publish(LoanedMessage<M>* loaned,
+                             const MessageInfo& msg_info) {
+  auto msg = loaned->Share();
+  loaned->Reset();
+  if (msg == nullptr) {
+    return false;
+  }
+  return Transmit(msg, msg_info);
+}
+
+template <typename M>
+void Transmitter<M>::PrepareMessageInfo() {
   msg_info_.set_seq_num(NextSeqNum());
   msg_info_.set_send_time(Time::Now().ToNanosecond());
+  if (statistics::LatencyTracer::Instance()->IsEnabled()) {
+    msg_info_.set_trace_stamp(TRACE_TRANSMIT, statistics::LatencyTracer::Now());
+  }
   PerfEventCache::Instance()->AddTransportEvent(
       TransPerf::TRANSMIT_BEGIN, attr_.channel_id(), msg_info_.seq_num());
-  return Transmit(msg, msg_info_);
 }
 
 template <typename M>
@@ -39,6 +39,11 @@ using apollo::common::math::Box2d;
 using apollo::common::math::PathMatcher;
 using apollo::common::math::Vec2d;
 
+namespace {
+// about the size of an extended vehicle box
+constexpr double kPredictedEnvironmentCellSize = 10.0;
+}  // namespace
+
 CollisionChecker::CollisionChecker(
     const std::vector<const Obstacle*>& obstacles, const double ego_vehicle_s,
     const double ego_vehicle_d,
@@ -86,7 +91,7 @@ bool CollisionChecker::InCollision(
 bool CollisionChecker::InCollision(
     const DiscretizedTrajectory& discretized_trajectory) {
   CHECK_LE(discretized_trajectory.NumOfPoints(),
-           predicted_bounding_rectangles_.size());
+           predicted_environment_.size());
   const auto& vehicle_config =
       common::VehicleConfigHelper::Instance()->GetConfig();
   double ego_length = vehicle_config.vehicle_param().length();
@@ -105,10 +110,8 @@ bool CollisionChecker::InCollision(
                     shift_distance * std::sin(ego_theta)};
     ego_box.Shift(shift_vec);
 
-    for (const auto& obstacle_box : predicted_bounding_rectangles_[i]) {
-      if (ego_box.HasOverlap(obstacle_box)) {
-        return true;
-      }
+    if (predicted_environment_[i].HasOverlap(ego_box)) {
+      return true;
     }
   }
   return false;
@@ -118,7 +121,7 @@ void CollisionChecker::BuildPredictedEnvironment(
     const std::vector<const Obstacle*>& obstacles, const double ego_vehicle_s,
     const double ego_vehicle_d,
     const std::vector<PathPoint>& discretized_reference_line) {
-  ACHECK(predicted_bounding_rectangles_.empty());
+  ACHECK(predicted_environment_.empty());
 
   // If the ego vehicle is in lane,
   // then, ignore all obstacles from the same lane.
@@ -140,7 +143,7 @@ void CollisionChecker::BuildPredictedEnvironment(
 
   double relative_time = 0.0;
   while (relative_time < FLAGS_trajectory_time_length) {
-    std::vector<Box2d> predicted_env;
+    CollisionGrid predicted_env;
     for (const Obstacle* obstacle : obstacles_considered) {
       // If an obstacle has no trajectory, it is considered as static.
       // Obstacle::GetPointAtTime has handled this case.
@@ -148,9 +151,10 @@ void CollisionChecker::BuildPredictedEnvironment(
       Box2d box = obstacle->GetBoundingBox(point);
       box.LongitudinalExtend(2.0 * FLAGS_lon_collision_buffer);
       box.LateralExtend(2.0 * FLAGS_lat_collision_buffer);
-      predicted_env.push_back(std::move(box));
+      predicted_env.AddBox(box);
     }
-    predicted_bounding_rectangles_.push_back(std::move(predicted_env));
+    predicted_env.Build(kPredictedEnvironmentCellSize);
+    predicted_environment_.push_back(std::move(predicted_env));
     relative_time += FLAGS_trajectory_time_resolution;
   }
 }
@@ -28,6 +28,7 @@
 #include "modules/planning/planning_base/common/obstacle.h"
 #include "modules/planning/planning_base/common/reference_line_info.h"
 #include "modules/planning/planning_base/common/trajectory/discretized_trajectory.h"
+#include "modules/planning/planning_base/math/collision_grid.h"
 
 namespace apollo {
 namespace planning {
@@ -64,7 +65,8 @@ class CollisionChecker {
  private:
   const ReferenceLineInfo* ptr_reference_line_info_;
   std::shared_ptr<PathTimeGraph> ptr_path_time_graph_;
-  std::vector<std::vector<common::math::Box2d>> predicted_bounding_rectangles_;
+  // the predicted obstacle boxes of every time slice
+  std::vector<CollisionGrid> predicted_environment_;
 };
 
 }  // namespace planning
@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include <memory>
+
 #include "modules/common/vehicle_state/vehicle_state_provider.h"
 #include "modules/planning/planning_base/common/ego_info.h"
 #include "modules/planning/planning_base/common/frame.h"
@@ -28,25 +30,47 @@ namespace planning {
 
 class DependencyInjector {
  public:
-  DependencyInjector() = default;
+  DependencyInjector()
+      : frame_history_(std::make_shared<FrameHistory>()),
+        history_(std::make_shared<History>()),
+        ego_info_(std::make_shared<EgoInfo>()),
+        vehicle_state_(
+            std::make_shared<apollo::common::VehicleStateProvider>()),
+        learning_based_data_(std::make_shared<LearningBasedData>()) {}
   ~DependencyInjector() = default;
 
+  /**
+   * @brief An injector sharing every dependency with this one but the
+   * planning context, which is its own. Task pipelines planning reference
+   * lines at the same time keep their status apart in it.
+   */
+  std::shared_ptr<DependencyInjector> Fork() const {
+    std::shared_ptr<DependencyInjector> fork(new DependencyInjector(*this));
+    fork->planning_context_.Clear();
+    return fork;
+  }
+
   PlanningContext* planning_context() { return &planning_context_; }
-  FrameHistory* frame_history() { return &frame_history_; }
-  History* history() { return &history_; }
-  EgoInfo* ego_info() { return &ego_info_; }
+  FrameHistory* frame_history() { return frame_history_.get(); }
+  History* history() { return history_.get(); }
+  EgoInfo* ego_info() { return ego_info_.get(); }
   apollo::common::VehicleStateProvider* vehicle_state() {
-    return &vehicle_state_;
+    return vehicle_state_.get();
+  }
+  LearningBasedData* learning_based_data() {
+    return learning_based_data_.get();
   }
-  LearningBasedData* learning_based_data() { return &learning_based_data_; }
 
  private:
+  DependencyInjector(const DependencyInjector&) = default;
+  DependencyInjector& operator=(const DependencyInjector&) = delete;
+
   PlanningContext planning_context_;
-  FrameHistory frame_history_;
-  History history_;
-  EgoInfo ego_info_;
-  apollo::common::VehicleStateProvider vehicle_state_;
-  LearningBasedData learning_based_data_;
+  std::shared_ptr<FrameHistory> frame_history_;
+  std::shared_ptr<History> history_;
+  std::shared_ptr<EgoInfo> ego_info_;
+  std::shared_ptr<apollo::common::VehicleStateProvider> vehicle_state_;
+  std::shared_ptr<LearningBasedData> learning_based_data_;
 };
 
 }  // namespace planning
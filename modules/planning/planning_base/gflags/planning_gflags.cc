@@ -68,6 +68,9 @@ DEFINE_double(look_forward_extend_distance, 50,
 DEFINE_double(reference_line_stitch_overlap_distance, 20,
               "The overlap distance with the existing reference line when "
               "stitching the existing reference line");
+DEFINE_bool(enable_incremental_reference_line_smoothing, false,
+            "Reuse the smoothed lanes of recent reference lines when a route "
+            "segment is smoothed from scratch, and only smooth the rest of it");
 
 DEFINE_bool(enable_smooth_reference_line, true,
             "enable smooth the map reference line");
@@ -209,6 +212,9 @@ DEFINE_double(speed_fallback_distance, 3.0,
 /// thread pool
 DEFINE_bool(use_multi_thread_to_add_obstacles, false,
             "use multiple thread to add obstacles.");
+DEFINE_bool(enable_parallel_reference_line_planning, false,
+            "plan the reference lines of lane follow stage at the same time, "
+            "each with a task pipeline of its own.");
 
 /// Lattice Planner
 DEFINE_double(numerical_epsilon, 1e-6, "Epsilon in lattice planner.");
@@ -38,6 +38,7 @@ DECLARE_bool(prioritize_change_lane);
 DECLARE_bool(enable_reference_line_stitching);
 DECLARE_double(look_forward_extend_distance);
 DECLARE_double(reference_line_stitch_overlap_distance);
+DECLARE_bool(enable_incremental_reference_line_smoothing);
 DECLARE_string(smoother_config_filename);
 DECLARE_bool(enable_smooth_reference_line);
 DECLARE_bool(enable_reference_line_provider_thread);
@@ -102,6 +103,7 @@ DECLARE_double(slowdown_profile_deceleration);
 DECLARE_double(speed_fallback_distance);
 /// thread pool
 DECLARE_bool(use_multi_thread_to_add_obstacles);
+DECLARE_bool(enable_parallel_reference_line_planning);
 
 DECLARE_double(numerical_epsilon);
 DECLARE_double(default_cruise_speed);
@@ -0,0 +1,170 @@
+/******************************************************************************
+ * Copyright 2024 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file collision_grid.cc
+ **/
+
+#include "modules/planning/planning_base/math/collision_grid.h"
+
+#include <cmath>
+#include <limits>
+
+namespace apollo {
+namespace planning {
+
+using apollo::common::math::Box2d;
+using apollo::common::math::LineSegment2d;
+using apollo::common::math::Vec2d;
+
+namespace {
+// bounds the memory of the cells, long curbs would span millions of cells of
+// the size of a vehicle in a large open space roi
+constexpr double kMaxCellNum = 1 << 16;
+}  // namespace
+
+void CollisionGrid::AddLineSegment(const LineSegment2d& line_segment) {
+  const Vec2d& start = line_segment.start();
+  const Vec2d& end = line_segment.end();
+  AddObject(std::fmin(start.x(), end.x()), std::fmin(start.y(), end.y()),
+            std::fmax(start.x(), end.x()), std::fmax(start.y(), end.y()),
+            false, static_cast<uint32_t>(line_segments_.size()));
+  line_segments_.push_back(line_segment);
+}
+
+void CollisionGrid::AddBox(const Box2d& box) {
+  AddObject(box.min_x(), box.min_y(), box.max_x(), box.max_y(), true,
+            static_cast<uint32_t>(boxes_.size()));
+  boxes_.push_back(box);
+}
+
+void CollisionGrid::AddObject(const double min_x, const double min_y,
+                              const double max_x, const double max_y,
+                              const bool is_box, const uint32_t index) {
+  Object object;
+  object.min_x = min_x;
+  object.min_y = min_y;
+  object.max_x = max_x;
+  object.max_y = max_y;
+  object.is_box = is_box;
+  object.index = index;
+  objects_.push_back(object);
+  built_ = false;
+}
+
+void CollisionGrid::Build(const double cell_size) {
+  built_ = true;
+  cell_begin_.clear();
+  cell_objects_.clear();
+  if (objects_.empty()) {
+    num_cells_x_ = 0;
+    num_cells_y_ = 0;
+    return;
+  }
+
+  min_x_ = std::numeric_limits<double>::infinity();
+  min_y_ = std::numeric_limits<double>::infinity();
+  max_x_ = -std::numeric_limits<double>::infinity();
+  max_y_ = -std::numeric_limits<double>::infinity();
+  for (const auto& object : objects_) {
+    min_x_ = std::fmin(min_x_, object.min_x);
+    min_y_ = std::fmin(min_y_, object.min_y);
+    max_x_ = std::fmax(max_x_, object.max_x);
+    max_y_ = std::fmax(max_y_, object.max_y);
+  }
+  cell_size_ = std::fmax(cell_size, 1e-3);
+  const double cell_num = std::ceil((max_x_ - min_x_) / cell_size_ + 1.0) *
+                          std::ceil((max_y_ - min_y_) / cell_size_ + 1.0);
+  if (cell_num > kMaxCellNum) {
+    cell_size_ *= std::sqrt(cell_num / kMaxCellNum);
+  }
+  num_cells_x_ = static_cast<int>((max_x_ - min_x_) / cell_size_) + 1;
+  num_cells_y_ = static_cast<int>((max_y_ - min_y_) / cell_size_) + 1;
+
+  // count the objects of every cell, then place them
+  cell_begin_.assign(num_cells_x_ * num_cells_y_ + 1, 0);
+  for (auto& object : objects_) {
+    object.cell_x = CellX(object.min_x);
+    object.cell_y = CellY(object.min_y);
+    const int end_x = CellX(object.max_x);
+    const int end_y = CellY(object.max_y);
+    for (int y = object.cell_y; y <= end_y; ++y) {
+      for (int x = object.cell_x; x <= end_x; ++x) {
+        ++cell_begin_[y * num_cells_x_ + x + 1];
+      }
+    }
+  }
+  for (size_t i = 1; i < cell_begin_.size(); ++i) {
+    cell_begin_[i] += cell_begin_[i - 1];
+  }
+  cell_objects_.resize(cell_begin_.back());
+  std::vector<uint32_t> cell_end(cell_begin_.begin(), cell_begin_.end() - 1);
+  for (size_t i = 0; i < objects_.size(); ++i) {
+    const Object& object = objects_[i];
+    const int end_x = CellX(object.max_x);
+    const int end_y = CellY(object.max_y);
+    for (int y = object.cell_y; y <= end_y; ++y) {
+      for (int x = object.cell_x; x <= end_x; ++x) {
+        cell_objects_[cell_end[y * num_cells_x_ + x]++] =
+            static_cast<uint32_t>(i);
+      }
+    }
+  }
+}
+
+void CollisionGrid::Clear() {
+  line_segments_.clear();
+  boxes_.clear();
+  objects_.clear();
+  cell_begin_.clear();
+  cell_objects_.clear();
+  num_cells_x_ = 0;
+  num_cells_y_ = 0;
+  built_ = false;
+}
+
+bool CollisionGrid::HasOverlap(const Box2d& box) const {
+  return AnyCandidate(
+      box.min_x(), box.min_y(), box.max_x(), box.max_y(),
+      [this, &box](const Object& object) {
+        return object.is_box ? box.HasOverlap(boxes_[object.index])
+                             : box.HasOverlap(line_segments_[object.index]);
+      });
+}
+
+bool CollisionGrid::HasObjectWithin(const Vec2d& point,
+                                    const double distance) const {
+  return AnyCandidate(
+      point.x() - distance, point.y() - distance, point.x() + distance,
+      point.y() + distance, [this, &point, distance](const Object& object) {
+        return object.is_box
+                   ? boxes_[object.index].DistanceTo(point) < distance
+                   : line_segments_[object.index].DistanceTo(point) < distance;
+      });
+}
+
+int CollisionGrid::CellX(const double x) const {
+  const double cell = std::floor((x - min_x_) / cell_size_);
+  return static_cast<int>(std::fmax(0.0, std::fmin(num_cells_x_ - 1, cell)));
+}
+
+int CollisionGrid::CellY(const double y) const {
+  const double cell = std::floor((y - min_y_) / cell_size_);
+  return static_cast<int>(std::fmax(0.0, std::fmin(num_cells_y_ - 1, cell)));
+}
+
+}  // namespace planning
+}  // namespace apollo
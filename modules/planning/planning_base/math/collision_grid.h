@@ -0,0 +1,157 @@
+/******************************************************************************
+ * Copyright 2024 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file collision_grid.h
+ **/
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "cyber/common/log.h"
+#include "modules/common/math/box2d.h"
+#include "modules/common/math/line_segment2d.h"
+#include "modules/common/math/vec2d.h"
+
+namespace apollo {
+namespace planning {
+
+/**
+ * @class CollisionGrid
+ * @brief Broad phase of collision checks against a fixed set of line segments
+ * and boxes. The objects are bucketed by their axis aligned bounding boxes
+ * into a uniform grid, a query runs the exact check on the objects of the
+ * cells it covers only.
+ *
+ * Build the grid once per frame (or per time slice of predictions) and query
+ * it for every footprint. Queries are const and can run concurrently.
+ */
+class CollisionGrid {
+ public:
+  void AddLineSegment(const common::math::LineSegment2d& line_segment);
+
+  void AddBox(const common::math::Box2d& box);
+
+  /**
+   * @brief Index the objects added so far in square cells. The cells are
+   * made larger if the objects would span too many of them.
+   * @param cell_size The side length of a cell, about the size of a query.
+   */
+  void Build(const double cell_size);
+
+  void Clear();
+
+  bool empty() const { return objects_.empty(); }
+
+  size_t num_objects() const { return objects_.size(); }
+
+  /**
+   * @brief Whether the box overlaps one of the objects, the same as
+   * Box2d::HasOverlap against each of them.
+   */
+  bool HasOverlap(const common::math::Box2d& box) const;
+
+  /**
+   * @brief Whether one of the objects is closer to the point than distance.
+   */
+  bool HasObjectWithin(const common::math::Vec2d& point,
+                       const double distance) const;
+
+ private:
+  struct Object {
+    double min_x = 0.0;
+    double min_y = 0.0;
+    double max_x = 0.0;
+    double max_y = 0.0;
+    // the first cell of the object
+    int cell_x = 0;
+    int cell_y = 0;
+    bool is_box = false;
+    // in boxes_ or line_segments_
+    uint32_t index = 0;
+  };
+
+  void AddObject(const double min_x, const double min_y, const double max_x,
+                 const double max_y, const bool is_box, const uint32_t index);
+
+  int CellX(const double x) const;
+  int CellY(const double y) const;
+
+  // calls check on every object whose bounding box overlaps the query one,
+  // each object once, until check returns true
+  template <typename Check>
+  bool AnyCandidate(const double min_x, const double min_y, const double max_x,
+                    const double max_y, const Check& check) const;
+
+  std::vector<common::math::LineSegment2d> line_segments_;
+  std::vector<common::math::Box2d> boxes_;
+  std::vector<Object> objects_;
+  bool built_ = false;
+
+  double min_x_ = 0.0;
+  double min_y_ = 0.0;
+  double max_x_ = 0.0;
+  double max_y_ = 0.0;
+  double cell_size_ = 1.0;
+  int num_cells_x_ = 0;
+  int num_cells_y_ = 0;
+  // the objects of cell i are cell_objects_[cell_begin_[i], cell_begin_[i+1])
+  std::vector<uint32_t> cell_begin_;
+  std::vector<uint32_t> cell_objects_;
+};
+
+template <typename Check>
+bool CollisionGrid::AnyCandidate(const double min_x, const double min_y,
+                                 const double max_x, const double max_y,
+                                 const Check& check) const {
+  DCHECK(built_ || objects_.empty()) << "query before Build";
+  if (objects_.empty() || max_x < min_x_ || min_x > max_x_ || max_y < min_y_ ||
+      min_y > max_y_) {
+    return false;
+  }
+  const int begin_x = CellX(min_x);
+  const int begin_y = CellY(min_y);
+  const int end_x = CellX(max_x);
+  const int end_y = CellY(max_y);
+  for (int y = begin_y; y <= end_y; ++y) {
+    for (int x = begin_x; x <= end_x; ++x) {
+      const int cell = y * num_cells_x_ + x;
+      for (uint32_t i = cell_begin_[cell]; i < cell_begin_[cell + 1]; ++i) {
+        const Object& object = objects_[cell_objects_[i]];
+        // an object in several cells of the query is checked in the first
+        // one only
+        if (x != std::max(object.cell_x, begin_x) ||
+            y != std::max(object.cell_y, begin_y)) {
+          continue;
+        }
+        if (object.max_x < min_x || object.min_x > max_x ||
+            object.max_y < min_y || object.min_y > max_y) {
+          continue;
+        }
+        if (check(object)) {
+          return true;
+        }
+      }
+    }
+  }
+  return false;
+}
+
+}  // namespace planning
+}  // namespace apollo
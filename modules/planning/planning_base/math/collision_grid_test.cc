@@ -0,0 +1,113 @@
+/******************************************************************************
+ * Copyright 2024 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ **/
+
+#include "modules/planning/planning_base/math/collision_grid.h"
+
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace planning {
+
+using apollo::common::math::Box2d;
+using apollo::common::math::LineSegment2d;
+using apollo::common::math::Vec2d;
+
+TEST(CollisionGridTest, empty) {
+  CollisionGrid grid;
+  grid.Build(1.0);
+  EXPECT_TRUE(grid.empty());
+  EXPECT_FALSE(grid.HasOverlap(Box2d({0.0, 0.0}, 0.0, 4.0, 2.0)));
+  EXPECT_FALSE(grid.HasObjectWithin({0.0, 0.0}, 10.0));
+}
+
+TEST(CollisionGridTest, long_segment) {
+  CollisionGrid grid;
+  // spans more cells than the grid keeps
+  grid.AddLineSegment(LineSegment2d({-1000.0, 0.0}, {1000.0, 0.0}));
+  grid.AddBox(Box2d({0.0, 10.0}, 0.5, 4.0, 2.0));
+  grid.Build(0.1);
+  EXPECT_EQ(2U, grid.num_objects());
+  EXPECT_TRUE(grid.HasOverlap(Box2d({500.0, 0.5}, 0.0, 4.0, 2.0)));
+  EXPECT_FALSE(grid.HasOverlap(Box2d({500.0, 1.5}, 0.0, 4.0, 2.0)));
+  EXPECT_TRUE(grid.HasOverlap(Box2d({0.0, 8.5}, 0.0, 4.0, 2.0)));
+  EXPECT_TRUE(grid.HasObjectWithin({-999.0, 0.5}, 1.0));
+  EXPECT_FALSE(grid.HasObjectWithin({-1001.0, 0.5}, 1.0));
+
+  grid.Clear();
+  grid.Build(0.1);
+  EXPECT_FALSE(grid.HasOverlap(Box2d({500.0, 0.5}, 0.0, 4.0, 2.0)));
+}
+
+TEST(CollisionGridTest, same_as_brute_force) {
+  std::mt19937 generator(0);
+  std::uniform_real_distribution<double> position(-30.0, 30.0);
+  std::uniform_real_distribution<double> heading(-M_PI, M_PI);
+  std::uniform_real_distribution<double> size(0.1, 6.0);
+
+  std::vector<LineSegment2d> line_segments;
+  std::vector<Box2d> boxes;
+  CollisionGrid grid;
+  for (int i = 0; i < 100; ++i) {
+    const Vec2d start(position(generator), position(generator));
+    line_segments.emplace_back(
+        start, start + Vec2d::CreateUnitVec2d(heading(generator)) *
+                           size(generator));
+    grid.AddLineSegment(line_segments.back());
+    boxes.emplace_back(Vec2d(position(generator), position(generator)),
+                       heading(generator), size(generator), size(generator));
+    grid.AddBox(boxes.back());
+  }
+  grid.Build(2.0);
+
+  int overlap_num = 0;
+  for (int i = 0; i < 2000; ++i) {
+    const Box2d query({position(generator), position(generator)},
+                      heading(generator), 4.8, 2.0);
+    bool expected = false;
+    for (const auto& line_segment : line_segments) {
+      expected = expected || query.HasOverlap(line_segment);
+    }
+    for (const auto& box : boxes) {
+      expected = expected || query.HasOverlap(box);
+    }
+    EXPECT_EQ(expected, grid.HasOverlap(query));
+    overlap_num += expected;
+
+    const Vec2d point(position(generator), position(generator));
+    const double distance = 0.5 * size(generator);
+    expected = false;
+    for (const auto& line_segment : line_segments) {
+      expected = expected || line_segment.DistanceTo(point) < distance;
+    }
+    for (const auto& box : boxes) {
+      expected = expected || box.DistanceTo(point) < distance;
+    }
+    EXPECT_EQ(expected, grid.HasObjectWithin(point, distance));
+  }
+  // both outcomes are covered
+  EXPECT_GT(overlap_num, 100);
+  EXPECT_LT(overlap_num, 1900);
+}
+
+}  // namespace planning
+}  // namespace apollo
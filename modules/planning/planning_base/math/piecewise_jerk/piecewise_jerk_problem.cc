@@ -48,46 +48,47 @@ PiecewiseJerkProblem::PiecewiseJerkProblem(
   weight_x_ref_vec_ = std::vector<double>(num_of_knots_, 0.0);
 }
 
-bool PiecewiseJerkProblem::FormulateProblem(OSQPData* data) {
+bool PiecewiseJerkProblem::FormulateProblem(
+    PiecewiseJerkSolverSession::QpData* qp) {
   // calculate kernel
-  std::vector<c_float> P_data;
-  std::vector<c_int> P_indices;
-  std::vector<c_int> P_indptr;
-  CalculateKernel(&P_data, &P_indices, &P_indptr);
+  CalculateKernel(&qp->P_data, &qp->P_indices, &qp->P_indptr);
 
   // calculate affine constraints
-  std::vector<c_float> A_data;
-  std::vector<c_int> A_indices;
-  std::vector<c_int> A_indptr;
-  std::vector<c_float> lower_bounds;
-  std::vector<c_float> upper_bounds;
-  CalculateAffineConstraint(&A_data, &A_indices, &A_indptr, &lower_bounds,
-                            &upper_bounds);
+  CalculateAffineConstraint(&qp->A_data, &qp->A_indices, &qp->A_indptr,
+                            &qp->l, &qp->u);
 
   // calculate offset
-  std::vector<c_float> q;
-  CalculateOffset(&q);
-
-  CHECK_EQ(lower_bounds.size(), upper_bounds.size());
-
-  size_t kernel_dim = 3 * num_of_knots_;
-  size_t num_affine_constraint = lower_bounds.size();
-
-  data->n = kernel_dim;
-  data->m = num_affine_constraint;
-  data->P = csc_matrix(kernel_dim, kernel_dim, P_data.size(), CopyData(P_data),
-                       CopyData(P_indices), CopyData(P_indptr));
-  data->q = CopyData(q);
-  data->A =
-      csc_matrix(num_affine_constraint, kernel_dim, A_data.size(),
-                 CopyData(A_data), CopyData(A_indices), CopyData(A_indptr));
-  data->l = CopyData(lower_bounds);
-  data->u = CopyData(upper_bounds);
-
-  return CheckLowUpperBound(lower_bounds, upper_bounds);
+  CalculateOffset(&qp->q);
+
+  CHECK_EQ(qp->l.size(), qp->u.size());
+
+  qp->n = 3 * num_of_knots_;
+  qp->m = qp->l.size();
+
+  return CheckLowUpperBound(qp->l, qp->u);
+}
+
+bool PiecewiseJerkProblem::FormulateProblem(OSQPData* data) {
+  PiecewiseJerkSolverSession::QpData qp;
+  bool invalid_bounds = FormulateProblem(&qp);
+
+  data->n = qp.n;
+  data->m = qp.m;
+  data->P = csc_matrix(qp.n, qp.n, qp.P_data.size(), CopyData(qp.P_data),
+                       CopyData(qp.P_indices), CopyData(qp.P_indptr));
+  data->q = CopyData(qp.q);
+  data->A = csc_matrix(qp.m, qp.n, qp.A_data.size(), CopyData(qp.A_data),
+                       CopyData(qp.A_indices), CopyData(qp.A_indptr));
+  data->l = CopyData(qp.l);
+  data->u = CopyData(qp.u);
+
+  return invalid_bounds;
 }
 
 bool PiecewiseJerkProblem::Optimize(const int max_iter) {
+  if (solver_session_ != nullptr) {
+    return OptimizeInSession(max_iter);
+  }
   OSQPData* data = reinterpret_cast<OSQPData*>(c_malloc(sizeof(OSQPData)));
   if (FormulateProblem(data)) {
     FreeData(data);
@@ -98,6 +99,10 @@ bool PiecewiseJerkProblem::Optimize(const int max_iter) {
   OSQPWorkspace* osqp_work = nullptr;
   osqp_work = osqp_setup(data, settings);
   // osqp_setup(&osqp_work, data, settings);
+  const std::vector<c_float> warm_start_x = ScaledWarmStart();
+  if (!warm_start_x.empty()) {
+    osqp_warm_start_x(osqp_work, warm_start_x.data());
+  }
   osqp_solve(osqp_work);
   auto status = osqp_work->info->status_val;
 
@@ -116,15 +121,7 @@ bool PiecewiseJerkProblem::Optimize(const int max_iter) {
   }
 
   // extract primal results
-  x_.resize(num_of_knots_);
-  dx_.resize(num_of_knots_);
-  ddx_.resize(num_of_knots_);
-  for (size_t i = 0; i < num_of_knots_; ++i) {
-    x_.at(i) = osqp_work->solution->x[i] / scale_factor_[0];
-    dx_.at(i) = osqp_work->solution->x[i + num_of_knots_] / scale_factor_[1];
-    ddx_.at(i) =
-        osqp_work->solution->x[i + 2 * num_of_knots_] / scale_factor_[2];
-  }
+  ExtractSolution(osqp_work->solution->x);
 
   // Cleanup
   osqp_cleanup(osqp_work);
@@ -133,6 +130,52 @@ bool PiecewiseJerkProblem::Optimize(const int max_iter) {
   return true;
 }
 
+bool PiecewiseJerkProblem::OptimizeInSession(const int max_iter) {
+  PiecewiseJerkSolverSession::QpData qp;
+  if (FormulateProblem(&qp)) {
+    return false;
+  }
+  OSQPSettings* settings = SolverDefaultSettings();
+  settings->max_iter = max_iter;
+  std::vector<c_float> solution;
+  bool success = solver_session_->Solve(qp, *settings, ScaledWarmStart(),
+                                        &solution);
+  c_free(settings);
+  if (!success) {
+    return false;
+  }
+  ExtractSolution(solution.data());
+  return true;
+}
+
+std::vector<c_float> PiecewiseJerkProblem::ScaledWarmStart() const {
+  std::vector<c_float> warm_start_x;
+  if (warm_start_.x.size() != num_of_knots_ ||
+      warm_start_.dx.size() != num_of_knots_ ||
+      warm_start_.ddx.size() != num_of_knots_) {
+    return warm_start_x;
+  }
+  warm_start_x.resize(3 * num_of_knots_);
+  for (size_t i = 0; i < num_of_knots_; ++i) {
+    warm_start_x[i] = warm_start_.x[i] * scale_factor_[0];
+    warm_start_x[i + num_of_knots_] = warm_start_.dx[i] * scale_factor_[1];
+    warm_start_x[i + 2 * num_of_knots_] =
+        warm_start_.ddx[i] * scale_factor_[2];
+  }
+  return warm_start_x;
+}
+
+void PiecewiseJerkProblem::ExtractSolution(const c_float* solution) {
+  x_.resize(num_of_knots_);
+  dx_.resize(num_of_knots_);
+  ddx_.resize(num_of_knots_);
+  for (size_t i = 0; i < num_of_knots_; ++i) {
+    x_.at(i) = solution[i] / scale_factor_[0];
+    dx_.at(i) = solution[i + num_of_knots_] / scale_factor_[1];
+    ddx_.at(i) = solution[i + 2 * num_of_knots_] / scale_factor_[2];
+  }
+}
+
 void PiecewiseJerkProblem::CalculateAffineConstraint(
     std::vector<c_float>* A_data, std::vector<c_int>* A_indices,
     std::vector<c_int>* A_indptr, std::vector<c_float>* lower_bounds,
@@ -26,9 +26,18 @@
 
 #include "osqp/osqp.h"
 
+#include "modules/planning/planning_base/math/piecewise_jerk/piecewise_jerk_solver_session.h"
+
 namespace apollo {
 namespace planning {
 
+// x, x', x'' of every knot the solver starts from
+struct PiecewiseJerkWarmStart {
+  std::vector<double> x;
+  std::vector<double> dx;
+  std::vector<double> ddx;
+};
+
 /*
  * @brief:
  * This class solve an optimization problem:
@@ -120,6 +129,23 @@ class PiecewiseJerkProblem {
   void set_end_state_ref(const std::array<double, 3>& weight_end_state,
                          const std::array<double, 3>& end_state_ref);
 
+  /**
+   * @brief Start the solver from warm_start, e.g. the solution of the last
+   * planning cycle stitched to this one. Ignored unless it has a value of
+   * every knot.
+   */
+  void set_warm_start(PiecewiseJerkWarmStart warm_start) {
+    warm_start_ = std::move(warm_start);
+  }
+
+  /**
+   * @brief Solve in the workspaces kept by session instead of setting one up
+   * and tearing it down in Optimize.
+   */
+  void set_solver_session(PiecewiseJerkSolverSession* session) {
+    solver_session_ = session;
+  }
+
   virtual bool Optimize(const int max_iter = 4000);
 
   const std::vector<double>& opt_x() const { return x_; }
@@ -146,6 +172,17 @@ class PiecewiseJerkProblem {
 
   bool FormulateProblem(OSQPData* data);
 
+  // returns true if a lower bound is above its upper bound, as
+  // FormulateProblem
+  bool FormulateProblem(PiecewiseJerkSolverSession::QpData* qp);
+
+  bool OptimizeInSession(const int max_iter);
+
+  // the scaled warm start, empty if there is none
+  std::vector<c_float> ScaledWarmStart() const;
+
+  void ExtractSolution(const c_float* solution);
+
   void FreeData(OSQPData* data);
 
   bool CheckLowUpperBound(const std::vector<c_float>& lower,
@@ -194,6 +231,9 @@ class PiecewiseJerkProblem {
   bool has_end_state_ref_ = false;
   std::array<double, 3> weight_end_state_ = {{0.0, 0.0, 0.0}};
   std::array<double, 3> end_state_ref_;
+
+  PiecewiseJerkWarmStart warm_start_;
+  PiecewiseJerkSolverSession* solver_session_ = nullptr;
 };
 
 }  // namespace planning
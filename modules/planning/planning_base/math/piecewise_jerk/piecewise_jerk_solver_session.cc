@@ -0,0 +1,286 @@
+/******************************************************************************
+ * Copyright 2024 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/planning/planning_base/math/piecewise_jerk/piecewise_jerk_solver_session.h"
+
+#include <algorithm>
+#include <chrono>
+#include <sstream>
+
+#include "cyber/common/log.h"
+
+namespace apollo {
+namespace planning {
+
+namespace {
+// a task solves a few problems of different sizes in a cycle at most, e.g.
+// one per path boundary
+constexpr size_t kMaxWorkspaces = 4;
+
+double ElapsedMs(const std::chrono::steady_clock::time_point& start) {
+  return std::chrono::duration<double, std::milli>(
+             std::chrono::steady_clock::now() - start)
+      .count();
+}
+
+// the settings baked into the factorization and the scaling of a workspace
+bool SameSetupSettings(const OSQPSettings& a, const OSQPSettings& b) {
+  return a.rho == b.rho && a.sigma == b.sigma && a.scaling == b.scaling &&
+         a.adaptive_rho == b.adaptive_rho &&
+         a.adaptive_rho_interval == b.adaptive_rho_interval &&
+         a.adaptive_rho_tolerance == b.adaptive_rho_tolerance &&
+         a.linsys_solver == b.linsys_solver;
+}
+
+bool UpdateSettings(const OSQPSettings& settings, OSQPWorkspace* work) {
+  return osqp_update_max_iter(work, settings.max_iter) == 0 &&
+         osqp_update_eps_abs(work, settings.eps_abs) == 0 &&
+         osqp_update_eps_rel(work, settings.eps_rel) == 0 &&
+         osqp_update_eps_prim_inf(work, settings.eps_prim_inf) == 0 &&
+         osqp_update_eps_dual_inf(work, settings.eps_dual_inf) == 0 &&
+         osqp_update_alpha(work, settings.alpha) == 0 &&
+         osqp_update_polish(work, settings.polish) == 0 &&
+         osqp_update_scaled_termination(work, settings.scaled_termination) ==
+             0 &&
+         osqp_update_check_termination(work, settings.check_termination) ==
+             0 &&
+         osqp_update_warm_start(work, settings.warm_start) == 0 &&
+         osqp_update_verbose(work, settings.verbose) == 0;
+}
+
+bool IsUpperTriangular(const PiecewiseJerkSolverSession::QpData& qp) {
+  for (c_int col = 0; col < qp.n; ++col) {
+    for (c_int k = qp.P_indptr[col]; k < qp.P_indptr[col + 1]; ++k) {
+      if (qp.P_indices[k] > col) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+void DropLowerTriangle(PiecewiseJerkSolverSession::QpData* qp) {
+  size_t nnz = 0;
+  c_int begin = qp->P_indptr[0];
+  for (c_int col = 0; col < qp->n; ++col) {
+    const c_int end = qp->P_indptr[col + 1];
+    for (c_int k = begin; k < end; ++k) {
+      if (qp->P_indices[k] <= col) {
+        qp->P_data[nnz] = qp->P_data[k];
+        qp->P_indices[nnz] = qp->P_indices[k];
+        ++nnz;
+      }
+    }
+    begin = end;
+    qp->P_indptr[col + 1] = static_cast<c_int>(nnz);
+  }
+  qp->P_data.resize(nnz);
+  qp->P_indices.resize(nnz);
+}
+}  // namespace
+
+std::string PiecewiseJerkSolverSession::Stats::DebugString() const {
+  std::ostringstream out;
+  out << "setup " << setup_num << " in " << setup_time_ms << " ms, update "
+      << update_num << ", solve " << solve_time_ms << " ms";
+  return out.str();
+}
+
+PiecewiseJerkSolverSession::~PiecewiseJerkSolverSession() { Clear(); }
+
+bool PiecewiseJerkSolverSession::Solve(const QpData& qp,
+                                       const OSQPSettings& settings,
+                                       const std::vector<c_float>& warm_start_x,
+                                       std::vector<c_float>* solution) {
+  ACHECK(solution != nullptr);
+  // osqp_setup keeps the upper triangular part of P only, so do the same
+  // before comparing and updating the values of a kept workspace, e.g. the
+  // piecewise jerk kernels have their jerk cross terms below the diagonal
+  if (!IsUpperTriangular(qp)) {
+    QpData upper = qp;
+    DropLowerTriangle(&upper);
+    return Solve(upper, settings, warm_start_x, solution);
+  }
+  const auto setup_start = std::chrono::steady_clock::now();
+  Workspace* workspace = Find(qp, settings);
+  if (workspace != nullptr && !Update(qp, settings, workspace)) {
+    AWARN << "Update osqp workspace failed, set it up again.";
+    Remove(workspace);
+    workspace = nullptr;
+  }
+  if (workspace == nullptr) {
+    workspace = Setup(qp, settings);
+    if (workspace == nullptr) {
+      return false;
+    }
+    ++stats_.setup_num;
+  } else {
+    ++stats_.update_num;
+  }
+  workspace->last_used = ++use_count_;
+  OSQPWorkspace* work = workspace->work;
+  if (warm_start_x.size() == static_cast<size_t>(qp.n)) {
+    osqp_warm_start_x(work, warm_start_x.data());
+  }
+  stats_.setup_time_ms += ElapsedMs(setup_start);
+
+  const auto solve_start = std::chrono::steady_clock::now();
+  osqp_solve(work);
+  stats_.solve_time_ms += ElapsedMs(solve_start);
+
+  auto status = work->info->status_val;
+  if (status < 0 || (status != 1 && status != 2)) {
+    AERROR << "failed optimization status:\t" << work->info->status;
+    // the iterates of a failed solve are no start for the next one
+    Remove(workspace);
+    return false;
+  } else if (work->solution == nullptr) {
+    AERROR << "The solution from OSQP is nullptr";
+    Remove(workspace);
+    return false;
+  }
+  solution->assign(work->solution->x, work->solution->x + qp.n);
+  return true;
+}
+
+PiecewiseJerkSolverSession::Stats PiecewiseJerkSolverSession::TakeStats() {
+  Stats stats = stats_;
+  stats_ = Stats();
+  return stats;
+}
+
+void PiecewiseJerkSolverSession::Clear() {
+  for (auto& workspace : workspaces_) {
+    osqp_cleanup(workspace.work);
+  }
+  workspaces_.clear();
+}
+
+PiecewiseJerkSolverSession::Workspace* PiecewiseJerkSolverSession::Find(
+    const QpData& qp, const OSQPSettings& settings) {
+  for (auto& workspace : workspaces_) {
+    if (workspace.n == qp.n && workspace.m == qp.m &&
+        workspace.P_indptr == qp.P_indptr &&
+        workspace.P_indices == qp.P_indices &&
+        workspace.A_indptr == qp.A_indptr &&
+        workspace.A_indices == qp.A_indices &&
+        SameSetupSettings(workspace.settings, settings)) {
+      return &workspace;
+    }
+  }
+  return nullptr;
+}
+
+PiecewiseJerkSolverSession::Workspace* PiecewiseJerkSolverSession::Setup(
+    const QpData& qp, const OSQPSettings& settings) {
+  if (workspaces_.size() >= kMaxWorkspaces) {
+    Remove(&*std::min_element(workspaces_.begin(), workspaces_.end(),
+                              [](const Workspace& a, const Workspace& b) {
+                                return a.last_used < b.last_used;
+                              }));
+  }
+
+  // osqp_setup copies the data into the workspace
+  std::vector<c_float> P_data = qp.P_data;
+  std::vector<c_int> P_indices = qp.P_indices;
+  std::vector<c_int> P_indptr = qp.P_indptr;
+  std::vector<c_float> A_data = qp.A_data;
+  std::vector<c_int> A_indices = qp.A_indices;
+  std::vector<c_int> A_indptr = qp.A_indptr;
+  std::vector<c_float> q = qp.q;
+  std::vector<c_float> l = qp.l;
+  std::vector<c_float> u = qp.u;
+  OSQPData data;
+  data.n = qp.n;
+  data.m = qp.m;
+  data.P = csc_matrix(qp.n, qp.n, P_data.size(), P_data.data(),
+                      P_indices.data(), P_indptr.data());
+  data.A = csc_matrix(qp.m, qp.n, A_data.size(), A_data.data(),
+                      A_indices.data(), A_indptr.data());
+  data.q = q.data();
+  data.l = l.data();
+  data.u = u.data();
+  OSQPSettings setup_settings = settings;
+  OSQPWorkspace* work = osqp_setup(&data, &setup_settings);
+  c_free(data.P);
+  c_free(data.A);
+  if (work == nullptr) {
+    AERROR << "osqp setup failed, n: " << qp.n << ", m: " << qp.m;
+    return nullptr;
+  }
+
+  Workspace workspace;
+  workspace.work = work;
+  workspace.settings = settings;
+  workspace.n = qp.n;
+  workspace.m = qp.m;
+  workspace.P_indices = qp.P_indices;
+  workspace.P_indptr = qp.P_indptr;
+  workspace.A_indices = qp.A_indices;
+  workspace.A_indptr = qp.A_indptr;
+  workspace.P_data = qp.P_data;
+  workspace.A_data = qp.A_data;
+  workspaces_.push_back(std::move(workspace));
+  return &workspaces_.back();
+}
+
+bool PiecewiseJerkSolverSession::Update(const QpData& qp,
+                                        const OSQPSettings& settings,
+                                        Workspace* workspace) {
+  OSQPWorkspace* work = workspace->work;
+  const bool update_P = workspace->P_data != qp.P_data;
+  const bool update_A = workspace->A_data != qp.A_data;
+  // P is upper triangular here, check it against the workspace anyway since
+  // osqp_update_P writes its values without any check
+  if (update_P && work->data->P->p[qp.n] !=
+                      static_cast<c_int>(qp.P_data.size())) {
+    return false;
+  }
+  // the kkt matrix is factorized again after P or A is updated
+  c_int ret = 0;
+  if (update_P && update_A) {
+    ret = osqp_update_P_A(work, qp.P_data.data(), OSQP_NULL,
+                          qp.P_data.size(), qp.A_data.data(), OSQP_NULL,
+                          qp.A_data.size());
+  } else if (update_P) {
+    ret = osqp_update_P(work, qp.P_data.data(), OSQP_NULL, qp.P_data.size());
+  } else if (update_A) {
+    ret = osqp_update_A(work, qp.A_data.data(), OSQP_NULL, qp.A_data.size());
+  }
+  if (ret != 0 || osqp_update_lin_cost(work, qp.q.data()) != 0 ||
+      osqp_update_bounds(work, qp.l.data(), qp.u.data()) != 0 ||
+      !UpdateSettings(settings, work)) {
+    return false;
+  }
+  if (update_P) {
+    workspace->P_data = qp.P_data;
+  }
+  if (update_A) {
+    workspace->A_data = qp.A_data;
+  }
+  return true;
+}
+
+void PiecewiseJerkSolverSession::Remove(Workspace* workspace) {
+  osqp_cleanup(workspace->work);
+  if (workspace != &workspaces_.back()) {
+    *workspace = std::move(workspaces_.back());
+  }
+  workspaces_.pop_back();
+}
+
+}  // namespace planning
+}  // namespace apollo
@@ -0,0 +1,118 @@
+/******************************************************************************
+ * Copyright 2024 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ **/
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "osqp/osqp.h"
+
+namespace apollo {
+namespace planning {
+
+/*
+ * @brief:
+ * Keeps the osqp workspaces of the problems a task solves cycle after cycle.
+ * A problem with the sparsity of a kept workspace only updates the values of
+ * P, A, q, l and u in it, the workspace is set up again when the sparsity or
+ * a setting which can not be updated changes. The solver starts from the
+ * given primal warm start, or else from the last solution of the workspace.
+ */
+class PiecewiseJerkSolverSession {
+ public:
+  // the problem in osqp format, P and A in csc
+  struct QpData {
+    c_int n = 0;
+    c_int m = 0;
+    std::vector<c_float> P_data;
+    std::vector<c_int> P_indices;
+    std::vector<c_int> P_indptr;
+    std::vector<c_float> A_data;
+    std::vector<c_int> A_indices;
+    std::vector<c_int> A_indptr;
+    std::vector<c_float> q;
+    std::vector<c_float> l;
+    std::vector<c_float> u;
+  };
+
+  struct Stats {
+    // problems set up from scratch and solved on a kept workspace
+    int setup_num = 0;
+    int update_num = 0;
+    // time of osqp_setup, or of the updates of a kept workspace
+    double setup_time_ms = 0.0;
+    double solve_time_ms = 0.0;
+
+    std::string DebugString() const;
+  };
+
+  PiecewiseJerkSolverSession() = default;
+  ~PiecewiseJerkSolverSession();
+
+  PiecewiseJerkSolverSession(const PiecewiseJerkSolverSession&) = delete;
+  PiecewiseJerkSolverSession& operator=(const PiecewiseJerkSolverSession&) =
+      delete;
+
+  /**
+   * @brief Solve the problem, warm_start_x is ignored unless it has n values.
+   * @return false if osqp fails, solution is the primal solution otherwise.
+   */
+  bool Solve(const QpData& qp, const OSQPSettings& settings,
+             const std::vector<c_float>& warm_start_x,
+             std::vector<c_float>* solution);
+
+  /**
+   * @brief The stats since the last call, e.g. of one planning cycle.
+   */
+  Stats TakeStats();
+
+  void Clear();
+
+ private:
+  struct Workspace {
+    OSQPWorkspace* work = nullptr;
+    OSQPSettings settings;
+    c_int n = 0;
+    c_int m = 0;
+    std::vector<c_int> P_indices;
+    std::vector<c_int> P_indptr;
+    std::vector<c_int> A_indices;
+    std::vector<c_int> A_indptr;
+    std::vector<c_float> P_data;
+    std::vector<c_float> A_data;
+    uint64_t last_used = 0;
+  };
+
+  // a kept workspace of the sparsity of qp, nullptr if there is none
+  Workspace* Find(const QpData& qp, const OSQPSettings& settings);
+  Workspace* Setup(const QpData& qp, const OSQPSettings& settings);
+  bool Update(const QpData& qp, const OSQPSettings& settings,
+              Workspace* workspace);
+  void Remove(Workspace* workspace);
+
+  std::vector<Workspace> workspaces_;
+  uint64_t use_count_ = 0;
+  Stats stats_;
+};
+
+}  // namespace planning
+}  // namespace apollo
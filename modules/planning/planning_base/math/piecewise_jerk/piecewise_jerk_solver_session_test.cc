@@ -0,0 +1,137 @@
+/******************************************************************************
+ * Copyright 2024 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/planning/planning_base/math/piecewise_jerk/piecewise_jerk_solver_session.h"
+
+#include "gtest/gtest.h"
+
+#include "modules/planning/planning_base/math/piecewise_jerk/piecewise_jerk_speed_problem.h"
+
+namespace apollo {
+namespace planning {
+
+namespace {
+
+constexpr double kDeltaT = 0.1;
+
+void SetUpProblem(const double cruise_speed,
+                  PiecewiseJerkSpeedProblem* problem) {
+  problem->set_weight_ddx(1.0);
+  problem->set_weight_dddx(10.0);
+  problem->set_scale_factor({1.0, 10.0, 100.0});
+  problem->set_x_bounds(0.0, 200.0);
+  problem->set_dx_bounds(0.0, 20.0);
+  problem->set_ddx_bounds(-4.0, 2.0);
+  problem->set_dddx_bound(-4.0, 2.0);
+  problem->set_dx_ref(10.0, cruise_speed);
+}
+
+void ExpectNear(const std::vector<double>& expected,
+                const std::vector<double>& actual) {
+  ASSERT_EQ(expected.size(), actual.size());
+  for (size_t i = 0; i < expected.size(); ++i) {
+    EXPECT_NEAR(expected[i], actual[i], 1e-2);
+  }
+}
+
+}  // namespace
+
+TEST(PiecewiseJerkSolverSessionTest, keep_workspace) {
+  PiecewiseJerkSolverSession session;
+  for (int cycle = 0; cycle < 3; ++cycle) {
+    const double cruise_speed = 8.0 + cycle;
+    const std::array<double, 3> init_s = {0.0, 5.0 + cycle, 0.0};
+
+    PiecewiseJerkSpeedProblem reference(40, kDeltaT, init_s);
+    SetUpProblem(cruise_speed, &reference);
+    ASSERT_TRUE(reference.Optimize());
+
+    PiecewiseJerkSpeedProblem problem(40, kDeltaT, init_s);
+    SetUpProblem(cruise_speed, &problem);
+    problem.set_solver_session(&session);
+    ASSERT_TRUE(problem.Optimize());
+
+    ExpectNear(reference.opt_x(), problem.opt_x());
+    ExpectNear(reference.opt_dx(), problem.opt_dx());
+    ExpectNear(reference.opt_ddx(), problem.opt_ddx());
+  }
+  auto stats = session.TakeStats();
+  EXPECT_EQ(stats.setup_num, 1);
+  EXPECT_EQ(stats.update_num, 2);
+
+  // another number of knots is another sparsity
+  PiecewiseJerkSpeedProblem problem(50, kDeltaT, {0.0, 5.0, 0.0});
+  SetUpProblem(8.0, &problem);
+  problem.set_solver_session(&session);
+  ASSERT_TRUE(problem.Optimize());
+  stats = session.TakeStats();
+  EXPECT_EQ(stats.setup_num, 1);
+  EXPECT_EQ(stats.update_num, 0);
+}
+
+TEST(PiecewiseJerkSolverSessionTest, update_kernel) {
+  // the kernel changes every cycle, as it does with the path curvature
+  PiecewiseJerkSolverSession session;
+  const std::array<double, 3> init_s = {0.0, 5.0, 0.0};
+  for (int cycle = 0; cycle < 3; ++cycle) {
+    const std::vector<double> penalty_dx(40, 0.5 * cycle);
+
+    PiecewiseJerkSpeedProblem reference(40, kDeltaT, init_s);
+    SetUpProblem(8.0, &reference);
+    reference.set_penalty_dx(penalty_dx);
+    ASSERT_TRUE(reference.Optimize());
+
+    PiecewiseJerkSpeedProblem problem(40, kDeltaT, init_s);
+    SetUpProblem(8.0, &problem);
+    problem.set_penalty_dx(penalty_dx);
+    problem.set_solver_session(&session);
+    ASSERT_TRUE(problem.Optimize());
+
+    ExpectNear(reference.opt_x(), problem.opt_x());
+    ExpectNear(reference.opt_dx(), problem.opt_dx());
+    ExpectNear(reference.opt_ddx(), problem.opt_ddx());
+  }
+  auto stats = session.TakeStats();
+  EXPECT_EQ(stats.setup_num, 1);
+  EXPECT_EQ(stats.update_num, 2);
+}
+
+TEST(PiecewiseJerkSolverSessionTest, warm_start) {
+  const std::array<double, 3> init_s = {0.0, 5.0, 0.0};
+  PiecewiseJerkSpeedProblem reference(40, kDeltaT, init_s);
+  SetUpProblem(8.0, &reference);
+  ASSERT_TRUE(reference.Optimize());
+
+  PiecewiseJerkSolverSession session;
+  PiecewiseJerkSpeedProblem problem(40, kDeltaT, init_s);
+  SetUpProblem(8.0, &problem);
+  problem.set_solver_session(&session);
+  problem.set_warm_start(
+      {reference.opt_x(), reference.opt_dx(), reference.opt_ddx()});
+  ASSERT_TRUE(problem.Optimize());
+  ExpectNear(reference.opt_x(), problem.opt_x());
+
+  // a warm start of another size is ignored
+  PiecewiseJerkSpeedProblem other(30, kDeltaT, init_s);
+  SetUpProblem(8.0, &other);
+  other.set_solver_session(&session);
+  other.set_warm_start(
+      {reference.opt_x(), reference.opt_dx(), reference.opt_ddx()});
+  EXPECT_TRUE(other.Optimize());
+}
+
+}  // namespace planning
+}  // namespace apollo
@@ -23,6 +23,7 @@
 
 #include <algorithm>
 #include <limits>
+#include <sstream>
 #include <utility>
 
 #include "cyber/common/file.h"
@@ -55,6 +56,15 @@ using apollo::hdmap::LaneWaypoint;
 using apollo::hdmap::MapPathPoint;
 using apollo::hdmap::RouteSegments;
 
+std::string ReferenceLineProvider::SmoothingStats::DebugString() const {
+  std::ostringstream out;
+  out << "full " << full_num << ", stitched " << stitched_num
+      << ", incremental " << incremental_num
+      << ", reused " << reused_num << ", smoothed " << smoothed_length
+      << " m in " << smoothing_time_ms << " ms";
+  return out.str();
+}
+
 ReferenceLineProvider::~ReferenceLineProvider() {}
 
 ReferenceLineProvider::ReferenceLineProvider(
@@ -297,6 +307,12 @@ double ReferenceLineProvider::LastTimeDelay() {
   }
 }
 
+ReferenceLineProvider::SmoothingStats
+ReferenceLineProvider::LastSmoothingStats() {
+  std::lock_guard<std::mutex> lock(reference_lines_mutex_);
+  return last_smoothing_stats_;
+}
+
 bool ReferenceLineProvider::GetReferenceLines(
     std::list<ReferenceLine> *reference_lines,
     std::list<hdmap::RouteSegments> *segments) {
@@ -653,6 +669,7 @@ bool ReferenceLineProvider::CreateReferenceLine(
     AERROR << "Failed to create reference line from routing";
     return false;
   }
+  smoothing_stats_ = SmoothingStats();
   if (is_new_command_ || !FLAGS_enable_reference_line_stitching) {
     for (auto iter = segments->begin(); iter != segments->end();) {
       reference_lines->emplace_back();
@@ -674,7 +691,6 @@ bool ReferenceLineProvider::CreateReferenceLine(
       }
     }
     is_new_command_ = false;
-    return true;
   } else {  // stitching reference line
     for (auto iter = segments->begin(); iter != segments->end();) {
       reference_lines->emplace_back();
@@ -688,6 +704,17 @@ bool ReferenceLineProvider::CreateReferenceLine(
       }
     }
   }
+  if (FLAGS_enable_incremental_reference_line_smoothing) {
+    auto segment_iter = segments->begin();
+    for (const auto &reference_line : *reference_lines) {
+      smoothed_segment_cache_.Add(*segment_iter, reference_line);
+      ++segment_iter;
+    }
+  }
+  AINFO << "Planning Perf: reference line smoothing "
+        << smoothing_stats_.DebugString();
+  std::lock_guard<std::mutex> lock(reference_lines_mutex_);
+  last_smoothing_stats_ = smoothing_stats_;
   return true;
 }
 
@@ -729,6 +756,7 @@ bool ReferenceLineProvider::ExtendReferenceLine(const VehicleState &state,
     *segments = *prev_segment;
     segments->SetProperties(segment_properties);
     *reference_line = *prev_ref;
+    ++smoothing_stats_.reused_num;
     ADEBUG << "Reference line remain " << remain_s
            << ", which is more than required " << look_forward_required_distance
            << " and no need to extend";
@@ -752,12 +780,15 @@ bool ReferenceLineProvider::ExtendReferenceLine(const VehicleState &state,
     *segments = *prev_segment;
     segments->SetProperties(segment_properties);
     *reference_line = *prev_ref;
+    ++smoothing_stats_.reused_num;
     ADEBUG << "Could not further extend reference line";
     return true;
   }
   hdmap::Path path(shifted_segments);
   ReferenceLine new_ref(path);
-  if (!SmoothPrefixedReferenceLine(*prev_ref, new_ref, reference_line)) {
+  ++smoothing_stats_.stitched_num;
+  if (!SmoothPrefixedReferenceLine(*prev_ref, new_ref, false,
+                                   reference_line)) {
     AWARN << "Failed to smooth forward shifted reference line";
     return SmoothRouteSegment(*segments, reference_line);
   }
@@ -963,12 +994,73 @@ void ReferenceLineProvider::GetAnchorPoints(
 bool ReferenceLineProvider::SmoothRouteSegment(const RouteSegments &segments,
                                                ReferenceLine *reference_line) {
   hdmap::Path path(segments);
-  return SmoothReferenceLine(ReferenceLine(path), reference_line);
+  const ReferenceLine raw_reference_line(path);
+  if (FLAGS_enable_incremental_reference_line_smoothing &&
+      SmoothWithCachedPrefix(segments, raw_reference_line, reference_line)) {
+    return true;
+  }
+  return SmoothReferenceLine(raw_reference_line, reference_line);
+}
+
+bool ReferenceLineProvider::SmoothWithCachedPrefix(
+    const RouteSegments &segments, const ReferenceLine &raw_reference_line,
+    ReferenceLine *reference_line) {
+  if (!FLAGS_enable_smooth_reference_line ||
+      raw_reference_line.reference_points().empty()) {
+    return false;
+  }
+  double shared_length = 0.0;
+  const ReferenceLine *cached_line =
+      smoothed_segment_cache_.Find(segments, &shared_length);
+  // the rest is smoothed with an overlap on the prefix
+  if (cached_line == nullptr ||
+      shared_length < FLAGS_reference_line_stitch_overlap_distance) {
+    return false;
+  }
+
+  ReferenceLine prefix(*cached_line);
+  common::SLPoint start_sl;
+  if (!prefix.XYToSL(raw_reference_line.reference_points().front(),
+                     &start_sl)) {
+    return false;
+  }
+  const double raw_length = raw_reference_line.Length();
+  static constexpr double kLengthEpsilon = 1e-3;
+  if (shared_length > raw_length - kLengthEpsilon) {
+    if (!prefix.Segment(start_sl.s(), 0.0, raw_length)) {
+      return false;
+    }
+    *reference_line = prefix;
+    ++smoothing_stats_.reused_num;
+    ADEBUG << "Reuse " << raw_length << " m of a cached reference line";
+    return true;
+  }
+  if (!prefix.Segment(start_sl.s(), 0.0, shared_length)) {
+    return false;
+  }
+  const double rest_start_s =
+      shared_length - FLAGS_reference_line_stitch_overlap_distance;
+  ReferenceLine rest(raw_reference_line);
+  if (!rest.Segment(rest_start_s, 0.0, raw_length - rest_start_s)) {
+    return false;
+  }
+  ++smoothing_stats_.incremental_num;
+  if (!SmoothPrefixedReferenceLine(prefix, rest, true, reference_line)) {
+    AWARN << "Failed to smooth the rest of a cached reference line";
+    return false;
+  }
+  if (!reference_line->Stitch(prefix)) {
+    AWARN << "Failed to stitch the rest to a cached reference line";
+    return false;
+  }
+  ADEBUG << "Reuse " << shared_length << " m of a cached reference line, "
+         << "smooth " << raw_length - rest_start_s << " m";
+  return true;
 }
 
 bool ReferenceLineProvider::SmoothPrefixedReferenceLine(
     const ReferenceLine &prefix_ref, const ReferenceLine &raw_ref,
-    ReferenceLine *reference_line) {
+    const bool keep_overlap, ReferenceLine *reference_line) {
   if (!FLAGS_enable_smooth_reference_line) {
     *reference_line = raw_ref;
     return true;
@@ -976,7 +1068,10 @@ bool ReferenceLineProvider::SmoothPrefixedReferenceLine(
   // generate anchor points:
   std::vector<AnchorPoint> anchor_points;
   GetAnchorPoints(raw_ref, &anchor_points);
-  // modify anchor points based on prefix_ref
+  // modify anchor points based on prefix_ref: the first anchor on it joins
+  // the lines, with keep_overlap the later ones on it are kept close
+  static constexpr double kOverlapAnchorBound = 0.05;
+  bool is_joined = false;
   for (auto &point : anchor_points) {
     common::SLPoint sl_point;
     if (!prefix_ref.XYToSL(point.path_point, &sl_point)) {
@@ -990,14 +1085,28 @@ bool ReferenceLineProvider::SmoothPrefixedReferenceLine(
     point.path_point.set_y(prefix_ref_point.y());
     point.path_point.set_z(0.0);
     point.path_point.set_theta(prefix_ref_point.heading());
+    if (is_joined) {
+      // keep the heading and curvature of the prefix over the overlap
+      point.longitudinal_bound = kOverlapAnchorBound;
+      point.lateral_bound = kOverlapAnchorBound;
+      continue;
+    }
     point.longitudinal_bound = 1e-6;
     point.lateral_bound = 1e-6;
     point.enforced = true;
-    break;
+    if (!keep_overlap) {
+      break;
+    }
+    is_joined = true;
   }
 
   smoother_->SetAnchorPoints(anchor_points);
-  if (!smoother_->Smooth(raw_ref, reference_line)) {
+  const double start_time = Clock::NowInSeconds();
+  const bool smoothed = smoother_->Smooth(raw_ref, reference_line);
+  smoothing_stats_.smoothed_length += raw_ref.Length();
+  smoothing_stats_.smoothing_time_ms +=
+      (Clock::NowInSeconds() - start_time) * 1000.0;
+  if (!smoothed) {
     AERROR << "Failed to smooth prefixed reference line with anchor points";
     return false;
   }
@@ -1018,7 +1127,13 @@ bool ReferenceLineProvider::SmoothReferenceLine(
   std::vector<AnchorPoint> anchor_points;
   GetAnchorPoints(raw_reference_line, &anchor_points);
   smoother_->SetAnchorPoints(anchor_points);
-  if (!smoother_->Smooth(raw_reference_line, reference_line)) {
+  const double start_time = Clock::NowInSeconds();
+  const bool smoothed = smoother_->Smooth(raw_reference_line, reference_line);
+  ++smoothing_stats_.full_num;
+  smoothing_stats_.smoothed_length += raw_reference_line.Length();
+  smoothing_stats_.smoothing_time_ms +=
+      (Clock::NowInSeconds() - start_time) * 1000.0;
+  if (!smoothed) {
     AERROR << "Failed to smooth reference line with anchor points";
     return false;
   }
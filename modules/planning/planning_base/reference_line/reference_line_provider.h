@@ -44,6 +44,7 @@
 #include "modules/planning/planning_base/reference_line/discrete_points_reference_line_smoother.h"
 #include "modules/planning/planning_base/reference_line/qp_spline_reference_line_smoother.h"
 #include "modules/planning/planning_base/reference_line/reference_line.h"
+#include "modules/planning/planning_base/reference_line/smoothed_segment_cache.h"
 #include "modules/planning/planning_base/reference_line/spiral_reference_line_smoother.h"
 
 /**
@@ -60,6 +61,25 @@ namespace planning {
  */
 class ReferenceLineProvider {
  public:
+  /**
+   * @brief Smoothing work of one reference line cycle.
+   */
+  struct SmoothingStats {
+    // lines smoothed over their whole length
+    int full_num = 0;
+    // lines extended from the previous reference line by stitching
+    int stitched_num = 0;
+    // lines of which a smoothed prefix of a cached line is kept and the rest
+    // is smoothed
+    int incremental_num = 0;
+    // lines taken from smoothed lines without smoothing
+    int reused_num = 0;
+    double smoothed_length = 0.0;
+    double smoothing_time_ms = 0.0;
+
+    std::string DebugString() const;
+  };
+
   ReferenceLineProvider() = default;
 
   ReferenceLineProvider(
@@ -92,6 +112,8 @@ class ReferenceLineProvider {
 
   double LastTimeDelay();
 
+  SmoothingStats LastSmoothingStats();
+
   std::vector<routing::LaneWaypoint> FutureRouteWaypoints();
 
   bool UpdatedReferenceLine() { return is_reference_line_updated_.load(); }
@@ -136,8 +158,13 @@ class ReferenceLineProvider {
   bool SmoothReferenceLine(const ReferenceLine& raw_reference_line,
                            ReferenceLine* reference_line);
 
+  /**
+   * @brief Smooth raw_ref joined to prefix_ref at the first anchor on it. With
+   * keep_overlap, the later anchors on prefix_ref are kept close to it too.
+   */
   bool SmoothPrefixedReferenceLine(const ReferenceLine& prefix_ref,
                                    const ReferenceLine& raw_ref,
+                                   const bool keep_overlap,
                                    ReferenceLine* reference_line);
 
   void GetAnchorPoints(const ReferenceLine& reference_line,
@@ -146,6 +173,16 @@ class ReferenceLineProvider {
   bool SmoothRouteSegment(const hdmap::RouteSegments& segments,
                           ReferenceLine* reference_line);
 
+  /**
+   * @brief Take the smoothed lanes the segments share with a cached line and
+   * smooth the rest only.
+   * @return false if no cached line covers the start of segments or smoothing
+   * the rest fails.
+   */
+  bool SmoothWithCachedPrefix(const hdmap::RouteSegments& segments,
+                              const ReferenceLine& raw_reference_line,
+                              ReferenceLine* reference_line);
+
   /**
    * @brief This function creates a smoothed forward reference line
    * based on the given segments.
@@ -174,11 +211,18 @@ class ReferenceLineProvider {
               hdmap::RouteSegments* segments);
 
  private:
+  // a passage, its neighbors and the lines of a recent reroute
+  static constexpr size_t kSmoothedSegmentCacheSize = 8;
+
   bool is_initialized_ = false;
   std::atomic<bool> is_stop_{false};
 
   std::unique_ptr<ReferenceLineSmoother> smoother_;
   ReferenceLineSmootherConfig smoother_config_;
+  // smoothed lines of the recent cycles, by their lane segments
+  SmoothedSegmentCache smoothed_segment_cache_{kSmoothedSegmentCacheSize};
+  // of the cycle in progress
+  SmoothingStats smoothing_stats_;
 
   std::mutex pnc_map_mutex_;
   // The loaded pnc map plugin which can create referene line from
@@ -201,6 +245,7 @@ class ReferenceLineProvider {
   std::list<ReferenceLine> reference_lines_;
   std::list<hdmap::RouteSegments> route_segments_;
   double last_calculation_time_ = 0.0;
+  SmoothingStats last_smoothing_stats_;
 
   std::queue<std::list<ReferenceLine>> reference_line_history_;
   std::queue<std::list<hdmap::RouteSegments>> route_segments_history_;
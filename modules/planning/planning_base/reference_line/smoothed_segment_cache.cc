@@ -0,0 +1,115 @@
+/******************************************************************************
+ * Copyright 2024 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ **/
+
+#include "modules/planning/planning_base/reference_line/smoothed_segment_cache.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace apollo {
+namespace planning {
+
+using apollo::hdmap::RouteSegments;
+
+namespace {
+// lane s of the same map point in two route segments
+constexpr double kSEpsilon = 1e-3;
+}  // namespace
+
+double SmoothedSegmentCache::SharedLength(const RouteSegments& cached,
+                                          const RouteSegments& segments) {
+  if (cached.empty() || segments.empty()) {
+    return 0.0;
+  }
+  // the lane segment of cached on which segments starts
+  const auto& first = segments.front();
+  size_t offset = 0;
+  while (offset < cached.size() &&
+         (cached[offset].lane->id().id() != first.lane->id().id() ||
+          cached[offset].start_s > first.start_s + kSEpsilon ||
+          cached[offset].end_s < first.start_s + kSEpsilon)) {
+    ++offset;
+  }
+  double shared_length = 0.0;
+  for (size_t i = 0; i < segments.size() && offset + i < cached.size(); ++i) {
+    const auto& segment = segments[i];
+    const auto& cached_segment = cached[offset + i];
+    if (segment.lane->id().id() != cached_segment.lane->id().id() ||
+        (i > 0 &&
+         std::fabs(segment.start_s - cached_segment.start_s) > kSEpsilon)) {
+      break;
+    }
+    shared_length +=
+        std::min(segment.end_s, cached_segment.end_s) - segment.start_s;
+    // one of them leaves the lane before the other
+    if (std::fabs(segment.end_s - cached_segment.end_s) > kSEpsilon) {
+      break;
+    }
+  }
+  return std::max(shared_length, 0.0);
+}
+
+void SmoothedSegmentCache::Add(const RouteSegments& segments,
+                               const ReferenceLine& reference_line) {
+  if (capacity_ == 0 || segments.empty() ||
+      reference_line.reference_points().empty()) {
+    return;
+  }
+  entries_.erase(std::remove_if(entries_.begin(), entries_.end(),
+                                [&segments](const Entry& entry) {
+                                  return SharedLength(entry.segments,
+                                                      segments) > 0.0 ||
+                                         SharedLength(segments,
+                                                      entry.segments) > 0.0;
+                                }),
+                 entries_.end());
+  if (entries_.size() >= capacity_) {
+    entries_.erase(std::min_element(entries_.begin(), entries_.end(),
+                                    [](const Entry& a, const Entry& b) {
+                                      return a.last_used < b.last_used;
+                                    }));
+  }
+  entries_.emplace_back();
+  entries_.back().segments = segments;
+  entries_.back().reference_line = reference_line;
+  entries_.back().last_used = ++use_count_;
+}
+
+const ReferenceLine* SmoothedSegmentCache::Find(const RouteSegments& segments,
+                                                double* shared_length) {
+  Entry* best_entry = nullptr;
+  double best_length = 0.0;
+  for (auto& entry : entries_) {
+    const double length = SharedLength(entry.segments, segments);
+    if (length > best_length) {
+      best_length = length;
+      best_entry = &entry;
+    }
+  }
+  *shared_length = best_length;
+  if (best_entry == nullptr) {
+    return nullptr;
+  }
+  best_entry->last_used = ++use_count_;
+  return &best_entry->reference_line;
+}
+
+}  // namespace planning
+}  // namespace apollo
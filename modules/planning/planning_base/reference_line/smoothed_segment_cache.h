@@ -0,0 +1,85 @@
+/******************************************************************************
+ * Copyright 2024 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ **/
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "modules/map/pnc_map/route_segments.h"
+#include "modules/planning/planning_base/reference_line/reference_line.h"
+
+namespace apollo {
+namespace planning {
+
+/**
+ * @class SmoothedSegmentCache
+ * @brief Smoothed reference lines of the last cycles, keyed by the lane
+ * segments (lane id and s range) they were smoothed from. A new route segment
+ * that starts on the lanes of a cached line can take the smoothed points of
+ * the lanes they share instead of smoothing them again.
+ */
+class SmoothedSegmentCache {
+ public:
+  explicit SmoothedSegmentCache(const size_t capacity) : capacity_(capacity) {}
+
+  /**
+   * @brief Keep the smoothed reference line of segments. It replaces the
+   * cached lines it overlaps, so there is one line per passage, and the
+   * least recently used line is dropped when the cache is full.
+   */
+  void Add(const hdmap::RouteSegments& segments,
+           const ReferenceLine& reference_line);
+
+  /**
+   * @brief Find the cached line sharing the longest stretch of lanes with the
+   * start of segments.
+   * @param shared_length The length of that stretch from the start of
+   * segments.
+   * @return nullptr if no cached line covers the start of segments.
+   */
+  const ReferenceLine* Find(const hdmap::RouteSegments& segments,
+                            double* shared_length);
+
+  void Clear() { entries_.clear(); }
+
+  size_t size() const { return entries_.size(); }
+
+  /**
+   * @brief The length from the start of segments on which cached runs on the
+   * same lanes, 0 if segments does not start on cached.
+   */
+  static double SharedLength(const hdmap::RouteSegments& cached,
+                             const hdmap::RouteSegments& segments);
+
+ private:
+  struct Entry {
+    hdmap::RouteSegments segments;
+    ReferenceLine reference_line;
+    uint64_t last_used = 0;
+  };
+
+  size_t capacity_ = 0;
+  uint64_t use_count_ = 0;
+  std::vector<Entry> entries_;
+};
+
+}  // namespace planning
+}  // namespace apollo
@@ -0,0 +1,159 @@
+/******************************************************************************
+ * Copyright 2024 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ **/
+
+#include "modules/planning/planning_base/reference_line/smoothed_segment_cache.h"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace planning {
+
+using apollo::hdmap::LaneInfo;
+using apollo::hdmap::LaneInfoConstPtr;
+using apollo::hdmap::LaneSegment;
+using apollo::hdmap::LaneWaypoint;
+using apollo::hdmap::MapPathPoint;
+using apollo::hdmap::RouteSegments;
+
+namespace {
+
+// a straight lane of 100m along x, starting at start_x. LaneInfo refers to
+// the lane, which has to outlive it.
+LaneInfoConstPtr MakeLane(const std::string& id, const double start_x,
+                          const double y, hdmap::Lane* lane) {
+  lane->mutable_id()->set_id(id);
+  auto* line_segment =
+      lane->mutable_central_curve()->add_segment()->mutable_line_segment();
+  auto* start = line_segment->add_point();
+  start->set_x(start_x);
+  start->set_y(y);
+  auto* end = line_segment->add_point();
+  end->set_x(start_x + 100.0);
+  end->set_y(y);
+  lane->set_length(100.0);
+  lane->set_type(hdmap::Lane::CITY_DRIVING);
+  return LaneInfoConstPtr(new LaneInfo(*lane));
+}
+
+}  // namespace
+
+class SmoothedSegmentCacheTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    lane_a_ = MakeLane("a", 0.0, 0.0, &lanes_[0]);
+    lane_b_ = MakeLane("b", 100.0, 0.0, &lanes_[1]);
+    lane_c_ = MakeLane("c", 200.0, 0.0, &lanes_[2]);
+    lane_d_ = MakeLane("d", 0.0, 3.5, &lanes_[3]);
+  }
+
+  // a line along lanes a, b and c, or along lane d next to them
+  ReferenceLine MakeReferenceLine(const double start_x, const double end_x,
+                                  const bool on_neighbor) const {
+    std::vector<ReferencePoint> points;
+    for (double x = start_x; x <= end_x; x += 1.0) {
+      const int lane_index = std::min(static_cast<int>(x / 100.0), 2);
+      const LaneInfoConstPtr lane =
+          on_neighbor ? lane_d_
+                      : std::vector<LaneInfoConstPtr>{lane_a_, lane_b_,
+                                                      lane_c_}[lane_index];
+      const double y = on_neighbor ? 3.5 : 0.0;
+      const double s = on_neighbor ? x : x - 100.0 * lane_index;
+      points.emplace_back(MapPathPoint({x, y}, 0.0, LaneWaypoint(lane, s)),
+                          0.0, 0.0);
+    }
+    return ReferenceLine(points);
+  }
+
+ protected:
+  hdmap::Lane lanes_[4];
+  LaneInfoConstPtr lane_a_;
+  LaneInfoConstPtr lane_b_;
+  LaneInfoConstPtr lane_c_;
+  LaneInfoConstPtr lane_d_;
+};
+
+TEST_F(SmoothedSegmentCacheTest, SharedLength) {
+  RouteSegments cached;
+  cached.emplace_back(lane_a_, 10.0, 100.0);
+  cached.emplace_back(lane_b_, 0.0, 100.0);
+
+  RouteSegments extended;
+  extended.emplace_back(lane_a_, 20.0, 100.0);
+  extended.emplace_back(lane_b_, 0.0, 100.0);
+  extended.emplace_back(lane_c_, 0.0, 50.0);
+  EXPECT_DOUBLE_EQ(180.0, SmoothedSegmentCache::SharedLength(cached, extended));
+
+  RouteSegments shorter;
+  shorter.emplace_back(lane_b_, 30.0, 60.0);
+  EXPECT_DOUBLE_EQ(30.0, SmoothedSegmentCache::SharedLength(cached, shorter));
+
+  // starts before the cached line
+  RouteSegments earlier;
+  earlier.emplace_back(lane_a_, 0.0, 100.0);
+  EXPECT_DOUBLE_EQ(0.0, SmoothedSegmentCache::SharedLength(cached, earlier));
+
+  RouteSegments neighbor;
+  neighbor.emplace_back(lane_d_, 20.0, 100.0);
+  EXPECT_DOUBLE_EQ(0.0, SmoothedSegmentCache::SharedLength(cached, neighbor));
+}
+
+TEST_F(SmoothedSegmentCacheTest, AddAndFind) {
+  SmoothedSegmentCache cache(2);
+  RouteSegments passage;
+  passage.emplace_back(lane_a_, 0.0, 100.0);
+  cache.Add(passage, MakeReferenceLine(0.0, 100.0, false));
+
+  // the passage further on replaces the line it overlaps
+  RouteSegments moved_passage;
+  moved_passage.emplace_back(lane_a_, 20.0, 100.0);
+  moved_passage.emplace_back(lane_b_, 0.0, 50.0);
+  cache.Add(moved_passage, MakeReferenceLine(20.0, 150.0, false));
+  EXPECT_EQ(1U, cache.size());
+
+  RouteSegments neighbor;
+  neighbor.emplace_back(lane_d_, 0.0, 100.0);
+  cache.Add(neighbor, MakeReferenceLine(0.0, 100.0, true));
+  EXPECT_EQ(2U, cache.size());
+
+  RouteSegments query;
+  query.emplace_back(lane_a_, 40.0, 100.0);
+  query.emplace_back(lane_b_, 0.0, 100.0);
+  double shared_length = 0.0;
+  const ReferenceLine* line = cache.Find(query, &shared_length);
+  ASSERT_NE(nullptr, line);
+  EXPECT_DOUBLE_EQ(110.0, shared_length);
+  EXPECT_DOUBLE_EQ(130.0, line->Length());
+
+  // the neighbor line is used the least recently and dropped
+  RouteSegments other;
+  other.emplace_back(lane_c_, 0.0, 100.0);
+  cache.Add(other, MakeReferenceLine(200.0, 300.0, false));
+  EXPECT_EQ(2U, cache.size());
+  EXPECT_EQ(nullptr, cache.Find(neighbor, &shared_length));
+  EXPECT_DOUBLE_EQ(0.0, shared_length);
+  EXPECT_NE(nullptr, cache.Find(query, &shared_length));
+}
+
+}  // namespace planning
+}  // namespace apollo
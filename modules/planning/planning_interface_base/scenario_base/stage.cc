@@ -53,7 +53,13 @@ bool Stage::Init(const StagePipeline& config,
       ->mutable_scenario()
       ->set_stage_type(name_);
   std::string path_name = ConfigUtil::TransformToPathName(name_);
-  std::string task_config_dir = config_dir + "/" + path_name;
+  task_config_dir_ = config_dir + "/" + path_name;
+  return CreateTasks(injector, &task_list_, &fallback_task_);
+}
+
+bool Stage::CreateTasks(const std::shared_ptr<DependencyInjector>& injector,
+                        std::vector<std::shared_ptr<Task>>* task_list,
+                        std::shared_ptr<Task>* fallback_task) const {
   // Load task plugin.
   for (int i = 0; i < pipeline_config_.task_size(); ++i) {
     auto task = pipeline_config_.task(i);
@@ -65,8 +71,8 @@ bool Stage::Init(const StagePipeline& config,
       AERROR << "Create task " << task.name() << " of " << name_ << " failed!";
       return false;
     }
-    if (task_ptr->Init(task_config_dir, task.name(), injector)) {
-      task_list_.push_back(task_ptr);
+    if (task_ptr->Init(task_config_dir_, task.name(), injector)) {
+      task_list->push_back(task_ptr);
     } else {
       AERROR << task.name() << " init failed!";
       return false;
@@ -80,16 +86,16 @@ bool Stage::Init(const StagePipeline& config,
     fallback_task_type = pipeline_config_.fallback_task().type();
     fallback_task_name = pipeline_config_.fallback_task().name();
   }
-  fallback_task_ =
+  *fallback_task =
       apollo::cyber::plugin_manager::PluginManager::Instance()
           ->CreateInstance<Task>(
               ConfigUtil::GetFullPlanningClassName(fallback_task_type));
-  if (nullptr == fallback_task_) {
+  if (nullptr == *fallback_task) {
     AERROR << "Create fallback task " << fallback_task_name << " of " << name_
            << " failed!";
     return false;
   }
-  if (!fallback_task_->Init(task_config_dir, fallback_task_name, injector)) {
+  if (!(*fallback_task)->Init(task_config_dir_, fallback_task_name, injector)) {
     AERROR << fallback_task_name << " init failed!";
     return false;
   }
@@ -81,6 +81,13 @@ class Stage {
 
   virtual StageResult FinishScenario();
 
+  /**
+   * @brief Create and init the tasks of the stage pipeline with injector.
+   */
+  bool CreateTasks(const std::shared_ptr<DependencyInjector>& injector,
+                   std::vector<std::shared_ptr<Task>>* task_list,
+                   std::shared_ptr<Task>* fallback_task) const;
+
   void RecordDebugInfo(ReferenceLineInfo* reference_line_info,
                        const std::string& name, const double time_diff_ms);
 
@@ -90,6 +97,7 @@ class Stage {
   void* context_;
   std::shared_ptr<DependencyInjector> injector_;
   StagePipeline pipeline_config_;
+  std::string task_config_dir_;
 
  private:
   std::string name_;
@@ -24,6 +24,7 @@
 #include <vector>
 
 #include "modules/common/configs/vehicle_config_helper.h"
+#include "modules/planning/planning_interface_base/task_base/common/path_util/path_optimizer_util.h"
 
 namespace apollo {
 namespace planning {
@@ -31,7 +32,13 @@ namespace planning {
 apollo::common::Status PathGeneration::Execute(
     Frame* frame, ReferenceLineInfo* reference_line_info) {
   Task::Execute(frame, reference_line_info);
-  return Process(frame, reference_line_info);
+  auto status = Process(frame, reference_line_info);
+  const auto stats = solver_session_.TakeStats();
+  if (stats.setup_num + stats.update_num > 0) {
+    AINFO << "Planning Perf: task name [" << Name() << "], osqp "
+          << stats.DebugString();
+  }
+  return status;
 }
 
 apollo::common::Status PathGeneration::Execute(Frame* frame) {
@@ -131,6 +138,19 @@ void PathGeneration::GetStartPointSLState() {
   init_sl_state_ = reference_line.ToFrenetFrame(planning_start_point);
 }
 
+PiecewiseJerkWarmStart PathGeneration::StitchPreviousPath(
+    const PathBoundary& path_boundary) const {
+  PiecewiseJerkWarmStart warm_start;
+  const Frame* last_frame = injector_->frame_history()->Latest();
+  if (last_frame == nullptr ||
+      !PathOptimizerUtil::StitchPath(last_frame->current_frame_planned_path(),
+                                     reference_line_info_->reference_line(),
+                                     path_boundary, &warm_start)) {
+    return PiecewiseJerkWarmStart();
+  }
+  return warm_start;
+}
+
 bool PathGeneration::GetSLBoundary(const PathData& path_data, int point_index,
                                    const ReferenceLineInfo* reference_line_info,
                                    SLBoundary* const sl_boundary) {
@@ -22,6 +22,7 @@
 #include "modules/common/status/status.h"
 #include "modules/planning/planning_base/common/frame.h"
 #include "modules/planning/planning_base/common/path_boundary.h"
+#include "modules/planning/planning_base/math/piecewise_jerk/piecewise_jerk_problem.h"
 #include "modules/planning/planning_interface_base/task_base/common/path_util/path_bounds_decider_util.h"
 #include "modules/planning/planning_interface_base/task_base/task.h"
 
@@ -78,7 +79,16 @@ class PathGeneration : public Task {
                      const ReferenceLineInfo* reference_line_info,
                      SLBoundary* const sl_boundary);
 
+  /**
+   * @brief stitch the path planned in the last frame to path_boundary as a
+   * warm start of the path optimizer, empty if there is none
+   */
+  PiecewiseJerkWarmStart StitchPreviousPath(
+      const PathBoundary& path_boundary) const;
+
   SLState init_sl_state_;
+  // osqp workspaces of the path problems, kept from frame to frame
+  PiecewiseJerkSolverSession solver_session_;
 };
 
 }  // namespace planning
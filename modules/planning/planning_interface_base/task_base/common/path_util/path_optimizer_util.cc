@@ -16,10 +16,12 @@
 
 #include "modules/planning/planning_interface_base/task_base/common/path_util/path_optimizer_util.h"
 
+#include <algorithm>
 #include <utility>
 #include <vector>
 
 #include "modules/common/configs/vehicle_config_helper.h"
+#include "modules/common/math/linear_interpolation.h"
 #include "modules/common/math/math_utils.h"
 #include "modules/planning/planning_base/common/speed/speed_data.h"
 #include "modules/planning/planning_base/common/trajectory1d/piecewise_jerk_trajectory1d.h"
@@ -99,7 +101,9 @@ bool PathOptimizerUtil::OptimizePath(
     const PathBoundary& path_boundary,
     const std::vector<std::pair<double, double>>& ddl_bounds, double dddl_bound,
     const PiecewiseJerkPathConfig& config, std::vector<double>* x,
-    std::vector<double>* dx, std::vector<double>* ddx) {
+    std::vector<double>* dx, std::vector<double>* ddx,
+    PiecewiseJerkSolverSession* solver_session,
+    const PiecewiseJerkWarmStart* warm_start) {
   // num of knots
   const auto& lat_boundaries = path_boundary.boundary();
   const size_t kNumKnots = lat_boundaries.size();
@@ -184,6 +188,10 @@ bool PathOptimizerUtil::OptimizePath(
   piecewise_jerk_problem.set_ddx_bounds(ddl_bounds);
 
   piecewise_jerk_problem.set_dddx_bound(dddl_bound);
+  piecewise_jerk_problem.set_solver_session(solver_session);
+  if (warm_start != nullptr) {
+    piecewise_jerk_problem.set_warm_start(*warm_start);
+  }
 
   bool success = piecewise_jerk_problem.Optimize(config.max_iteration());
 
@@ -336,6 +344,66 @@ bool PathOptimizerUtil::OptimizePathWithTowingPoints(
   return true;
 }
 
+bool PathOptimizerUtil::StitchPath(const DiscretizedPath& path,
+                                   const ReferenceLine& reference_line,
+                                   const PathBoundary& path_boundary,
+                                   PiecewiseJerkWarmStart* warm_start) {
+  const size_t num_of_knots = path_boundary.boundary().size();
+  const double delta_s = path_boundary.delta_s();
+  if (path.size() < 2 || num_of_knots < 2 || delta_s <= 0.0) {
+    return false;
+  }
+  // project the path onto the reference line, each point from the s of the
+  // one before
+  std::vector<double> path_s;
+  std::vector<double> path_l;
+  double warm_start_s = -1.0;
+  for (const auto& path_point : path) {
+    common::SLPoint sl_point;
+    if (!reference_line.XYToSL(
+            common::math::Vec2d(path_point.x(), path_point.y()), &sl_point,
+            warm_start_s)) {
+      continue;
+    }
+    warm_start_s = sl_point.s();
+    if (!path_s.empty() && sl_point.s() <= path_s.back()) {
+      continue;
+    }
+    path_s.push_back(sl_point.s());
+    path_l.push_back(sl_point.l());
+  }
+  if (path_s.size() < 2 || path_s.front() > path_boundary.start_s() + delta_s ||
+      path_s.back() < path_boundary.start_s()) {
+    return false;
+  }
+
+  // knots beyond the path keep the l of its end
+  auto& x = warm_start->x;
+  x.resize(num_of_knots);
+  for (size_t i = 0; i < num_of_knots; ++i) {
+    const double s =
+        common::math::Clamp(path_boundary.start_s() + i * delta_s,
+                            path_s.front(), path_s.back());
+    size_t index = std::upper_bound(path_s.begin(), path_s.end(), s) -
+                   path_s.begin();
+    index = std::min(std::max(index, size_t(1)), path_s.size() - 1);
+    x[i] = common::math::lerp(path_l[index - 1], path_s[index - 1],
+                              path_l[index], path_s[index], s);
+  }
+  auto differentiate = [num_of_knots, delta_s](const std::vector<double>& f,
+                                               std::vector<double>* df) {
+    df->resize(num_of_knots);
+    for (size_t i = 0; i < num_of_knots; ++i) {
+      const size_t prev = i == 0 ? 0 : i - 1;
+      const size_t next = std::min(i + 1, num_of_knots - 1);
+      (*df)[i] = (f[next] - f[prev]) / ((next - prev) * delta_s);
+    }
+  };
+  differentiate(x, &warm_start->dx);
+  differentiate(warm_start->dx, &warm_start->ddx);
+  return true;
+}
+
 void PathOptimizerUtil::UpdatePathRefWithBound(
     const PathBoundary& path_boundary, double weight,
     std::vector<double>* ref_l, std::vector<double>* weight_ref_l) {
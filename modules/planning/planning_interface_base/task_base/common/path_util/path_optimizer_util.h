@@ -21,6 +21,7 @@
 
 #include "modules/planning/planning_base/common/path/path_data.h"
 #include "modules/planning/planning_base/common/path_boundary.h"
+#include "modules/planning/planning_base/math/piecewise_jerk/piecewise_jerk_problem.h"
 
 namespace apollo {
 namespace planning {
@@ -48,7 +49,8 @@ class PathOptimizerUtil {
       PathBound extra_path_bound, const PathBoundary& path_boundary,
       ObsCornerConstraints* extra_constraints);
   /**
-   * @brief Piecewise jerk path optimizer.
+   * @brief Piecewise jerk path optimizer. The problem is solved in the
+   * workspaces of solver_session and started from warm_start if they are set.
    */
   static bool OptimizePath(
       const SLState& init_state, const std::array<double, 3>& end_state,
@@ -57,7 +59,9 @@ class PathOptimizerUtil {
       const std::vector<std::pair<double, double>>& ddl_bounds,
       double dddl_bound, const PiecewiseJerkPathConfig& config,
       std::vector<double>* x, std::vector<double>* dx,
-      std::vector<double>* ddx);
+      std::vector<double>* ddx,
+      PiecewiseJerkSolverSession* solver_session = nullptr,
+      const PiecewiseJerkWarmStart* warm_start = nullptr);
 
   static bool OptimizePathWithTowingPoints(
       const SLState& init_state, const std::array<double, 3>& end_state,
@@ -69,6 +73,16 @@ class PathOptimizerUtil {
       std::vector<double>* x, std::vector<double>* dx,
       std::vector<double>* ddx);
 
+  /**
+   * @brief Stitch the path planned in the last cycle to the knots of
+   * path_boundary as a warm start of the path optimizer.
+   * @return false if the path does not cover the start of the boundary.
+   */
+  static bool StitchPath(const DiscretizedPath& path,
+                         const ReferenceLine& reference_line,
+                         const PathBoundary& path_boundary,
+                         PiecewiseJerkWarmStart* warm_start);
+
   /**
    * @brief If ref_l is below or above path boundary, will update its values and
    * weights
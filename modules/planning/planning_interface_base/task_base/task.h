@@ -50,6 +50,14 @@ class Task {
 
   virtual common::Status Execute(Frame* frame);
 
+  /**
+   * @brief Whether Execute only touches the reference line it is given and
+   * keeps its state across cycles in the planning status, so pipelines of the
+   * task may plan different reference lines at the same time. Tasks opt in
+   * once they are audited.
+   */
+  virtual bool IsReferenceLineLocal() const { return false; }
+
  protected:
   template <typename T>
   bool LoadConfig(T* config);
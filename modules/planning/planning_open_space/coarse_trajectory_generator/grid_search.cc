@@ -20,6 +20,9 @@
 
 #include "modules/planning/planning_open_space/coarse_trajectory_generator/grid_search.h"
 
+#include <algorithm>
+#include <cmath>
+
 namespace apollo {
 namespace planning {
 
@@ -37,71 +40,57 @@ double GridSearch::EuclidDistance(
   return std::sqrt((x1 - x2) * (x1 - x2) + (y1 - y2) * (y1 - y2));
 }
 
-bool GridSearch::CheckConstraints(std::shared_ptr<Node2d> node) {
-  const double node_grid_x = node->GetGridX();
-  const double node_grid_y = node->GetGridY();
+bool GridSearch::CheckConstraints(const Node2d& node) {
+  const double node_grid_x = node.GetGridX();
+  const double node_grid_y = node.GetGridY();
   if (node_grid_x > max_grid_x_ ||
       node_grid_x < 0  ||
       node_grid_y > max_grid_y_ ||
       node_grid_y < 0) {
     return false;
   }
-  if (obstacles_linesegments_vec_.empty()) {
-    return true;
-  }
-  for (const auto& obstacle_linesegments : obstacles_linesegments_vec_) {
-    for (const common::math::LineSegment2d& linesegment :
-         obstacle_linesegments) {
-      if (linesegment.DistanceTo({node->GetGridX(), node->GetGridY()})
-          < node_radius_) {
-        return false;
-      }
+  return !obstacle_grid_.HasObjectWithin({node.GetGridX(), node.GetGridY()},
+                                         node_radius_);
+}
+
+void GridSearch::SetObstacles(
+    const std::vector<std::vector<common::math::LineSegment2d>>&
+        obstacles_linesegments_vec) {
+  obstacle_grid_.Clear();
+  for (const auto& obstacle_linesegments : obstacles_linesegments_vec) {
+    for (const auto& linesegment : obstacle_linesegments) {
+      obstacle_grid_.AddLineSegment(linesegment);
     }
   }
-  return true;
+  // a query covers a square of twice the node radius
+  obstacle_grid_.Build(std::max(2.0 * node_radius_, 1.0));
+}
+
+void GridSearch::GenerateNextNodes(const Node2d& current_node,
+                                   std::vector<Node2d>* next_nodes) {
+  // up, up right, right, down right, down, down left, left, up left
+  static constexpr int kNeighborNum = 8;
+  static constexpr int kDx[kNeighborNum] = {0, 1, 1, 1, 0, -1, -1, -1};
+  static constexpr int kDy[kNeighborNum] = {1, 1, 0, -1, -1, -1, 0, 1};
+  const int current_node_x = static_cast<int>(current_node.GetGridX());
+  const int current_node_y = static_cast<int>(current_node.GetGridY());
+  const double current_node_path_cost = current_node.GetPathCost();
+  const double diagonal_distance = std::sqrt(2.0);
+  next_nodes->clear();
+  for (int i = 0; i < kNeighborNum; ++i) {
+    next_nodes->emplace_back(current_node_x + kDx[i],
+                             current_node_y + kDy[i], XYbounds_);
+    next_nodes->back().SetPathCost(
+        current_node_path_cost +
+        (kDx[i] != 0 && kDy[i] != 0 ? diagonal_distance : 1.0));
+  }
 }
 
-std::vector<std::shared_ptr<Node2d>> GridSearch::GenerateNextNodes(
-    std::shared_ptr<Node2d> current_node) {
-  double current_node_x = current_node->GetGridX();
-  double current_node_y = current_node->GetGridY();
-  double current_node_path_cost = current_node->GetPathCost();
-  double diagonal_distance = std::sqrt(2.0);
-  std::vector<std::shared_ptr<Node2d>> next_nodes;
-  std::shared_ptr<Node2d> up =
-      std::make_shared<Node2d>(current_node_x, current_node_y + 1.0, XYbounds_);
-  up->SetPathCost(current_node_path_cost + 1.0);
-  std::shared_ptr<Node2d> up_right = std::make_shared<Node2d>(
-      current_node_x + 1.0, current_node_y + 1.0, XYbounds_);
-  up_right->SetPathCost(current_node_path_cost + diagonal_distance);
-  std::shared_ptr<Node2d> right =
-      std::make_shared<Node2d>(current_node_x + 1.0, current_node_y, XYbounds_);
-  right->SetPathCost(current_node_path_cost + 1.0);
-  std::shared_ptr<Node2d> down_right = std::make_shared<Node2d>(
-      current_node_x + 1.0, current_node_y - 1.0, XYbounds_);
-  down_right->SetPathCost(current_node_path_cost + diagonal_distance);
-  std::shared_ptr<Node2d> down =
-      std::make_shared<Node2d>(current_node_x, current_node_y - 1.0, XYbounds_);
-  down->SetPathCost(current_node_path_cost + 1.0);
-  std::shared_ptr<Node2d> down_left = std::make_shared<Node2d>(
-      current_node_x - 1.0, current_node_y - 1.0, XYbounds_);
-  down_left->SetPathCost(current_node_path_cost + diagonal_distance);
-  std::shared_ptr<Node2d> left =
-      std::make_shared<Node2d>(current_node_x - 1.0, current_node_y, XYbounds_);
-  left->SetPathCost(current_node_path_cost + 1.0);
-  std::shared_ptr<Node2d> up_left = std::make_shared<Node2d>(
-      current_node_x - 1.0, current_node_y + 1.0, XYbounds_);
-  up_left->SetPathCost(current_node_path_cost + diagonal_distance);
-
-  next_nodes.emplace_back(up);
-  next_nodes.emplace_back(up_right);
-  next_nodes.emplace_back(right);
-  next_nodes.emplace_back(down_right);
-  next_nodes.emplace_back(down);
-  next_nodes.emplace_back(down_left);
-  next_nodes.emplace_back(left);
-  next_nodes.emplace_back(up_left);
-  return next_nodes;
+void GridSearch::ResetNodes() {
+  node_arena_.Clear();
+  node_table_.Clear();
+  open_heap_.Clear();
+  final_node_ = nullptr;
 }
 
 bool GridSearch::GenerateAStarPath(
@@ -110,51 +99,42 @@ bool GridSearch::GenerateAStarPath(
     const std::vector<std::vector<common::math::LineSegment2d>>&
         obstacles_linesegments_vec,
     GridAStartResult* result) {
-  std::priority_queue<std::pair<std::string, double>,
-                      std::vector<std::pair<std::string, double>>, cmp>
-      open_pq;
-  std::unordered_map<std::string, std::shared_ptr<Node2d>> open_set;
-  std::unordered_map<std::string, std::shared_ptr<Node2d>> close_set;
+  ResetNodes();
   XYbounds_ = XYbounds;
-  std::shared_ptr<Node2d> start_node =
-      std::make_shared<Node2d>(sx, sy, xy_grid_resolution_, XYbounds_);
-  std::shared_ptr<Node2d> end_node =
-      std::make_shared<Node2d>(ex, ey, xy_grid_resolution_, XYbounds_);
-  std::shared_ptr<Node2d> final_node_ = nullptr;
-  obstacles_linesegments_vec_ = obstacles_linesegments_vec;
-  open_set.emplace(start_node->GetIndex(), start_node);
-  open_pq.emplace(start_node->GetIndex(), start_node->GetCost());
+  const NodeHandle start_node =
+      node_arena_.Create(sx, sy, xy_grid_resolution_, XYbounds_);
+  const Node2d end_node(ex, ey, xy_grid_resolution_, XYbounds_);
+  SetObstacles(obstacles_linesegments_vec);
+  node_table_.Insert(node_arena_[start_node].GetIndex(), start_node);
+  open_heap_.Push(start_node, node_arena_[start_node].GetCost());
 
   // Grid a star begins
   size_t explored_node_num = 0;
-  while (!open_pq.empty()) {
-    std::string current_id = open_pq.top().first;
-    open_pq.pop();
-    std::shared_ptr<Node2d> current_node = open_set[current_id];
+  while (!open_heap_.empty()) {
+    const Node2d& current_node = node_arena_[open_heap_.Top()];
+    open_heap_.Pop();
     // Check destination
-    if (*(current_node) == *(end_node)) {
-      final_node_ = current_node;
+    if (current_node == end_node) {
+      final_node_ = &current_node;
       break;
     }
-    close_set.emplace(current_node->GetIndex(), current_node);
-    std::vector<std::shared_ptr<Node2d>> next_nodes =
-        std::move(GenerateNextNodes(current_node));
-    for (auto& next_node : next_nodes) {
+    GenerateNextNodes(current_node, &next_nodes_);
+    for (auto& next_node : next_nodes_) {
       if (!CheckConstraints(next_node)) {
         continue;
       }
-      if (close_set.find(next_node->GetIndex()) != close_set.end()) {
+      // the node is open or closed already
+      if (node_table_.Find(next_node.GetIndex()) != kInvalidNodeHandle) {
         continue;
       }
-      if (open_set.find(next_node->GetIndex()) == open_set.end()) {
-        ++explored_node_num;
-        next_node->SetHeuristic(
-            EuclidDistance(next_node->GetGridX(), next_node->GetGridY(),
-                           end_node->GetGridX(), end_node->GetGridY()));
-        next_node->SetPreNode(current_node);
-        open_set.emplace(next_node->GetIndex(), next_node);
-        open_pq.emplace(next_node->GetIndex(), next_node->GetCost());
-      }
+      ++explored_node_num;
+      next_node.SetHeuristic(
+          EuclidDistance(next_node.GetGridX(), next_node.GetGridY(),
+                         end_node.GetGridX(), end_node.GetGridY()));
+      next_node.SetPreNode(&current_node);
+      const NodeHandle handle = node_arena_.Create(next_node);
+      node_table_.Insert(next_node.GetIndex(), handle);
+      open_heap_.Push(handle, next_node.GetCost());
     }
   }
 
@@ -175,47 +155,48 @@ bool GridSearch::GenerateDpMap(
             obstacles_linesegments_vec,
         const std::vector<std::vector<common::math::LineSegment2d>>&
             soft_boundary_linesegments_vec) {
-  std::priority_queue<std::pair<std::string, double>,
-                      std::vector<std::pair<std::string, double>>, cmp>
-      open_pq;
-  std::unordered_map<std::string, std::shared_ptr<Node2d>> open_set;
-  dp_map_ = decltype(dp_map_)();
+  ResetNodes();
   XYbounds_ = XYbounds;
   // XYbounds with xmin, xmax, ymin, ymax
   max_grid_y_ = std::round((XYbounds_[3] - XYbounds_[2]) / xy_grid_resolution_);
   max_grid_x_ = std::round((XYbounds_[1] - XYbounds_[0]) / xy_grid_resolution_);
-  std::shared_ptr<Node2d> end_node =
-      std::make_shared<Node2d>(ex, ey, xy_grid_resolution_, XYbounds_);
-  obstacles_linesegments_vec_ = obstacles_linesegments_vec;
-  open_set.emplace(end_node->GetIndex(), end_node);
-  open_pq.emplace(end_node->GetIndex(), end_node->GetCost());
+  dp_map_.assign((static_cast<size_t>(max_grid_x_) + 1) *
+                     (static_cast<size_t>(max_grid_y_) + 1),
+                 std::numeric_limits<double>::infinity());
+  const NodeHandle end_node =
+      node_arena_.Create(ex, ey, xy_grid_resolution_, XYbounds_);
+  SetObstacles(obstacles_linesegments_vec);
+  node_table_.Insert(node_arena_[end_node].GetIndex(), end_node);
+  open_heap_.Push(end_node, node_arena_[end_node].GetCost());
 
   // Grid a star begins
   size_t explored_node_num = 0;
-  while (!open_pq.empty()) {
-    const std::string current_id = open_pq.top().first;
-    open_pq.pop();
-    std::shared_ptr<Node2d> current_node = open_set[current_id];
-    dp_map_.emplace(current_node->GetIndex(), current_node);
-    std::vector<std::shared_ptr<Node2d>> next_nodes =
-        std::move(GenerateNextNodes(current_node));
-    for (auto& next_node : next_nodes) {
+  while (!open_heap_.empty()) {
+    const Node2d& current_node = node_arena_[open_heap_.Top()];
+    open_heap_.Pop();
+    const int dp_map_index =
+        DpMapIndex(static_cast<int>(current_node.GetGridX()),
+                   static_cast<int>(current_node.GetGridY()));
+    if (dp_map_index >= 0) {
+      dp_map_[dp_map_index] = current_node.GetCost();
+    }
+    GenerateNextNodes(current_node, &next_nodes_);
+    for (auto& next_node : next_nodes_) {
       if (!CheckConstraints(next_node)) {
         continue;
       }
-      if (dp_map_.find(next_node->GetIndex()) != dp_map_.end()) {
-        continue;
-      }
-      if (open_set.find(next_node->GetIndex()) == open_set.end()) {
+      const NodeHandle handle = node_table_.Find(next_node.GetIndex());
+      if (handle == kInvalidNodeHandle) {
         ++explored_node_num;
-        next_node->SetPreNode(current_node);
-        open_set.emplace(next_node->GetIndex(), next_node);
-        open_pq.emplace(next_node->GetIndex(), next_node->GetCost());
-      } else {
-        if (open_set[next_node->GetIndex()]->GetCost() > next_node->GetCost()) {
-          open_set[next_node->GetIndex()]->SetCost(next_node->GetCost());
-          open_set[next_node->GetIndex()]->SetPreNode(current_node);
-        }
+        next_node.SetPreNode(&current_node);
+        const NodeHandle next_handle = node_arena_.Create(next_node);
+        node_table_.Insert(next_node.GetIndex(), next_handle);
+        open_heap_.Push(next_handle, next_node.GetCost());
+      } else if (open_heap_.Contains(handle) &&
+                 node_arena_[handle].GetCost() > next_node.GetCost()) {
+        node_arena_[handle].SetPathCost(next_node.GetPathCost());
+        node_arena_[handle].SetPreNode(&current_node);
+        open_heap_.DecreaseCost(handle, next_node.GetCost());
       }
     }
   }
@@ -223,18 +204,28 @@ bool GridSearch::GenerateDpMap(
   return true;
 }
 
+int GridSearch::DpMapIndex(const int grid_x, const int grid_y) const {
+  if (grid_x < 0 || grid_x > max_grid_x_ || grid_y < 0 ||
+      grid_y > max_grid_y_) {
+    return -1;
+  }
+  return grid_x * (static_cast<int>(max_grid_y_) + 1) + grid_y;
+}
+
 double GridSearch::CheckDpMap(const double sx, const double sy) {
-  std::string index = Node2d::CalcIndex(sx, sy, xy_grid_resolution_, XYbounds_);
-  if (dp_map_.find(index) != dp_map_.end()) {
-    return dp_map_[index]->GetCost() * xy_grid_resolution_;
-  } else {
+  // XYbounds with xmin, xmax, ymin, ymax
+  const int dp_map_index = DpMapIndex(
+      static_cast<int>((sx - XYbounds_[0]) / xy_grid_resolution_),
+      static_cast<int>((sy - XYbounds_[2]) / xy_grid_resolution_));
+  if (dp_map_index < 0) {
     return std::numeric_limits<double>::infinity();
   }
+  return dp_map_[dp_map_index] * xy_grid_resolution_;
 }
 
 void GridSearch::LoadGridAStarResult(GridAStartResult* result) {
   (*result).path_cost = final_node_->GetPathCost() * xy_grid_resolution_;
-  std::shared_ptr<Node2d> current_node = final_node_;
+  const Node2d* current_node = final_node_;
   std::vector<double> grid_a_x;
   std::vector<double> grid_a_y;
   while (current_node->GetPreNode() != nullptr) {
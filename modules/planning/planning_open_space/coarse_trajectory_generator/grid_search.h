@@ -20,21 +20,19 @@
 
 #pragma once
 
+#include <cstdint>
 #include <limits>
-#include <memory>
-#include <queue>
 #include <string>
-#include <unordered_map>
 #include <utility>
 #include <unordered_set>
 #include <vector>
 
-#include "absl/strings/str_cat.h"
-
 #include "modules/planning/planning_open_space/proto/planner_open_space_config.pb.h"
 
 #include "cyber/common/log.h"
 #include "modules/common/math/line_segment2d.h"
+#include "modules/planning/planning_base/math/collision_grid.h"
+#include "modules/planning/planning_open_space/coarse_trajectory_generator/node_arena.h"
 
 namespace apollo {
 namespace planning {
@@ -46,13 +44,13 @@ class Node2d {
     // XYbounds with xmin, xmax, ymin, ymax
     grid_x_ = static_cast<int>((x - XYbounds[0]) / xy_resolution);
     grid_y_ = static_cast<int>((y - XYbounds[2]) / xy_resolution);
-    index_ = ComputeStringIndex(grid_x_, grid_y_);
+    index_ = PackGridIndex(grid_x_, grid_y_);
   }
   Node2d(const int grid_x, const int grid_y,
          const std::vector<double>& XYbounds) {
     grid_x_ = grid_x;
     grid_y_ = grid_y;
-    index_ = ComputeStringIndex(grid_x_, grid_y_);
+    index_ = PackGridIndex(grid_x_, grid_y_);
   }
   void SetPathCost(const double path_cost) {
     path_cost_ = path_cost;
@@ -66,7 +64,7 @@ class Node2d {
   void SetDistanceToObstacle(const double dist) {
       distance_to_obstacle_ = dist;
   }
-  void SetPreNode(std::shared_ptr<Node2d> pre_node) { pre_node_ = pre_node; }
+  void SetPreNode(const Node2d* pre_node) { pre_node_ = pre_node; }
   double GetGridX() const { return grid_x_; }
   double GetGridY() const { return grid_y_; }
   double GetPathCost() const { return path_cost_; }
@@ -75,25 +73,21 @@ class Node2d {
   double GetDistanceToObstacle() const {
       return distance_to_obstacle_;
   }
-  const std::string& GetIndex() const { return index_; }
-  std::shared_ptr<Node2d> GetPreNode() const { return pre_node_; }
-  static std::string CalcIndex(const double x, const double y,
+  // packed grid index of the node
+  uint64_t GetIndex() const { return index_; }
+  const Node2d* GetPreNode() const { return pre_node_; }
+  static uint64_t CalcIndex(const double x, const double y,
                                const double xy_resolution,
                                const std::vector<double>& XYbounds) {
     // XYbounds with xmin, xmax, ymin, ymax
     int grid_x = static_cast<int>((x - XYbounds[0]) / xy_resolution);
     int grid_y = static_cast<int>((y - XYbounds[2]) / xy_resolution);
-    return ComputeStringIndex(grid_x, grid_y);
+    return PackGridIndex(grid_x, grid_y);
   }
   bool operator==(const Node2d& right) const {
     return right.GetIndex() == index_;
   }
 
- private:
-  static std::string ComputeStringIndex(int x_grid, int y_grid) {
-    return absl::StrCat(x_grid, "_", y_grid);
-  }
-
  private:
   int grid_x_ = 0;
   int grid_y_ = 0;
@@ -101,8 +95,9 @@ class Node2d {
   double heuristic_ = 0.0;
   double cost_ = 0.0;
   double distance_to_obstacle_ = std::numeric_limits<double>::max();
-  std::string index_;
-  std::shared_ptr<Node2d> pre_node_ = nullptr;
+  uint64_t index_ = 0;
+  // owned by the search, in its NodeArena
+  const Node2d* pre_node_ = nullptr;
 };
 
 struct GridAStartResult {
@@ -134,10 +129,16 @@ class GridSearch {
  private:
   double EuclidDistance(const double x1, const double y1, const double x2,
                         const double y2);
-  std::vector<std::shared_ptr<Node2d>> GenerateNextNodes(
-      std::shared_ptr<Node2d> node);
-  bool CheckConstraints(std::shared_ptr<Node2d> node);
+  void GenerateNextNodes(const Node2d& current_node,
+                         std::vector<Node2d>* next_nodes);
+  bool CheckConstraints(const Node2d& node);
+  void SetObstacles(
+      const std::vector<std::vector<common::math::LineSegment2d>>&
+          obstacles_linesegments_vec);
   void LoadGridAStarResult(GridAStartResult* result);
+  // index of the grid in dp_map_, -1 if it is out of the map
+  int DpMapIndex(const int grid_x, const int grid_y) const;
+  void ResetNodes();
 
  private:
   double xy_grid_resolution_ = 0.0;
@@ -145,20 +146,18 @@ class GridSearch {
   std::vector<double> XYbounds_;
   double max_grid_x_ = 0.0;
   double max_grid_y_ = 0.0;
-  std::shared_ptr<Node2d> start_node_;
-  std::shared_ptr<Node2d> end_node_;
-  std::shared_ptr<Node2d> final_node_;
-  std::vector<std::vector<common::math::LineSegment2d>>
-      obstacles_linesegments_vec_;
-
-  struct cmp {
-      bool operator()(const std::pair<std::string,
-                      double>& left,
-                      const std::pair<std::string, double>& right) const {
-          return left.second >= right.second;
-      }
-  };
-  std::unordered_map<std::string, std::shared_ptr<Node2d>> dp_map_;
+  const Node2d* final_node_ = nullptr;
+  // obstacle line segments of the current search
+  CollisionGrid obstacle_grid_;
+
+  // nodes of the current search, a node is open while it is in open_heap_
+  // and closed after
+  NodeArena<Node2d> node_arena_;
+  NodeIndexTable node_table_;
+  NodeHeap open_heap_;
+  std::vector<Node2d> next_nodes_;
+  // cost from every grid to the end, by DpMapIndex
+  std::vector<double> dp_map_;
 
   // park generic
  public:
@@ -21,7 +21,6 @@
 #include "modules/planning/planning_open_space/coarse_trajectory_generator/hybrid_a_star.h"
 
 #include <limits>
-#include <unordered_set>
 
 #include "modules/planning/planning_base/common/path/discretized_path.h"
 #include "modules/planning/planning_base/common/speed/speed_data.h"
@@ -106,11 +105,10 @@ HybridAStar::HybridAStar(const PlannerOpenSpaceConfig& open_space_conf) {
 }
 
 bool HybridAStar::AnalyticExpansion(
-    std::shared_ptr<Node3d> current_node,
-    std::shared_ptr<Node3d>* candidate_final_node) {
+    const Node3d& current_node, NodeHandle* candidate_final_node) {
   std::shared_ptr<ReedSheppPath> reeds_shepp_to_check =
       std::make_shared<ReedSheppPath>();
-  if (!reed_shepp_generator_->ShortestRSP(current_node, end_node_,
+  if (!reed_shepp_generator_->ShortestRSP(current_node, *end_node_,
                                           reeds_shepp_to_check)) {
     return false;
   }
@@ -124,24 +122,23 @@ bool HybridAStar::AnalyticExpansion(
 
 bool HybridAStar::RSPCheck(
     const std::shared_ptr<ReedSheppPath> reeds_shepp_to_end) {
-  std::shared_ptr<Node3d> node = std::shared_ptr<Node3d>(new Node3d(
-      reeds_shepp_to_end->x, reeds_shepp_to_end->y, reeds_shepp_to_end->phi,
-      XYbounds_, planner_open_space_config_));
+  const Node3d node(reeds_shepp_to_end->x, reeds_shepp_to_end->y,
+                    reeds_shepp_to_end->phi, XYbounds_,
+                    planner_open_space_config_);
   return ValidityCheck(node);
 }
 
-bool HybridAStar::ValidityCheck(std::shared_ptr<Node3d> node) {
-  CHECK_NOTNULL(node);
-  CHECK_GT(node->GetStepSize(), 0U);
+bool HybridAStar::ValidityCheck(const Node3d& node) {
+  CHECK_GT(node.GetStepSize(), 0U);
 
   if (obstacles_linesegments_vec_.empty()) {
     return true;
   }
 
-  size_t node_step_size = node->GetStepSize();
-  const auto& traversed_x = node->GetXs();
-  const auto& traversed_y = node->GetYs();
-  const auto& traversed_phi = node->GetPhis();
+  size_t node_step_size = node.GetStepSize();
+  const auto& traversed_x = node.GetXs();
+  const auto& traversed_y = node.GetYs();
+  const auto& traversed_phi = node.GetPhis();
 
   // The first {x, y, phi} is collision free unless they are start and end
   // configuration of search problem
@@ -159,35 +156,29 @@ bool HybridAStar::ValidityCheck(std::shared_ptr<Node3d> node) {
     }
     Box2d bounding_box = Node3d::GetBoundingBox(
         vehicle_param_, traversed_x[i], traversed_y[i], traversed_phi[i]);
-    for (const auto& obstacle_linesegments : obstacles_linesegments_vec_) {
-      for (const common::math::LineSegment2d& linesegment :
-           obstacle_linesegments) {
-        if (bounding_box.HasOverlap(linesegment)) {
-          ADEBUG << "collision start at x: " << linesegment.start().x();
-          ADEBUG << "collision start at y: " << linesegment.start().y();
-          ADEBUG << "collision end at x: " << linesegment.end().x();
-          ADEBUG << "collision end at y: " << linesegment.end().y();
-          return false;
-        }
-      }
+    if (obstacle_grid_.HasOverlap(bounding_box)) {
+      ADEBUG << "collision at x: " << traversed_x[i];
+      ADEBUG << "collision at y: " << traversed_y[i];
+      return false;
     }
   }
   return true;
 }
 
-std::shared_ptr<Node3d> HybridAStar::LoadRSPinCS(
+NodeHandle HybridAStar::LoadRSPinCS(
     const std::shared_ptr<ReedSheppPath> reeds_shepp_to_end,
-    std::shared_ptr<Node3d> current_node) {
-  std::shared_ptr<Node3d> end_node = std::shared_ptr<Node3d>(new Node3d(
+    const Node3d& current_node) {
+  const NodeHandle end_node = node_arena_.Create(
       reeds_shepp_to_end->x, reeds_shepp_to_end->y, reeds_shepp_to_end->phi,
-      XYbounds_, planner_open_space_config_));
-  end_node->SetPre(current_node);
-  end_node->SetTrajCost(current_node->GetTrajCost() + reeds_shepp_to_end->cost);
+      XYbounds_, planner_open_space_config_);
+  node_arena_[end_node].SetPre(&current_node);
+  node_arena_[end_node].SetTrajCost(current_node.GetTrajCost() +
+                                    reeds_shepp_to_end->cost);
   return end_node;
 }
 
-std::shared_ptr<Node3d> HybridAStar::Next_node_generator(
-    std::shared_ptr<Node3d> current_node, size_t next_node_index) {
+NodeHandle HybridAStar::Next_node_generator(
+    const Node3d& current_node, size_t next_node_index) {
   double steering = 0.0;
   double traveled_distance = 0.0;
   if (next_node_index < static_cast<double>(next_node_num_) / 2) {
@@ -209,9 +200,9 @@ std::shared_ptr<Node3d> HybridAStar::Next_node_generator(
   std::vector<double> intermediate_x;
   std::vector<double> intermediate_y;
   std::vector<double> intermediate_phi;
-  double last_x = current_node->GetX();
-  double last_y = current_node->GetY();
-  double last_phi = current_node->GetPhi();
+  double last_x = current_node.GetX();
+  double last_y = current_node.GetY();
+  double last_phi = current_node.GetPhi();
   intermediate_x.push_back(last_x);
   intermediate_y.push_back(last_y);
   intermediate_phi.push_back(last_phi);
@@ -238,59 +229,60 @@ std::shared_ptr<Node3d> HybridAStar::Next_node_generator(
       intermediate_x.back() < XYbounds_[0] ||
       intermediate_y.back() > XYbounds_[3] ||
       intermediate_y.back() < XYbounds_[2]) {
-    return nullptr;
-  }
-  std::shared_ptr<Node3d> next_node = std::shared_ptr<Node3d>(
-      new Node3d(intermediate_x, intermediate_y, intermediate_phi, XYbounds_,
-                 planner_open_space_config_));
-  next_node->SetPre(current_node);
-  next_node->SetDirec(traveled_distance > 0.0);
-  next_node->SetSteer(steering);
-  return next_node;
+    return kInvalidNodeHandle;
+  }
+  const NodeHandle next_handle =
+      node_arena_.Create(intermediate_x, intermediate_y, intermediate_phi,
+                         XYbounds_, planner_open_space_config_);
+  Node3d& next_node = node_arena_[next_handle];
+  next_node.SetPre(&current_node);
+  next_node.SetDirec(traveled_distance > 0.0);
+  next_node.SetSteer(steering);
+  return next_handle;
 }
 
 void HybridAStar::CalculateNodeCost(
-    std::shared_ptr<Node3d> current_node, std::shared_ptr<Node3d> next_node) {
+    const Node3d& current_node, Node3d* next_node) {
   next_node->SetTrajCost(
-      current_node->GetTrajCost() + TrajCost(current_node, next_node));
+      current_node.GetTrajCost() + TrajCost(current_node, *next_node));
   // evaluate heuristic cost
   double optimal_path_cost = 0.0;
-  optimal_path_cost += HoloObstacleHeuristic(next_node);
+  optimal_path_cost += HoloObstacleHeuristic(*next_node);
   next_node->SetHeuCost(optimal_path_cost);
 }
 
-double HybridAStar::TrajCost(std::shared_ptr<Node3d> current_node,
-                             std::shared_ptr<Node3d> next_node) {
+double HybridAStar::TrajCost(const Node3d& current_node,
+                             const Node3d& next_node) {
     // evaluate cost on the trajectory and add current cost
   double piecewise_cost = 0.0;
-  if (next_node->GetDirec()) {
+  if (next_node.GetDirec()) {
     piecewise_cost +=
-      static_cast<double>(next_node->GetStepSize() - 1) *
+      static_cast<double>(next_node.GetStepSize() - 1) *
       step_size_ *
       traj_forward_penalty_;
   } else {
     piecewise_cost +=
-      static_cast<double>(next_node->GetStepSize() - 1) *
+      static_cast<double>(next_node.GetStepSize() - 1) *
       step_size_ *
       traj_back_penalty_;
   }
   AINFO << "traj cost: " << piecewise_cost;
-  if (current_node->GetDirec() != next_node->GetDirec()) {
+  if (current_node.GetDirec() != next_node.GetDirec()) {
     piecewise_cost += traj_gear_switch_penalty_;
   }
-  piecewise_cost += traj_steer_penalty_ * std::abs(next_node->GetSteer());
+  piecewise_cost += traj_steer_penalty_ * std::abs(next_node.GetSteer());
   piecewise_cost += traj_steer_change_penalty_ *
-                    std::abs(next_node->GetSteer() - current_node->GetSteer());
+                    std::abs(next_node.GetSteer() - current_node.GetSteer());
   return piecewise_cost;
 }
 
-double HybridAStar::HoloObstacleHeuristic(std::shared_ptr<Node3d> next_node) {
+double HybridAStar::HoloObstacleHeuristic(const Node3d& next_node) {
   return grid_a_star_heuristic_generator_->CheckDpMap(
-      next_node->GetX(), next_node->GetY());
+      next_node.GetX(), next_node.GetY());
 }
 
 bool HybridAStar::GetResult(HybridAStartResult* result) {
-  std::shared_ptr<Node3d> current_node = final_node_;
+  const Node3d* current_node = final_node_;
   std::vector<double> hybrid_a_x;
   std::vector<double> hybrid_a_y;
   std::vector<double> hybrid_a_phi;
@@ -712,10 +704,11 @@ bool HybridAStar::Plan(
     bool reeds_sheep_last_straight) {
   reed_shepp_generator_->reeds_sheep_last_straight_ = reeds_sheep_last_straight;
   // clear containers
-  open_set_.clear();
-  close_set_.clear();
-  open_pq_ = decltype(open_pq_)();
+  node_arena_.Clear();
+  node_table_.Clear();
+  open_heap_.Clear();
   final_node_ = nullptr;
+  explored_node_num_ = 0;
   PrintCurves print_curves;
   std::vector<std::vector<common::math::LineSegment2d>>
       obstacles_linesegments_vec;
@@ -731,6 +724,14 @@ bool HybridAStar::Plan(
     obstacles_linesegments_vec.emplace_back(obstacle_linesegments);
   }
   obstacles_linesegments_vec_ = std::move(obstacles_linesegments_vec);
+  obstacle_grid_.Clear();
+  for (const auto& obstacle_linesegments : obstacles_linesegments_vec_) {
+    for (const auto& linesegment : obstacle_linesegments) {
+      obstacle_grid_.AddLineSegment(linesegment);
+    }
+  }
+  // about a quarter of the footprint per cell
+  obstacle_grid_.Build(vehicle_param_.length() / 2.0);
   for (size_t i = 0; i < obstacles_linesegments_vec_.size(); i++) {
     for (auto linesg : obstacles_linesegments_vec_[i]) {
       std::string name = std::to_string(i) + "roi_boundary";
@@ -765,7 +766,7 @@ bool HybridAStar::Plan(
       new Node3d({ex}, {ey}, {ephi}, XYbounds_, planner_open_space_config_));
   AINFO << "start node" << sx << "," << sy << "," << sphi;
   AINFO << "end node " << ex << "," << ey << "," << ephi;
-  if (!ValidityCheck(start_node_)) {
+  if (!ValidityCheck(*start_node_)) {
     AERROR << "start_node in collision with obstacles";
     AERROR << start_node_->GetX()
            << "," << start_node_->GetY()
@@ -773,7 +774,7 @@ bool HybridAStar::Plan(
     print_curves.PrintToLog();
     return false;
   }
-  if (!ValidityCheck(end_node_)) {
+  if (!ValidityCheck(*end_node_)) {
     AERROR << "end_node in collision with obstacles";
     print_curves.PrintToLog();
     return false;
@@ -783,8 +784,9 @@ bool HybridAStar::Plan(
       ex, ey, XYbounds_, obstacles_linesegments_vec_);
   ADEBUG << "map time " << Clock::NowInSeconds() - map_time;
   // load open set, pq
-  open_set_.insert(start_node_->GetIndex());
-  open_pq_.emplace(start_node_, start_node_->GetCost());
+  const NodeHandle start_handle = node_arena_.Create(*start_node_);
+  node_table_.Insert(start_node_->GetIndex(), start_handle);
+  open_heap_.Push(start_handle, start_node_->GetCost());
   // Hybrid A* begins
   size_t explored_node_num = 0;
   size_t available_result_num = 0;
@@ -801,28 +803,29 @@ bool HybridAStar::Plan(
       planner_open_space_config_.warm_start_config().desired_explored_num(),
       planner_open_space_config_.warm_start_config().max_explored_num());
   static constexpr int kMaxNodeNum = 200000;
-  std::vector<std::shared_ptr<Node3d>> candidate_final_nodes;
-  while (!open_pq_.empty() &&
-         open_pq_.size() < kMaxNodeNum &&
+  while (!open_heap_.empty() &&
+         open_heap_.size() < kMaxNodeNum &&
          available_result_num < desired_explored_num &&
          explored_node_num < max_explored_num) {
-    std::shared_ptr<Node3d> current_node = open_pq_.top().first;
-    open_pq_.pop();
+    const Node3d& current_node = node_arena_[open_heap_.Top()];
+    open_heap_.Pop();
     const double rs_start_time = Clock::NowInSeconds();
-    std::shared_ptr<Node3d> final_node = nullptr;
+    NodeHandle final_node = kInvalidNodeHandle;
     if (AnalyticExpansion(current_node, &final_node)) {
       if (final_node_ == nullptr ||
-          final_node_->GetTrajCost() > final_node->GetTrajCost()) {
-        final_node_ = final_node;
+          final_node_->GetTrajCost() >
+              node_arena_[final_node].GetTrajCost()) {
+        final_node_ = &node_arena_[final_node];
         best_explored_num = explored_node_num + 1;
         best_available_result_num = available_result_num + 1;
+      } else {
+        node_arena_.PopBack();
       }
       available_result_num++;
     }
     explored_node_num++;
     const double rs_end_time = Clock::NowInSeconds();
     rs_time += rs_end_time - rs_start_time;
-    close_set_.insert(current_node->GetIndex());
 
     if (Clock::NowInSeconds() - astar_start_time >
             planner_open_space_config_.warm_start_config()
@@ -833,37 +836,37 @@ bool HybridAStar::Plan(
 
     size_t begin_index = 0;
     size_t end_index = next_node_num_;
-    std::unordered_set<std::string> temp_set;
     for (size_t i = begin_index; i < end_index; ++i) {
       const double gen_node_time = Clock::NowInSeconds();
-      std::shared_ptr<Node3d> next_node = Next_node_generator(current_node, i);
+      const NodeHandle next_handle = Next_node_generator(current_node, i);
       node_generator_time += Clock::NowInSeconds() - gen_node_time;
 
       // boundary check failure handle
-      if (next_node == nullptr) {
+      if (next_handle == kInvalidNodeHandle) {
         continue;
       }
-      // check if the node is already in the close set
-      if (close_set_.count(next_node->GetIndex()) > 0) {
+      Node3d& next_node = node_arena_[next_handle];
+      // check if the node is already in the open or close set
+      if (node_table_.Find(next_node.GetIndex()) != kInvalidNodeHandle) {
+        node_arena_.PopBack();
         continue;
       }
       // collision check
       const double validity_check_start_time = Clock::NowInSeconds();
       if (!ValidityCheck(next_node)) {
+        node_arena_.PopBack();
         continue;
       }
       validity_check_time += Clock::NowInSeconds() - validity_check_start_time;
-      if (open_set_.count(next_node->GetIndex()) == 0) {
-        const double start_time = Clock::NowInSeconds();
-        CalculateNodeCost(current_node, next_node);
-        const double end_time = Clock::NowInSeconds();
-        heuristic_time += end_time - start_time;
-        temp_set.insert(next_node->GetIndex());
-        open_pq_.emplace(next_node, next_node->GetCost());
-      }
+      const double start_time = Clock::NowInSeconds();
+      CalculateNodeCost(current_node, &next_node);
+      const double end_time = Clock::NowInSeconds();
+      heuristic_time += end_time - start_time;
+      node_table_.Insert(next_node.GetIndex(), next_handle);
+      open_heap_.Push(next_handle, next_node.GetCost());
     }
-    open_set_.insert(temp_set.begin(), temp_set.end());
   }
+  explored_node_num_ = explored_node_num;
 
   if (final_node_ == nullptr) {
     AERROR << "Hybird A* cannot find a valid path";
@@ -871,8 +874,8 @@ bool HybridAStar::Plan(
     return false;
   }
 
-  AINFO << "open_pq_.empty()" << (open_pq_.empty() ? "true" : "false");
-  AINFO << "open_pq_.size()" << open_pq_.size();
+  AINFO << "open_heap_.empty()" << (open_heap_.empty() ? "true" : "false");
+  AINFO << "open_heap_.size()" << open_heap_.size();
   AINFO << "desired_explored_num" << desired_explored_num;
   AINFO << "min cost is : " << final_node_->GetTrajCost();
   AINFO << "max_explored_num is " << max_explored_num;
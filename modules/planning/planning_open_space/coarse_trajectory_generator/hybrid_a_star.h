@@ -22,10 +22,7 @@
 
 #include <algorithm>
 #include <memory>
-#include <queue>
 #include <string>
-#include <unordered_map>
-#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -39,8 +36,10 @@
 #include "modules/common/math/math_utils.h"
 #include "modules/planning/planning_base/common/obstacle.h"
 #include "modules/planning/planning_base/gflags/planning_gflags.h"
+#include "modules/planning/planning_base/math/collision_grid.h"
 #include "modules/planning/planning_open_space/coarse_trajectory_generator/grid_search.h"
 #include "modules/planning/planning_open_space/coarse_trajectory_generator/node3d.h"
+#include "modules/planning/planning_open_space/coarse_trajectory_generator/node_arena.h"
 #include "modules/planning/planning_open_space/coarse_trajectory_generator/reeds_shepp_path.h"
 
 namespace apollo {
@@ -63,29 +62,34 @@ class HybridAStar {
   bool TrajectoryPartition(
           const HybridAStartResult& result,
           std::vector<HybridAStartResult>* partitioned_result);
+  // nodes explored by the last Plan
+  size_t explored_node_num() const {
+      return explored_node_num_;
+  }
 
  private:
   bool AnalyticExpansion(
-          std::shared_ptr<Node3d> current_node,
-          std::shared_ptr<Node3d>* candidate_final_node);
+          const Node3d& current_node,
+          NodeHandle* candidate_final_node);
   // check collision and validity
-  bool ValidityCheck(std::shared_ptr<Node3d> node);
+  bool ValidityCheck(const Node3d& node);
   // check Reeds Shepp path collision and validity
   bool RSPCheck(const std::shared_ptr<ReedSheppPath> reeds_shepp_to_end);
   // load the whole RSP as nodes and add to the close set
-  std::shared_ptr<Node3d> LoadRSPinCS(
+  NodeHandle LoadRSPinCS(
           const std::shared_ptr<ReedSheppPath> reeds_shepp_to_end,
-          std::shared_ptr<Node3d> current_node);
-  std::shared_ptr<Node3d> Next_node_generator(
-          std::shared_ptr<Node3d> current_node,
+          const Node3d& current_node);
+  // kInvalidNodeHandle if the node runs out of the XY boundary
+  NodeHandle Next_node_generator(
+          const Node3d& current_node,
           size_t next_node_index);
   void CalculateNodeCost(
-          std::shared_ptr<Node3d> current_node,
-          std::shared_ptr<Node3d> next_node);
+          const Node3d& current_node,
+          Node3d* next_node);
   double TrajCost(
-          std::shared_ptr<Node3d> current_node,
-          std::shared_ptr<Node3d> next_node);
-  double HoloObstacleHeuristic(std::shared_ptr<Node3d> next_node);
+          const Node3d& current_node,
+          const Node3d& next_node);
+  double HoloObstacleHeuristic(const Node3d& next_node);
   bool GetResult(HybridAStartResult* result);
   bool GetTemporalProfile(HybridAStartResult* result);
   bool GenerateSpeedAcceleration(HybridAStartResult* result);
@@ -124,26 +128,20 @@ class HybridAStar {
   double max_acc_jerk_ = 0.0;
   double arc_length_ = 0.0;
   std::vector<double> XYbounds_;
-  std::shared_ptr<Node3d> start_node_;
-  std::shared_ptr<Node3d> end_node_;
-  std::shared_ptr<Node3d> final_node_;
+  std::unique_ptr<Node3d> start_node_;
+  std::unique_ptr<Node3d> end_node_;
+  const Node3d* final_node_ = nullptr;
   std::vector<std::vector<common::math::LineSegment2d>>
       obstacles_linesegments_vec_;
-
-  struct cmp {
-      bool operator()(
-              const std::pair<std::shared_ptr<Node3d>, double>& left,
-              const std::pair<std::shared_ptr<Node3d>, double>& right) const {
-          return left.second >= right.second;
-      }
-  };
-  std::priority_queue<
-          std::pair<std::shared_ptr<Node3d>, double>,
-          std::vector<std::pair<std::shared_ptr<Node3d>, double>>,
-          cmp>
-          open_pq_;
-  std::unordered_set<std::string> open_set_;
-  std::unordered_set<std::string> close_set_;
+  // obstacles_linesegments_vec_ indexed for ValidityCheck
+  CollisionGrid obstacle_grid_;
+
+  // nodes of the current search, a node is open while it is in open_heap_
+  // and closed after
+  NodeArena<Node3d> node_arena_;
+  NodeIndexTable node_table_;
+  NodeHeap open_heap_;
+  size_t explored_node_num_ = 0;
   std::unique_ptr<ReedShepp> reed_shepp_generator_;
   std::unique_ptr<GridSearch> grid_a_star_heuristic_generator_;
 
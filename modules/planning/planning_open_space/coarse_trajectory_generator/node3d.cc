@@ -20,8 +20,6 @@
 
 #include "modules/planning/planning_open_space/coarse_trajectory_generator/node3d.h"
 
-#include "absl/strings/str_cat.h"
-
 #include "cyber/common/log.h"
 
 namespace apollo {
@@ -59,7 +57,7 @@ Node3d::Node3d(double x, double y, double phi,
   traversed_y_.push_back(y);
   traversed_phi_.push_back(phi);
 
-  index_ = ComputeStringIndex(x_grid_, y_grid_, phi_grid_);
+  index_ = PackGridIndex(x_grid_, y_grid_, phi_grid_);
 }
 
 Node3d::Node3d(const std::vector<double>& traversed_x,
@@ -91,7 +89,7 @@ Node3d::Node3d(const std::vector<double>& traversed_x,
   traversed_y_ = traversed_y;
   traversed_phi_ = traversed_phi;
 
-  index_ = ComputeStringIndex(x_grid_, y_grid_, phi_grid_);
+  index_ = PackGridIndex(x_grid_, y_grid_, phi_grid_);
   step_size_ = traversed_x.size();
 }
 
@@ -111,9 +109,5 @@ bool Node3d::operator==(const Node3d& right) const {
     return right.GetIndex() == index_;
 }
 
-std::string Node3d::ComputeStringIndex(int x_grid, int y_grid, int phi_grid) {
-    return absl::StrCat(x_grid, "_", y_grid, "_", phi_grid);
-}
-
 }  // namespace planning
 }  // namespace apollo
@@ -20,14 +20,14 @@
 
 #pragma once
 
-#include <memory>
-#include <string>
+#include <cstdint>
 #include <vector>
 
 #include "modules/common_msgs/config_msgs/vehicle_config.pb.h"
 #include "modules/planning/planning_open_space/proto/planner_open_space_config.pb.h"
 
 #include "modules/common/math/box2d.h"
+#include "modules/planning/planning_open_space/coarse_trajectory_generator/node_arena.h"
 
 namespace apollo {
 namespace planning {
@@ -76,7 +76,8 @@ class Node3d {
       return phi_;
   }
   bool operator==(const Node3d& right) const;
-  const std::string& GetIndex() const {
+  // packed grid index of the node
+  uint64_t GetIndex() const {
       return index_;
   }
   size_t GetStepSize() const {
@@ -88,7 +89,7 @@ class Node3d {
   double GetSteer() const {
       return steering_;
   }
-  std::shared_ptr<Node3d> GetPreNode() const {
+  const Node3d* GetPreNode() const {
       return pre_node_;
   }
   const std::vector<double>& GetXs() const {
@@ -103,7 +104,7 @@ class Node3d {
   const double& GetTravelDist() const {
       return travel_distance_;
   }
-  void SetPre(std::shared_ptr<Node3d> pre_node) {
+  void SetPre(const Node3d* pre_node) {
       pre_node_ = pre_node;
   }
   void SetDirec(bool direction) {
@@ -122,10 +123,6 @@ class Node3d {
       travel_distance_ = dist;
   }
 
- private:
-  static std::string ComputeStringIndex(
-          int x_grid, int y_grid, int phi_grid);
-
  private:
   double x_ = 0.0;
   double y_ = 0.0;
@@ -137,11 +134,12 @@ class Node3d {
   int x_grid_ = 0;
   int y_grid_ = 0;
   int phi_grid_ = 0;
-  std::string index_;
+  uint64_t index_ = 0;
   double traj_cost_ = 0.0;
   double heuristic_cost_ = 0.0;
   double cost_ = 0.0;
-  std::shared_ptr<Node3d> pre_node_ = nullptr;
+  // owned by the search, e.g. in its NodeArena
+  const Node3d* pre_node_ = nullptr;
   double steering_ = 0.0;
   // true for moving forward and false for moving backward
   bool direction_ = true;
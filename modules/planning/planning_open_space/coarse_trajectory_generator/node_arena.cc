@@ -0,0 +1,162 @@
+/******************************************************************************
+ * Copyright 2024 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/*
+ * @file
+ */
+
+#include "modules/planning/planning_open_space/coarse_trajectory_generator/node_arena.h"
+
+#include <algorithm>
+
+namespace apollo {
+namespace planning {
+
+namespace {
+// a power of 2, the table grows before it is half full
+constexpr size_t kInitialSlotNum = 1024;
+
+// packed indexes of neighbor nodes differ in a few bits only, mix them all
+uint64_t Mix(uint64_t key) {
+  key ^= key >> 33;
+  key *= 0xff51afd7ed558ccdULL;
+  key ^= key >> 33;
+  key *= 0xc4ceb9fe1a85ec53ULL;
+  key ^= key >> 33;
+  return key;
+}
+}  // namespace
+
+NodeIndexTable::NodeIndexTable() : slots_(kInitialSlotNum) {}
+
+size_t NodeIndexTable::SlotIndex(const uint64_t key) const {
+  const size_t mask = slots_.size() - 1;
+  size_t index = Mix(key) & mask;
+  while (slots_[index].handle != kInvalidNodeHandle &&
+         slots_[index].key != key) {
+    index = (index + 1) & mask;
+  }
+  return index;
+}
+
+NodeHandle NodeIndexTable::Find(const uint64_t key) const {
+  return slots_[SlotIndex(key)].handle;
+}
+
+bool NodeIndexTable::Insert(const uint64_t key, const NodeHandle handle) {
+  if (2 * (size_ + 1) > slots_.size()) {
+    Grow();
+  }
+  Slot& slot = slots_[SlotIndex(key)];
+  if (slot.handle != kInvalidNodeHandle) {
+    return false;
+  }
+  slot.key = key;
+  slot.handle = handle;
+  ++size_;
+  return true;
+}
+
+void NodeIndexTable::Clear() {
+  if (size_ == 0) {
+    return;
+  }
+  std::fill(slots_.begin(), slots_.end(), Slot());
+  size_ = 0;
+}
+
+void NodeIndexTable::Grow() {
+  std::vector<Slot> slots(slots_.size() * 2);
+  slots.swap(slots_);
+  for (const auto& slot : slots) {
+    if (slot.handle != kInvalidNodeHandle) {
+      slots_[SlotIndex(slot.key)] = slot;
+    }
+  }
+}
+
+void NodeHeap::Push(const NodeHandle handle, const double cost) {
+  if (handle >= positions_.size()) {
+    positions_.resize(handle + 1, kNotInHeap);
+  }
+  entries_.emplace_back();
+  Place(entries_.size() - 1, {cost, handle});
+  SiftUp(entries_.size() - 1);
+}
+
+void NodeHeap::Pop() {
+  positions_[entries_.front().handle] = kNotInHeap;
+  const Entry last = entries_.back();
+  entries_.pop_back();
+  if (!entries_.empty()) {
+    Place(0, last);
+    SiftDown(0);
+  }
+}
+
+void NodeHeap::DecreaseCost(const NodeHandle handle, const double cost) {
+  const size_t position = positions_[handle];
+  if (cost >= entries_[position].cost) {
+    return;
+  }
+  entries_[position].cost = cost;
+  SiftUp(position);
+}
+
+void NodeHeap::Clear() {
+  for (const auto& entry : entries_) {
+    positions_[entry.handle] = kNotInHeap;
+  }
+  entries_.clear();
+}
+
+void NodeHeap::Place(const size_t position, const Entry& entry) {
+  entries_[position] = entry;
+  positions_[entry.handle] = static_cast<uint32_t>(position);
+}
+
+void NodeHeap::SiftUp(size_t position) {
+  const Entry entry = entries_[position];
+  while (position > 0) {
+    const size_t parent = (position - 1) / 2;
+    if (entries_[parent].cost <= entry.cost) {
+      break;
+    }
+    Place(position, entries_[parent]);
+    position = parent;
+  }
+  Place(position, entry);
+}
+
+void NodeHeap::SiftDown(size_t position) {
+  const Entry entry = entries_[position];
+  const size_t size = entries_.size();
+  while (2 * position + 1 < size) {
+    size_t child = 2 * position + 1;
+    if (child + 1 < size && entries_[child + 1].cost < entries_[child].cost) {
+      ++child;
+    }
+    if (entry.cost <= entries_[child].cost) {
+      break;
+    }
+    Place(position, entries_[child]);
+    position = child;
+  }
+  Place(position, entry);
+}
+
+}  // namespace planning
+}  // namespace apollo
@@ -0,0 +1,159 @@
+/******************************************************************************
+ * Copyright 2024 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/*
+ * @file
+ * @brief Node storage of the grid searches: an arena the nodes are created
+ * in, a flat table from grid index to node and a heap of node handles.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace apollo {
+namespace planning {
+
+// position of a node in its NodeArena
+using NodeHandle = uint32_t;
+constexpr NodeHandle kInvalidNodeHandle =
+    std::numeric_limits<NodeHandle>::max();
+
+/**
+ * @brief Pack the grid indexes of a node into one key, 21 bits each.
+ * Indexes are offset by 2^20 so negative ones pack as well.
+ */
+inline uint64_t PackGridIndex(const int x_grid, const int y_grid,
+                              const int phi_grid = 0) {
+  constexpr int64_t kOffset = int64_t(1) << 20;
+  constexpr uint64_t kMask = (uint64_t(1) << 21) - 1;
+  return ((static_cast<uint64_t>(x_grid + kOffset) & kMask) << 42) |
+         ((static_cast<uint64_t>(y_grid + kOffset) & kMask) << 21) |
+         (static_cast<uint64_t>(phi_grid + kOffset) & kMask);
+}
+
+/**
+ * @brief The nodes of a search. Nodes stay in place until Clear, which keeps
+ * the memory for the next search.
+ */
+template <typename T>
+class NodeArena {
+ public:
+  template <typename... Args>
+  NodeHandle Create(Args&&... args) {
+    if (size_ < nodes_.size()) {
+      nodes_[size_] = T(std::forward<Args>(args)...);
+    } else {
+      nodes_.emplace_back(std::forward<Args>(args)...);
+    }
+    return static_cast<NodeHandle>(size_++);
+  }
+
+  // drop the node created last, e.g. one which failed its checks
+  void PopBack() {
+    if (size_ > 0) {
+      --size_;
+    }
+  }
+
+  T& operator[](const NodeHandle handle) { return nodes_[handle]; }
+  const T& operator[](const NodeHandle handle) const { return nodes_[handle]; }
+
+  size_t size() const { return size_; }
+
+  void Clear() { size_ = 0; }
+
+ private:
+  // a deque does not move its elements as it grows
+  std::deque<T> nodes_;
+  size_t size_ = 0;
+};
+
+/**
+ * @brief Open addressing map from packed grid index to node handle.
+ */
+class NodeIndexTable {
+ public:
+  NodeIndexTable();
+
+  // the node of key, kInvalidNodeHandle if there is none
+  NodeHandle Find(const uint64_t key) const;
+
+  // false if key has a node already, which is kept
+  bool Insert(const uint64_t key, const NodeHandle handle);
+
+  size_t size() const { return size_; }
+
+  void Clear();
+
+ private:
+  struct Slot {
+    uint64_t key = 0;
+    NodeHandle handle = kInvalidNodeHandle;
+  };
+
+  size_t SlotIndex(const uint64_t key) const;
+  void Grow();
+
+  std::vector<Slot> slots_;
+  size_t size_ = 0;
+};
+
+/**
+ * @brief Binary min heap of node handles by cost, the cost of a node in the
+ * heap can be decreased in place.
+ */
+class NodeHeap {
+ public:
+  bool empty() const { return entries_.empty(); }
+  size_t size() const { return entries_.size(); }
+
+  void Push(const NodeHandle handle, const double cost);
+
+  // the node of the least cost
+  NodeHandle Top() const { return entries_.front().handle; }
+  void Pop();
+
+  bool Contains(const NodeHandle handle) const {
+    return handle < positions_.size() && positions_[handle] != kNotInHeap;
+  }
+  void DecreaseCost(const NodeHandle handle, const double cost);
+
+  void Clear();
+
+ private:
+  struct Entry {
+    double cost = 0.0;
+    NodeHandle handle = kInvalidNodeHandle;
+  };
+  static constexpr uint32_t kNotInHeap = std::numeric_limits<uint32_t>::max();
+
+  void Place(const size_t position, const Entry& entry);
+  void SiftUp(size_t position);
+  void SiftDown(size_t position);
+
+  std::vector<Entry> entries_;
+  // position of every node in entries_, by handle
+  std::vector<uint32_t> positions_;
+};
+
+}  // namespace planning
+}  // namespace apollo
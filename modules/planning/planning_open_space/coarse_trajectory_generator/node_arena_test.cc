@@ -0,0 +1,110 @@
+/******************************************************************************
+ * Copyright 2024 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/*
+ * @file
+ */
+
+#include "modules/planning/planning_open_space/coarse_trajectory_generator/node_arena.h"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace planning {
+
+TEST(NodeArenaTest, PackGridIndex) {
+  EXPECT_NE(PackGridIndex(1, 2, 3), PackGridIndex(3, 2, 1));
+  EXPECT_NE(PackGridIndex(-1, 0, 0), PackGridIndex(0, -1, 0));
+  EXPECT_NE(PackGridIndex(-1, 0), PackGridIndex(1, 0));
+  EXPECT_EQ(PackGridIndex(7, -8), PackGridIndex(7, -8, 0));
+}
+
+TEST(NodeArenaTest, CreateAndClear) {
+  NodeArena<std::vector<int>> arena;
+  const NodeHandle first = arena.Create(3, 1);
+  const std::vector<int>* first_node = &arena[first];
+  for (int i = 0; i < 1000; ++i) {
+    arena.Create(1, i);
+  }
+  // nodes stay in place as the arena grows
+  EXPECT_EQ(first_node, &arena[first]);
+  EXPECT_EQ(1001U, arena.size());
+  arena.PopBack();
+  EXPECT_EQ(1000U, arena.size());
+
+  arena.Clear();
+  EXPECT_EQ(0U, arena.size());
+  EXPECT_EQ(first, arena.Create(2, 5));
+  EXPECT_EQ(std::vector<int>({5, 5}), arena[first]);
+}
+
+TEST(NodeArenaTest, IndexTable) {
+  NodeIndexTable table;
+  for (int x = -50; x < 50; ++x) {
+    for (int y = -50; y < 50; ++y) {
+      const NodeHandle handle = static_cast<NodeHandle>(table.size());
+      EXPECT_TRUE(table.Insert(PackGridIndex(x, y, x + y), handle));
+    }
+  }
+  EXPECT_EQ(10000U, table.size());
+  EXPECT_FALSE(table.Insert(PackGridIndex(0, 0, 0), 0));
+  EXPECT_EQ(5050U, table.Find(PackGridIndex(0, 0, 0)));
+  EXPECT_EQ(kInvalidNodeHandle, table.Find(PackGridIndex(0, 0, 1)));
+
+  table.Clear();
+  EXPECT_EQ(0U, table.size());
+  EXPECT_EQ(kInvalidNodeHandle, table.Find(PackGridIndex(0, 0, 0)));
+}
+
+TEST(NodeArenaTest, Heap) {
+  std::mt19937 generator(0);
+  std::uniform_real_distribution<double> distribution(0.0, 100.0);
+  std::vector<double> costs;
+  NodeHeap heap;
+  for (NodeHandle handle = 0; handle < 200; ++handle) {
+    costs.push_back(distribution(generator));
+    heap.Push(handle, costs.back());
+  }
+  // lower the cost of every third node, higher costs are ignored
+  for (NodeHandle handle = 0; handle < 200; handle += 3) {
+    costs[handle] /= 2.0;
+    heap.DecreaseCost(handle, costs[handle]);
+    heap.DecreaseCost(handle, costs[handle] + 1.0);
+  }
+  EXPECT_TRUE(heap.Contains(10));
+  EXPECT_FALSE(heap.Contains(200));
+
+  std::vector<double> popped;
+  while (!heap.empty()) {
+    popped.push_back(costs[heap.Top()]);
+    heap.Pop();
+  }
+  EXPECT_FALSE(heap.Contains(10));
+  std::sort(costs.begin(), costs.end());
+  EXPECT_EQ(costs, popped);
+
+  heap.Push(3, 1.0);
+  heap.Clear();
+  EXPECT_TRUE(heap.empty());
+  EXPECT_FALSE(heap.Contains(3));
+}
+
+}  // namespace planning
+}  // namespace apollo
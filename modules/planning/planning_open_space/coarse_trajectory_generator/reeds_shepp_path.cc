@@ -75,8 +75,8 @@ std::pair<double, double> ReedShepp::calc_tau_omega(
 }
 
 bool ReedShepp::ShortestRSP(
-        const std::shared_ptr<Node3d> start_node,
-        const std::shared_ptr<Node3d> end_node,
+        const Node3d& start_node,
+        const Node3d& end_node,
         std::shared_ptr<ReedSheppPath> optimal_path) {
   std::vector<ReedSheppPath> all_possible_paths;
   if (!GenerateRSPs(start_node, end_node, &all_possible_paths)) {
@@ -86,7 +86,7 @@ bool ReedShepp::ShortestRSP(
   }
 
   double start_dire = 1;
-  if (start_node->GetDirec() == false)
+  if (start_node.GetDirec() == false)
       start_dire = -1;
 
   size_t optimal_path_index = 0;
@@ -151,12 +151,12 @@ bool ReedShepp::ShortestRSP(
   // AERROR << ssm.str();
 
   if (std::abs(all_possible_paths[optimal_path_index].x.back() -
-               end_node->GetX()) > 1e-3 ||
+               end_node.GetX()) > 1e-3 ||
       std::abs(all_possible_paths[optimal_path_index].y.back() -
-               end_node->GetY()) > 1e-3 ||
+               end_node.GetY()) > 1e-3 ||
       common::math::NormalizeAngle(
           all_possible_paths[optimal_path_index].phi.back() -
-          end_node->GetPhi()) > 1e-3) {
+          end_node.GetPhi()) > 1e-3) {
     ADEBUG << "RSP end position not right";
     for (size_t i = 0;
          i < all_possible_paths[optimal_path_index].segs_types.size(); ++i) {
@@ -167,8 +167,8 @@ bool ReedShepp::ShortestRSP(
            << all_possible_paths[optimal_path_index].x.back() << ", "
            << all_possible_paths[optimal_path_index].y.back() << ", "
            << all_possible_paths[optimal_path_index].phi.back();
-    ADEBUG << "end x, y, phi are: " << end_node->GetX() << ", "
-           << end_node->GetY() << ", " << end_node->GetPhi();
+    ADEBUG << "end x, y, phi are: " << end_node.GetX() << ", "
+           << end_node.GetY() << ", " << end_node.GetPhi();
     return false;
   }
   (*optimal_path).cost = min_cost;
@@ -186,8 +186,8 @@ bool ReedShepp::ShortestRSP(
 }
 
 bool ReedShepp::GenerateRSPs(
-        const std::shared_ptr<Node3d> start_node,
-        const std::shared_ptr<Node3d> end_node,
+        const Node3d& start_node,
+        const Node3d& end_node,
         std::vector<ReedSheppPath>* all_possible_paths) {
   if (FLAGS_enable_parallel_hybrid_a) {
       // AINFO << "parallel hybrid a*";
@@ -205,14 +205,14 @@ bool ReedShepp::GenerateRSPs(
 }
 
 bool ReedShepp::GenerateRSP(
-        const std::shared_ptr<Node3d> start_node,
-        const std::shared_ptr<Node3d> end_node,
+        const Node3d& start_node,
+        const Node3d& end_node,
         std::vector<ReedSheppPath>* all_possible_paths) {
-  double dx = end_node->GetX() - start_node->GetX();
-  double dy = end_node->GetY() - start_node->GetY();
-  double dphi = end_node->GetPhi() - start_node->GetPhi();
-  double c = std::cos(start_node->GetPhi());
-  double s = std::sin(start_node->GetPhi());
+  double dx = end_node.GetX() - start_node.GetX();
+  double dy = end_node.GetY() - start_node.GetY();
+  double dphi = end_node.GetPhi() - start_node.GetPhi();
+  double c = std::cos(start_node.GetPhi());
+  double s = std::sin(start_node.GetPhi());
   // normalize the initial point to (0,0,0)
   double x = (c * dx + s * dy) * max_kappa_;
   double y = (-s * dx + c * dy) * max_kappa_;
@@ -1063,8 +1063,8 @@ bool ReedShepp::SetRSP(const int size, const double* lengths, const char* types,
 
 // TODO(Jinyun) : reformulate GenerateLocalConfigurations.
 bool ReedShepp::GenerateLocalConfigurations(
-    const std::shared_ptr<Node3d> start_node,
-    const std::shared_ptr<Node3d> end_node, ReedSheppPath* shortest_path) {
+    const Node3d& start_node,
+    const Node3d& end_node, ReedSheppPath* shortest_path) {
   double radius = shortest_path->radius;
   double step_scaled =
       planner_open_space_config_.warm_start_config().step_size() * max_kappa_;
@@ -1125,14 +1125,14 @@ bool ReedShepp::GenerateLocalConfigurations(
     pgear.pop_back();
   }
   for (size_t i = 0; i < px.size(); ++i) {
-    shortest_path->x.push_back(std::cos(-start_node->GetPhi()) * px.at(i) +
-                               std::sin(-start_node->GetPhi()) * py.at(i) +
-                               start_node->GetX());
-    shortest_path->y.push_back(-std::sin(-start_node->GetPhi()) * px.at(i) +
-                               std::cos(-start_node->GetPhi()) * py.at(i) +
-                               start_node->GetY());
+    shortest_path->x.push_back(std::cos(-start_node.GetPhi()) * px.at(i) +
+                               std::sin(-start_node.GetPhi()) * py.at(i) +
+                               start_node.GetX());
+    shortest_path->y.push_back(-std::sin(-start_node.GetPhi()) * px.at(i) +
+                               std::cos(-start_node.GetPhi()) * py.at(i) +
+                               start_node.GetY());
     shortest_path->phi.push_back(
-        common::math::NormalizeAngle(pphi.at(i) + start_node->GetPhi()));
+        common::math::NormalizeAngle(pphi.at(i) + start_node.GetPhi()));
   }
   shortest_path->gear = pgear;
   for (size_t i = 0; i < shortest_path->segs_lengths.size(); ++i) {
@@ -1206,14 +1206,14 @@ bool ReedShepp::SetRSPPar(const int size, const double* lengths,
   return true;
 }
 
-bool ReedShepp::GenerateRSPPar(const std::shared_ptr<Node3d> start_node,
-                               const std::shared_ptr<Node3d> end_node,
+bool ReedShepp::GenerateRSPPar(const Node3d& start_node,
+                               const Node3d& end_node,
                                std::vector<ReedSheppPath>* all_possible_paths) {
-  double dx = end_node->GetX() - start_node->GetX();
-  double dy = end_node->GetY() - start_node->GetY();
-  double dphi = end_node->GetPhi() - start_node->GetPhi();
-  double c = std::cos(start_node->GetPhi());
-  double s = std::sin(start_node->GetPhi());
+  double dx = end_node.GetX() - start_node.GetX();
+  double dy = end_node.GetY() - start_node.GetY();
+  double dphi = end_node.GetPhi() - start_node.GetPhi();
+  double c = std::cos(start_node.GetPhi());
+  double s = std::sin(start_node.GetPhi());
   // normalize the initial point to (0,0,0)
   double x = (c * dx + s * dy) * this->max_kappa_;
   double y = (-s * dx + c * dy) * this->max_kappa_;
@@ -96,7 +96,7 @@ TEST_F(reeds_shepp, test_set_1) {
   std::shared_ptr<ReedSheppPath> optimal_path =
       std::shared_ptr<ReedSheppPath>(
           new ReedSheppPath());
-  if (!reedshepp_test->ShortestRSP(start_node, end_node, optimal_path)) {
+  if (!reedshepp_test->ShortestRSP(*start_node, *end_node, optimal_path)) {
     ADEBUG << "generating short RSP not successful";
   }
   check(start_node, end_node, optimal_path);
@@ -112,7 +112,7 @@ TEST_F(reeds_shepp, test_set_2) {
                      XYbounds_, planner_open_space_config_));
   std::shared_ptr<ReedSheppPath> optimal_path =
       std::shared_ptr<ReedSheppPath>(new ReedSheppPath());
-  if (!reedshepp_test->ShortestRSP(start_node, end_node, optimal_path)) {
+  if (!reedshepp_test->ShortestRSP(*start_node, *end_node, optimal_path)) {
     ADEBUG << "generating short RSP not successful";
   }
   check(start_node, end_node, optimal_path);
@@ -128,7 +128,7 @@ TEST_F(reeds_shepp, test_set_3) {
                      XYbounds_, planner_open_space_config_));
   std::shared_ptr<ReedSheppPath> optimal_path =
       std::shared_ptr<ReedSheppPath>(new ReedSheppPath());
-  if (!reedshepp_test->ShortestRSP(start_node, end_node, optimal_path)) {
+  if (!reedshepp_test->ShortestRSP(*start_node, *end_node, optimal_path)) {
     ADEBUG << "generating short RSP not successful";
   }
   check(start_node, end_node, optimal_path);
@@ -144,7 +144,7 @@ TEST_F(reeds_shepp, test_set_4) {
                      XYbounds_, planner_open_space_config_));
   std::shared_ptr<ReedSheppPath> optimal_path =
       std::shared_ptr<ReedSheppPath>(new ReedSheppPath());
-  if (!reedshepp_test->ShortestRSP(start_node, end_node, optimal_path)) {
+  if (!reedshepp_test->ShortestRSP(*start_node, *end_node, optimal_path)) {
     ADEBUG << "generating short RSP not successful";
   }
   check(start_node, end_node, optimal_path);
@@ -160,7 +160,7 @@ TEST_F(reeds_shepp, test_set_5) {
                      XYbounds_, planner_open_space_config_));
   std::shared_ptr<ReedSheppPath> optimal_path =
       std::shared_ptr<ReedSheppPath>(new ReedSheppPath());
-  if (!reedshepp_test->ShortestRSP(start_node, end_node, optimal_path)) {
+  if (!reedshepp_test->ShortestRSP(*start_node, *end_node, optimal_path)) {
     ADEBUG << "generating short RSP not successful";
   }
   check(start_node, end_node, optimal_path);
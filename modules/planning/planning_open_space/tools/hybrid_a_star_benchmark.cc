@@ -0,0 +1,169 @@
+/******************************************************************************
+ * Copyright 2024 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/*
+ * @file
+ * @brief Plans into the slots of a parking lot with hybrid A* and reports the
+ * time to solution and the explored nodes per second.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+#include "gflags/gflags.h"
+
+#include "cyber/common/file.h"
+#include "cyber/common/log.h"
+#include "modules/common/math/vec2d.h"
+#include "modules/planning/planning_base/gflags/planning_gflags.h"
+#include "modules/planning/planning_open_space/coarse_trajectory_generator/hybrid_a_star.h"
+
+DEFINE_int32(hybrid_a_star_benchmark_cycles, 20,
+             "times to plan into every free slot of the lot");
+DEFINE_int32(hybrid_a_star_benchmark_slots, 5,
+             "number of slots of the lot, every other one is free");
+
+namespace apollo {
+namespace planning {
+namespace {
+
+using apollo::common::math::Vec2d;
+
+// a row of perpendicular slots below a 7m wide lane
+constexpr double kSlotWidth = 3.0;
+constexpr double kSlotDepth = 5.5;
+constexpr double kLaneWidth = 7.0;
+constexpr double kParkedCarWidth = 1.9;
+constexpr double kParkedCarLength = 4.8;
+
+std::vector<Vec2d> Box(const double center_x, const double center_y,
+                       const double half_x, const double half_y) {
+  // closed polygon, the planner takes consecutive vertices as edges
+  return {Vec2d(center_x - half_x, center_y - half_y),
+          Vec2d(center_x + half_x, center_y - half_y),
+          Vec2d(center_x + half_x, center_y + half_y),
+          Vec2d(center_x - half_x, center_y + half_y),
+          Vec2d(center_x - half_x, center_y - half_y)};
+}
+
+struct ParkingLot {
+  std::vector<double> XYbounds;
+  std::vector<std::vector<Vec2d>> obstacles;
+  // centers of the free slots
+  std::vector<double> free_slot_x;
+};
+
+ParkingLot BuildParkingLot(const int slot_num) {
+  ParkingLot lot;
+  const double lot_length = slot_num * kSlotWidth;
+  const double x_min = -lot_length / 2.0 - 10.0;
+  const double x_max = lot_length / 2.0 + 10.0;
+  lot.XYbounds = {x_min, x_max, -kSlotDepth - 1.0, kLaneWidth + 1.0};
+  // curb behind the slots and the boundary across the lane
+  lot.obstacles.push_back(
+      {Vec2d(x_min, -kSlotDepth), Vec2d(x_max, -kSlotDepth)});
+  lot.obstacles.push_back(
+      {Vec2d(x_min, kLaneWidth), Vec2d(x_max, kLaneWidth)});
+  for (int i = 0; i < slot_num; ++i) {
+    const double slot_x = -lot_length / 2.0 + (i + 0.5) * kSlotWidth;
+    if (i % 2 == 0) {
+      lot.obstacles.push_back(Box(slot_x, -kSlotDepth / 2.0,
+                                  kParkedCarWidth / 2.0,
+                                  kParkedCarLength / 2.0));
+    } else {
+      lot.free_slot_x.push_back(slot_x);
+    }
+  }
+  return lot;
+}
+
+double Percentile(std::vector<double> values, const double ratio) {
+  std::sort(values.begin(), values.end());
+  const size_t index = std::min(
+      values.size() - 1, static_cast<size_t>(ratio * values.size()));
+  return values[index];
+}
+
+bool Run() {
+  PlannerOpenSpaceConfig planner_open_space_config;
+  if (!cyber::common::GetProtoFromFile(
+          FLAGS_planner_open_space_config_filename,
+          &planner_open_space_config)) {
+    AERROR << "Failed to load open space config file "
+           << FLAGS_planner_open_space_config_filename;
+    return false;
+  }
+  HybridAStar hybrid_a_star(planner_open_space_config);
+  const ParkingLot lot = BuildParkingLot(FLAGS_hybrid_a_star_benchmark_slots);
+  if (lot.free_slot_x.empty()) {
+    AERROR << "The parking lot has no free slot.";
+    return false;
+  }
+
+  std::vector<double> time_ms;
+  size_t explored_node_num = 0;
+  int failed_num = 0;
+  for (int cycle = 0; cycle < FLAGS_hybrid_a_star_benchmark_cycles; ++cycle) {
+    for (const double slot_x : lot.free_slot_x) {
+      HybridAStartResult result;
+      const auto start = std::chrono::steady_clock::now();
+      // from the lane into the slot, backwards
+      const bool success = hybrid_a_star.Plan(
+          lot.XYbounds[0] + 3.0, kLaneWidth / 2.0, 0.0, slot_x,
+          -kSlotDepth / 2.0, M_PI_2, lot.XYbounds, lot.obstacles, &result);
+      time_ms.push_back(std::chrono::duration<double, std::milli>(
+                            std::chrono::steady_clock::now() - start)
+                            .count());
+      explored_node_num += hybrid_a_star.explored_node_num();
+      if (!success) {
+        ++failed_num;
+      }
+    }
+  }
+  if (time_ms.empty()) {
+    return false;
+  }
+
+  double total_ms = 0.0;
+  for (const double t : time_ms) {
+    total_ms += t;
+  }
+  std::printf(
+      "plans: %zu, failed: %d\n"
+      "time to solution ms: mean %.3f, p50 %.3f, p99 %.3f, max %.3f\n"
+      "explored nodes: %.1f per plan, %.0f per second\n",
+      time_ms.size(), failed_num, total_ms / time_ms.size(),
+      Percentile(time_ms, 0.5), Percentile(time_ms, 0.99),
+      Percentile(time_ms, 1.0),
+      static_cast<double>(explored_node_num) / time_ms.size(),
+      explored_node_num / (total_ms / 1000.0));
+  return failed_num == 0;
+}
+
+}  // namespace
+}  // namespace planning
+}  // namespace apollo
+
+int main(int argc, char* argv[]) {
+  FLAGS_planner_open_space_config_filename =
+      "modules/planning/planning_base/testdata/conf/"
+      "open_space_standard_parking_lot.pb.txt";
+  google::ParseCommandLineFlags(&argc, &argv, true);
+  return apollo::planning::Run() ? 0 : 1;
+}
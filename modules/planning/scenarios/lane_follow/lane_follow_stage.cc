@@ -20,6 +20,7 @@
 
 #include "modules/planning/scenarios/lane_follow/lane_follow_stage.h"
 
+#include <future>
 #include <utility>
 
 #include "cyber/common/log.h"
@@ -32,6 +33,7 @@
 #include "modules/map/hdmap/hdmap_common.h"
 #include "modules/planning/planning_base/common/ego_info.h"
 #include "modules/planning/planning_base/common/frame.h"
+#include "modules/planning/planning_base/common/planning_context.h"
 #include "modules/planning/planning_base/common/speed_profile_generator.h"
 #include "modules/planning/planning_base/gflags/planning_gflags.h"
 #include "modules/planning/planning_base/math/constraint_checker/constraint_checker.h"
@@ -49,8 +51,72 @@ using apollo::cyber::Clock;
 
 namespace {
 constexpr double kStraightForwardLineCost = 10.0;
+// lane follow plans the current lane and the lanes on both sides at most
+constexpr size_t kMaxParallelReferenceLines = 3;
+
+// copy the status fields changed from base into merged
+void MergeChangedStatus(const PlanningStatus& base,
+                        const PlanningStatus& changed,
+                        PlanningStatus* merged) {
+  const auto* descriptor = PlanningStatus::descriptor();
+  const auto* reflection = PlanningStatus::GetReflection();
+  for (int i = 0; i < descriptor->field_count(); ++i) {
+    // every field of the status is a singular message
+    const auto* field = descriptor->field(i);
+    const bool has_field = reflection->HasField(changed, field);
+    if (has_field == reflection->HasField(base, field) &&
+        (!has_field || reflection->GetMessage(changed, field)
+                               .SerializeAsString() ==
+                           reflection->GetMessage(base, field)
+                               .SerializeAsString())) {
+      continue;
+    }
+    if (has_field) {
+      reflection->MutableMessage(merged, field)
+          ->CopyFrom(reflection->GetMessage(changed, field));
+    } else {
+      reflection->ClearField(merged, field);
+    }
+  }
+}
 }  // namespace
 
+bool LaneFollowStage::Init(const StagePipeline& config,
+                           const std::shared_ptr<DependencyInjector>& injector,
+                           const std::string& config_dir, void* context) {
+  if (!Stage::Init(config, injector, config_dir, context)) {
+    return false;
+  }
+  if (!FLAGS_enable_parallel_reference_line_planning) {
+    return true;
+  }
+  std::vector<std::shared_ptr<Task>> tasks = task_list_;
+  tasks.push_back(fallback_task_);
+  for (const auto& task : tasks) {
+    if (!task->IsReferenceLineLocal()) {
+      AWARN << "Task " << task->Name() << " of " << Name()
+            << " is not audited to plan reference lines in parallel, plan "
+               "them one by one.";
+      return true;
+    }
+  }
+  pipelines_.push_back({injector_, task_list_, fallback_task_});
+  while (pipelines_.size() < kMaxParallelReferenceLines) {
+    TaskPipeline pipeline;
+    pipeline.injector = injector_->Fork();
+    if (!CreateTasks(pipeline.injector, &pipeline.task_list,
+                     &pipeline.fallback_task)) {
+      AERROR << "Create task pipeline of " << Name() << " failed!";
+      return false;
+    }
+    pipelines_.push_back(std::move(pipeline));
+  }
+  // the first reference line is planned on the calling thread, a pool of our
+  // own keeps the tasks of the other lines off the one they wait for
+  thread_pool_.reset(new cyber::base::ThreadPool(pipelines_.size() - 1));
+  return true;
+}
+
 void LaneFollowStage::RecordObstacleDebugInfo(
     ReferenceLineInfo* reference_line_info) {
   if (!FLAGS_enable_record_debug) {
@@ -85,11 +151,16 @@ StageResult LaneFollowStage::Process(
     return StageResult(StageStatusType::FINISHED);
   }
 
-  bool has_drivable_reference_line = false;
-
   ADEBUG << "Number of reference lines:\t"
          << frame->mutable_reference_line_info()->size();
 
+  const size_t reference_line_num = frame->reference_line_info().size();
+  if (reference_line_num > 1 && reference_line_num <= pipelines_.size()) {
+    return ProcessInParallel(planning_start_point, frame);
+  }
+
+  bool has_drivable_reference_line = false;
+
   unsigned int count = 0;
   StageResult result;
   for (auto& reference_line_info : *frame->mutable_reference_line_info()) {
@@ -107,25 +178,62 @@ StageResult LaneFollowStage::Process(
 
     result =
         PlanOnReferenceLine(planning_start_point, frame, &reference_line_info);
+    has_drivable_reference_line = DecideDrivable(result, &reference_line_info);
+  }
 
-    if (!result.HasError()) {
-      if (!reference_line_info.IsChangeLanePath()) {
-        ADEBUG << "reference line is NOT lane change ref.";
-        has_drivable_reference_line = true;
-        continue;
-      }
-      if (reference_line_info.Cost() < kStraightForwardLineCost) {
-        // If the path and speed optimization succeed on target lane while
-        // under smart lane-change or IsClearToChangeLane under older version
-        has_drivable_reference_line = true;
-        reference_line_info.SetDrivable(true);
-      } else {
-        reference_line_info.SetDrivable(false);
-        ADEBUG << "\tlane change failed";
-      }
-    } else {
-      reference_line_info.SetDrivable(false);
+  return has_drivable_reference_line
+             ? result.SetStageStatus(StageStatusType::RUNNING)
+             : result.SetStageStatus(StageStatusType::ERROR);
+}
+
+StageResult LaneFollowStage::ProcessInParallel(
+    const TrajectoryPoint& planning_start_point, Frame* frame) {
+  auto* reference_line_infos = frame->mutable_reference_line_info();
+  const size_t reference_line_num = reference_line_infos->size();
+  std::vector<ReferenceLineInfo*> lines;
+  for (auto& reference_line_info : *reference_line_infos) {
+    lines.push_back(&reference_line_info);
+  }
+
+  // every line starts from the status the last cycle left
+  const PlanningStatus base_status =
+      injector_->planning_context()->planning_status();
+  std::vector<std::future<StageResult>> futures;
+  for (size_t i = 1; i < reference_line_num; ++i) {
+    *pipelines_[i].injector->planning_context()->mutable_planning_status() =
+        base_status;
+    futures.push_back(thread_pool_->Enqueue(
+        [this, &planning_start_point, frame, &lines, i]() {
+          return PlanOnReferenceLine(planning_start_point, frame, lines[i],
+                                     pipelines_[i]);
+        }));
+  }
+  std::vector<StageResult> results;
+  results.push_back(PlanOnReferenceLine(planning_start_point, frame, lines[0],
+                                        pipelines_[0]));
+  for (auto& future : futures) {
+    results.push_back(future.get());
+  }
+
+  // decide as planning the lines one by one does, the status changes of the
+  // lines after the first drivable one are dropped
+  bool has_drivable_reference_line = false;
+  StageResult result;
+  for (size_t i = 0; i < reference_line_num; ++i) {
+    if (has_drivable_reference_line) {
+      lines[i]->SetDrivable(false);
+      continue;
     }
+    ADEBUG << "No: [" << i + 1 << "] Reference Line.";
+    ADEBUG << "IsChangeLanePath: " << lines[i]->IsChangeLanePath();
+    if (i > 0) {
+      MergeChangedStatus(
+          base_status,
+          pipelines_[i].injector->planning_context()->planning_status(),
+          injector_->planning_context()->mutable_planning_status());
+    }
+    result = results[i];
+    has_drivable_reference_line = DecideDrivable(result, lines[i]);
   }
 
   return has_drivable_reference_line
@@ -133,9 +241,37 @@ StageResult LaneFollowStage::Process(
              : result.SetStageStatus(StageStatusType::ERROR);
 }
 
+bool LaneFollowStage::DecideDrivable(
+    const StageResult& result, ReferenceLineInfo* reference_line_info) const {
+  if (result.HasError()) {
+    reference_line_info->SetDrivable(false);
+    return false;
+  }
+  if (!reference_line_info->IsChangeLanePath()) {
+    ADEBUG << "reference line is NOT lane change ref.";
+    return true;
+  }
+  if (reference_line_info->Cost() < kStraightForwardLineCost) {
+    // If the path and speed optimization succeed on target lane while
+    // under smart lane-change or IsClearToChangeLane under older version
+    reference_line_info->SetDrivable(true);
+    return true;
+  }
+  reference_line_info->SetDrivable(false);
+  ADEBUG << "\tlane change failed";
+  return false;
+}
+
 StageResult LaneFollowStage::PlanOnReferenceLine(
     const TrajectoryPoint& planning_start_point, Frame* frame,
     ReferenceLineInfo* reference_line_info) {
+  return PlanOnReferenceLine(planning_start_point, frame, reference_line_info,
+                             {injector_, task_list_, fallback_task_});
+}
+
+StageResult LaneFollowStage::PlanOnReferenceLine(
+    const TrajectoryPoint& planning_start_point, Frame* frame,
+    ReferenceLineInfo* reference_line_info, const TaskPipeline& pipeline) {
   if (!reference_line_info->IsChangeLanePath()) {
     reference_line_info->AddCost(kStraightForwardLineCost);
   }
@@ -144,7 +280,7 @@ StageResult LaneFollowStage::PlanOnReferenceLine(
          << reference_line_info->IsChangeLanePath();
 
   StageResult ret;
-  for (auto task : task_list_) {
+  for (auto task : pipeline.task_list) {
     const double start_timestamp = Clock::NowInSeconds();
     const auto start_planning_perf_timestamp =
         std::chrono::duration<double>(
@@ -188,7 +324,7 @@ StageResult LaneFollowStage::PlanOnReferenceLine(
   // check path and speed results for path or speed fallback
   reference_line_info->set_trajectory_type(ADCTrajectory::NORMAL);
   if (ret.IsTaskError()) {
-    fallback_task_->Execute(frame, reference_line_info);
+    pipeline.fallback_task->Execute(frame, reference_line_info);
   }
 
   DiscretizedTrajectory trajectory;
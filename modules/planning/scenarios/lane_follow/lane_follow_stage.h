@@ -26,6 +26,7 @@
 
 #include "modules/common_msgs/basic_msgs/pnc_point.pb.h"
 #include "modules/common_msgs/planning_msgs/planning.pb.h"
+#include "cyber/base/thread_pool.h"
 #include "cyber/plugin_manager/plugin_manager.h"
 #include "modules/common/status/status.h"
 #include "modules/planning/planning_base/common/reference_line_info.h"
@@ -38,6 +39,10 @@ namespace planning {
 
 class LaneFollowStage : public Stage {
  public:
+  bool Init(const StagePipeline& config,
+            const std::shared_ptr<DependencyInjector>& injector,
+            const std::string& config_dir, void* context) override;
+
   StageResult Process(const common::TrajectoryPoint& planning_init_point,
                       Frame* frame) override;
 
@@ -53,6 +58,43 @@ class LaneFollowStage : public Stage {
                             const ReferenceLine& reference_line) const;
 
   void RecordObstacleDebugInfo(ReferenceLineInfo* reference_line_info);
+
+ protected:
+  /**
+   * @brief The tasks planning one reference line, with the injector they
+   * are initialized with.
+   */
+  struct TaskPipeline {
+    std::shared_ptr<DependencyInjector> injector;
+    std::vector<std::shared_ptr<Task>> task_list;
+    std::shared_ptr<Task> fallback_task;
+  };
+
+  StageResult PlanOnReferenceLine(
+      const common::TrajectoryPoint& planning_start_point, Frame* frame,
+      ReferenceLineInfo* reference_line_info, const TaskPipeline& pipeline);
+
+  /**
+   * @brief Plan every reference line with a pipeline of its own, all from the
+   * planning status of the last cycle. The status changes of the lines which
+   * would have been planned one by one are merged in reference line order.
+   * Unlike the serial loop, a line does not see the status changes of the
+   * lines before it in the same cycle.
+   */
+  StageResult ProcessInParallel(
+      const common::TrajectoryPoint& planning_start_point, Frame* frame);
+
+  /**
+   * @brief Mark the reference line drivable or not from the result planning
+   * it, returns true if the vehicle can drive on it.
+   */
+  bool DecideDrivable(const StageResult& result,
+                      ReferenceLineInfo* reference_line_info) const;
+
+  // the first pipeline is the one of the stage itself, empty unless reference
+  // lines are planned in parallel
+  std::vector<TaskPipeline> pipelines_;
+  std::unique_ptr<cyber::base::ThreadPool> thread_pool_;
 };
 
 CYBER_PLUGIN_MANAGER_REGISTER_PLUGIN(apollo::planning::LaneFollowStage, Stage)
@@ -0,0 +1,138 @@
+/******************************************************************************
+ * Copyright 2024 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Cycle time of the lane follow stage with 1, 2 and 3 reference lines,
+ * planned one by one and in parallel. The tasks spin for a fixed time, the
+ * lines carry no path so the stage ends in error right after them.
+ **/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+#include "gflags/gflags.h"
+
+#include "cyber/common/log.h"
+#include "modules/planning/planning_base/common/frame.h"
+#include "modules/planning/planning_interface_base/task_base/task.h"
+#include "modules/planning/scenarios/lane_follow/lane_follow_stage.h"
+
+DEFINE_int32(benchmark_task_num, 10, "tasks of the stage pipeline");
+DEFINE_int32(benchmark_task_time_us, 2000, "time each task spins");
+DEFINE_int32(benchmark_cycles, 200, "planning cycles of every case");
+
+namespace apollo {
+namespace planning {
+
+using apollo::common::Status;
+using apollo::common::TrajectoryPoint;
+
+class SpinTask : public Task {
+ public:
+  explicit SpinTask(const std::string& name) { name_ = name; }
+
+  bool IsReferenceLineLocal() const override { return true; }
+
+  Status Execute(Frame* frame,
+                 ReferenceLineInfo* reference_line_info) override {
+    const auto end = std::chrono::steady_clock::now() +
+                     std::chrono::microseconds(FLAGS_benchmark_task_time_us);
+    while (std::chrono::steady_clock::now() < end) {
+    }
+    return Status::OK();
+  }
+};
+
+class LaneFollowStageBenchmark : public LaneFollowStage {
+ public:
+  explicit LaneFollowStageBenchmark(bool parallel) {
+    injector_ = std::make_shared<DependencyInjector>();
+    CreateSpinTasks(&task_list_, &fallback_task_);
+    if (!parallel) {
+      return;
+    }
+    pipelines_.push_back({injector_, task_list_, fallback_task_});
+    for (int i = 1; i < 3; ++i) {
+      TaskPipeline pipeline;
+      pipeline.injector = injector_->Fork();
+      CreateSpinTasks(&pipeline.task_list, &pipeline.fallback_task);
+      pipelines_.push_back(std::move(pipeline));
+    }
+    thread_pool_.reset(new cyber::base::ThreadPool(pipelines_.size() - 1));
+  }
+
+ private:
+  static void CreateSpinTasks(std::vector<std::shared_ptr<Task>>* task_list,
+                              std::shared_ptr<Task>* fallback_task) {
+    for (int i = 0; i < FLAGS_benchmark_task_num; ++i) {
+      task_list->push_back(
+          std::make_shared<SpinTask>("SPIN_TASK_" + std::to_string(i)));
+    }
+    *fallback_task = std::make_shared<SpinTask>("SPIN_FALLBACK");
+  }
+};
+
+void RunCase(bool parallel, int reference_line_num) {
+  LaneFollowStageBenchmark stage(parallel);
+  TrajectoryPoint planning_start_point;
+  std::vector<double> cycle_ms;
+  for (int i = 0; i < FLAGS_benchmark_cycles; ++i) {
+    Frame frame(i);
+    for (int j = 0; j < reference_line_num; ++j) {
+      frame.mutable_reference_line_info()->emplace_back();
+    }
+    const auto start = std::chrono::steady_clock::now();
+    stage.Process(planning_start_point, &frame);
+    cycle_ms.push_back(std::chrono::duration<double, std::milli>(
+                           std::chrono::steady_clock::now() - start)
+                           .count());
+  }
+  std::sort(cycle_ms.begin(), cycle_ms.end());
+  double total_ms = 0.0;
+  for (double ms : cycle_ms) {
+    total_ms += ms;
+  }
+  const size_t p99 = std::min(cycle_ms.size() - 1, cycle_ms.size() * 99 / 100);
+  printf("%-9s %15d %10.3f %10.3f %10.3f\n",
+         parallel ? "parallel" : "serial", reference_line_num,
+         total_ms / cycle_ms.size(), cycle_ms[cycle_ms.size() / 2],
+         cycle_ms[p99]);
+}
+
+}  // namespace planning
+}  // namespace apollo
+
+int main(int argc, char* argv[]) {
+  google::InitGoogleLogging(argv[0]);
+  google::ParseCommandLineFlags(&argc, &argv, true);
+  if (FLAGS_benchmark_cycles <= 0) {
+    AERROR << "need --benchmark_cycles greater than 0";
+    return -1;
+  }
+
+  printf("%-9s %15s %10s %10s %10s\n", "mode", "reference_lines",
+         "mean_ms", "p50_ms", "p99_ms");
+  for (int reference_line_num = 1; reference_line_num <= 3;
+       ++reference_line_num) {
+    apollo::planning::RunCase(false, reference_line_num);
+    apollo::planning::RunCase(true, reference_line_num);
+  }
+  return 0;
+}
@@ -0,0 +1,164 @@
+/******************************************************************************
+ * Copyright 2024 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ **/
+
+#include "modules/planning/scenarios/lane_follow/lane_follow_stage.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "modules/planning/planning_base/common/frame.h"
+#include "modules/planning/planning_base/common/planning_context.h"
+
+namespace apollo {
+namespace planning {
+
+using apollo::common::Status;
+using apollo::common::TrajectoryPoint;
+
+namespace {
+
+int IndexOf(const Frame& frame, const ReferenceLineInfo* reference_line_info) {
+  int index = 0;
+  for (const auto& info : frame.reference_line_info()) {
+    if (&info == reference_line_info) {
+      return index;
+    }
+    ++index;
+  }
+  return -1;
+}
+
+// keeps its state across cycles in the planning status as the audited lane
+// follow tasks do: a block counter on the first line and the change lane
+// status on the second one
+class StatusTask : public Task {
+ public:
+  StatusTask(const std::string& name,
+             const std::shared_ptr<DependencyInjector>& injector) {
+    name_ = name;
+    injector_ = injector;
+  }
+
+  bool IsReferenceLineLocal() const override { return true; }
+
+  Status Execute(Frame* frame,
+                 ReferenceLineInfo* reference_line_info) override {
+    auto* planning_status =
+        injector_->planning_context()->mutable_planning_status();
+    const int index = IndexOf(*frame, reference_line_info);
+    if (index == 0) {
+      auto* path_decider = planning_status->mutable_path_decider();
+      path_decider->set_front_static_obstacle_cycle_counter(
+          path_decider->front_static_obstacle_cycle_counter() + 1);
+      path_decider->set_front_static_obstacle_id("obstacle_0");
+    } else if (index == 1) {
+      auto* change_lane = planning_status->mutable_change_lane();
+      change_lane->set_status(ChangeLaneStatus::IN_CHANGE_LANE);
+      change_lane->set_path_id("line_" + std::to_string(frame->SequenceNum()));
+    }
+    reference_line_info->AddCost(index);
+    return Status::OK();
+  }
+};
+
+class LaneFollowStageTestable : public LaneFollowStage {
+ public:
+  explicit LaneFollowStageTestable(bool parallel) {
+    injector_ = std::make_shared<DependencyInjector>();
+    CreateStatusTasks(injector_, &task_list_, &fallback_task_);
+    if (!parallel) {
+      return;
+    }
+    pipelines_.push_back({injector_, task_list_, fallback_task_});
+    for (int i = 1; i < 3; ++i) {
+      TaskPipeline pipeline;
+      pipeline.injector = injector_->Fork();
+      CreateStatusTasks(pipeline.injector, &pipeline.task_list,
+                        &pipeline.fallback_task);
+      pipelines_.push_back(std::move(pipeline));
+    }
+    thread_pool_.reset(new cyber::base::ThreadPool(pipelines_.size() - 1));
+  }
+
+  const PlanningStatus& planning_status() {
+    return injector_->planning_context()->planning_status();
+  }
+
+ private:
+  static void CreateStatusTasks(
+      const std::shared_ptr<DependencyInjector>& injector,
+      std::vector<std::shared_ptr<Task>>* task_list,
+      std::shared_ptr<Task>* fallback_task) {
+    task_list->push_back(
+        std::make_shared<StatusTask>("STATUS_TASK", injector));
+    *fallback_task =
+        std::make_shared<StatusTask>("STATUS_FALLBACK", injector);
+  }
+};
+
+}  // namespace
+
+TEST(LaneFollowStageTest, parallel_as_serial) {
+  LaneFollowStageTestable serial(false);
+  LaneFollowStageTestable parallel(true);
+  TrajectoryPoint planning_start_point;
+
+  // the count of reference lines changes between cycles, as it does when a
+  // lane change starts and finishes
+  const std::vector<int> reference_line_nums = {2, 2, 1, 2, 1, 1, 2};
+  for (size_t cycle = 0; cycle < reference_line_nums.size(); ++cycle) {
+    Frame serial_frame(cycle);
+    Frame parallel_frame(cycle);
+    for (int i = 0; i < reference_line_nums[cycle]; ++i) {
+      serial_frame.mutable_reference_line_info()->emplace_back();
+      parallel_frame.mutable_reference_line_info()->emplace_back();
+    }
+
+    auto serial_result = serial.Process(planning_start_point, &serial_frame);
+    auto parallel_result =
+        parallel.Process(planning_start_point, &parallel_frame);
+    EXPECT_EQ(serial_result.GetStageStatus(),
+              parallel_result.GetStageStatus());
+    EXPECT_EQ(serial_result.HasError(), parallel_result.HasError());
+
+    auto serial_line = serial_frame.reference_line_info().begin();
+    auto parallel_line = parallel_frame.reference_line_info().begin();
+    for (; serial_line != serial_frame.reference_line_info().end();
+         ++serial_line, ++parallel_line) {
+      EXPECT_EQ(serial_line->IsDrivable(), parallel_line->IsDrivable());
+      EXPECT_DOUBLE_EQ(serial_line->Cost(), parallel_line->Cost());
+    }
+    EXPECT_EQ(serial.planning_status().SerializeAsString(),
+              parallel.planning_status().SerializeAsString())
+        << "cycle " << cycle << "\nserial:\n"
+        << serial.planning_status().DebugString() << "parallel:\n"
+        << parallel.planning_status().DebugString();
+  }
+  EXPECT_EQ(parallel.planning_status()
+                .path_decider()
+                .front_static_obstacle_cycle_counter(),
+            static_cast<int>(reference_line_nums.size()));
+}
+
+}  // namespace planning
+}  // namespace apollo
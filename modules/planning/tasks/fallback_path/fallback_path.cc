@@ -112,9 +112,11 @@ bool FallbackPath::OptimizePath(
     std::vector<double> ref_l(path_boundary_size, 0);
     std::vector<double> weight_ref_l(path_boundary_size,
                                      config.path_reference_l_weight());
+    const auto warm_start = StitchPreviousPath(path_boundary);
     bool res_opt = PathOptimizerUtil::OptimizePath(
         init_sl_state_, end_state, ref_l, weight_ref_l, path_boundary,
-        ddl_bounds, jerk_bound, config, &opt_l, &opt_dl, &opt_ddl);
+        ddl_bounds, jerk_bound, config, &opt_l, &opt_dl, &opt_ddl,
+        &solver_session_, &warm_start);
     if (res_opt) {
       auto frenet_frame_path = PathOptimizerUtil::ToPiecewiseJerkPath(
           opt_l, opt_dl, opt_ddl, path_boundary.delta_s(),
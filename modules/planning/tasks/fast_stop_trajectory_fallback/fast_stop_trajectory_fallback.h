@@ -32,6 +32,9 @@ namespace apollo {
 namespace planning {
 
 class FastStopTrajectoryFallback : public TrajectoryFallbackTask {
+ public:
+  bool IsReferenceLineLocal() const override { return true; }
+
  private:
   SpeedData GenerateFallbackSpeed(const EgoInfo* ego_info,
                                   const double stop_distance = 0.0) override;
@@ -50,6 +50,15 @@ bool LaneBorrowPath::Init(const std::string& config_dir,
   if (!Task::Init(config_dir, name, injector)) {
     return false;
   }
+  // The hysteresis is kept in the planning status so that the reference
+  // lines planned in parallel share it, but it starts over with every task
+  // instance like the members it replaced.
+  auto* mutable_path_decider_status = injector_->planning_context()
+                                          ->mutable_planning_status()
+                                          ->mutable_path_decider();
+  mutable_path_decider_status->set_able_to_use_self_lane_counter(0);
+  mutable_path_decider_status->set_left_borrow(false);
+  mutable_path_decider_status->set_right_borrow(false);
   // Load the config this task.
   return Task::LoadConfig<LaneBorrowPathConfig>(&config_);
 }
@@ -85,7 +94,8 @@ apollo::common::Status LaneBorrowPath::Process(
 }
 
 bool LaneBorrowPath::DecidePathBounds(std::vector<PathBoundary>* boundary) {
-  for (size_t i = 0; i < decided_side_pass_direction_.size(); i++) {
+  const auto decided_side_pass_direction = GetDecidedSidePassDirection();
+  for (size_t i = 0; i < decided_side_pass_direction.size(); i++) {
     boundary->emplace_back();
     auto& path_bound = boundary->back();
     std::string blocking_obstacle_id = "";
@@ -100,7 +110,7 @@ bool LaneBorrowPath::DecidePathBounds(std::vector<PathBoundary>* boundary) {
       continue;
     }
     // 2. Decide a rough boundary based on lane info and ADC's position
-    if (!GetBoundaryFromNeighborLane(decided_side_pass_direction_[i],
+    if (!GetBoundaryFromNeighborLane(decided_side_pass_direction[i],
                                      &path_bound, &borrow_lane_type)) {
       AERROR << "Failed to decide a rough boundary based on lane and adc.";
       boundary->pop_back();
@@ -108,7 +118,7 @@ bool LaneBorrowPath::DecidePathBounds(std::vector<PathBoundary>* boundary) {
     }
 
     std::string label;
-    if (decided_side_pass_direction_[i] == SidePassDirection::LEFT_BORROW) {
+    if (decided_side_pass_direction[i] == SidePassDirection::LEFT_BORROW) {
       label = "regular/left" + borrow_lane_type;
     } else {
       label = "regular/right" + borrow_lane_type;
@@ -166,9 +176,11 @@ bool LaneBorrowPath::OptimizePath(
     PathOptimizerUtil::UpdatePathRefWithBound(
         path_boundary, config.path_reference_l_weight(), &ref_l, &weight_ref_l);
 
+    const auto warm_start = StitchPreviousPath(path_boundary);
     bool res_opt = PathOptimizerUtil::OptimizePath(
         init_sl_state_, end_state, ref_l, weight_ref_l, path_boundary,
-        ddl_bounds, jerk_bound, config, &opt_l, &opt_dl, &opt_ddl);
+        ddl_bounds, jerk_bound, config, &opt_l, &opt_dl, &opt_ddl,
+        &solver_session_, &warm_start);
     if (res_opt) {
       auto frenet_frame_path = PathOptimizerUtil::ToPiecewiseJerkPath(
           opt_l, opt_dl, opt_ddl, path_boundary.delta_s(),
@@ -346,14 +358,31 @@ bool LaneBorrowPath::GetBoundaryFromNeighborLane(
 }
 void LaneBorrowPath::UpdateSelfPathInfo() {
   auto cur_path = reference_line_info_->path_data();
+  auto* mutable_path_decider_status = injector_->planning_context()
+                                          ->mutable_planning_status()
+                                          ->mutable_path_decider();
   if (!cur_path.Empty() &&
       cur_path.path_label().find("self") != std::string::npos &&
       cur_path.blocking_obstacle_id().empty()) {
-    use_self_lane_ = std::min(use_self_lane_ + 1, 10);
+    mutable_path_decider_status->set_able_to_use_self_lane_counter(std::min(
+        mutable_path_decider_status->able_to_use_self_lane_counter() + 1, 10));
   } else {
-    use_self_lane_ = 0;
+    mutable_path_decider_status->set_able_to_use_self_lane_counter(0);
+  }
+}
+
+std::vector<SidePassDirection> LaneBorrowPath::GetDecidedSidePassDirection()
+    const {
+  const auto& path_decider_status =
+      injector_->planning_context()->planning_status().path_decider();
+  std::vector<SidePassDirection> decided_side_pass_direction;
+  if (path_decider_status.left_borrow()) {
+    decided_side_pass_direction.push_back(SidePassDirection::LEFT_BORROW);
   }
-  blocking_obstacle_id_ = cur_path.blocking_obstacle_id();
+  if (path_decider_status.right_borrow()) {
+    decided_side_pass_direction.push_back(SidePassDirection::RIGHT_BORROW);
+  }
+  return decided_side_pass_direction;
 }
 bool LaneBorrowPath::IsNecessaryToBorrowLane() {
   auto* mutable_path_decider_status = injector_->planning_context()
@@ -362,11 +391,12 @@ bool LaneBorrowPath::IsNecessaryToBorrowLane() {
   if (mutable_path_decider_status->is_in_path_lane_borrow_scenario()) {
     UpdateSelfPathInfo();
     // If originally borrowing neighbor lane:
-    if (use_self_lane_ >= 6) {
+    if (mutable_path_decider_status->able_to_use_self_lane_counter() >= 6) {
       // If have been able to use self-lane for some time, then switch to
       // non-lane-borrowing.
       mutable_path_decider_status->set_is_in_path_lane_borrow_scenario(false);
-      decided_side_pass_direction_.clear();
+      mutable_path_decider_status->set_left_borrow(false);
+      mutable_path_decider_status->set_right_borrow(false);
       AINFO << "Switch from LANE-BORROW path to SELF-LANE path.";
     }
   } else {
@@ -396,7 +426,8 @@ bool LaneBorrowPath::IsNecessaryToBorrowLane() {
     }
 
     // switch to lane-borrowing
-    if (decided_side_pass_direction_.empty()) {
+    if (!mutable_path_decider_status->left_borrow() &&
+        !mutable_path_decider_status->right_borrow()) {
       // first time init decided_side_pass_direction
       bool left_borrowable;
       bool right_borrowable;
@@ -408,17 +439,11 @@ bool LaneBorrowPath::IsNecessaryToBorrowLane() {
         return false;
       } else {
         mutable_path_decider_status->set_is_in_path_lane_borrow_scenario(true);
-        if (left_borrowable) {
-          decided_side_pass_direction_.push_back(
-              SidePassDirection::LEFT_BORROW);
-        }
-        if (right_borrowable) {
-          decided_side_pass_direction_.push_back(
-              SidePassDirection::RIGHT_BORROW);
-        }
+        mutable_path_decider_status->set_left_borrow(left_borrowable);
+        mutable_path_decider_status->set_right_borrow(right_borrowable);
       }
     }
-    use_self_lane_ = 0;
+    mutable_path_decider_status->set_able_to_use_self_lane_counter(0);
     AINFO << "Switch from SELF-LANE path to LANE-BORROW path.";
   }
   return mutable_path_decider_status->is_in_path_lane_borrow_scenario();
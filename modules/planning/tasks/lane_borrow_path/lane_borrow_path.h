@@ -37,6 +37,8 @@ class LaneBorrowPath : public PathGeneration {
   bool Init(const std::string& config_dir, const std::string& name,
             const std::shared_ptr<DependencyInjector>& injector) override;
 
+  bool IsReferenceLineLocal() const override { return true; }
+
  private:
   apollo::common::Status Process(
       Frame* frame, ReferenceLineInfo* reference_line_info) override;
@@ -116,10 +118,12 @@ class LaneBorrowPath : public PathGeneration {
    * @param lane_borrow_info is borrow side.
    */
   void SetPathInfo(PathData* const path_data);
+  /**
+   * @brief The borrow sides decided when switching to lane borrow, kept in
+   * the path decider status across cycles.
+   */
+  std::vector<SidePassDirection> GetDecidedSidePassDirection() const;
   LaneBorrowPathConfig config_;
-  std::vector<SidePassDirection> decided_side_pass_direction_;
-  int use_self_lane_;
-  std::string blocking_obstacle_id_;
 };
 
 /////////////////////////////////////////////////////////////////////////////
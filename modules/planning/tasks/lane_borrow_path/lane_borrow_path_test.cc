@@ -0,0 +1,56 @@
+/******************************************************************************
+ * Copyright 2024 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/planning/tasks/lane_borrow_path/lane_borrow_path.h"
+
+#include <memory>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace planning {
+
+class LaneBorrowPathTest : public ::testing::Test {
+ public:
+  virtual void SetUp() { injector_ = std::make_shared<DependencyInjector>(); }
+
+ protected:
+  std::shared_ptr<DependencyInjector> injector_;
+};
+
+TEST_F(LaneBorrowPathTest, HysteresisLivesWithTask) {
+  auto* path_decider_status = injector_->planning_context()
+                                  ->mutable_planning_status()
+                                  ->mutable_path_decider();
+  path_decider_status->set_is_in_path_lane_borrow_scenario(true);
+  path_decider_status->set_able_to_use_self_lane_counter(3);
+  path_decider_status->set_left_borrow(true);
+
+  // a new task, e.g. of a new stage, decides the borrow sides anew
+  LaneBorrowPath lane_borrow_path;
+  lane_borrow_path.Init(
+      "scenarios/lane_follow_scenario/conf/lane_follow_stage",
+      "LANE_BORROW_PATH", injector_);
+  EXPECT_EQ(lane_borrow_path.Name(), "LANE_BORROW_PATH");
+  EXPECT_EQ(path_decider_status->able_to_use_self_lane_counter(), 0);
+  EXPECT_FALSE(path_decider_status->left_borrow());
+  EXPECT_FALSE(path_decider_status->right_borrow());
+  // the borrow scenario flag was kept in the status before
+  EXPECT_TRUE(path_decider_status->is_in_path_lane_borrow_scenario());
+}
+
+}  // namespace planning
+}  // namespace apollo
@@ -51,6 +51,15 @@ bool LaneChangePath::Init(const std::string& config_dir,
   if (!Task::Init(config_dir, name, injector)) {
     return false;
   }
+  // The lane change start position starts over with every task instance
+  // like the members it replaced, the status only shares it with the
+  // reference lines planned in parallel.
+  auto* lane_change_status = injector_->planning_context()
+                                 ->mutable_planning_status()
+                                 ->mutable_change_lane();
+  lane_change_status->set_exist_lane_change_start_position(false);
+  lane_change_status->clear_lane_change_start_position();
+  lane_change_status->set_is_clear_to_change_lane(false);
   // Load the config this task.
   return Task::LoadConfig<LaneChangePathConfig>(&config_);
 }
@@ -171,9 +180,11 @@ bool LaneChangePath::OptimizePath(
     std::vector<double> ref_l(path_boundary_size, 0);
     std::vector<double> weight_ref_l(path_boundary_size, 0);
 
+    const auto warm_start = StitchPreviousPath(path_boundary);
     bool res_opt = PathOptimizerUtil::OptimizePath(
         init_sl_state_, end_state, ref_l, weight_ref_l, path_boundary,
-        ddl_bounds, jerk_bound, config, &opt_l, &opt_dl, &opt_ddl);
+        ddl_bounds, jerk_bound, config, &opt_l, &opt_dl, &opt_ddl,
+        &solver_session_, &warm_start);
     if (res_opt) {
       auto frenet_frame_path = PathOptimizerUtil::ToPiecewiseJerkPath(
           opt_l, opt_dl, opt_ddl, path_boundary.delta_s(),
@@ -250,10 +261,11 @@ void LaneChangePath::UpdateLaneChangeStatus() {
     const auto* history_frame = injector_->frame_history()->Latest();
     if (!CheckLastFrameSucceed(history_frame)) {
       UpdateStatus(now, ChangeLaneStatus::CHANGE_LANE_FAILED, change_lane_id);
-      is_exist_lane_change_start_position_ = false;
+      prev_status->set_exist_lane_change_start_position(false);
       return;
     }
-    is_clear_to_change_lane_ = IsClearToChangeLane(reference_line_info_);
+    prev_status->set_is_clear_to_change_lane(
+        IsClearToChangeLane(reference_line_info_));
     change_lane_id = reference_line_info_->Lanes().Id();
     ADEBUG << "change_lane_id" << change_lane_id;
     if (prev_status->status() == ChangeLaneStatus::CHANGE_LANE_FAILED) {
@@ -395,26 +407,38 @@ void LaneChangePath::GetBoundaryFromLaneChangeForbiddenZone(
   // Sanity checks.
   CHECK_NOTNULL(path_bound);
 
-  if (is_clear_to_change_lane_) {
-    is_exist_lane_change_start_position_ = false;
+  // the lane change status keeps the start position across cycles
+  auto* lane_change_status = injector_->planning_context()
+                                 ->mutable_planning_status()
+                                 ->mutable_change_lane();
+  if (lane_change_status->is_clear_to_change_lane()) {
+    lane_change_status->set_exist_lane_change_start_position(false);
     return;
   }
   double lane_change_start_s = 0.0;
   const ReferenceLine& reference_line = reference_line_info_->reference_line();
   // If there is a pre-determined lane-change starting position, then use it;
   // otherwise, decide one.
-  if (is_exist_lane_change_start_position_) {
+  if (lane_change_status->exist_lane_change_start_position()) {
     common::SLPoint point_sl;
-    reference_line.XYToSL(lane_change_start_xy_, &point_sl);
+    reference_line.XYToSL(
+        Vec2d(lane_change_status->lane_change_start_position().x(),
+              lane_change_status->lane_change_start_position().y()),
+        &point_sl);
     lane_change_start_s = point_sl.s();
   } else {
     // TODO(jiacheng): train ML model to learn this.
     lane_change_start_s =
         config_.lane_change_prepare_length() + init_sl_state_.first[0];
 
-    // Update the lane_change_start_xy_ decided by lane_change_start_s
+    // Update the lane change start position decided by lane_change_start_s
+    Vec2d lane_change_start_xy;
     GetLaneChangeStartPoint(reference_line, init_sl_state_.first[0],
-                            &lane_change_start_xy_);
+                            &lane_change_start_xy);
+    lane_change_status->mutable_lane_change_start_position()->set_x(
+        lane_change_start_xy.x());
+    lane_change_status->mutable_lane_change_start_position()->set_y(
+        lane_change_start_xy.y());
   }
 
   // Remove the target lane out of the path-boundary, up to the decided S.
@@ -38,6 +38,8 @@ class LaneChangePath : public PathGeneration {
   bool Init(const std::string& config_dir, const std::string& name,
             const std::shared_ptr<DependencyInjector>& injector) override;
 
+  bool IsReferenceLineLocal() const override { return true; }
+
  private:
   apollo::common::Status Process(
       Frame* frame, ReferenceLineInfo* reference_line_info) override;
@@ -100,9 +102,6 @@ class LaneChangePath : public PathGeneration {
 
  private:
   LaneChangePathConfig config_;
-  bool is_clear_to_change_lane_ = false;
-  bool is_exist_lane_change_start_position_ = false;
-  common::math::Vec2d lane_change_start_xy_;
 };
 
 CYBER_PLUGIN_MANAGER_REGISTER_PLUGIN(apollo::planning::LaneChangePath, Task)
@@ -0,0 +1,57 @@
+/******************************************************************************
+ * Copyright 2024 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/planning/tasks/lane_change_path/lane_change_path.h"
+
+#include <memory>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace planning {
+
+class LaneChangePathTest : public ::testing::Test {
+ public:
+  virtual void SetUp() { injector_ = std::make_shared<DependencyInjector>(); }
+
+ protected:
+  std::shared_ptr<DependencyInjector> injector_;
+};
+
+TEST_F(LaneChangePathTest, StartPositionLivesWithTask) {
+  auto* change_lane_status = injector_->planning_context()
+                                 ->mutable_planning_status()
+                                 ->mutable_change_lane();
+  change_lane_status->set_status(ChangeLaneStatus::IN_CHANGE_LANE);
+  change_lane_status->set_exist_lane_change_start_position(true);
+  change_lane_status->mutable_lane_change_start_position()->set_x(1.0);
+  change_lane_status->set_is_clear_to_change_lane(true);
+
+  // a new task, e.g. of a new stage, decides the start position anew
+  LaneChangePath lane_change_path;
+  lane_change_path.Init(
+      "scenarios/lane_follow_scenario/conf/lane_follow_stage",
+      "LANE_CHANGE_PATH", injector_);
+  EXPECT_EQ(lane_change_path.Name(), "LANE_CHANGE_PATH");
+  EXPECT_FALSE(change_lane_status->exist_lane_change_start_position());
+  EXPECT_FALSE(change_lane_status->has_lane_change_start_position());
+  EXPECT_FALSE(change_lane_status->is_clear_to_change_lane());
+  // the lane change state itself was kept in the status before
+  EXPECT_EQ(change_lane_status->status(), ChangeLaneStatus::IN_CHANGE_LANE);
+}
+
+}  // namespace planning
+}  // namespace apollo
@@ -35,6 +35,8 @@ class PathDecider : public Task {
   bool Init(const std::string &config_dir, const std::string &name,
             const std::shared_ptr<DependencyInjector> &injector) override;
 
+  bool IsReferenceLineLocal() const override { return true; }
+
   apollo::common::Status Execute(
       Frame *frame, ReferenceLineInfo *reference_line_info) override;
 
@@ -41,6 +41,8 @@ class PathTimeHeuristicOptimizer : public SpeedOptimizer {
   bool Init(const std::string& config_dir, const std::string& name,
             const std::shared_ptr<DependencyInjector>& injector) override;
 
+  bool IsReferenceLineLocal() const override { return true; }
+
  private:
   common::Status Process(const PathData& path_data,
                          const common::TrajectoryPoint& init_point,
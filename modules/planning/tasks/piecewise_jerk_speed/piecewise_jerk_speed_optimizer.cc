@@ -27,6 +27,7 @@
 #include "modules/common/vehicle_state/vehicle_state_provider.h"
 #include "modules/planning/planning_base/common/speed_profile_generator.h"
 #include "modules/planning/planning_base/common/st_graph_data.h"
+#include "modules/planning/planning_base/common/trajectory/discretized_trajectory.h"
 #include "modules/planning/planning_base/common/util/print_debug_info.h"
 #include "modules/planning/planning_base/gflags/planning_gflags.h"
 #include "modules/planning/planning_base/math/piecewise_jerk/piecewise_jerk_speed_problem.h"
@@ -184,27 +185,34 @@ Status PiecewiseJerkSpeedOptimizer::Process(const PathData& path_data,
   piecewise_jerk_problem.set_x_ref(config_.ref_s_weight(), std::move(x_ref));
   piecewise_jerk_problem.set_penalty_dx(penalty_dx);
   piecewise_jerk_problem.set_dx_bounds(std::move(s_dot_bounds));
+  piecewise_jerk_problem.set_solver_session(&solver_session_);
+  piecewise_jerk_problem.set_warm_start(
+      StitchPreviousSpeed(init_point, num_of_knots, delta_t));
 
   // Solve the problem
-  if (!piecewise_jerk_problem.Optimize()) {
-    const std::string msg = "Piecewise jerk speed optimizer failed!";
-    AERROR << msg << ".try to fallback.";
+  bool success = piecewise_jerk_problem.Optimize();
+  if (!success) {
+    AERROR << "Piecewise jerk speed optimizer failed!.try to fallback.";
     piecewise_jerk_problem.set_dx_bounds(
         0.0, std::fmax(FLAGS_planning_upper_speed_limit,
                        st_graph_data.init_point().v()));
-    if (!FLAGS_speed_optimize_fail_relax_velocity_constraint ||
-        !piecewise_jerk_problem.Optimize()) {
-      speed_data->clear();
-      print_debug.AddPoint("optimize_st_curve", 0, init_s[0]);
-      print_debug.AddPoint("optimize_vt_curve", 0, init_s[1]);
-      print_debug.AddPoint("optimize_at_curve", 0, init_s[2]);
-      AINFO << "jerk_bound: " << FLAGS_longitudinal_jerk_lower_bound << ","
-            << FLAGS_longitudinal_jerk_upper_bound;
-      AINFO << "acc bound: " << veh_param.max_deceleration() << ","
-            << veh_param.max_acceleration();
-      print_debug.PrintToLog();
-      return Status(ErrorCode::PLANNING_ERROR, msg);
-    }
+    success = FLAGS_speed_optimize_fail_relax_velocity_constraint &&
+              piecewise_jerk_problem.Optimize();
+  }
+  AINFO << "Planning Perf: task name [" << Name() << "], osqp "
+        << solver_session_.TakeStats().DebugString();
+  if (!success) {
+    const std::string msg = "Piecewise jerk speed optimizer failed!";
+    speed_data->clear();
+    print_debug.AddPoint("optimize_st_curve", 0, init_s[0]);
+    print_debug.AddPoint("optimize_vt_curve", 0, init_s[1]);
+    print_debug.AddPoint("optimize_at_curve", 0, init_s[2]);
+    AINFO << "jerk_bound: " << FLAGS_longitudinal_jerk_lower_bound << ","
+          << FLAGS_longitudinal_jerk_upper_bound;
+    AINFO << "acc bound: " << veh_param.max_deceleration() << ","
+          << veh_param.max_acceleration();
+    print_debug.PrintToLog();
+    return Status(ErrorCode::PLANNING_ERROR, msg);
   }
 
   // Extract output
@@ -258,5 +266,50 @@ void PiecewiseJerkSpeedOptimizer::AdjustInitStatus(
     }
   }
 }
+
+PiecewiseJerkWarmStart PiecewiseJerkSpeedOptimizer::StitchPreviousSpeed(
+    const TrajectoryPoint& init_point, const int num_of_knots,
+    const double delta_t) const {
+  PiecewiseJerkWarmStart warm_start;
+  const Frame* last_frame = injector_->frame_history()->Latest();
+  if (last_frame == nullptr ||
+      frame_->vehicle_state().gear() == canbus::Chassis::GEAR_REVERSE) {
+    return warm_start;
+  }
+  const auto& last_trajectory_pb =
+      last_frame->current_frame_planned_trajectory();
+  const DiscretizedTrajectory last_trajectory(last_trajectory_pb);
+  if (last_trajectory.size() < 2) {
+    return warm_start;
+  }
+  // relative time of the planning start point on the last trajectory
+  const double start_time = frame_->vehicle_state().timestamp() +
+                            init_point.relative_time() -
+                            last_trajectory_pb.header().timestamp_sec();
+  const double end_time = last_trajectory.back().relative_time();
+  if (start_time < last_trajectory.front().relative_time() ||
+      start_time > end_time) {
+    return warm_start;
+  }
+  const double start_s = last_trajectory.Evaluate(start_time).path_point().s();
+  const auto& end_point = last_trajectory.back();
+  for (int i = 0; i < num_of_knots; ++i) {
+    const double t = start_time + i * delta_t;
+    if (t > end_time) {
+      // keep the speed of the end beyond the last trajectory
+      warm_start.x.push_back(end_point.path_point().s() - start_s +
+                             end_point.v() * (t - end_time));
+      warm_start.dx.push_back(end_point.v());
+      warm_start.ddx.push_back(0.0);
+      continue;
+    }
+    const auto point = last_trajectory.Evaluate(t);
+    warm_start.x.push_back(point.path_point().s() - start_s);
+    warm_start.dx.push_back(point.v());
+    warm_start.ddx.push_back(point.a());
+  }
+  return warm_start;
+}
+
 }  // namespace planning
 }  // namespace apollo
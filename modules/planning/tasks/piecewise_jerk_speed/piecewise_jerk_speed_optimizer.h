@@ -26,6 +26,7 @@
 #include <vector>
 #include "modules/planning/tasks/piecewise_jerk_speed/proto/piecewise_jerk_speed.pb.h"
 #include "cyber/plugin_manager/plugin_manager.h"
+#include "modules/planning/planning_base/math/piecewise_jerk/piecewise_jerk_problem.h"
 #include "modules/planning/planning_interface_base/task_base/common/speed_optimizer.h"
 
 namespace apollo {
@@ -36,6 +37,8 @@ class PiecewiseJerkSpeedOptimizer : public SpeedOptimizer {
   bool Init(const std::string& config_dir, const std::string& name,
             const std::shared_ptr<DependencyInjector>& injector) override;
 
+  bool IsReferenceLineLocal() const override { return true; }
+
   virtual ~PiecewiseJerkSpeedOptimizer() = default;
 
  private:
@@ -45,7 +48,14 @@ class PiecewiseJerkSpeedOptimizer : public SpeedOptimizer {
   void AdjustInitStatus(
       const std::vector<std::pair<double, double>> s_dot_bound, double delta_t,
       std::array<double, 3>& init_s);
+  // stitch the trajectory planned in the last frame to the knots starting at
+  // init_point, empty if there is none
+  PiecewiseJerkWarmStart StitchPreviousSpeed(
+      const common::TrajectoryPoint& init_point, const int num_of_knots,
+      const double delta_t) const;
   PiecewiseJerkSpeedOptimizerConfig config_;
+  // osqp workspaces of the speed problem, kept from frame to frame
+  PiecewiseJerkSolverSession solver_session_;
 };
 
 CYBER_PLUGIN_MANAGER_REGISTER_PLUGIN(
@@ -213,9 +213,11 @@ bool PullOverPath::OptimizePath(
     const double jerk_bound = PathOptimizerUtil::EstimateJerkBoundary(
         std::fmax(init_sl_state_.first[1], 1e-12));
 
+    const auto warm_start = StitchPreviousPath(path_boundary);
     bool res_opt = PathOptimizerUtil::OptimizePath(
         init_sl_state_, end_state, ref_l, weight_ref_l, path_boundary,
-        ddl_bounds, jerk_bound, path_config, &opt_l, &opt_dl, &opt_ddl);
+        ddl_bounds, jerk_bound, path_config, &opt_l, &opt_dl, &opt_ddl,
+        &solver_session_, &warm_start);
     if (res_opt) {
       auto frenet_frame_path = PathOptimizerUtil::ToPiecewiseJerkPath(
           opt_l, opt_dl, opt_ddl, path_boundary.delta_s(),
@@ -51,6 +51,13 @@ bool RuleBasedStopDecider::Init(
   return Decider::LoadConfig<RuleBasedStopDeciderConfig>(&config_);
 }
 
+bool RuleBasedStopDecider::IsReferenceLineLocal() const {
+  // lane change urgency looks at the other reference lines, the side pass stop
+  // keeps state across them
+  return !config_.enable_lane_change_urgency_checking() &&
+         !config_.enable_stop_on_side_pass();
+}
+
 apollo::common::Status RuleBasedStopDecider::Process(
     Frame *const frame, ReferenceLineInfo *const reference_line_info) {
   // 1. Rule_based stop for side pass onto reverse lane
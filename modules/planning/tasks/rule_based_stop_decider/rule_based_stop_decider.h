@@ -32,6 +32,8 @@ class RuleBasedStopDecider : public Decider {
   bool Init(const std::string& config_dir, const std::string& name,
             const std::shared_ptr<DependencyInjector>& injector) override;
 
+  bool IsReferenceLineLocal() const override;
+
  private:
   apollo::common::Status Process(
       Frame* const frame,
@@ -37,6 +37,8 @@ class SpeedBoundsDecider : public Decider {
   bool Init(const std::string& config_dir, const std::string& name,
             const std::shared_ptr<DependencyInjector>& injector) override;
 
+  bool IsReferenceLineLocal() const override { return true; }
+
  private:
   common::Status Process(Frame* const frame,
                          ReferenceLineInfo* const reference_line_info) override;
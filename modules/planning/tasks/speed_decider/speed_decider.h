@@ -41,6 +41,8 @@ class SpeedDecider : public Task {
   bool Init(const std::string& config_dir, const std::string& name,
             const std::shared_ptr<DependencyInjector>& injector) override;
 
+  bool IsReferenceLineLocal() const override { return true; }
+
   common::Status Execute(Frame* frame,
                          ReferenceLineInfo* reference_line_info) override;
 